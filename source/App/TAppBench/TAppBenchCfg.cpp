@@ -0,0 +1,122 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TAppBenchCfg.cpp
+    \brief    Kernel benchmark configuration class
+*/
+
+#include <cstdio>
+#include <string>
+#include "TAppBenchCfg.h"
+#include "TAppCommon/program_options_lite.h"
+#include "TLibCommon/TComCpuFeatures.h"
+
+using namespace std;
+namespace po = df::program_options_lite;
+
+//! \ingroup TAppBench
+//! \{
+
+// ====================================================================================================================
+// Public member functions
+// ====================================================================================================================
+
+/** \param argc number of arguments
+    \param argv array of arguments
+ */
+Bool TAppBenchCfg::parseCfg( Int argc, TChar* argv[] )
+{
+  Bool do_help = false;
+  string simdSetting;
+
+  po::Options opts;
+  opts.addOptions()
+
+  ("help",                      do_help,                               false,      "this help text")
+  ("Kernels,k",                 m_kernelFilter,                        string(""), "Comma separated list of parts of the kernel names to run, e.g. SAD,Interp (empty string: all kernels)")
+  ("BitDepth,d",                m_bitDepth,                            8,          "Bit depth of the synthetic samples")
+  ("MinTime",                   m_minTime,                             0.02,       "Minimum measurement time of each kernel and SIMD extension, in seconds")
+  ("CheckOnly",                 m_checkOnly,                           false,      "Only compare the outputs of the SIMD extensions with the C code, without timing")
+  ("Seed",                      m_seed,                                1U,         "Seed of the synthetic data")
+  ("SIMD",                      simdSetting,                           string(""), "Maximum SIMD extensions measured, e.g. none, sse2, sse41, avx2 or avx2,sao=none (empty string: the HM_SIMD environment variable, else all that the processor supports). "
+                                                                                   "Groups: distortion, interpolation, transform, intra, loopfilter, sao, yuv, bitstream")
+  ;
+
+  po::setDefaults(opts);
+  po::ErrorReporter err;
+  const list<const TChar*>& argv_unhandled = po::scanArgv(opts, argc, (const TChar**) argv, err);
+
+  for (list<const TChar*>::const_iterator it = argv_unhandled.begin(); it != argv_unhandled.end(); it++)
+  {
+    fprintf(stderr, "Unhandled argument ignored: `%s'\n", *it);
+  }
+
+  if (do_help)
+  {
+    po::doHelp(cout, opts);
+    return false;
+  }
+
+  if (err.is_errored)
+  {
+    /* errors have already been reported to stderr */
+    return false;
+  }
+
+  if (!simdSetting.empty() && !parseSIMDExtensions(simdSetting))
+  {
+    fprintf(stderr, "Bad SIMD setting \"%s\"\n", simdSetting.c_str());
+    return false;
+  }
+
+#if RExt__HIGH_BIT_DEPTH_SUPPORT
+  const Int maxBitDepth = 16;
+#else
+  const Int maxBitDepth = 12;
+#endif
+  if (m_bitDepth < 8 || m_bitDepth > maxBitDepth)
+  {
+    fprintf(stderr, "BitDepth must be in the range 8 to %d\n", maxBitDepth);
+    return false;
+  }
+
+  if (m_minTime <= 0)
+  {
+    fprintf(stderr, "MinTime must be greater than 0\n");
+    return false;
+  }
+
+  return true;
+}
+
+//! \}
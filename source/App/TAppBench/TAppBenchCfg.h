@@ -0,0 +1,82 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TAppBenchCfg.h
+    \brief    Kernel benchmark configuration class (header)
+*/
+
+#ifndef __TAPPBENCHCFG__
+#define __TAPPBENCHCFG__
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+#include "TLibCommon/CommonDef.h"
+#include <string>
+
+//! \ingroup TAppBench
+//! \{
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// Kernel benchmark configuration class
+class TAppBenchCfg
+{
+protected:
+  std::string   m_kernelFilter;                       ///< comma separated list of kernel name parts, empty for all kernels
+  Int           m_bitDepth;                           ///< bit depth of the synthetic samples
+  Double        m_minTime;                            ///< minimum measurement time of each kernel and SIMD extension, in seconds
+  Bool          m_checkOnly;                          ///< only compare the outputs of the SIMD extensions, without timing
+  UInt          m_seed;                               ///< seed of the synthetic data
+
+public:
+  TAppBenchCfg()
+  : m_kernelFilter()
+  , m_bitDepth(8)
+  , m_minTime(0.02)
+  , m_checkOnly(false)
+  , m_seed(1)
+  {}
+
+  virtual ~TAppBenchCfg() {}
+
+  Bool  parseCfg        ( Int argc, TChar* argv[] );   ///< initialize option class from configuration
+};
+
+//! \}
+
+#endif
+
@@ -0,0 +1,1061 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TAppBenchKernels.cpp
+    \brief    Kernels measured by the benchmark
+*/
+
+#include <cstring>
+#include <sstream>
+#include "TAppBenchKernels.h"
+#include "TLibCommon/TComRdCost.h"
+#include "TLibCommon/TComPattern.h"
+#include "TLibCommon/TComInterpolationFilter.h"
+#include "TLibCommon/TComTrQuant.h"
+#include "TLibCommon/TComPrediction.h"
+#include "TLibCommon/TComLoopFilter.h"
+#include "TLibCommon/TComSampleAdaptiveOffset.h"
+#include "TLibCommon/TComYuv.h"
+#include "TLibCommon/TComWeightPrediction.h"
+#include "TLibCommon/TComPicYuv.h"
+#include "TLibCommon/TComSlice.h"
+#include "TLibCommon/TComBitStream.h"
+#include "TLibCommon/TComPic.h"
+#include "TLibCommon/TComTU.h"
+#include "TLibEncoder/TEncSampleAdaptiveOffset.h"
+
+//! \ingroup TAppBench
+//! \{
+
+// ====================================================================================================================
+// Synthetic data
+// ====================================================================================================================
+
+static const Int BENCH_STRIDE                    = MAX_CU_SIZE + 16; ///< stride of the sample buffers, which hold up to MAX_CU_SIZE samples and the filter margins
+static const Int BENCH_MAX_LOG2_TR_DYNAMIC_RANGE = 15;               ///< dynamic range of the coefficients without extended precision processing
+
+static UInt g_benchRandomState = 1;
+
+static Void xSeedRandom( UInt seed )
+{
+  g_benchRandomState = seed != 0 ? seed : 1;
+}
+
+/// pseudo-random value in [minVal, maxVal] (xorshift), so that every run uses the same data
+static Int xRandom( Int minVal, Int maxVal )
+{
+  g_benchRandomState ^= g_benchRandomState << 13;
+  g_benchRandomState ^= g_benchRandomState >> 17;
+  g_benchRandomState ^= g_benchRandomState << 5;
+  return minVal + Int( g_benchRandomState % UInt( maxVal - minVal + 1 ) );
+}
+
+static Void xFillRandom( Pel* dst, Int stride, Int width, Int height, Int minVal, Int maxVal )
+{
+  for( Int y = 0; y < height; y++, dst += stride )
+  {
+    for( Int x = 0; x < width; x++ )
+    {
+      dst[x] = Pel( xRandom( minVal, maxVal ) );
+    }
+  }
+}
+
+static Void xAppendOutput( std::vector<Int64>& output, const Pel* src, Int stride, Int width, Int height )
+{
+  for( Int y = 0; y < height; y++, src += stride )
+  {
+    for( Int x = 0; x < width; x++ )
+    {
+      output.push_back( src[x] );
+    }
+  }
+}
+
+static std::string xSizeName( Int width, Int height )
+{
+  std::ostringstream name;
+  name << width << "x" << height;
+  return name.str();
+}
+
+// ====================================================================================================================
+// Distortion (TComRdCost)
+// ====================================================================================================================
+
+class TBenchDistortion : public TAppBenchKernel
+{
+private:
+  TComRdCost       m_rdCost;
+  TComPattern      m_pattern;
+  DistParam        m_distParam;
+  const DFunc      m_dFunc;
+  const Int        m_width;
+  const Int        m_height;
+  const Int        m_subShift;
+  const Int        m_bitDepth;
+  std::vector<Pel> m_org;
+  std::vector<Pel> m_cur;
+  Distortion       m_distortion;
+
+public:
+  /// subShift > 0 only measures every ( 1 << subShift )-th row, as the fast integer motion search
+  TBenchDistortion( const std::string& name, DFunc dFunc, Int width, Int height, Int subShift, Int bitDepth )
+  : TAppBenchKernel( name, xSizeName( width, height ), SIMD_KERNELS_DISTORTION, width*( height >> subShift ) )
+  , m_dFunc( dFunc ), m_width( width ), m_height( height ), m_subShift( subShift ), m_bitDepth( bitDepth )
+  , m_org( BENCH_STRIDE*height ), m_cur( BENCH_STRIDE*height ), m_distortion( 0 )
+  {
+    const Int maxVal = ( 1 << bitDepth ) - 1;
+    xFillRandom( &m_org[0], BENCH_STRIDE, width, height, 0, maxVal );
+
+    // the current block is close to the original one, as in motion estimation
+    for( Int i = 0; i < BENCH_STRIDE*height; i++ )
+    {
+      m_cur[i] = Pel( Clip3( 0, maxVal, m_org[i] + xRandom( -16, 16 ) * ( 1 << ( bitDepth - 8 ) ) ) );
+    }
+  }
+
+  // the distortion functions are selected by TComRdCost::init()
+  Void select()
+  {
+    m_rdCost.init();
+    if( m_dFunc == DF_SAD )
+    {
+      // as the integer motion search, which also selects the functions of the AMP widths 12, 24 and 48
+      m_pattern.initPattern( &m_org[0], m_width, m_height, BENCH_STRIDE, m_bitDepth );
+      m_rdCost.setDistParam( &m_pattern, &m_cur[0], BENCH_STRIDE, m_distParam );
+    }
+    else
+    {
+      m_rdCost.setDistParam( m_width, m_height, m_dFunc, m_distParam );
+      m_distParam.pOrg       = &m_org[0];
+      m_distParam.pCur       = &m_cur[0];
+      m_distParam.iStrideOrg = BENCH_STRIDE;
+      m_distParam.iStrideCur = BENCH_STRIDE;
+    }
+    m_distParam.iStep      = 1;
+    m_distParam.iSubShift  = m_subShift;
+    m_distParam.bitDepth   = m_bitDepth;
+  }
+
+  Void run()
+  {
+    m_distortion = m_distParam.DistFunc( &m_distParam );
+  }
+
+  Void getOutput( std::vector<Int64>& output ) const
+  {
+    output.push_back( Int64( m_distortion ) );
+  }
+};
+
+// ====================================================================================================================
+// Interpolation filters (TComInterpolationFilter)
+// ====================================================================================================================
+
+enum BenchFilterDirection
+{
+  BENCH_FILTER_HOR     = 0,
+  BENCH_FILTER_VER     = 1,
+  BENCH_FILTER_HOR_VER = 2
+};
+
+class TBenchInterpolation : public TAppBenchKernel
+{
+private:
+  TComInterpolationFilter    m_if;
+  const ComponentID          m_compID;
+  const BenchFilterDirection m_direction;
+  const Int                  m_width;
+  const Int                  m_height;
+  const Bool                 m_isLast;
+  const Int                  m_bitDepth;
+  std::vector<Pel>           m_src;
+  std::vector<Pel>           m_tmp;
+  std::vector<Pel>           m_dst;
+
+public:
+  TBenchInterpolation( const std::string& name, ComponentID compID, BenchFilterDirection direction, Int size, Bool isLast, Int bitDepth )
+  : TAppBenchKernel( name, xSizeName( size, size ), SIMD_KERNELS_INTERPOLATION, size*size )
+  , m_compID( compID ), m_direction( direction ), m_width( size ), m_height( size ), m_isLast( isLast ), m_bitDepth( bitDepth )
+  , m_src( BENCH_STRIDE*( size + NTAPS_LUMA ) ), m_tmp( BENCH_STRIDE*( size + NTAPS_LUMA ) ), m_dst( BENCH_STRIDE*size )
+  {
+    xFillRandom( &m_src[0], BENCH_STRIDE, size + NTAPS_LUMA, size + NTAPS_LUMA, 0, ( 1 << bitDepth ) - 1 );
+  }
+
+  Void run()
+  {
+    // the block starts after the samples used by the first taps of the luma filter
+    Pel*      src   = &m_src[( ( NTAPS_LUMA >> 1 ) - 1 ) * ( BENCH_STRIDE + 1 )];
+    const Int fracX = isLuma( m_compID ) ? 1 : 3;
+    const Int fracY = isLuma( m_compID ) ? 3 : 5;
+
+    switch( m_direction )
+    {
+      case BENCH_FILTER_HOR:
+        m_if.filterHor( m_compID, src, BENCH_STRIDE, &m_dst[0], BENCH_STRIDE, m_width, m_height, fracX, m_isLast, CHROMA_420, m_bitDepth );
+        break;
+      case BENCH_FILTER_VER:
+        m_if.filterVer( m_compID, src, BENCH_STRIDE, &m_dst[0], BENCH_STRIDE, m_width, m_height, fracY, true, m_isLast, CHROMA_420, m_bitDepth );
+        break;
+      case BENCH_FILTER_HOR_VER:
+      default:
+        m_if.filterHorVer( m_compID, src, BENCH_STRIDE, &m_tmp[0], BENCH_STRIDE, &m_dst[0], BENCH_STRIDE, m_width, m_height, fracX, fracY, m_isLast, CHROMA_420, m_bitDepth );
+        break;
+    }
+  }
+
+  Void getOutput( std::vector<Int64>& output ) const
+  {
+    xAppendOutput( output, &m_dst[0], BENCH_STRIDE, m_width, m_height );
+  }
+};
+
+// ====================================================================================================================
+// Core transforms (TComTrQuant)
+// ====================================================================================================================
+
+class TBenchTransform : public TAppBenchKernel
+{
+private:
+  const Bool          m_forward;
+  const Bool          m_useDST;
+  const Int           m_size;
+  const Int           m_bitDepth;
+  std::vector<TCoeff> m_input;
+  std::vector<TCoeff> m_output;
+
+public:
+  TBenchTransform( const std::string& name, Bool forward, Bool useDST, Int size, Int bitDepth )
+  : TAppBenchKernel( name, xSizeName( size, size ), SIMD_KERNELS_TRANSFORM, size*size )
+  , m_forward( forward ), m_useDST( useDST ), m_size( size ), m_bitDepth( bitDepth )
+  , m_input( size*size ), m_output( size*size )
+  {
+    const Int maxResidual = ( 1 << bitDepth ) - 1;
+    for( Int i = 0; i < size*size; i++ )
+    {
+      m_input[i] = xRandom( -maxResidual, maxResidual );
+    }
+
+    // the inverse transform gets the coefficients of a residual block
+    if( !forward )
+    {
+      std::vector<TCoeff> residual( m_input );
+      TComTrQuant::coreTransform( bitDepth, &residual[0], &m_input[0], size, size, useDST, BENCH_MAX_LOG2_TR_DYNAMIC_RANGE );
+    }
+  }
+
+  Void run()
+  {
+    if( m_forward )
+    {
+      TComTrQuant::coreTransform( m_bitDepth, &m_input[0], &m_output[0], m_size, m_size, m_useDST, BENCH_MAX_LOG2_TR_DYNAMIC_RANGE );
+    }
+    else
+    {
+      TComTrQuant::coreInvTransform( m_bitDepth, &m_input[0], &m_output[0], m_size, m_size, m_useDST, BENCH_MAX_LOG2_TR_DYNAMIC_RANGE );
+    }
+  }
+
+  Void getOutput( std::vector<Int64>& output ) const
+  {
+    output.insert( output.end(), m_output.begin(), m_output.end() );
+  }
+};
+
+// ====================================================================================================================
+// Quantisation (TComTrQuant)
+// ====================================================================================================================
+
+/// quantisation without RDOQ and scaling lists, of the luma TU of an inter CU; xQuant() and xDeQuant() only have a C version
+class TBenchQuant : public TAppBenchKernel
+{
+private:
+  TComTrQuant         m_trQuant;
+  TComPic             m_pic;
+  const Bool          m_forward;
+  const Int           m_size;
+  const QpParam       m_qp;
+  TComDataCU*         m_cu;
+  std::vector<TCoeff> m_input;
+  std::vector<TCoeff> m_output;
+  std::vector<TCoeff> m_arlOutput;
+  TCoeff              m_absSum;
+
+public:
+  static const Int QP = 32;
+
+  TBenchQuant( const std::string& name, Bool forward, Int size, Int bitDepth )
+  : TAppBenchKernel( name, xSizeName( size, size ), NUMBER_OF_SIMD_KERNEL_GROUPS, size*size )
+  , m_forward( forward ), m_size( size ), m_qp( QP, CHANNEL_TYPE_LUMA, 6*( bitDepth - 8 ), 0, CHROMA_420 )
+  , m_cu( NULL ), m_input( size*size ), m_output( size*size ), m_arlOutput( size*size ), m_absSum( 0 )
+  {
+    // a picture of one CTU, with sign data hiding as in the common test conditions
+    TComSPS sps;
+    TComPPS pps;
+    sps.setChromaFormatIdc( CHROMA_420 );
+    sps.setPicWidthInLumaSamples( MAX_CU_SIZE );
+    sps.setPicHeightInLumaSamples( MAX_CU_SIZE );
+    sps.setMaxCUWidth( MAX_CU_SIZE );
+    sps.setMaxCUHeight( MAX_CU_SIZE );
+    sps.setMaxTotalCUDepth( g_aucConvertToBit[MAX_CU_SIZE] );
+    sps.setQuadtreeTULog2MaxSize( g_aucConvertToBit[MAX_TU_SIZE] + 2 );
+    for( Int channelType = 0; channelType < MAX_NUM_CHANNEL_TYPE; channelType++ )
+    {
+      sps.setBitDepth( ChannelType( channelType ), bitDepth );
+      sps.setQpBDOffset( ChannelType( channelType ), 6*( bitDepth - 8 ) );
+    }
+    pps.setSignDataHidingEnabledFlag( true );
+#if REDUCED_ENCODER_MEMORY
+    m_pic.create( sps, pps, false, true );
+#else
+    m_pic.create( sps, pps, true );
+#endif
+    TComSlice* slice = m_pic.getSlice( 0 );
+    slice->setSPS( &m_pic.getPicSym()->getSPS() );
+    slice->setPPS( &m_pic.getPicSym()->getPPS() );
+    slice->setSliceType( B_SLICE );
+
+    // an inter CU of the size of the TU
+    const UInt depth = g_aucConvertToBit[MAX_CU_SIZE] - g_aucConvertToBit[size];
+    m_cu = m_pic.getCtu( 0 );
+    m_cu->initCtu( &m_pic, 0 );
+    m_cu->setDepthSubParts( depth, 0 );
+    m_cu->setSizeSubParts( size, size, 0, depth );
+    m_cu->setPredModeSubParts( MODE_INTER, 0, depth );
+    m_cu->setTrIdxSubParts( 0, 0, depth );
+    m_cu->setTransformSkipSubParts( 0, COMPONENT_Y, 0, depth );
+
+    const Int maxLog2TrDynamicRange[MAX_NUM_CHANNEL_TYPE] = { BENCH_MAX_LOG2_TR_DYNAMIC_RANGE, BENCH_MAX_LOG2_TR_DYNAMIC_RANGE };
+    m_trQuant.init( MAX_TU_SIZE );
+    m_trQuant.setFlatScalingList( maxLog2TrDynamicRange, sps.getBitDepths() );
+    m_trQuant.setUseScalingList( false );
+
+    // the coefficients of a residual block, quantised for the dequantisation
+    const Int maxResidual = ( 1 << bitDepth ) - 1;
+    std::vector<TCoeff> residual( size*size );
+    for( Int i = 0; i < size*size; i++ )
+    {
+      residual[i] = xRandom( -maxResidual, maxResidual ) >> 2;
+    }
+    TComTrQuant::coreTransform( bitDepth, &residual[0], &m_input[0], size, size, false, BENCH_MAX_LOG2_TR_DYNAMIC_RANGE );
+    if( !forward )
+    {
+      TComTU              tu( m_cu, 0, depth, 0 );
+      std::vector<TCoeff> levels( size*size );
+      m_trQuant.xQuant( tu, &m_input[0], &levels[0],
+#if ADAPTIVE_QP_SELECTION
+                        &m_arlOutput[0],
+#endif
+                        m_absSum, COMPONENT_Y, m_qp );
+      m_input  = levels;
+      m_absSum = 0;
+    }
+  }
+
+  ~TBenchQuant()
+  {
+    m_pic.destroy();
+  }
+
+  Void run()
+  {
+    TComTU tu( m_cu, 0, m_cu->getDepth( 0 ), 0 );
+    if( m_forward )
+    {
+      m_absSum = 0;
+      m_trQuant.xQuant( tu, &m_input[0], &m_output[0],
+#if ADAPTIVE_QP_SELECTION
+                        &m_arlOutput[0],
+#endif
+                        m_absSum, COMPONENT_Y, m_qp );
+    }
+    else
+    {
+      m_trQuant.xDeQuant( tu, &m_input[0], &m_output[0], COMPONENT_Y, m_qp );
+    }
+  }
+
+  Void getOutput( std::vector<Int64>& output ) const
+  {
+    output.insert( output.end(), m_output.begin(), m_output.end() );
+    output.push_back( Int64( m_absSum ) );
+  }
+};
+
+// ====================================================================================================================
+// Intra prediction (TComPrediction)
+// ====================================================================================================================
+
+/// gives access to the protected prediction functions
+class TBenchPrediction : public TComPrediction
+{
+public:
+  using TComPrediction::xPredIntraAng;
+  using TComPrediction::xPredIntraPlanar;
+  using TComPrediction::xDCPredFiltering;
+};
+
+class TBenchIntraPrediction : public TAppBenchKernel
+{
+private:
+  TBenchPrediction m_prediction;
+  const UInt       m_dirMode;
+  const Int        m_size;
+  const Int        m_bitDepth;
+  const Int        m_refStride;
+  std::vector<Pel> m_ref;
+  std::vector<Pel> m_dst;
+
+public:
+  TBenchIntraPrediction( const std::string& name, UInt dirMode, Int size, Int bitDepth )
+  : TAppBenchKernel( name, xSizeName( size, size ), SIMD_KERNELS_INTRA_PREDICTION, size*size )
+  , m_dirMode( dirMode ), m_size( size ), m_bitDepth( bitDepth ), m_refStride( 2*size + 1 )
+  , m_ref( ( 2*size + 1 ) * ( 2*size + 1 ) ), m_dst( BENCH_STRIDE*size )
+  {
+    // the reference samples (top row and left column of the buffer, as built by initIntraPatternChType) vary smoothly
+    const Int maxVal = ( 1 << bitDepth ) - 1;
+    Int value = 1 << ( bitDepth - 1 );
+    for( Int i = 0; i < m_refStride; i++ )
+    {
+      value = Clip3( 0, maxVal, value + xRandom( -8, 8 ) * ( 1 << ( bitDepth - 8 ) ) );
+      m_ref[i] = Pel( value );
+    }
+    value = m_ref[0];
+    for( Int i = 1; i < m_refStride; i++ )
+    {
+      value = Clip3( 0, maxVal, value + xRandom( -8, 8 ) * ( 1 << ( bitDepth - 8 ) ) );
+      m_ref[i*m_refStride] = Pel( value );
+    }
+  }
+
+  Void run()
+  {
+    const Pel* src = &m_ref[m_refStride + 1];
+    if( m_dirMode == PLANAR_IDX )
+    {
+      m_prediction.xPredIntraPlanar( src, m_refStride, &m_dst[0], BENCH_STRIDE, m_size, m_size );
+    }
+    else
+    {
+      m_prediction.xPredIntraAng( m_bitDepth, src, m_refStride, &m_dst[0], BENCH_STRIDE, m_size, m_size, CHANNEL_TYPE_LUMA, m_dirMode, true );
+      if( m_dirMode == DC_IDX )
+      {
+        m_prediction.xDCPredFiltering( src, m_refStride, &m_dst[0], BENCH_STRIDE, m_size, m_size, CHANNEL_TYPE_LUMA );
+      }
+    }
+  }
+
+  Void getOutput( std::vector<Int64>& output ) const
+  {
+    xAppendOutput( output, &m_dst[0], BENCH_STRIDE, m_size, m_size );
+  }
+};
+
+// ====================================================================================================================
+// Deblocking filter (TComLoopFilter)
+// ====================================================================================================================
+
+/// gives access to the protected filtering functions
+class TBenchLoopFilter : public TComLoopFilter
+{
+public:
+  using TComLoopFilter::xFilterLumaSegment;
+  using TComLoopFilter::xFilterChromaLines;
+
+  static Int getTc( Int indexTC ) { return sm_tcTable[indexTC]; }
+};
+
+class TBenchDeblocking : public TAppBenchKernel
+{
+private:
+  TBenchLoopFilter     m_loopFilter;
+  const ChannelType    m_channelType;
+  const DeblockEdgeDir m_edgeDir;
+  const Int            m_size;
+  const Int            m_bitDepth;
+  std::vector<Pel>     m_original;
+  std::vector<Pel>     m_block;
+
+public:
+  static const Int QP = 37;
+
+  TBenchDeblocking( const std::string& name, ChannelType channelType, DeblockEdgeDir edgeDir, Int size, Int bitDepth )
+  : TAppBenchKernel( name, xSizeName( size, size ), SIMD_KERNELS_LOOP_FILTER, size*size )
+  , m_channelType( channelType ), m_edgeDir( edgeDir ), m_size( size ), m_bitDepth( bitDepth )
+  , m_original( BENCH_STRIDE*size ), m_block( BENCH_STRIDE*size )
+  {
+    // 8x8 blocks of slightly different levels, flat or noisy, so that all filter decisions occur
+    const Int scale = 1 << ( bitDepth - 8 );
+    for( Int blkY = 0; blkY < size; blkY += 8 )
+    {
+      for( Int blkX = 0; blkX < size; blkX += 8 )
+      {
+        const Int level = 128 + xRandom( -12, 12 );
+        const Int noise = xRandom( 0, 2 ) == 2 ? 8 : xRandom( 0, 2 );
+        for( Int y = blkY; y < blkY + 8; y++ )
+        {
+          for( Int x = blkX; x < blkX + 8; x++ )
+          {
+            m_original[y*BENCH_STRIDE + x] = Pel( ( level + xRandom( -noise, noise ) ) * scale );
+          }
+        }
+      }
+    }
+  }
+
+  Bool prepareEachCall() const { return true; }
+
+  Void prepare()
+  {
+    m_block = m_original;
+  }
+
+  // filters all edges of the 8x8 grid inside the block, in segments of 4 lines as xEdgeFilterLuma()/xEdgeFilterChroma()
+  Void run()
+  {
+    const Int  scale         = 1 << ( m_bitDepth - 8 );
+    const Int  beta          = TComLoopFilter::getBeta( QP ) * scale;
+    const Int  tc            = TBenchLoopFilter::getTc( QP + 2 ) * scale;   // boundary strength 2, as for intra blocks
+    const Int  sideThreshold = ( beta + ( beta >> 1 ) ) >> 3;
+    const Bool vertical      = m_edgeDir == EDGE_VER;
+    const Int  offset        = vertical ? 1 : BENCH_STRIDE;
+    const Int  step          = vertical ? BENCH_STRIDE : 1;
+
+    for( Int edge = 8; edge < m_size; edge += 8 )
+    {
+      for( Int line = 0; line < m_size; line += 4 )
+      {
+        Pel* src = &m_block[vertical ? ( line*BENCH_STRIDE + edge ) : ( edge*BENCH_STRIDE + line )];
+        if( isLuma( m_channelType ) )
+        {
+          m_loopFilter.xFilterLumaSegment( src, offset, step, beta, tc, sideThreshold, tc*10, false, false, m_bitDepth );
+        }
+        else
+        {
+          m_loopFilter.xFilterChromaLines( src, offset, step, 4, tc, false, false, m_bitDepth );
+        }
+      }
+    }
+  }
+
+  Void getOutput( std::vector<Int64>& output ) const
+  {
+    xAppendOutput( output, &m_block[0], BENCH_STRIDE, m_size, m_size );
+  }
+};
+
+// ====================================================================================================================
+// Sample adaptive offset (TComSampleAdaptiveOffset, TEncSampleAdaptiveOffset)
+// ====================================================================================================================
+
+/// gives access to the protected offset function
+class TBenchSampleAdaptiveOffset : public TComSampleAdaptiveOffset
+{
+public:
+  using TComSampleAdaptiveOffset::offsetBlock;
+};
+
+class TBenchSAO : public TAppBenchKernel
+{
+private:
+  TBenchSampleAdaptiveOffset m_sao;
+  const Int                  m_typeIdx;
+  const Int                  m_size;
+  const Int                  m_bitDepth;
+  Int                        m_offset[MAX_NUM_SAO_CLASSES];
+  std::vector<Pel>           m_src;
+  std::vector<Pel>           m_res;
+
+public:
+  TBenchSAO( const std::string& name, Int typeIdx, Int size, Int bitDepth )
+  : TAppBenchKernel( name, xSizeName( size, size ), SIMD_KERNELS_SAO, size*size )
+  , m_typeIdx( typeIdx ), m_size( size ), m_bitDepth( bitDepth )
+  , m_src( BENCH_STRIDE*( size + 2 ) ), m_res( BENCH_STRIDE*size )
+  {
+    m_sao.create( MAX_CU_SIZE, MAX_CU_SIZE, CHROMA_420, MAX_CU_SIZE, MAX_CU_SIZE, MAX_CU_DEPTH, 0, 0 );
+
+    // the block and the neighbouring samples used by the edge offsets
+    const Int level = 1 << ( bitDepth - 1 );
+    xFillRandom( &m_src[0], BENCH_STRIDE, size + 2, size + 2, level - ( 8 << ( bitDepth - 8 ) ), level + ( 8 << ( bitDepth - 8 ) ) );
+
+    // offsets of the edge categories (positive for the local minima, negative for the local maxima), or of 4 bands
+    const Int offsetScale = 1 << std::max( 0, bitDepth - 10 );
+    memset( m_offset, 0, sizeof( m_offset ) );
+    if( typeIdx == SAO_TYPE_START_BO )
+    {
+      const Int firstBand = ( level >> ( bitDepth - NUM_SAO_BO_CLASSES_LOG2 ) ) - 2;
+      for( Int band = firstBand; band < firstBand + 4; band++ )
+      {
+        m_offset[band] = xRandom( -7, 7 ) * offsetScale;
+      }
+    }
+    else
+    {
+      m_offset[0] =  xRandom( 0, 7 ) * offsetScale;
+      m_offset[1] =  xRandom( 0, 7 ) * offsetScale;
+      m_offset[3] = -xRandom( 0, 7 ) * offsetScale;
+      m_offset[4] = -xRandom( 0, 7 ) * offsetScale;
+    }
+  }
+
+  Void run()
+  {
+    m_sao.offsetBlock( m_bitDepth, m_typeIdx, m_offset, &m_src[BENCH_STRIDE + 1], &m_res[0], BENCH_STRIDE, BENCH_STRIDE, m_size, m_size
+                     , true, true, true, true, true, true, true, true );
+  }
+
+  Void getOutput( std::vector<Int64>& output ) const
+  {
+    xAppendOutput( output, &m_res[0], BENCH_STRIDE, m_size, m_size );
+  }
+};
+
+/// statistics of all SAO types of a luma CTU, from the deblocked or from the not yet deblocked samples
+class TBenchSAOStatistics : public TAppBenchKernel
+{
+private:
+  TEncSampleAdaptiveOffset      m_sao;
+  const Bool                    m_preDeblocking;
+  const Int                     m_size;
+  const Int                     m_bitDepth;
+  SAOStatData                   m_stats[NUM_SAO_NEW_TYPES];
+  std::vector<Pel>              m_src;
+  std::vector<Pel>              m_org;
+
+public:
+  TBenchSAOStatistics( const std::string& name, Bool preDeblocking, Int size, Int bitDepth )
+  : TAppBenchKernel( name, xSizeName( size, size ), SIMD_KERNELS_SAO, size*size )
+  , m_preDeblocking( preDeblocking ), m_size( size ), m_bitDepth( bitDepth )
+  , m_src( BENCH_STRIDE*( size + 2 ) ), m_org( BENCH_STRIDE*size )
+  {
+    m_sao.create( MAX_CU_SIZE, MAX_CU_SIZE, CHROMA_420, MAX_CU_SIZE, MAX_CU_SIZE, MAX_CU_DEPTH, 0, 0 );
+    m_sao.createEncData( preDeblocking );
+
+    // the reconstructed block with its neighbouring samples, and the original block close to it
+    const Int level = 1 << ( bitDepth - 1 );
+    const Int scale = 1 << ( bitDepth - 8 );
+    xFillRandom( &m_src[0], BENCH_STRIDE, size + 2, size + 2, level - 8*scale, level + 8*scale );
+    for( Int y = 0; y < size; y++ )
+    {
+      for( Int x = 0; x < size; x++ )
+      {
+        m_org[y*BENCH_STRIDE + x] = Pel( m_src[( y + 1 )*BENCH_STRIDE + x + 1] + xRandom( -4, 4 ) * scale );
+      }
+    }
+  }
+
+  ~TBenchSAOStatistics()
+  {
+    m_sao.destroyEncData();
+    m_sao.destroy();
+  }
+
+  Void run()
+  {
+    m_sao.getBlkStats( COMPONENT_Y, m_bitDepth, m_stats, &m_src[BENCH_STRIDE + 1], &m_org[0], BENCH_STRIDE, BENCH_STRIDE, m_size, m_size
+                     , true, true, true, true, true, true, m_preDeblocking );
+  }
+
+  Void getOutput( std::vector<Int64>& output ) const
+  {
+    for( Int typeIdx = 0; typeIdx < NUM_SAO_NEW_TYPES; typeIdx++ )
+    {
+      output.insert( output.end(), m_stats[typeIdx].diff,  m_stats[typeIdx].diff  + MAX_NUM_SAO_CLASSES );
+      output.insert( output.end(), m_stats[typeIdx].count, m_stats[typeIdx].count + MAX_NUM_SAO_CLASSES );
+    }
+  }
+};
+
+// ====================================================================================================================
+// Residual, reconstruction and weighted prediction (TComYuv, TComWeightPrediction)
+// ====================================================================================================================
+
+enum BenchYuvOperation
+{
+  BENCH_YUV_ADD_CLIP         = 0,
+  BENCH_YUV_SUBTRACT         = 1,
+  BENCH_YUV_ADD_AVG          = 2,
+  BENCH_YUV_REMOVE_HIGH_FREQ = 3,
+  BENCH_YUV_WEIGHT_BI        = 4,
+  BENCH_YUV_WEIGHT_UNI       = 5
+};
+
+class TBenchYuv : public TAppBenchKernel
+{
+private:
+  TComWeightPrediction    m_weightPrediction;
+  const BenchYuvOperation m_operation;
+  const Int               m_size;
+  BitDepths               m_bitDepths;
+  WPScalingParam          m_wp0[MAX_NUM_COMPONENT];
+  WPScalingParam          m_wp1[MAX_NUM_COMPONENT];
+  TComYuv                 m_src0;
+  TComYuv                 m_src1;
+  TComYuv                 m_dst;
+  TComYuv                 m_dstOriginal;
+
+  // samples, residuals or predictions at the intermediate precision of the interpolation filters
+  Void xFill( TComYuv& yuv, Int minVal, Int maxVal )
+  {
+    for( UInt comp = 0; comp < yuv.getNumberValidComponents(); comp++ )
+    {
+      const ComponentID compID = ComponentID( comp );
+      xFillRandom( yuv.getAddr( compID ), yuv.getStride( compID ), yuv.getWidth( compID ), yuv.getHeight( compID ), minVal, maxVal );
+    }
+  }
+
+  Void xSetWeights( WPScalingParam* wp, Int bitDepth )
+  {
+    for( Int comp = 0; comp < MAX_NUM_COMPONENT; comp++ )
+    {
+      wp[comp].bPresentFlag      = true;
+      wp[comp].uiLog2WeightDenom = 6;
+      wp[comp].iWeight           = xRandom( 32, 96 );
+      wp[comp].iOffset           = xRandom( -16, 16 );
+      wp[comp].w                 = wp[comp].iWeight;
+      wp[comp].o                 = wp[comp].iOffset * ( 1 << ( bitDepth - 8 ) );
+      wp[comp].offset            = wp[comp].o;
+      wp[comp].shift             = wp[comp].uiLog2WeightDenom;
+      wp[comp].round             = 1 << ( wp[comp].shift - 1 );
+    }
+  }
+
+public:
+  TBenchYuv( const std::string& name, BenchYuvOperation operation, Int size, Int bitDepth )
+  : TAppBenchKernel( name, xSizeName( size, size ), SIMD_KERNELS_YUV_OPERATIONS, size*size*3/2 )
+  , m_operation( operation ), m_size( size )
+  {
+    for( Int channelType = 0; channelType < MAX_NUM_CHANNEL_TYPE; channelType++ )
+    {
+      m_bitDepths.recon[channelType] = bitDepth;
+#if O0043_BEST_EFFORT_DECODING
+      m_bitDepths.stream[channelType] = bitDepth;
+#endif
+    }
+    xSetWeights( m_wp0, bitDepth );
+    xSetWeights( m_wp1, bitDepth );
+
+    m_src0.create( size, size, CHROMA_420 );
+    m_src1.create( size, size, CHROMA_420 );
+    m_dst.create( size, size, CHROMA_420 );
+    m_dstOriginal.create( size, size, CHROMA_420 );
+
+    const Int maxVal = ( 1 << bitDepth ) - 1;
+    switch( operation )
+    {
+      case BENCH_YUV_ADD_CLIP:
+        xFill( m_src0, 0, maxVal );
+        xFill( m_src1, -maxVal, maxVal );
+        break;
+      case BENCH_YUV_ADD_AVG:
+      case BENCH_YUV_WEIGHT_BI:
+      case BENCH_YUV_WEIGHT_UNI:
+        {
+          const Int shift = std::max<Int>( 2, IF_INTERNAL_PREC - bitDepth );
+          xFill( m_src0, -IF_INTERNAL_OFFS, ( maxVal << shift ) - IF_INTERNAL_OFFS );
+          xFill( m_src1, -IF_INTERNAL_OFFS, ( maxVal << shift ) - IF_INTERNAL_OFFS );
+        }
+        break;
+      default:
+        xFill( m_src0, 0, maxVal );
+        xFill( m_src1, 0, maxVal );
+        break;
+    }
+    xFill( m_dstOriginal, 0, maxVal );
+    m_dstOriginal.copyToPartYuv( &m_dst, 0 );
+  }
+
+  ~TBenchYuv()
+  {
+    m_src0.destroy();
+    m_src1.destroy();
+    m_dst.destroy();
+    m_dstOriginal.destroy();
+  }
+
+  // removeHighFreq() modifies the destination
+  Void prepare()
+  {
+    m_dstOriginal.copyToPartYuv( &m_dst, 0 );
+  }
+
+  Void run()
+  {
+    switch( m_operation )
+    {
+      case BENCH_YUV_ADD_CLIP:
+        m_dst.addClip( &m_src0, &m_src1, 0, m_size, m_bitDepths );
+        break;
+      case BENCH_YUV_SUBTRACT:
+        m_dst.subtract( &m_src0, &m_src1, 0, m_size );
+        break;
+      case BENCH_YUV_ADD_AVG:
+        m_dst.addAvg( &m_src0, &m_src1, 0, m_size, m_size, m_bitDepths );
+        break;
+      case BENCH_YUV_REMOVE_HIGH_FREQ:
+        m_dst.removeHighFreq( &m_src0, 0, m_size, m_size, m_bitDepths.recon, true );
+        break;
+      case BENCH_YUV_WEIGHT_BI:
+        m_weightPrediction.addWeightBi( &m_src0, &m_src1, m_bitDepths, 0, m_size, m_size, m_wp0, m_wp1, &m_dst );
+        break;
+      case BENCH_YUV_WEIGHT_UNI:
+      default:
+        m_weightPrediction.addWeightUni( &m_src0, m_bitDepths, 0, m_size, m_size, m_wp0, &m_dst );
+        break;
+    }
+  }
+
+  Void getOutput( std::vector<Int64>& output ) const
+  {
+    for( UInt comp = 0; comp < m_dst.getNumberValidComponents(); comp++ )
+    {
+      const ComponentID compID = ComponentID( comp );
+      xAppendOutput( output, m_dst.getAddr( compID ), m_dst.getStride( compID ), m_dst.getWidth( compID ), m_dst.getHeight( compID ) );
+    }
+  }
+};
+
+// ====================================================================================================================
+// Picture hashes (TComPicYuvMD5)
+// ====================================================================================================================
+
+class TBenchPictureHash : public TAppBenchKernel
+{
+private:
+  typedef UInt (*HashFunc)( const TComPicYuv&, TComPictureHash&, const BitDepths& );
+
+  const HashFunc  m_hashFunc;
+  TComPicYuv      m_picture;
+  BitDepths       m_bitDepths;
+  TComPictureHash m_digest;
+
+public:
+  static const Int WIDTH  = 1920;
+  static const Int HEIGHT = 1080;
+
+  TBenchPictureHash( const std::string& name, HashFunc hashFunc, Int bitDepth )
+  : TAppBenchKernel( name, xSizeName( WIDTH, HEIGHT ), NUMBER_OF_SIMD_KERNEL_GROUPS, WIDTH*HEIGHT*3/2 )
+  , m_hashFunc( hashFunc )
+  {
+    for( Int channelType = 0; channelType < MAX_NUM_CHANNEL_TYPE; channelType++ )
+    {
+      m_bitDepths.recon[channelType] = bitDepth;
+#if O0043_BEST_EFFORT_DECODING
+      m_bitDepths.stream[channelType] = bitDepth;
+#endif
+    }
+    m_picture.createWithoutCUInfo( WIDTH, HEIGHT, CHROMA_420 );
+    for( UInt comp = 0; comp < m_picture.getNumberValidComponents(); comp++ )
+    {
+      const ComponentID compID = ComponentID( comp );
+      xFillRandom( m_picture.getAddr( compID ), m_picture.getStride( compID ), m_picture.getWidth( compID ), m_picture.getHeight( compID ), 0, ( 1 << bitDepth ) - 1 );
+    }
+  }
+
+  ~TBenchPictureHash()
+  {
+    m_picture.destroy();
+  }
+
+  Void run()
+  {
+    m_hashFunc( m_picture, m_digest, m_bitDepths );
+  }
+
+  Void getOutput( std::vector<Int64>& output ) const
+  {
+    output.insert( output.end(), m_digest.hash.begin(), m_digest.hash.end() );
+  }
+};
+
+// ====================================================================================================================
+// Start code and emulation prevention scanning (TComBitStream)
+// ====================================================================================================================
+
+class TBenchZeroZeroScan : public TAppBenchKernel
+{
+private:
+  const UInt           m_maxThirdByte;
+  std::vector<uint8_t> m_data;
+  std::vector<Int64>   m_positions;
+
+public:
+  static const Int NUM_BYTES = 1 << 16;
+
+  TBenchZeroZeroScan( const std::string& name, UInt maxThirdByte )
+  : TAppBenchKernel( name, "64KB", SIMD_KERNELS_BITSTREAM, NUM_BYTES )
+  , m_maxThirdByte( maxThirdByte )
+  , m_data( NUM_BYTES )
+  {
+    // entropy coded data, with zero byte pairs followed by any byte, and occasional sequences that match
+    for( Int i = 0; i < NUM_BYTES; i++ )
+    {
+      m_data[i] = uint8_t( xRandom( 0, 255 ) );
+    }
+    for( Int i = xRandom( 0, 63 ); i + 3 <= NUM_BYTES; i += xRandom( 1, 127 ) )
+    {
+      m_data[i]     = 0;
+      m_data[i + 1] = 0;
+      m_data[i + 2] = uint8_t( xRandom( 0, 15 ) < 4 ? xRandom( 0, 3 ) : xRandom( 0, 255 ) );
+    }
+  }
+
+  Void run()
+  {
+    m_positions.clear();
+    const uint8_t* begin = &m_data[0];
+    const uint8_t* end   = begin + m_data.size();
+    for( const uint8_t* p = findZeroZeroSequence( begin, end, m_maxThirdByte ); p != end; p = findZeroZeroSequence( p + 1, end, m_maxThirdByte ) )
+    {
+      m_positions.push_back( Int64( p - begin ) );
+    }
+  }
+
+  Void getOutput( std::vector<Int64>& output ) const
+  {
+    output.insert( output.end(), m_positions.begin(), m_positions.end() );
+  }
+};
+
+// ====================================================================================================================
+// Public functions
+// ====================================================================================================================
+
+Void createBenchKernels( std::vector<TAppBenchKernel*>& kernels, Int bitDepth, UInt seed )
+{
+  xSeedRandom( seed );
+
+  // square blocks, and the rectangular and AMP partitions of the prediction units
+  const Int blockSizes[][2] = { {  4,  4 }, {  8,  8 }, { 16, 16 }, { 32, 32 }, { 64, 64 },
+                                {  8,  4 }, {  4,  8 }, { 16,  8 }, {  8, 16 }, { 32, 16 }, { 16, 32 }, { 64, 32 }, { 32, 64 },
+                                { 16,  4 }, {  4, 16 }, { 32,  8 }, {  8, 32 }, { 64, 16 }, { 16, 64 },
+                                { 12, 16 }, { 24, 32 }, { 48, 64 } };
+  const Int numBlockSizes   = Int( sizeof( blockSizes ) / sizeof( blockSizes[0] ) );
+  for( Int i = 0; i < numBlockSizes; i++ )
+  {
+    kernels.push_back( new TBenchDistortion( "SAD", DF_SAD, blockSizes[i][0], blockSizes[i][1], 0, bitDepth ) );
+  }
+  // subsampled rows of the fast integer motion search
+  for( Int i = 0; i < numBlockSizes; i++ )
+  {
+    if( blockSizes[i][1] > 8 )
+    {
+      kernels.push_back( new TBenchDistortion( "SADSub", DF_SAD, blockSizes[i][0], blockSizes[i][1], 1, bitDepth ) );
+    }
+  }
+  for( Int i = 0; i < numBlockSizes; i++ )
+  {
+    kernels.push_back( new TBenchDistortion( "SSE", DF_SSE, blockSizes[i][0], blockSizes[i][1], 0, bitDepth ) );
+  }
+  for( Int i = 0; i < numBlockSizes; i++ )
+  {
+    kernels.push_back( new TBenchDistortion( "SATD", DF_HADS, blockSizes[i][0], blockSizes[i][1], 0, bitDepth ) );
+  }
+
+  // uni-prediction (isLast) and the first stage of bi-prediction
+  for( Int size = 8; size <= MAX_CU_SIZE; size <<= 1 )
+  {
+    kernels.push_back( new TBenchInterpolation( "InterpLumaHor",     COMPONENT_Y, BENCH_FILTER_HOR,     size, true,  bitDepth ) );
+    kernels.push_back( new TBenchInterpolation( "InterpLumaVer",     COMPONENT_Y, BENCH_FILTER_VER,     size, true,  bitDepth ) );
+    kernels.push_back( new TBenchInterpolation( "InterpLumaHorVer",  COMPONENT_Y, BENCH_FILTER_HOR_VER, size, true,  bitDepth ) );
+    kernels.push_back( new TBenchInterpolation( "InterpLumaHorVerBi", COMPONENT_Y, BENCH_FILTER_HOR_VER, size, false, bitDepth ) );
+  }
+  for( Int size = 4; size <= MAX_CU_SIZE/2; size <<= 1 )
+  {
+    kernels.push_back( new TBenchInterpolation( "InterpChromaHor",    COMPONENT_Cb, BENCH_FILTER_HOR,     size, true, bitDepth ) );
+    kernels.push_back( new TBenchInterpolation( "InterpChromaVer",    COMPONENT_Cb, BENCH_FILTER_VER,     size, true, bitDepth ) );
+    kernels.push_back( new TBenchInterpolation( "InterpChromaHorVer", COMPONENT_Cb, BENCH_FILTER_HOR_VER, size, true, bitDepth ) );
+  }
+
+  kernels.push_back( new TBenchTransform( "DST",  true,  true, 4, bitDepth ) );
+  kernels.push_back( new TBenchTransform( "IDST", false, true, 4, bitDepth ) );
+  for( Int size = 4; size <= MAX_TU_SIZE; size <<= 1 )
+  {
+    kernels.push_back( new TBenchTransform( "DCT",  true,  false, size, bitDepth ) );
+    kernels.push_back( new TBenchTransform( "IDCT", false, false, size, bitDepth ) );
+  }
+  for( Int size = 4; size <= MAX_TU_SIZE; size <<= 1 )
+  {
+    kernels.push_back( new TBenchQuant( "Quant",   true,  size, bitDepth ) );
+    kernels.push_back( new TBenchQuant( "DeQuant", false, size, bitDepth ) );
+  }
+
+  for( Int size = 4; size <= MAX_TU_SIZE; size <<= 1 )
+  {
+    kernels.push_back( new TBenchIntraPrediction( "IntraPlanar", PLANAR_IDX, size, bitDepth ) );
+    kernels.push_back( new TBenchIntraPrediction( "IntraDC",     DC_IDX,     size, bitDepth ) );
+    // the 33 angular modes
+    for( Int mode = DC_IDX + 1; mode < NUM_INTRA_MODE - 1; mode++ )
+    {
+      std::ostringstream name;
+      name << "IntraAng" << mode;
+      kernels.push_back( new TBenchIntraPrediction( name.str(), mode, size, bitDepth ) );
+    }
+  }
+
+  kernels.push_back( new TBenchDeblocking( "DeblockLumaVer",   CHANNEL_TYPE_LUMA,   EDGE_VER, MAX_CU_SIZE,   bitDepth ) );
+  kernels.push_back( new TBenchDeblocking( "DeblockLumaHor",   CHANNEL_TYPE_LUMA,   EDGE_HOR, MAX_CU_SIZE,   bitDepth ) );
+  kernels.push_back( new TBenchDeblocking( "DeblockChromaVer", CHANNEL_TYPE_CHROMA, EDGE_VER, MAX_CU_SIZE/2, bitDepth ) );
+  kernels.push_back( new TBenchDeblocking( "DeblockChromaHor", CHANNEL_TYPE_CHROMA, EDGE_HOR, MAX_CU_SIZE/2, bitDepth ) );
+
+  for( Int size = MAX_CU_SIZE/2; size <= MAX_CU_SIZE; size <<= 1 )
+  {
+    kernels.push_back( new TBenchSAO( "SaoEdgeHor",     SAO_TYPE_EO_0,   size, bitDepth ) );
+    kernels.push_back( new TBenchSAO( "SaoEdgeVer",     SAO_TYPE_EO_90,  size, bitDepth ) );
+    kernels.push_back( new TBenchSAO( "SaoEdge135",     SAO_TYPE_EO_135, size, bitDepth ) );
+    kernels.push_back( new TBenchSAO( "SaoEdge45",      SAO_TYPE_EO_45,  size, bitDepth ) );
+    kernels.push_back( new TBenchSAO( "SaoBand",        SAO_TYPE_BO,     size, bitDepth ) );
+    kernels.push_back( new TBenchSAOStatistics( "SaoStats",       false, size, bitDepth ) );
+    kernels.push_back( new TBenchSAOStatistics( "SaoStatsPreDbf", true,  size, bitDepth ) );
+  }
+
+  for( Int size = 8; size <= MAX_CU_SIZE; size <<= 1 )
+  {
+    kernels.push_back( new TBenchYuv( "YuvAddClip",        BENCH_YUV_ADD_CLIP,         size, bitDepth ) );
+    kernels.push_back( new TBenchYuv( "YuvSubtract",       BENCH_YUV_SUBTRACT,         size, bitDepth ) );
+    kernels.push_back( new TBenchYuv( "YuvAddAvg",         BENCH_YUV_ADD_AVG,          size, bitDepth ) );
+    kernels.push_back( new TBenchYuv( "YuvRemoveHighFreq", BENCH_YUV_REMOVE_HIGH_FREQ, size, bitDepth ) );
+    kernels.push_back( new TBenchYuv( "WeightBi",          BENCH_YUV_WEIGHT_BI,        size, bitDepth ) );
+    kernels.push_back( new TBenchYuv( "WeightUni",         BENCH_YUV_WEIGHT_UNI,       size, bitDepth ) );
+  }
+
+  kernels.push_back( new TBenchZeroZeroScan( "StartCodeScan",  1 ) );
+  kernels.push_back( new TBenchZeroZeroScan( "EmulationScan",  3 ) );
+
+  kernels.push_back( new TBenchPictureHash( "MD5",      calcMD5,      bitDepth ) );
+  kernels.push_back( new TBenchPictureHash( "CRC",      calcCRC,      bitDepth ) );
+  kernels.push_back( new TBenchPictureHash( "Checksum", calcChecksum, bitDepth ) );
+}
+
+//! \}
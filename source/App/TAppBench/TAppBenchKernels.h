@@ -0,0 +1,94 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TAppBenchKernels.h
+    \brief    Kernels measured by the benchmark (header)
+*/
+
+#ifndef __TAPPBENCHKERNELS__
+#define __TAPPBENCHKERNELS__
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+#include "TLibCommon/CommonDef.h"
+#include "TLibCommon/TComCpuFeatures.h"
+#include <string>
+#include <vector>
+
+//! \ingroup TAppBench
+//! \{
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// one kernel call on synthetic data, repeated by the benchmark for each SIMD extension of its group
+class TAppBenchKernel
+{
+private:
+  std::string     m_name;
+  std::string     m_size;
+  SIMDKernelGroup m_group;
+  UInt            m_numSamples;
+
+public:
+  /// group NUMBER_OF_SIMD_KERNEL_GROUPS is used by the kernels that only have a C version
+  TAppBenchKernel( const std::string& name, const std::string& size, SIMDKernelGroup group, UInt numSamples )
+  : m_name(name), m_size(size), m_group(group), m_numSamples(numSamples) {}
+  virtual ~TAppBenchKernel() {}
+
+  const std::string& getName      () const { return m_name;       }
+  const std::string& getSize      () const { return m_size;       }
+  SIMDKernelGroup    getGroup     () const { return m_group;      }
+  UInt               getNumSamples() const { return m_numSamples; } ///< samples processed by one call
+
+  virtual Bool prepareEachCall() const { return false; }            ///< true when each call must get the inputs of prepare(), e.g. for in-place filters
+  virtual Void select   () {}                                       ///< called after the SIMD extension of the group has changed
+  virtual Void prepare  () {}                                       ///< restores the inputs that run() modifies
+  virtual Void run      () = 0;                                     ///< calls the kernel once
+  virtual Void getOutput( std::vector<Int64>& output ) const = 0;   ///< output of the last call of run()
+};
+
+// ====================================================================================================================
+// Function declarations
+// ====================================================================================================================
+
+/// creates the kernels, with synthetic data of the given bit depth; the caller deletes them
+Void createBenchKernels( std::vector<TAppBenchKernel*>& kernels, Int bitDepth, UInt seed );
+
+//! \}
+
+#endif // __TAPPBENCHKERNELS__
+
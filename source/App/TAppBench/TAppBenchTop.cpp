@@ -0,0 +1,364 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TAppBenchTop.cpp
+    \brief    Kernel benchmark application class
+*/
+
+#include <cstdio>
+#if defined( _MSC_VER ) && _MSC_VER < 1700
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <chrono>
+#endif
+#include "TAppBenchTop.h"
+#include "TLibCommon/TComRom.h"
+
+#if defined(__i386__) || defined(__x86_64__) || defined(_M_IX86) || defined(_M_X64)
+#define BENCH_TIMER_TSC 1
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#else
+#define BENCH_TIMER_TSC 0
+#endif
+
+//! \ingroup TAppBench
+//! \{
+
+static const Int BENCH_NUM_MEASUREMENTS = 3;   ///< the time of a kernel is the minimum of this number of measurements
+
+/// monotonic time in nanoseconds
+static inline UInt64 xGetTimeNs()
+{
+#if defined( _MSC_VER ) && _MSC_VER < 1700
+  // VS2010 has no <chrono>
+  LARGE_INTEGER frequency;
+  LARGE_INTEGER counter;
+  QueryPerformanceFrequency( &frequency );
+  QueryPerformanceCounter( &counter );
+  return UInt64( Double( counter.QuadPart ) * 1.0e9 / Double( frequency.QuadPart ) );
+#else
+  return UInt64( std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now().time_since_epoch() ).count() );
+#endif
+}
+
+/// time stamp counter, else nanoseconds
+static inline UInt64 xReadTimer()
+{
+#if BENCH_TIMER_TSC
+  return __rdtsc();
+#else
+  return xGetTimeNs();
+#endif
+}
+
+/// the SIMD extensions that have their own version of the kernels of the group in this build, up to the extension
+/// selected for the group (--SIMD, HM_SIMD or the processor)
+static std::vector<SIMDExtension> xGetMeasuredExtensions( SIMDKernelGroup group )
+{
+  std::vector<SIMDExtension> extensions( 1, SIMD_NONE );
+  switch( group )
+  {
+    case SIMD_KERNELS_DISTORTION:
+#if VECTOR_CODING__DISTORTION_CALCULATIONS && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+      extensions.push_back( SIMD_SSE2 );
+#if VECTOR_CODING__AVX2
+      extensions.push_back( SIMD_AVX2 );
+#endif
+#endif
+      break;
+    case SIMD_KERNELS_INTERPOLATION:
+#if VECTOR_CODING__INTERPOLATION_FILTER && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+      extensions.push_back( SIMD_SSE2 );
+#endif
+#if VECTOR_CODING__INTERPOLATION_FILTER && VECTOR_CODING__AVX2
+      extensions.push_back( SIMD_AVX2 );
+#endif
+      break;
+    case SIMD_KERNELS_TRANSFORM:
+#if VECTOR_CODING__TRANSFORM && VECTOR_CODING__AVX2
+      extensions.push_back( SIMD_AVX2 );
+#endif
+      break;
+    case SIMD_KERNELS_INTRA_PREDICTION:
+#if VECTOR_CODING__INTRA_PREDICTION && VECTOR_CODING__AVX2 && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+      extensions.push_back( SIMD_AVX2 );
+#endif
+      break;
+    case SIMD_KERNELS_LOOP_FILTER:
+#if VECTOR_CODING__DEBLOCKING_FILTER && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+      extensions.push_back( SIMD_SSE41 );
+#endif
+      break;
+    case SIMD_KERNELS_SAO:
+#if VECTOR_CODING__SAO && VECTOR_CODING__AVX2 && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+      extensions.push_back( SIMD_AVX2 );
+#endif
+      break;
+    case SIMD_KERNELS_YUV_OPERATIONS:
+#if VECTOR_CODING__YUV_OPERATIONS && VECTOR_CODING__AVX2
+      extensions.push_back( SIMD_AVX2 );
+#endif
+      break;
+    case SIMD_KERNELS_BITSTREAM:
+#if VECTOR_CODING__BITSTREAM
+      extensions.push_back( SIMD_SSE2 );
+#if VECTOR_CODING__AVX2
+      extensions.push_back( SIMD_AVX2 );
+#endif
+#endif
+      break;
+    default:
+      return extensions;
+  }
+
+  while( extensions.back() > getSIMDExtension( group ) )
+  {
+    extensions.pop_back();
+  }
+  return extensions;
+}
+
+// ====================================================================================================================
+// Constructor / destructor / initialization / destroy
+// ====================================================================================================================
+
+TAppBenchTop::TAppBenchTop()
+: m_numKernelsChecked(0)
+, m_numMismatches(0)
+{
+}
+
+Void TAppBenchTop::create()
+{
+  initROM();
+}
+
+Void TAppBenchTop::destroy()
+{
+  for( UInt i = 0; i < m_kernels.size(); i++ )
+  {
+    delete m_kernels[i];
+  }
+  m_kernels.clear();
+  destroyROM();
+}
+
+// ====================================================================================================================
+// Public member functions
+// ====================================================================================================================
+
+/**
+ - create the kernels and their synthetic data
+ - for each kernel selected with --Kernels, run each SIMD version, compare its output with the C code and measure it
+ .
+ */
+Void TAppBenchTop::benchmark()
+{
+  createBenchKernels( m_kernels, m_bitDepth, m_seed );
+
+  printf( "\nSIMD extensions: %s", getSIMDExtensionName( getDetectedSIMDExtension() ) );
+  for( Int group = 0; group < NUMBER_OF_SIMD_KERNEL_GROUPS; group++ )
+  {
+    printf( " %s:%s", getSIMDKernelGroupName( SIMDKernelGroup( group ) ), getSIMDExtensionName( getSIMDExtension( SIMDKernelGroup( group ) ) ) );
+  }
+  printf( "\nBit depth: %d\n", m_bitDepth );
+  if( !m_checkOnly )
+  {
+#if BENCH_TIMER_TSC
+    printf( "Time per sample in time stamp counter cycles, speed-up against the C code in brackets\n" );
+#else
+    printf( "Time per sample in nanoseconds, speed-up against the C code in brackets\n" );
+#endif
+  }
+  printf( "\n" );
+
+  for( UInt i = 0; i < m_kernels.size(); i++ )
+  {
+    if( xIsSelected( *m_kernels[i] ) )
+    {
+      xBenchmarkKernel( *m_kernels[i] );
+    }
+  }
+
+  printf( "\n%u kernels checked, %u mismatches\n", m_numKernelsChecked, m_numMismatches );
+}
+
+// ====================================================================================================================
+// Protected member functions
+// ====================================================================================================================
+
+Bool TAppBenchTop::xIsSelected( const TAppBenchKernel& kernel ) const
+{
+  if( m_kernelFilter.empty() )
+  {
+    return true;
+  }
+
+  size_t start = 0;
+  while( start <= m_kernelFilter.size() )
+  {
+    size_t end = m_kernelFilter.find( ',', start );
+    if( end == std::string::npos )
+    {
+      end = m_kernelFilter.size();
+    }
+    const std::string part = m_kernelFilter.substr( start, end - start );
+    if( !part.empty() && kernel.getName().find( part ) != std::string::npos )
+    {
+      return true;
+    }
+    start = end + 1;
+  }
+  return false;
+}
+
+Void TAppBenchTop::xBenchmarkKernel( TAppBenchKernel& kernel )
+{
+  const SIMDKernelGroup            group      = kernel.getGroup();
+  const Bool                       hasSIMD    = group < NUMBER_OF_SIMD_KERNEL_GROUPS;
+  const SIMDExtension              selected   = hasSIMD ? getSIMDExtension( group ) : SIMD_NONE;
+  const std::vector<SIMDExtension> extensions = xGetMeasuredExtensions( group );
+
+  printf( "%-20s %-9s", kernel.getName().c_str(), kernel.getSize().c_str() );
+  fflush( stdout );
+
+  std::vector<Int64> reference;
+  std::vector<Int64> output;
+  Double             referenceTime = 0;
+  Bool               mismatch      = false;
+
+  for( UInt i = 0; i < extensions.size(); i++ )
+  {
+    if( hasSIMD )
+    {
+      setMaximumSIMDExtension( group, extensions[i] );
+    }
+    kernel.select();
+
+    kernel.prepare();
+    kernel.run();
+    output.clear();
+    kernel.getOutput( output );
+    if( i == 0 )
+    {
+      reference.swap( output );
+    }
+    else if( output != reference )
+    {
+      printf( "  %-6s MISMATCH", getSIMDExtensionName( extensions[i] ) );
+      mismatch = true;
+      continue;
+    }
+
+    if( m_checkOnly )
+    {
+      continue;
+    }
+    const Double time = xMeasure( kernel );
+    if( i == 0 )
+    {
+      referenceTime = time;
+      printf( "  %-6s %8.3f", getSIMDExtensionName( extensions[i] ), time );
+    }
+    else
+    {
+      printf( "  %-6s %8.3f (%5.2fx)", getSIMDExtensionName( extensions[i] ), time, time > 0 ? referenceTime / time : 0.0 );
+    }
+    fflush( stdout );
+  }
+
+  if( hasSIMD )
+  {
+    setMaximumSIMDExtension( group, selected );
+  }
+  kernel.select();
+
+  printf( "  %s\n", mismatch ? "FAILED" : "ok" );
+  m_numKernelsChecked++;
+  m_numMismatches += mismatch ? 1 : 0;
+}
+
+/** The kernel is called as often as needed for the minimum measurement time, using the data of prepare() for each call
+ *  when the kernel modifies its inputs; the time is the minimum of several measurements.
+ */
+Double TAppBenchTop::xMeasure( TAppBenchKernel& kernel )
+{
+  const Bool prepareEachCall = kernel.prepareEachCall();
+  Double     bestTime        = 0;
+
+  for( Int measurement = 0; measurement < BENCH_NUM_MEASUREMENTS; measurement++ )
+  {
+    for( UInt64 numCalls = 1; ; numCalls *= 2 )
+    {
+      const UInt64 startTime = xGetTimeNs();
+      UInt64 ticks = 0;
+      if( prepareEachCall )
+      {
+        for( UInt64 call = 0; call < numCalls; call++ )
+        {
+          kernel.prepare();
+          const UInt64 start = xReadTimer();
+          kernel.run();
+          ticks += xReadTimer() - start;
+        }
+      }
+      else
+      {
+        kernel.prepare();
+        const UInt64 start = xReadTimer();
+        for( UInt64 call = 0; call < numCalls; call++ )
+        {
+          kernel.run();
+        }
+        ticks = xReadTimer() - start;
+      }
+      const Double seconds = Double( xGetTimeNs() - startTime ) * 1.0e-9;
+
+      if( seconds >= m_minTime / BENCH_NUM_MEASUREMENTS )
+      {
+        const Double time = Double( ticks ) / ( Double( numCalls ) * kernel.getNumSamples() );
+        bestTime = measurement == 0 ? time : std::min( bestTime, time );
+        break;
+      }
+    }
+  }
+  return bestTime;
+}
+
+//! \}
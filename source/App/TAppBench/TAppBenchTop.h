@@ -0,0 +1,83 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TAppBenchTop.h
+    \brief    Kernel benchmark application class (header)
+*/
+
+#ifndef __TAPPBENCHTOP__
+#define __TAPPBENCHTOP__
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+#include <vector>
+#include "TAppBenchCfg.h"
+#include "TAppBenchKernels.h"
+
+//! \ingroup TAppBench
+//! \{
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// kernel benchmark application class: compares the output of each SIMD version of the kernels with the C code and
+/// measures the time per sample of each version
+class TAppBenchTop : public TAppBenchCfg
+{
+private:
+  std::vector<TAppBenchKernel*>   m_kernels;                      ///< kernels, created by benchmark()
+  UInt                            m_numKernelsChecked;            ///< number of kernels run
+  UInt                            m_numMismatches;                ///< number of SIMD versions whose output differs from the C code
+
+public:
+  TAppBenchTop();
+  virtual ~TAppBenchTop() {}
+
+  Void  create            (); ///< create internal members
+  Void  destroy           (); ///< destroy internal members
+  Void  benchmark         (); ///< main benchmark function
+  UInt  getNumberOfMismatches() const { return m_numMismatches; }
+
+protected:
+  Bool    xIsSelected     ( const TAppBenchKernel& kernel ) const;
+  Void    xBenchmarkKernel( TAppBenchKernel& kernel );
+  Double  xMeasure        ( TAppBenchKernel& kernel );          ///< timer ticks per sample of the selected version
+};
+
+//! \}
+
+#endif
+
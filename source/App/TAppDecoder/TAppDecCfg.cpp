@@ -41,6 +41,7 @@
 #include "TAppDecCfg.h"
 #include "TAppCommon/program_options_lite.h"
 #include "TLibCommon/TComChromaFormat.h"
+#include "TLibCommon/TComCpuFeatures.h"
 #ifdef WIN32
 #define strdup _strdup
 #endif
@@ -63,6 +64,7 @@ Bool TAppDecCfg::parseCfg( Int argc, TChar* argv[] )
   Bool do_help = false;
   string cfg_TargetDecLayerIdSetFile;
   string outputColourSpaceConvert;
+  string simdSetting;
   Int warnUnknowParameter = 0;
 
   po::Options opts;
@@ -91,6 +93,14 @@ Bool TAppDecCfg::parseCfg( Int argc, TChar* argv[] )
 #endif
   ("OutputDecodedSEIMessagesFilename",  m_outputDecodedSEIMessagesFilename,    string(""), "When non empty, output decoded SEI messages to the indicated file. If file is '-', then output to stdout\n")
   ("ClipOutputVideoToRec709Range",      m_bClipOutputVideoToRec709Range,  false, "If true then clip output video to the Rec. 709 Range on saving")
+  ("Threads",                   m_numWorkerThreads,                    1,          "Number of threads used for decoding (1: single-threaded)")
+  ("ParallelFrames",            m_numParallelFrames,                   1,          "Maximum number of pictures decoded concurrently when more than one thread is used")
+  ("SIMD",                      simdSetting,                           string(""), "Maximum SIMD extensions of the kernels, e.g. none, sse2, sse41, avx2 or avx2,sao=none (empty string: the HM_SIMD environment variable, else all that the processor supports). "
+                                                                                   "Groups: distortion, interpolation, transform, intra, loopfilter, sao, yuv, bitstream")
+  ("PipelinedLoopFilter",       m_pipelinedLoopFilter,                 true,       "Deblock and apply SAO to each CTU row as soon as the row below has been decoded, on a worker thread when more than one thread is used")
+  ("Profiling",                 m_profiling,                           false,      "Print the run time of the decoding stages (NAL unit and slice header parsing, CABAC parsing, prediction, inverse transform, loop filters, hash check, YUV output) for each picture, "
+                                                                                   "and for the bitstream with the decoding speed in pictures and bits per second")
+  ("ProfilingFile",             m_profilingFileName,                   string(""), "JSON file for the run time of the decoding stages of each picture and of the bitstream; implies Profiling")
   ;
 
   po::setDefaults(opts);
@@ -124,6 +134,29 @@ Bool TAppDecCfg::parseCfg( Int argc, TChar* argv[] )
     return false;
   }
 
+  if (!simdSetting.empty() && !parseSIMDExtensions(simdSetting))
+  {
+    fprintf(stderr, "Bad SIMD setting \"%s\"\n", simdSetting.c_str());
+    return false;
+  }
+
+  if (m_numWorkerThreads < 1)
+  {
+    fprintf(stderr, "Threads must be at least 1\n");
+    return false;
+  }
+
+  if (m_numParallelFrames < 1)
+  {
+    fprintf(stderr, "ParallelFrames must be at least 1\n");
+    return false;
+  }
+
+  if (!m_profilingFileName.empty())
+  {
+    m_profiling = true;
+  }
+
   if (m_bitstreamFileName.empty())
   {
     fprintf(stderr, "No input file specified, aborting\n");
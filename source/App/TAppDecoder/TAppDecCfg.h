@@ -73,6 +73,11 @@ protected:
 #endif
   std::string   m_outputDecodedSEIMessagesFilename;   ///< filename to output decoded SEI messages to. If '-', then use stdout. If empty, do not output details.
   Bool          m_bClipOutputVideoToRec709Range;      ///< If true, clip the output video to the Rec 709 range on saving.
+  Int           m_numWorkerThreads;                   ///< number of threads used for decoding
+  Int           m_numParallelFrames;                  ///< maximum number of pictures decoded concurrently
+  Bool          m_pipelinedLoopFilter;                ///< filter the CTU rows of a picture while it is decoded
+  Bool          m_profiling;                          ///< print the run time of the decoding stages for each picture and for the bitstream
+  std::string   m_profilingFileName;                  ///< JSON file for the run time of the decoding stages. If empty, no file is written.
 
 public:
   TAppDecCfg()
@@ -92,6 +97,11 @@ public:
 #endif
   , m_outputDecodedSEIMessagesFilename()
   , m_bClipOutputVideoToRec709Range(false)
+  , m_numWorkerThreads(1)
+  , m_numParallelFrames(1)
+  , m_pipelinedLoopFilter(true)
+  , m_profiling(false)
+  , m_profilingFileName()
   {
     for (UInt channelTypeIndex = 0; channelTypeIndex < MAX_NUM_CHANNEL_TYPE; channelTypeIndex++)
     {
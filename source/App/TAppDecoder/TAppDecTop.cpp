@@ -44,6 +44,7 @@
 #include "TAppDecTop.h"
 #include "TLibDecoder/AnnexBread.h"
 #include "TLibDecoder/NALread.h"
+#include "TLibCommon/TComProfiler.h"
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
 #include "TLibCommon/TComCodingStatistics.h"
 #endif
@@ -88,14 +89,13 @@ Void TAppDecTop::decode()
   Int                 poc;
   TComList<TComPic*>* pcListPic = NULL;
 
-  ifstream bitstreamFile(m_bitstreamFileName.c_str(), ifstream::in | ifstream::binary);
-  if (!bitstreamFile)
+  AnnexBFileReader bytestream;
+  if (!bytestream.open(m_bitstreamFileName))
   {
     fprintf(stderr, "\nfailed to open bitstream file `%s' for reading\n", m_bitstreamFileName.c_str());
     exit(EXIT_FAILURE);
   }
-
-  InputByteStream bytestream(bitstreamFile);
+  const UInt64 bitstreamSize = bytestream.getSize();
 
   if (!m_outputDecodedSEIMessagesFilename.empty() && m_outputDecodedSEIMessagesFilename!="-")
   {
@@ -112,6 +112,14 @@ Void TAppDecTop::decode()
   xInitDecLib  ();
   m_iPOCLastDisplay += m_iSkipFrame;      // set the last displayed POC correctly for skip forward.
 
+  const UInt64 startTime = TComProfiler::getTimeNs();
+  if (m_profiling)
+  {
+    TComProfilingScope::setEnabled(true);
+    m_profilingLog.reset();
+    m_cTDecTop.setProfilingLog(&m_profilingLog);
+  }
+
   // clear contents of colour-remap-information-SEI output file
   if (!m_colourRemapSEIFileName.empty())
   {
@@ -126,23 +134,29 @@ Void TAppDecTop::decode()
   // main decoder loop
   Bool openedReconFile = false; // reconstruction file not yet opened. (must be performed after SPS is seen)
   Bool loopFiltered = false;
+  Bool endOfStream = false;
 
-  while (!!bitstreamFile)
+  /* when TDecTop::decode() finds the first slice of a new picture, it
+   * completes the previous picture without decoding the slice, and must be
+   * called again with the same NAL unit, which is kept in nalUnitView. */
+  AnnexBNALUnitView nalUnitView = { NULL, 0 };
+  Bool decodeNALUnitAgain = false;
+
+  while (!endOfStream)
   {
-    /* location serves to work around a design fault in the decoder, whereby
-     * the process of reading a new slice that is the first slice of a new frame
-     * requires the TDecTop::decode() method to be called again with the same
-     * nal unit. */
+    InputNALUnit nalu;
+    {
+      TComProfilingScope profilingScope( PROFILE_DEC_NAL_PARSING );
+      if (!decodeNALUnitAgain)
+      {
+        AnnexBStats stats = AnnexBStats();
+        bytestream.readNALUnit(nalUnitView, stats);
+      }
+      nalu.getBitstream().getFifo().assign(nalUnitView.m_data, nalUnitView.m_data + nalUnitView.m_numBytes);
+    }
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
     TComCodingStatistics::TComCodingStatisticsData backupStats(TComCodingStatistics::GetStatistics());
-    streampos location = bitstreamFile.tellg() - streampos(bytestream.GetNumBufferedBytes());
-#else
-    streampos location = bitstreamFile.tellg();
 #endif
-    AnnexBStats stats = AnnexBStats();
-
-    InputNALUnit nalu;
-    byteStreamNALUnit(bytestream, nalu.getBitstream().getFifo(), stats);
 
     // call actual decoding function
     Bool bNewPicture = false;
@@ -157,7 +171,10 @@ Void TAppDecTop::decode()
     }
     else
     {
-      read(nalu);
+      {
+        TComProfilingScope profilingScope( PROFILE_DEC_NAL_PARSING );
+        read(nalu);
+      }
       if( (m_iMaxTemporalLayer >= 0 && nalu.m_temporalId > m_iMaxTemporalLayer) || !isNaluWithinTargetDecLayerIdSet(&nalu)  )
       {
         bNewPicture = false;
@@ -165,29 +182,21 @@ Void TAppDecTop::decode()
       else
       {
         bNewPicture = m_cTDecTop.decode(nalu, m_iSkipFrame, m_iPOCLastDisplay);
+#if RExt__DECODER_DEBUG_BIT_STATISTICS
         if (bNewPicture)
         {
-          bitstreamFile.clear();
-          /* location points to the current nalunit payload[1] due to the
-           * need for the annexB parser to read three extra bytes.
-           * [1] except for the first NAL unit in the file
-           *     (but bNewPicture doesn't happen then) */
-#if RExt__DECODER_DEBUG_BIT_STATISTICS
-          bitstreamFile.seekg(location);
-          bytestream.reset();
           TComCodingStatistics::SetStatistics(backupStats);
-#else
-          bitstreamFile.seekg(location-streamoff(3));
-          bytestream.reset();
-#endif
         }
+#endif
       }
     }
+    decodeNALUnitAgain = bNewPicture;
+    endOfStream = !decodeNALUnitAgain && bytestream.isEndOfStream();
 
-    if ( (bNewPicture || !bitstreamFile || nalu.m_nalUnitType == NAL_UNIT_EOS) &&
+    if ( (bNewPicture || endOfStream || nalu.m_nalUnitType == NAL_UNIT_EOS) &&
         !m_cTDecTop.getFirstSliceInSequence () )
     {
-      if (!loopFiltered || bitstreamFile)
+      if (!loopFiltered || !endOfStream)
       {
         m_cTDecTop.executeLoopFilters(poc, pcListPic);
       }
@@ -197,7 +206,7 @@ Void TAppDecTop::decode()
         m_cTDecTop.setFirstSliceInSequence(true);
       }
     }
-    else if ( (bNewPicture || !bitstreamFile || nalu.m_nalUnitType == NAL_UNIT_EOS ) &&
+    else if ( (bNewPicture || endOfStream || nalu.m_nalUnitType == NAL_UNIT_EOS ) &&
               m_cTDecTop.getFirstSliceInSequence () ) 
     {
       m_cTDecTop.setFirstSliceInPicture (true);
@@ -255,6 +264,11 @@ Void TAppDecTop::decode()
   // delete buffers
   m_cTDecTop.deletePicBuffer();
 
+  if (m_profiling)
+  {
+    xPrintProfile( bitstreamSize, Double( TComProfiler::getTimeNs() - startTime ) * 1.0e-9 );
+  }
+
   // destroy internal classes
   xDestroyDecLib();
 }
@@ -266,6 +280,8 @@ Void TAppDecTop::decode()
 Void TAppDecTop::xCreateDecLib()
 {
   // create decoder class
+  m_cTDecTop.setNumWorkerThreads(m_numWorkerThreads);
+  m_cTDecTop.setNumParallelFrames(m_numParallelFrames);
   m_cTDecTop.create();
 }
 
@@ -289,6 +305,7 @@ Void TAppDecTop::xDestroyDecLib()
 Void TAppDecTop::xInitDecLib()
 {
   // initialize decoder class
+  m_cTDecTop.setPipelinedLoopFilter(m_pipelinedLoopFilter);
   m_cTDecTop.init();
   m_cTDecTop.setDecodedPictureHashSEIEnabled(m_decodedPictureHashSEIEnabled);
 #if O0043_BEST_EFFORT_DECODING
@@ -375,6 +392,8 @@ Void TAppDecTop::xWriteOutput( TComList<TComPic*>* pcListPic, UInt tId )
           (pcPicTop->getPOC() == m_iPOCLastDisplay+1 || m_iPOCLastDisplay < 0))
       {
         // write to file
+        m_cTDecTop.finishPictureDecoding(pcPicTop);
+        m_cTDecTop.finishPictureDecoding(pcPicBottom);
         numPicsNotYetDisplayed = numPicsNotYetDisplayed-2;
         if ( !m_reconFileName.empty() )
         {
@@ -395,6 +414,7 @@ Void TAppDecTop::xWriteOutput( TComList<TComPic*>* pcListPic, UInt tId )
 
           if (display)
           {
+            TComProfilingScope profilingScope( PROFILE_FILE_IO );
             m_cTVideoIOYuvReconFile.write( pcPicTop->getPicYuvRec(), pcPicBottom->getPicYuvRec(),
                                            m_outputColourSpaceConvert,
                                            conf.getWindowLeftOffset() + defDisp.getWindowLeftOffset(),
@@ -439,6 +459,7 @@ Void TAppDecTop::xWriteOutput( TComList<TComPic*>* pcListPic, UInt tId )
         (numPicsNotYetDisplayed >  numReorderPicsHighestTid || dpbFullness > maxDecPicBufferingHighestTid))
       {
         // write to file
+        m_cTDecTop.finishPictureDecoding(pcPic);
          numPicsNotYetDisplayed--;
         if(pcPic->getSlice(0)->isReferenced() == false)
         {
@@ -450,6 +471,7 @@ Void TAppDecTop::xWriteOutput( TComList<TComPic*>* pcListPic, UInt tId )
           const Window &conf    = pcPic->getConformanceWindow();
           const Window  defDisp = m_respectDefDispWindow ? pcPic->getDefDisplayWindow() : Window();
 
+          TComProfilingScope profilingScope( PROFILE_FILE_IO );
           m_cTVideoIOYuvReconFile.write( pcPic->getPicYuvRec(),
                                          m_outputColourSpaceConvert,
                                          conf.getWindowLeftOffset() + defDisp.getWindowLeftOffset(),
@@ -491,6 +513,7 @@ Void TAppDecTop::xFlushOutput( TComList<TComPic*>* pcListPic )
   {
     return;
   }
+  m_cTDecTop.finishPictureDecoding();
   TComList<TComPic*>::iterator iterPic   = pcListPic->begin();
 
   iterPic   = pcListPic->begin();
@@ -515,6 +538,7 @@ Void TAppDecTop::xFlushOutput( TComList<TComPic*>* pcListPic )
           const Window &conf = pcPicTop->getConformanceWindow();
           const Window  defDisp = m_respectDefDispWindow ? pcPicTop->getDefDisplayWindow() : Window();
           const Bool isTff = pcPicTop->isTopField();
+          TComProfilingScope profilingScope( PROFILE_FILE_IO );
           m_cTVideoIOYuvReconFile.write( pcPicTop->getPicYuvRec(), pcPicBottom->getPicYuvRec(),
                                          m_outputColourSpaceConvert,
                                          conf.getWindowLeftOffset() + defDisp.getWindowLeftOffset(),
@@ -573,6 +597,7 @@ Void TAppDecTop::xFlushOutput( TComList<TComPic*>* pcListPic )
           const Window &conf    = pcPic->getConformanceWindow();
           const Window  defDisp = m_respectDefDispWindow ? pcPic->getDefDisplayWindow() : Window();
 
+          TComProfilingScope profilingScope( PROFILE_FILE_IO );
           m_cTVideoIOYuvReconFile.write( pcPic->getPicYuvRec(),
                                          m_outputColourSpaceConvert,
                                          conf.getWindowLeftOffset() + defDisp.getWindowLeftOffset(),
@@ -615,6 +640,27 @@ Void TAppDecTop::xFlushOutput( TComList<TComPic*>* pcListPic )
 
 /** \param nalu Input nalu to check whether its LayerId is within targetDecLayerIdSet
  */
+/** The decoding speed is measured from the initialisation of the decoder until all pictures have been written.
+ */
+Void TAppDecTop::xPrintProfile( UInt64 bitstreamSize, Double decodingTime )
+{
+  TComProfilingCounters profilingCounters;
+  m_profilingLog.getTotal( profilingCounters );
+  TComProfiler::printSummary( profilingCounters, m_profilingLog.getNumPictures() );
+
+  if ( decodingTime > 0 )
+  {
+    printf( "Decoding speed: %.2f pictures/s, %.1f kbit/s (%u pictures, %llu bytes in %.3f s)\n",
+            m_profilingLog.getNumPictures() / decodingTime, bitstreamSize * 8.0 / 1000.0 / decodingTime,
+            m_profilingLog.getNumPictures(), (unsigned long long)bitstreamSize, decodingTime );
+  }
+
+  if ( !m_profilingFileName.empty() && !m_profilingLog.writeJSON( m_profilingFileName ) )
+  {
+    fprintf( stderr, "\nUnable to write the profiling file %s\n", m_profilingFileName.c_str() );
+  }
+}
+
 Bool TAppDecTop::isNaluWithinTargetDecLayerIdSet( InputNALUnit* nalu )
 {
   if ( m_targetDecLayerIdSet.size() == 0 ) // By default, the set is empty, meaning all LayerIds are allowed
@@ -45,6 +45,7 @@
 #include "TLibVideoIO/TVideoIOYuv.h"
 #include "TLibCommon/TComList.h"
 #include "TLibCommon/TComPicYuv.h"
+#include "TLibCommon/TComProfiler.h"
 #include "TLibDecoder/TDecTop.h"
 #include "TAppDecCfg.h"
 
@@ -69,6 +70,8 @@ private:
 
   SEIColourRemappingInfo*         m_pcSeiColourRemappingInfoPrevious;
 
+  TComProfilingLog                m_profilingLog;                 ///< run time of the decoding stages of each picture, when profiling
+
 public:
   TAppDecTop();
   virtual ~TAppDecTop() {}
@@ -86,6 +89,7 @@ protected:
   Void  xWriteOutput      ( TComList<TComPic*>* pcListPic , UInt tId); ///< write YUV to file
   Void  xFlushOutput      ( TComList<TComPic*>* pcListPic ); ///< flush all remaining decoded pictures to file
   Bool  isNaluWithinTargetDecLayerIdSet ( InputNALUnit* nalu ); ///< check whether given Nalu is within targetDecLayerIdSet
+  Void  xPrintProfile     ( UInt64 bitstreamSize, Double decodingTime ); ///< print the run time of the decoding stages and the decoding speed
 
 private:
   Void applyColourRemapping(const TComPicYuv& pic, SEIColourRemappingInfo& pCriSEI, const TComSPS &activeSPS);
@@ -42,6 +42,7 @@
 #include <string>
 #include <limits>
 #include "TLibCommon/TComRom.h"
+#include "TLibCommon/TComCpuFeatures.h"
 #include "TAppEncCfg.h"
 #include "TAppCommon/program_options_lite.h"
 #include "TLibEncoder/TEncRateCtrl.h"
@@ -639,6 +640,7 @@ Bool TAppEncCfg::parseCfg( Int argc, TChar* argv[] )
   Int tmpSliceSegmentMode;
   Int tmpDecodedPictureHashSEIMappedType;
   string inputColourSpaceConvert;
+  string simdSetting;
   ExtendedProfileName extendedProfile;
   Int saoOffsetBitShift[MAX_NUM_CHANNEL_TYPE];
 
@@ -736,6 +738,8 @@ Bool TAppEncCfg::parseCfg( Int argc, TChar* argv[] )
   ("SummaryOutFilename",                              m_summaryOutFilename,                          string(), "Filename to use for producing summary output file. If empty, do not produce a file.")
   ("SummaryPicFilenameBase",                          m_summaryPicFilenameBase,                      string(), "Base filename to use for producing summary picture output files. The actual filenames used will have I.txt, P.txt and B.txt appended. If empty, do not produce a file.")
   ("SummaryVerboseness",                              m_summaryVerboseness,                                0u, "Specifies the level of the verboseness of the text output")
+  ("Profiling",                                       m_profiling,                                      false, "Print the run time of the encoding stages (motion estimation, RDOQ, entropy coding, loop filters, file I/O, ...) for each picture and for the sequence")
+  ("ProfilingFile",                                   m_profilingFileName,                           string(), "JSON file for the run time of the encoding stages of each picture and of the sequence; implies Profiling. If empty, do not produce a file.")
 
   //Field coding parameters
   ("FieldCoding",                                     m_isField,                                        false, "Signals if it's a field based coding")
@@ -914,6 +918,10 @@ Bool TAppEncCfg::parseCfg( Int argc, TChar* argv[] )
   ("TileRowHeightArray",                              cfg_RowHeight,                            cfg_RowHeight, "Array containing tile row height values in units of CTU")
   ("LFCrossTileBoundaryFlag",                         m_bLFCrossTileBoundaryFlag,                        true, "1: cross-tile-boundary loop filtering. 0:non-cross-tile-boundary loop filtering")
   ("WaveFrontSynchro",                                m_entropyCodingSyncEnabledFlag,                   false, "0: entropy coding sync disabled; 1 entropy coding sync enabled")
+  ("Threads",                                         m_numWorkerThreads,                                   1, "Number of threads used to compress and entropy code CTUs. CTU rows (WaveFrontSynchro) or tiles are processed in parallel (1: single-threaded)")
+  ("ParallelFrames",                                  m_numParallelFrames,                                  1, "Maximum number of pictures compressed concurrently when Threads > 1 (1: one picture at a time)")
+  ("SIMD",                                            simdSetting,                                 string(""), "Maximum SIMD extensions of the kernels, e.g. none, sse2, sse41, avx2 or avx2,sao=none (empty string: the HM_SIMD environment variable, else all that the processor supports). "
+                                                                                                               "Groups: distortion, interpolation, transform, intra, loopfilter, sao, yuv, bitstream")
   ("ScalingList",                                     m_useScalingListId,                    SCALING_LIST_OFF, "0/off: no scaling list, 1/default: default scaling lists, 2/file: scaling lists specified in ScalingListFile")
   ("ScalingListFile",                                 m_scalingListFileName,                       string(""), "Scaling list file name. Use an empty string to produce help.")
   ("SignHideFlag,-SBH",                               m_signDataHidingEnabledFlag,                                    true)
@@ -1351,6 +1359,12 @@ Bool TAppEncCfg::parseCfg( Int argc, TChar* argv[] )
 
   m_inputColourSpaceConvert = stringToInputColourSpaceConvert(inputColourSpaceConvert, true);
 
+  if (!simdSetting.empty() && !parseSIMDExtensions(simdSetting))
+  {
+    fprintf(stderr, "Bad SIMD setting \"%s\"\n", simdSetting.c_str());
+    return false;
+  }
+
   switch (m_conformanceWindowMode)
   {
   case 0:
@@ -1826,6 +1840,8 @@ Void TAppEncCfg::xCheckParameter()
   xConfirmPara( m_deblockingFilterMetric!=0 && (m_bLoopFilterDisable || m_loopFilterOffsetInPPS), "If DeblockingFilterMetric is non-zero then both LoopFilterDisable and LoopFilterOffsetInPPS must be 0");
   xConfirmPara( m_loopFilterBetaOffsetDiv2 < -6 || m_loopFilterBetaOffsetDiv2 > 6,        "Loop Filter Beta Offset div. 2 exceeds supported range (-6 to 6)");
   xConfirmPara( m_loopFilterTcOffsetDiv2 < -6 || m_loopFilterTcOffsetDiv2 > 6,            "Loop Filter Tc Offset div. 2 exceeds supported range (-6 to 6)");
+  xConfirmPara( m_numWorkerThreads < 1,                                                      "Threads must be at least 1" );
+  xConfirmPara( m_numParallelFrames < 1,                                                     "ParallelFrames must be at least 1" );
   xConfirmPara( m_iSearchRange < 0 ,                                                        "Search Range must be more than 0" );
   xConfirmPara( m_bipredSearchRange < 0 ,                                                   "Bi-prediction refinement search range must be more than 0" );
   xConfirmPara( m_minSearchWindow < 0,                                                      "Minimum motion search window size for the adaptive window ME must be greater than or equal to 0" );
@@ -2474,6 +2490,7 @@ Void TAppEncCfg::xPrintParameter()
   printf("Sequence PSNR output                   : %s\n", (m_printMSEBasedSequencePSNR ? "Linear average, MSE-based" : "Linear average only") );
   printf("Sequence MSE output                    : %s\n", (m_printSequenceMSE ? "Enabled" : "Disabled") );
   printf("Frame MSE output                       : %s\n", (m_printFrameMSE    ? "Enabled" : "Disabled") );
+  printf("Profiling                              : %s\n", (m_profiling || !m_profilingFileName.empty()) ? "Enabled" : "Disabled" );
   printf("Cabac-zero-word-padding                : %s\n", (m_cabacZeroWordPaddingEnabled? "Enabled" : "Disabled") );
   if (m_isField)
   {
@@ -2593,6 +2610,12 @@ Void TAppEncCfg::xPrintParameter()
   }
 
   printf("Max Num Merge Candidates               : %d\n", m_maxNumMergeCand);
+  printf("SIMD extensions                        : %s (", getSIMDExtensionName(getDetectedSIMDExtension()));
+  for (Int group = 0; group < NUMBER_OF_SIMD_KERNEL_GROUPS; group++)
+  {
+    printf("%s%s:%s", (group == 0) ? "" : " ", getSIMDKernelGroupName(SIMDKernelGroup(group)), getSIMDExtensionName(getSIMDExtension(SIMDKernelGroup(group))));
+  }
+  printf(")\n");
   printf("\n");
 
   printf("TOOL CFG: ");
@@ -2643,6 +2666,8 @@ Void TAppEncCfg::xPrintParameter()
   printf("PME:%d ", m_log2ParallelMergeLevel);
   const Int iWaveFrontSubstreams = m_entropyCodingSyncEnabledFlag ? (m_iSourceHeight + m_uiMaxCUHeight - 1) / m_uiMaxCUHeight : 1;
   printf(" WaveFrontSynchro:%d WaveFrontSubstreams:%d", m_entropyCodingSyncEnabledFlag?1:0, iWaveFrontSubstreams);
+  printf(" Threads:%d", m_numWorkerThreads);
+  printf(" ParallelFrames:%d", m_numParallelFrames);
   printf(" ScalingList:%d ", m_useScalingListId );
   printf("TMVPMode:%d ", m_TMVPModeId     );
 #if ADAPTIVE_QP_SELECTION
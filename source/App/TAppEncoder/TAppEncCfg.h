@@ -270,6 +270,8 @@ protected:
   std::vector<Int> m_tileColumnWidth;
   std::vector<Int> m_tileRowHeight;
   Bool      m_entropyCodingSyncEnabledFlag;
+  Int       m_numWorkerThreads;                               ///< number of threads used to compress CTUs
+  Int       m_numParallelFrames;                              ///< maximum number of pictures compressed concurrently
 
   Bool      m_bUseConstrainedIntraPred;                       ///< flag for using constrained intra prediction
   Bool      m_bFastUDIUseMPMEnabled;
@@ -415,6 +417,8 @@ protected:
   std::string m_summaryOutFilename;                           ///< filename to use for producing summary output file.
   std::string m_summaryPicFilenameBase;                       ///< Base filename to use for producing summary picture output files. The actual filenames used will have I.txt, P.txt and B.txt appended.
   UInt        m_summaryVerboseness;                           ///< Specifies the level of the verboseness of the text output.
+  Bool        m_profiling;                                    ///< print the run time of the encoding stages for each picture and for the sequence
+  std::string m_profilingFileName;                            ///< JSON file for the run time of the encoding stages. If empty, no file is written.
 
 #if EXTENSION_360_VIDEO
   TExt360AppEncCfg m_ext360;
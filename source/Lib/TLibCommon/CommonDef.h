@@ -271,6 +271,13 @@ template <typename T> inline Void Check3( T minVal, T maxVal, T a)
 #define xFree( ptr )                free     ( ptr )
 #endif
 
+// thread-local storage of plain data; the compiler keywords are used, as thread_local is not supported before VS2015
+#if     defined( _MSC_VER )
+#define THREAD_LOCAL                __declspec( thread )
+#else
+#define THREAD_LOCAL                __thread
+#endif
+
 #define FATAL_ERROR_0(MESSAGE, EXITCODE)                      \
 {                                                             \
   printf(MESSAGE);                                            \
@@ -41,6 +41,17 @@
 #include <string.h>
 #include <memory.h>
 
+#if VECTOR_CODING__BITSTREAM
+#include <emmintrin.h>
+#include "TComCpuFeatures.h"
+#if VECTOR_CODING__AVX2
+#include <immintrin.h>
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
 using namespace std;
 
 //! \ingroup TLibCommon
@@ -63,18 +74,22 @@ TComOutputBitstream::~TComOutputBitstream()
 TComInputBitstream::TComInputBitstream()
 : m_fifo()
 , m_emulationPreventionByteLocation()
+, m_view(NULL)
+, m_viewNumBytes(0)
 , m_fifo_idx(0)
-, m_num_held_bits(0)
 , m_held_bits(0)
+, m_num_held_bits(0)
 , m_numBitsRead(0)
 { }
 
 TComInputBitstream::TComInputBitstream(const TComInputBitstream &src)
 : m_fifo(src.m_fifo)
 , m_emulationPreventionByteLocation(src.m_emulationPreventionByteLocation)
+, m_view(src.m_view)
+, m_viewNumBytes(src.m_viewNumBytes)
 , m_fifo_idx(src.m_fifo_idx)
-, m_num_held_bits(src.m_num_held_bits)
 , m_held_bits(src.m_held_bits)
+, m_num_held_bits(src.m_num_held_bits)
 , m_numBitsRead(src.m_numBitsRead)
 { }
 
@@ -90,13 +105,105 @@ Void TComInputBitstream::resetToStart()
   m_numBitsRead=0;
 }
 
-UChar* TComOutputBitstream::getByteStream() const
+/**
+ * loads as many whole bytes as fit into m_held_bits, eight of them
+ * with a single big-endian load when they are available
+ */
+static inline UInt64 xReadBigEndian64( const uint8_t* p )
+{
+  return ( UInt64( p[0] ) << 56 ) | ( UInt64( p[1] ) << 48 ) | ( UInt64( p[2] ) << 40 ) | ( UInt64( p[3] ) << 32 )
+       | ( UInt64( p[4] ) << 24 ) | ( UInt64( p[5] ) << 16 ) | ( UInt64( p[6] ) <<  8 ) |   UInt64( p[7] );
+}
+
+Void TComInputBitstream::xRefill()
+{
+  const uint8_t* data     = xGetData();
+  const UInt     numBytes = xGetNumBytes();
+  const UInt     numBytesToLoad = ( 64 - m_num_held_bits ) >> 3;
+  assert( numBytesToLoad > 0 );
+
+  if( m_fifo_idx + 8 <= numBytes )
+  {
+    const UInt64 word = xReadBigEndian64( data + m_fifo_idx );
+    m_held_bits     |= ( word >> ( 64 - 8 * numBytesToLoad ) ) << ( ( 64 - m_num_held_bits ) & 7 );
+    m_fifo_idx      += numBytesToLoad;
+    m_num_held_bits += 8 * numBytesToLoad;
+  }
+  else
+  {
+    for( UInt i = 0; i < numBytesToLoad && m_fifo_idx < numBytes; i++ )
+    {
+      m_held_bits     |= UInt64( data[m_fifo_idx++] ) << ( 56 - m_num_held_bits );
+      m_num_held_bits += 8;
+    }
+  }
+}
+
+/**
+ * Read up to 8 whole bytes at once. The bitstream must be byte aligned.
+ * \param  uiMaxNumberOfBytes  number of bytes to read, fewer are read at the end of the bitstream
+ * \param  ruiBytes            the bytes read, in the low bytes with the first byte most significant
+ * \returns the number of bytes read
+ */
+UInt TComInputBitstream::readBytes( UInt uiMaxNumberOfBytes, UInt64& ruiBytes )
 {
+  assert( uiMaxNumberOfBytes <= 8 );
+  assert( getNumBitsUntilByteAligned() == 0 );
+
+  const uint8_t* data       = xGetData();
+  const UInt     numBytes   = xGetNumBytes();
+  const UInt     byteIdx    = getByteLocation();
+  const UInt     numToRead  = std::min( uiMaxNumberOfBytes, numBytes - byteIdx );
+
+  if( numToRead == 0 )
+  {
+    ruiBytes = 0;
+  }
+  else if( byteIdx + 8 <= numBytes )
+  {
+    ruiBytes = xReadBigEndian64( data + byteIdx ) >> ( 64 - 8 * numToRead );
+  }
+  else
+  {
+    ruiBytes = 0;
+    for( UInt i = 0; i < numToRead; i++ )
+    {
+      ruiBytes = ( ruiBytes << 8 ) | data[byteIdx + i];
+    }
+  }
+
+  // the held bits are dropped; the next read refills from the new position
+  m_fifo_idx       = byteIdx + numToRead;
+  m_held_bits      = 0;
+  m_num_held_bits  = 0;
+  m_numBitsRead   += 8 * numToRead;
+  return numToRead;
+}
+
+/**
+ * Return whole bytes that have been read but were not used to the bitstream, so that they are read again.
+ * The bitstream must be byte aligned.
+ */
+Void TComInputBitstream::unreadBytes( UInt uiNumberOfBytes )
+{
+  assert( getNumBitsUntilByteAligned() == 0 );
+  assert( uiNumberOfBytes <= getByteLocation() );
+
+  m_fifo_idx       = getByteLocation() - uiNumberOfBytes;
+  m_held_bits      = 0;
+  m_num_held_bits  = 0;
+  m_numBitsRead   -= 8 * uiNumberOfBytes;
+}
+
+UChar* TComOutputBitstream::getByteStream()
+{
+  xFlushBytes();
   return (UChar*) &m_fifo.front();
 }
 
 UInt TComOutputBitstream::getByteStreamLength()
 {
+  xFlushBytes();
   return UInt(m_fifo.size());
 }
 
@@ -112,43 +219,45 @@ Void TComOutputBitstream::write   ( UInt uiBits, UInt uiNumberOfBits )
   assert( uiNumberOfBits <= 32 );
   assert( uiNumberOfBits == 32 || (uiBits & (~0 << uiNumberOfBits)) == 0 );
 
-  /* any modulo 8 remainder of num_total_bits cannot be written this time,
-   * and will be held until next time. */
-  UInt num_total_bits = uiNumberOfBits + m_num_held_bits;
-  UInt next_num_held_bits = num_total_bits % 8;
-
-  /* form a byte aligned word (write_bits), by concatenating any held bits
-   * with the new bits, discarding the bits that will form the next_held_bits.
-   * eg: H = held bits, V = n new bits        /---- next_held_bits
-   * len(H)=7, len(V)=1: ... ---- HHHH HHHV . 0000 0000, next_num_held_bits=0
-   * len(H)=7, len(V)=2: ... ---- HHHH HHHV . V000 0000, next_num_held_bits=1
-   * if total_bits < 8, the value of v_ is not used */
-  UChar next_held_bits = uiBits << (8 - next_num_held_bits);
-
-  if (!(num_total_bits >> 3))
+  if (m_num_held_bits + uiNumberOfBits < 64)
   {
-    /* insufficient bits accumulated to write out, append new_held_bits to
-     * current held_bits */
-    /* NB, this requires that v only contains 0 in bit positions {31..n} */
-    m_held_bits |= next_held_bits;
-    m_num_held_bits = next_num_held_bits;
+    m_held_bits = (m_held_bits << uiNumberOfBits) | uiBits;
+    m_num_held_bits += uiNumberOfBits;
     return;
   }
 
-  /* topword serves to justify held_bits to align with the msb of uiBits */
-  UInt topword = (uiNumberOfBits - next_num_held_bits) & ~((1 << 3) -1);
-  UInt write_bits = (m_held_bits << topword) | (uiBits >> next_num_held_bits);
+  /* complete the 64-bit word with the leading new bits, write it out, and
+   * hold the remaining new bits.
+   * eg: H = held bits, V = n new bits
+   * len(H)=60, len(V)=6: HHHH ... HHHH VVVV, next_num_held_bits=2 */
+  const UInt   num_fill_bits      = 64 - m_num_held_bits;
+  const UInt   next_num_held_bits = uiNumberOfBits - num_fill_bits;
+  const UInt64 word               = (m_held_bits << num_fill_bits) | (UInt64(uiBits) >> next_num_held_bits);
+
+  const size_t size = m_fifo.size();
+  m_fifo.resize(size + 8);
+  uint8_t* p = &m_fifo[size];
+  p[0] = uint8_t(word >> 56);
+  p[1] = uint8_t(word >> 48);
+  p[2] = uint8_t(word >> 40);
+  p[3] = uint8_t(word >> 32);
+  p[4] = uint8_t(word >> 24);
+  p[5] = uint8_t(word >> 16);
+  p[6] = uint8_t(word >>  8);
+  p[7] = uint8_t(word);
+
+  m_held_bits     = uiBits & ((UInt64(1) << next_num_held_bits) - 1);
+  m_num_held_bits = next_num_held_bits;
+}
 
-  switch (num_total_bits >> 3)
+Void TComOutputBitstream::xFlushBytes()
+{
+  while (m_num_held_bits >= 8)
   {
-  case 4: m_fifo.push_back(write_bits >> 24);
-  case 3: m_fifo.push_back(write_bits >> 16);
-  case 2: m_fifo.push_back(write_bits >> 8);
-  case 1: m_fifo.push_back(write_bits);
+    m_num_held_bits -= 8;
+    m_fifo.push_back(uint8_t(m_held_bits >> m_num_held_bits));
   }
-
-  m_held_bits = next_held_bits;
-  m_num_held_bits = next_num_held_bits;
+  m_held_bits &= (UInt64(1) << m_num_held_bits) - 1;
 }
 
 Void TComOutputBitstream::writeAlignOne()
@@ -160,11 +269,12 @@ Void TComOutputBitstream::writeAlignOne()
 
 Void TComOutputBitstream::writeAlignZero()
 {
+  xFlushBytes();
   if (0 == m_num_held_bits)
   {
     return;
   }
-  m_fifo.push_back(m_held_bits);
+  m_fifo.push_back(uint8_t(m_held_bits << (8 - m_num_held_bits)));
   m_held_bits = 0;
   m_num_held_bits = 0;
 }
@@ -179,9 +289,24 @@ Void   TComOutputBitstream::addSubstream( TComOutputBitstream* pcSubstream )
   UInt uiNumBits = pcSubstream->getNumberOfWrittenBits();
 
   const vector<uint8_t>& rbsp = pcSubstream->getFIFO();
-  for (vector<uint8_t>::const_iterator it = rbsp.begin(); it != rbsp.end();)
+  if (getNumBitsUntilByteAligned() == 0)
   {
-    write(*it++, 8);
+    // the bytes of the substream are appended as they are
+    xFlushBytes();
+    m_fifo.insert(m_fifo.end(), rbsp.begin(), rbsp.end());
+  }
+  else
+  {
+    const size_t numBytes = rbsp.size();
+    size_t i = 0;
+    for (; i + 4 <= numBytes; i += 4)
+    {
+      write((UInt(rbsp[i]) << 24) | (UInt(rbsp[i + 1]) << 16) | (UInt(rbsp[i + 2]) << 8) | UInt(rbsp[i + 3]), 32);
+    }
+    for (; i < numBytes; i++)
+    {
+      write(rbsp[i], 8);
+    }
   }
   if (uiNumBits&0x7)
   {
@@ -199,30 +324,15 @@ Int TComOutputBitstream::countStartCodeEmulations()
 {
   UInt cnt = 0;
   vector<uint8_t>& rbsp   = getFIFO();
-  for (vector<uint8_t>::iterator it = rbsp.begin(); it != rbsp.end();)
+  if (rbsp.empty())
   {
-    vector<uint8_t>::iterator found = it;
-    do
-    {
-      // find the next emulated 00 00 {00,01,02,03}
-      // NB, end()-1, prevents finding a trailing two byte sequence
-      found = search_n(found, rbsp.end()-1, 2, 0);
-      found++;
-      // if not found, found == end, otherwise found = second zero byte
-      if (found == rbsp.end())
-      {
-        break;
-      }
-      if (*(++found) <= 3)
-      {
-        break;
-      }
-    } while (true);
-    it = found;
-    if (found != rbsp.end())
-    {
-      cnt++;
-    }
+    return 0;
+  }
+  // find each emulated 00 00 {00,01,02,03}; the third byte can start the next one
+  const uint8_t* end = &rbsp[0] + rbsp.size();
+  for (const uint8_t* found = findZeroZeroSequence(&rbsp[0], end, 3); found != end; found = findZeroZeroSequence(found + 2, end, 3))
+  {
+    cnt++;
   }
   return cnt;
 }
@@ -236,94 +346,29 @@ Int TComOutputBitstream::countStartCodeEmulations()
  * avoid the overrun.
  */
 Void TComInputBitstream::pseudoRead ( UInt uiNumberOfBits, UInt& ruiBits )
-{
-  UInt saved_num_held_bits = m_num_held_bits;
-  UChar saved_held_bits = m_held_bits;
-  UInt saved_fifo_idx = m_fifo_idx;
-
-  UInt num_bits_to_read = min(uiNumberOfBits, getNumBitsLeft());
-  read(num_bits_to_read, ruiBits);
-  ruiBits <<= (uiNumberOfBits - num_bits_to_read);
-
-  m_fifo_idx = saved_fifo_idx;
-  m_held_bits = saved_held_bits;
-  m_num_held_bits = saved_num_held_bits;
-}
-
-
-Void TComInputBitstream::read (UInt uiNumberOfBits, UInt& ruiBits)
 {
   assert( uiNumberOfBits <= 32 );
-
-  m_numBitsRead += uiNumberOfBits;
-
-  /* NB, bits are extracted from the MSB of each byte. */
-  UInt retval = 0;
-  if (uiNumberOfBits <= m_num_held_bits)
+  if( uiNumberOfBits > m_num_held_bits )
   {
-    /* n=1, len(H)=7:   -VHH HHHH, shift_down=6, mask=0xfe
-     * n=3, len(H)=7:   -VVV HHHH, shift_down=4, mask=0xf8
-     */
-    retval = m_held_bits >> (m_num_held_bits - uiNumberOfBits);
-    retval &= ~(0xff << uiNumberOfBits);
-    m_num_held_bits -= uiNumberOfBits;
-    ruiBits = retval;
-    return;
+    // loading more bytes does not change the position in the bitstream, and the bits past its end are zero
+    xRefill();
   }
-
-  /* all num_held_bits will go into retval
-   *   => need to mask leftover bits from previous extractions
-   *   => align retval with top of extracted word */
-  /* n=5, len(H)=3: ---- -VVV, mask=0x07, shift_up=5-3=2,
-   * n=9, len(H)=3: ---- -VVV, mask=0x07, shift_up=9-3=6 */
-  uiNumberOfBits -= m_num_held_bits;
-  retval = m_held_bits & ~(0xff << m_num_held_bits);
-  retval <<= uiNumberOfBits;
-
-  /* number of whole bytes that need to be loaded to form retval */
-  /* n=32, len(H)=0, load 4bytes, shift_down=0
-   * n=32, len(H)=1, load 4bytes, shift_down=1
-   * n=31, len(H)=1, load 4bytes, shift_down=1+1
-   * n=8,  len(H)=0, load 1byte,  shift_down=0
-   * n=8,  len(H)=3, load 1byte,  shift_down=3
-   * n=5,  len(H)=1, load 1byte,  shift_down=1+3
-   */
-  UInt aligned_word = 0;
-  UInt num_bytes_to_load = (uiNumberOfBits - 1) >> 3;
-  assert(m_fifo_idx + num_bytes_to_load < m_fifo.size());
-
-  switch (num_bytes_to_load)
-  {
-  case 3: aligned_word  = m_fifo[m_fifo_idx++] << 24;
-  case 2: aligned_word |= m_fifo[m_fifo_idx++] << 16;
-  case 1: aligned_word |= m_fifo[m_fifo_idx++] <<  8;
-  case 0: aligned_word |= m_fifo[m_fifo_idx++];
-  }
-
-  /* resolve remainder bits */
-  UInt next_num_held_bits = (32 - uiNumberOfBits) % 8;
-
-  /* copy required part of aligned_word into retval */
-  retval |= aligned_word >> next_num_held_bits;
-
-  /* store held bits */
-  m_num_held_bits = next_num_held_bits;
-  m_held_bits = aligned_word;
-
-  ruiBits = retval;
+  ruiBits = UInt( ( m_held_bits >> 1 ) >> ( 63 - uiNumberOfBits ) );
 }
 
 /**
  * insert the contents of the bytealigned (and flushed) bitstream src
  * into this at byte position pos.
  */
-Void TComOutputBitstream::insertAt(const TComOutputBitstream& src, UInt pos)
+Void TComOutputBitstream::insertAt(TComOutputBitstream& src, UInt pos)
 {
   UInt src_bits = src.getNumberOfWrittenBits();
   assert(0 == src_bits % 8);
 
+  const vector<uint8_t>& srcFifo = src.getFIFO();
+  xFlushBytes();
   vector<uint8_t>::iterator at = m_fifo.begin() + pos;
-  m_fifo.insert(at, src.m_fifo.begin(), src.m_fifo.end());
+  m_fifo.insert(at, srcFifo.begin(), srcFifo.end());
 }
 
 UInt TComInputBitstream::readOutTrailingBits ()
@@ -353,44 +398,45 @@ UInt TComInputBitstream::readOutTrailingBits ()
 /**
  Extract substream from the current bitstream.
 
+ When the current position and the size of the substream are byte aligned,
+ the substream reads the bytes of this bitstream, which must outlive it.
+ Otherwise the bits are copied into the fifo of the substream.
+
  \param  uiNumBits    number of bits to transfer
+ \param  substream    bitstream that receives the substream
  */
-TComInputBitstream *TComInputBitstream::extractSubstream( UInt uiNumBits )
+Void TComInputBitstream::extractSubstream( UInt uiNumBits, TComInputBitstream& substream )
 {
-  UInt uiNumBytes = uiNumBits/8;
-  TComInputBitstream *pResult = new TComInputBitstream;
-
-  std::vector<uint8_t> &buf = pResult->getFifo();
-  buf.reserve((uiNumBits+7)>>3);
+  substream.m_fifo.clear();
+  substream.m_emulationPreventionByteLocation.clear();
+  substream.m_view         = NULL;
+  substream.m_viewNumBytes = 0;
+  substream.resetToStart();
 
-  if (m_num_held_bits == 0)
-  {
-    std::size_t currentOutputBufferSize=buf.size();
-    const UInt uiNumBytesToReadFromFifo = std::min<UInt>(uiNumBytes, (UInt)m_fifo.size() - m_fifo_idx);
-    buf.resize(currentOutputBufferSize+uiNumBytes);
-    memcpy(&(buf[currentOutputBufferSize]), &(m_fifo[m_fifo_idx]), uiNumBytesToReadFromFifo); m_fifo_idx+=uiNumBytesToReadFromFifo;
-    if (uiNumBytesToReadFromFifo != uiNumBytes)
-    {
-      memset(&(buf[currentOutputBufferSize+uiNumBytesToReadFromFifo]), 0, uiNumBytes - uiNumBytesToReadFromFifo);
-    }
-  }
-  else
+  if ( getNumBitsUntilByteAligned() == 0 && (uiNumBits & 0x7) == 0 && uiNumBits <= getNumBitsLeft() )
   {
-    for (UInt ui = 0; ui < uiNumBytes; ui++)
-    {
-      UInt uiByte;
-      read(8, uiByte);
-      buf.push_back(uiByte);
-    }
+    const UInt byteLocation = getByteLocation();
+    substream.m_view         = xGetData() + byteLocation;
+    substream.m_viewNumBytes = uiNumBits >> 3;
+
+    m_fifo_idx      = byteLocation + (uiNumBits >> 3);
+    m_held_bits     = 0;
+    m_num_held_bits = 0;
+    m_numBitsRead  += uiNumBits;
+    return;
   }
-  if (uiNumBits&0x7)
+
+  // the bits past the end of this bitstream are zero
+  std::vector<uint8_t> &buf = substream.m_fifo;
+  buf.reserve((uiNumBits+7)>>3);
+  for (UInt ui = 0; ui < uiNumBits; ui += 8)
   {
+    const UInt uiNumBitsInByte = std::min<UInt>(8, uiNumBits - ui);
+    const UInt uiNumBitsToRead = std::min<UInt>(uiNumBitsInByte, getNumBitsLeft());
     UInt uiByte = 0;
-    read(uiNumBits&0x7, uiByte);
-    uiByte <<= 8-(uiNumBits&0x7);
-    buf.push_back(uiByte);
+    read(uiNumBitsToRead, uiByte);
+    buf.push_back(uint8_t(uiByte << (8 - uiNumBitsToRead)));
   }
-  return pResult;
 }
 
 UInt TComInputBitstream::readByteAlignment()
@@ -409,4 +455,111 @@ UInt TComInputBitstream::readByteAlignment()
   return numBits+1;
 }
 
+// ====================================================================================================================
+// Start code and emulation prevention scanning
+// ====================================================================================================================
+
+static const uint8_t* xFindZeroZeroSequence( const uint8_t* begin, const uint8_t* end, UInt maxThirdByte )
+{
+  const uint8_t* p = begin;
+  while( end - p >= 3 )
+  {
+    if( p[2] > maxThirdByte )
+    {
+      // no sequence starts at p, nor at p + 1 or p + 2, which would need p[2] to be zero
+      p += 3;
+    }
+    else if( p[1] != 0 )
+    {
+      p += 2;
+    }
+    else if( p[0] != 0 )
+    {
+      p++;
+    }
+    else
+    {
+      return p;
+    }
+  }
+  return end;
+}
+
+#if VECTOR_CODING__BITSTREAM
+static inline UInt xCountTrailingZeros( UInt value )
+{
+#if defined(_MSC_VER)
+  unsigned long index;
+  _BitScanForward( &index, value );
+  return UInt( index );
+#else
+  return UInt( __builtin_ctz( value ) );
+#endif
+}
+
+static const uint8_t* xFindZeroZeroSequenceSSE2( const uint8_t* begin, const uint8_t* end, UInt maxThirdByte )
+{
+  const __m128i zero    = _mm_setzero_si128();
+  const __m128i maximum = _mm_set1_epi8( SChar( std::min<UInt>( maxThirdByte, 0xff ) ) );
+  const uint8_t* p = begin;
+  while( end - p >= 18 )
+  {
+    const __m128i byte0 = _mm_loadu_si128( ( const __m128i* )( p     ) );
+    const __m128i byte1 = _mm_loadu_si128( ( const __m128i* )( p + 1 ) );
+    const __m128i byte2 = _mm_loadu_si128( ( const __m128i* )( p + 2 ) );
+    const __m128i match = _mm_and_si128( _mm_and_si128( _mm_cmpeq_epi8( byte0, zero ), _mm_cmpeq_epi8( byte1, zero ) ),
+                                         _mm_cmpeq_epi8( _mm_min_epu8( byte2, maximum ), byte2 ) );
+    const UInt mask = UInt( _mm_movemask_epi8( match ) );
+    if( mask )
+    {
+      return p + xCountTrailingZeros( mask );
+    }
+    p += 16;
+  }
+  return xFindZeroZeroSequence( p, end, maxThirdByte );
+}
+
+#if VECTOR_CODING__AVX2
+SIMD_TARGET_AVX2
+static const uint8_t* xFindZeroZeroSequenceAVX2( const uint8_t* begin, const uint8_t* end, UInt maxThirdByte )
+{
+  const __m256i zero    = _mm256_setzero_si256();
+  const __m256i maximum = _mm256_set1_epi8( SChar( std::min<UInt>( maxThirdByte, 0xff ) ) );
+  const uint8_t* p = begin;
+  while( end - p >= 34 )
+  {
+    const __m256i byte0 = _mm256_loadu_si256( ( const __m256i* )( p     ) );
+    const __m256i byte1 = _mm256_loadu_si256( ( const __m256i* )( p + 1 ) );
+    const __m256i byte2 = _mm256_loadu_si256( ( const __m256i* )( p + 2 ) );
+    const __m256i match = _mm256_and_si256( _mm256_and_si256( _mm256_cmpeq_epi8( byte0, zero ), _mm256_cmpeq_epi8( byte1, zero ) ),
+                                            _mm256_cmpeq_epi8( _mm256_min_epu8( byte2, maximum ), byte2 ) );
+    const UInt mask = UInt( _mm256_movemask_epi8( match ) );
+    if( mask )
+    {
+      return p + xCountTrailingZeros( mask );
+    }
+    p += 32;
+  }
+  return xFindZeroZeroSequenceSSE2( p, end, maxThirdByte );
+}
+#endif
+#endif
+
+const uint8_t* findZeroZeroSequence( const uint8_t* begin, const uint8_t* end, UInt maxThirdByte )
+{
+#if VECTOR_CODING__BITSTREAM
+#if VECTOR_CODING__AVX2
+  if( getSIMDExtension( SIMD_KERNELS_BITSTREAM ) >= SIMD_AVX2 )
+  {
+    return xFindZeroZeroSequenceAVX2( begin, end, maxThirdByte );
+  }
+#endif
+  if( getSIMDExtension( SIMD_KERNELS_BITSTREAM ) >= SIMD_SSE2 )
+  {
+    return xFindZeroZeroSequenceSSE2( begin, end, maxThirdByte );
+  }
+#endif
+  return xFindZeroZeroSequence( begin, end, maxThirdByte );
+}
+
 //! \}
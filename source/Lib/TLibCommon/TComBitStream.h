@@ -70,6 +70,10 @@ public:
 /**
  * Model of a writable bitstream that accumulates bits to produce a
  * bytestream.
+ *
+ * The bits are accumulated in a 64-bit register, which is flushed to the
+ * FIFO eight bytes at a time. The functions that give access to the bytes
+ * first move the complete bytes held in the register to the FIFO.
  */
 class TComOutputBitstream : public TComBitIf
 {
@@ -82,9 +86,11 @@ class TComOutputBitstream : public TComBitIf
    */
   std::vector<uint8_t> m_fifo;
 
-  UInt m_num_held_bits; /// number of bits not flushed to bytestream.
-  UChar m_held_bits; /// the bits held and not flushed to bytestream.
-                             /// this value is always msb-aligned, bigendian.
+  UInt   m_num_held_bits; /// number of bits not flushed to bytestream (less than 64).
+  UInt64 m_held_bits;     /// the bits held and not flushed to bytestream.
+                          /// this value is lsb-aligned: the last written bit is the lsb, the bits above the held ones are zero.
+
+  Void xFlushBytes();     ///< moves the complete bytes held in m_held_bits to the FIFO
 public:
   // create / destroy
   TComOutputBitstream();
@@ -114,7 +120,7 @@ public:
    * NB, data is arranged such that subsequent bytes in the
    * bytestream are stored in ascending addresses.
    */
-  UChar* getByteStream() const;
+  UChar* getByteStream();
 
   /**
    * Return the number of valid bytes available from  getByteStream()
@@ -137,18 +143,19 @@ public:
    */
   UInt getNumberOfWrittenBits() const { return UInt(m_fifo.size()) * 8 + m_num_held_bits; }
 
-  Void insertAt(const TComOutputBitstream& src, UInt pos);
+  Void insertAt(TComOutputBitstream& src, UInt pos);
 
   /**
-   * Return a reference to the internal fifo
+   * Return a reference to the internal fifo, which holds all the complete bytes
    */
-  std::vector<uint8_t>& getFIFO() { return m_fifo; }
+  std::vector<uint8_t>& getFIFO() { xFlushBytes(); return m_fifo; }
 
-  UChar getHeldBits  ()          { return m_held_bits;          }
+  /**
+   * Return the bits of the incomplete last byte, msb-aligned
+   */
+  UChar getHeldBits  ()          { xFlushBytes(); return UChar( m_held_bits << ( 8 - m_num_held_bits ) ); }
 
   //TComOutputBitstream& operator= (const TComOutputBitstream& src);
-  /** Return a reference to the internal fifo */
-  const std::vector<uint8_t>& getFIFO() const { return m_fifo; }
 
   Void          addSubstream    ( TComOutputBitstream* pcSubstream );
   Void writeByteAlignment();
@@ -160,6 +167,12 @@ public:
 /**
  * Model of an input bitstream that extracts bits from a predefined
  * bytestream.
+ *
+ * The bits are read from a 64-bit cache, which is refilled with as many
+ * whole bytes as fit when a read needs more bits than it holds. The bytes
+ * are those of the fifo, or, for a substream extracted at a byte-aligned
+ * position, those of the bitstream it was extracted from, which must then
+ * outlive it.
  */
 class TComInputBitstream
 {
@@ -167,11 +180,18 @@ protected:
   std::vector<uint8_t> m_fifo; /// FIFO for storage of complete bytes
   std::vector<UInt>    m_emulationPreventionByteLocation;
 
-  UInt m_fifo_idx; /// Read index into m_fifo
+  const uint8_t* m_view;         ///< bytes read by a substream that refers to its parent bitstream, or NULL to read m_fifo
+  UInt           m_viewNumBytes; ///< number of bytes at m_view
+
+  UInt   m_fifo_idx;      ///< index of the next byte to load into m_held_bits
+  UInt64 m_held_bits;     ///< next bits of the bitstream, from the MSB; the bits below the held ones are zero
+  UInt   m_num_held_bits;
+  UInt   m_numBitsRead;
 
-  UInt m_num_held_bits;
-  UChar m_held_bits;
-  UInt  m_numBitsRead;
+  const uint8_t* xGetData    () const { return m_view != NULL ? m_view : m_fifo.data(); }
+  UInt           xGetNumBytes() const { return m_view != NULL ? m_viewNumBytes : UInt(m_fifo.size()); }
+
+  Void xRefill();
 
 public:
   /**
@@ -185,23 +205,37 @@ public:
 
   // interface for decoding
   Void        pseudoRead      ( UInt uiNumberOfBits, UInt& ruiBits );
-  Void        read            ( UInt uiNumberOfBits, UInt& ruiBits );
-  Void        readByte        ( UInt &ruiBits )
+
+  Void        read            ( UInt uiNumberOfBits, UInt& ruiBits )
   {
-    assert(m_fifo_idx < m_fifo.size());
-    ruiBits = m_fifo[m_fifo_idx++];
+    assert( uiNumberOfBits <= 32 );
+    if( uiNumberOfBits > m_num_held_bits )
+    {
+      xRefill();
+      assert( uiNumberOfBits <= m_num_held_bits );
+    }
+    m_numBitsRead += uiNumberOfBits;
+
+    // the first shift makes reading zero bits return zero without a branch
+    ruiBits = UInt( ( m_held_bits >> 1 ) >> ( 63 - uiNumberOfBits ) );
+    m_held_bits <<= uiNumberOfBits;
+    m_num_held_bits -= uiNumberOfBits;
   }
 
+  Void        readByte        ( UInt &ruiBits ) { read( 8, ruiBits ); }
+
   Void        peekPreviousByte( UInt &byte )
   {
-    assert(m_fifo_idx > 0);
-    byte = m_fifo[m_fifo_idx - 1];
+    assert(getByteLocation() > 0);
+    byte = xGetData()[getByteLocation() - 1];
   }
 
   UInt        readOutTrailingBits ();
-  UChar getHeldBits  ()          { return m_held_bits;          }
-  TComOutputBitstream& operator= (const TComOutputBitstream& src);
-  UInt  getByteLocation              ( )                     { return m_fifo_idx                    ; }
+
+  // bulk interface for the CABAC engine, which buffers whole bytes ahead of the syntax it decodes
+  UInt        readBytes       ( UInt uiMaxNumberOfBytes, UInt64& ruiBytes ); ///< reads up to 8 bytes, fewer at the end of the bitstream, into the low bytes of ruiBytes, and returns how many were read
+  Void        unreadBytes     ( UInt uiNumberOfBytes );                      ///< moves the read position back by whole bytes that were read but not used
+  UInt  getByteLocation              ( )                     { return m_fifo_idx - ( m_num_held_bits >> 3 ); }
 
   // Peek at bits in word-storage. Used in determining if we have completed reading of current bitstream and therefore slice in LCEC.
   UInt        peekBits (UInt uiBits) { UInt tmp; pseudoRead(uiBits, tmp); return tmp; }
@@ -210,8 +244,8 @@ public:
   UInt read(UInt numberOfBits) { UInt tmp; read(numberOfBits, tmp); return tmp; }
   UInt     readByte() { UInt tmp; readByte( tmp ); return tmp; }
   UInt getNumBitsUntilByteAligned() { return m_num_held_bits & (0x7); }
-  UInt getNumBitsLeft() { return 8*((UInt)m_fifo.size() - m_fifo_idx) + m_num_held_bits; }
-  TComInputBitstream *extractSubstream( UInt uiNumBits ); // Read the nominated number of bits, and return as a bitstream.
+  UInt getNumBitsLeft() { return 8*(xGetNumBytes() - m_fifo_idx) + m_num_held_bits; }
+  Void extractSubstream( UInt uiNumBits, TComInputBitstream& substream ); // Read the nominated number of bits into substream, which refers to the bytes of this bitstream when they are byte aligned.
   UInt  getNumBitsRead() { return m_numBitsRead; }
   UInt readByteAlignment();
 
@@ -226,6 +260,18 @@ public:
         std::vector<uint8_t> &getFifo()       { return m_fifo; }
 };
 
+// ====================================================================================================================
+// Function declarations
+// ====================================================================================================================
+
+/**
+ * Returns the position of the first byte-aligned three-byte sequence 0x0000xx, with xx <= maxThirdByte, that lies
+ * entirely within [begin, end), or end if there is none. With maxThirdByte equal to 1 this finds the start code
+ * prefixes and the ends of the NAL units of a byte stream, with 3 the sequences that need an emulation prevention
+ * byte.
+ */
+const uint8_t* findZeroZeroSequence( const uint8_t* begin, const uint8_t* end, UInt maxThirdByte );
+
 //! \}
 
 #endif
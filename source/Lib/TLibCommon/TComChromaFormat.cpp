@@ -131,31 +131,28 @@ Void getTUEntropyCodingParameters(      TUEntropyCodingParameters &result,
 
   //set the significance map context selection parameters
 
+  SignificanceMapContextType contextType;
+
   if (pcCU->getSlice()->getSPS()->getSpsRangeExtension().getTransformSkipContextEnabledFlag()
       && (pcCU->getCUTransquantBypass(uiAbsPartIdx) || (pcCU->getTransformSkip(uiAbsPartIdx, component) != 0)))
   {
-    result.firstSignificanceMapContext = significanceMapContextSetStart[channelType][CONTEXT_TYPE_SINGLE];
+    contextType = CONTEXT_TYPE_SINGLE;
+  }
+  else if ((area.width == 4) && (area.height == 4))
+  {
+    contextType = CONTEXT_TYPE_4x4;
+  }
+  else if ((area.width == 8) && (area.height == 8))
+  {
+    contextType = CONTEXT_TYPE_8x8;
   }
   else
   {
-    if ((area.width == 4) && (area.height == 4))
-    {
-      result.firstSignificanceMapContext = significanceMapContextSetStart[channelType][CONTEXT_TYPE_4x4];
-    }
-    else if ((area.width == 8) && (area.height == 8))
-    {
-      result.firstSignificanceMapContext = significanceMapContextSetStart[channelType][CONTEXT_TYPE_8x8];
-      if (result.scanType != SCAN_DIAG)
-      {
-        result.firstSignificanceMapContext += nonDiagonalScan8x8ContextOffset[channelType];
-      }
-    }
-    else
-    {
-      result.firstSignificanceMapContext = significanceMapContextSetStart[channelType][CONTEXT_TYPE_NxN];
-    }
+    contextType = CONTEXT_TYPE_NxN;
   }
 
+  result.sigCtxIncInGroup = &(g_sigCtxIncInGroup[channelType][contextType][result.scanType][0][0][0]);
+
   //------------------------------------------------
 }
 
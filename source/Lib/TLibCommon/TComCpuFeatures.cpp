@@ -0,0 +1,264 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TComCpuFeatures.cpp
+    \brief    run-time detection of the SIMD extensions of the processor
+*/
+
+#include "TComCpuFeatures.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#if defined(__i386__) || defined(__x86_64__) || defined(_M_IX86) || defined(_M_X64)
+#define CPU_FEATURES_X86 1
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#else
+#define CPU_FEATURES_X86 0
+#endif
+
+//! \ingroup TLibCommon
+//! \{
+
+#if CPU_FEATURES_X86
+static Void xCpuid( UInt leaf, UInt subLeaf, UInt regs[4] )
+{
+#if defined(_MSC_VER)
+  __cpuidex( (Int*)regs, leaf, subLeaf );
+#else
+  __cpuid_count( leaf, subLeaf, regs[0], regs[1], regs[2], regs[3] );
+#endif
+}
+
+/// register state enabled by the operating system (XCR0)
+static UInt64 xGetXCR0()
+{
+#if defined(_MSC_VER)
+  return _xgetbv( 0 );
+#else
+  UInt eax, edx;
+  __asm__ volatile( "xgetbv" : "=a"(eax), "=d"(edx) : "c"(0) );
+  return ( UInt64(edx) << 32 ) | eax;
+#endif
+}
+
+static SIMDExtension xDetectSIMDExtension()
+{
+  UInt regs[4]; // eax, ebx, ecx, edx
+
+  xCpuid( 0, 0, regs );
+  const UInt maxLeaf = regs[0];
+  if( maxLeaf < 1 )
+  {
+    return SIMD_NONE;
+  }
+
+  xCpuid( 1, 0, regs );
+  const UInt features1Ecx = regs[2];
+  const UInt features1Edx = regs[3];
+
+  if( !( features1Edx & ( 1 << 26 ) ) )
+  {
+    return SIMD_NONE;
+  }
+  if( !( features1Ecx & ( 1 << 19 ) ) )
+  {
+    return SIMD_SSE2;
+  }
+
+  // AVX state (XMM and YMM registers) must be saved by the operating system
+  const Bool osxsave = ( features1Ecx & ( 1 << 27 ) ) != 0;
+  const Bool avx     = ( features1Ecx & ( 1 << 28 ) ) != 0;
+  const UInt64 xcr0  = ( osxsave && avx ) ? xGetXCR0() : 0;
+  if( ( xcr0 & 0x06 ) != 0x06 || maxLeaf < 7 )
+  {
+    return SIMD_SSE41;
+  }
+
+  xCpuid( 7, 0, regs );
+  const UInt features7Ebx = regs[1];
+  if( !( features7Ebx & ( 1 << 5 ) ) )
+  {
+    return SIMD_SSE41;
+  }
+
+  // AVX-512 F and BW, with the opmask and ZMM state saved as well
+  if( ( xcr0 & 0xe6 ) == 0xe6 && ( features7Ebx & ( 1 << 16 ) ) && ( features7Ebx & ( 1 << 30 ) ) )
+  {
+    return SIMD_AVX512;
+  }
+  return SIMD_AVX2;
+}
+#endif
+
+static const TChar* const g_simdExtensionNames[NUMBER_OF_SIMD_EXTENSIONS] =
+{
+  "none", "sse2", "sse41", "avx2", "avx512"
+};
+
+static const TChar* const g_simdKernelGroupNames[NUMBER_OF_SIMD_KERNEL_GROUPS] =
+{
+  "distortion", "interpolation", "transform", "intra", "loopfilter", "sao", "yuv", "bitstream"
+};
+
+static Bool xParseSIMDExtension( const std::string& name, SIMDExtension& extension )
+{
+  for( Int ext = 0; ext < NUMBER_OF_SIMD_EXTENSIONS; ext++ )
+  {
+    if( name == g_simdExtensionNames[ext] )
+    {
+      extension = SIMDExtension( ext );
+      return true;
+    }
+  }
+  return false;
+}
+
+static Bool xParseSIMDKernelGroup( const std::string& name, SIMDKernelGroup& group )
+{
+  for( Int g = 0; g < NUMBER_OF_SIMD_KERNEL_GROUPS; g++ )
+  {
+    if( name == g_simdKernelGroupNames[g] )
+    {
+      group = SIMDKernelGroup( g );
+      return true;
+    }
+  }
+  return false;
+}
+
+#if CPU_FEATURES_X86
+static const SIMDExtension g_detectedSIMDExtension = xDetectSIMDExtension();
+#else
+static const SIMDExtension g_detectedSIMDExtension = SIMD_NONE;
+#endif
+
+SIMDExtension g_simdKernelExtensions[NUMBER_OF_SIMD_KERNEL_GROUPS];
+
+/// selects the detected extension for all groups, lowered by the HM_SIMD environment variable when it is set
+static Bool xInitSIMDKernelExtensions()
+{
+  setMaximumSIMDExtension( g_detectedSIMDExtension );
+
+  const TChar* setting = getenv( "HM_SIMD" );
+  if( setting != NULL && !parseSIMDExtensions( setting ) )
+  {
+    fprintf( stderr, "Warning: ignoring the invalid HM_SIMD setting \"%s\"\n", setting );
+  }
+  return true;
+}
+
+static const Bool g_simdKernelExtensionsInitialised = xInitSIMDKernelExtensions();
+
+SIMDExtension getDetectedSIMDExtension()
+{
+  return g_detectedSIMDExtension;
+}
+
+Void setMaximumSIMDExtension( SIMDExtension maximum )
+{
+  for( Int group = 0; group < NUMBER_OF_SIMD_KERNEL_GROUPS; group++ )
+  {
+    setMaximumSIMDExtension( SIMDKernelGroup( group ), maximum );
+  }
+}
+
+Void setMaximumSIMDExtension( SIMDKernelGroup group, SIMDExtension maximum )
+{
+  g_simdKernelExtensions[group] = std::min( g_detectedSIMDExtension, maximum );
+}
+
+Bool parseSIMDExtensions( const std::string& setting )
+{
+  SIMDExtension maximum[NUMBER_OF_SIMD_KERNEL_GROUPS];
+  for( Int group = 0; group < NUMBER_OF_SIMD_KERNEL_GROUPS; group++ )
+  {
+    maximum[group] = SIMDExtension( NUMBER_OF_SIMD_EXTENSIONS - 1 );
+  }
+
+  // the whole list is checked before any group is changed
+  size_t start = 0;
+  while( start <= setting.size() )
+  {
+    size_t end = setting.find( ',', start );
+    if( end == std::string::npos )
+    {
+      end = setting.size();
+    }
+    const std::string item   = setting.substr( start, end - start );
+    const size_t      equals = item.find( '=' );
+    SIMDExtension     extension;
+    if( equals == std::string::npos )
+    {
+      if( !xParseSIMDExtension( item, extension ) )
+      {
+        return false;
+      }
+      for( Int group = 0; group < NUMBER_OF_SIMD_KERNEL_GROUPS; group++ )
+      {
+        maximum[group] = extension;
+      }
+    }
+    else
+    {
+      SIMDKernelGroup group;
+      if( !xParseSIMDKernelGroup( item.substr( 0, equals ), group ) || !xParseSIMDExtension( item.substr( equals + 1 ), extension ) )
+      {
+        return false;
+      }
+      maximum[group] = extension;
+    }
+    start = end + 1;
+  }
+
+  for( Int group = 0; group < NUMBER_OF_SIMD_KERNEL_GROUPS; group++ )
+  {
+    setMaximumSIMDExtension( SIMDKernelGroup( group ), maximum[group] );
+  }
+  return true;
+}
+
+const TChar* getSIMDExtensionName( SIMDExtension extension )
+{
+  return g_simdExtensionNames[extension];
+}
+
+const TChar* getSIMDKernelGroupName( SIMDKernelGroup group )
+{
+  return g_simdKernelGroupNames[group];
+}
+
+//! \}
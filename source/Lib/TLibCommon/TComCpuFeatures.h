@@ -0,0 +1,133 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TComCpuFeatures.h
+    \brief    run-time detection of the SIMD extensions of the processor (header)
+*/
+
+#ifndef __TCOMCPUFEATURES__
+#define __TCOMCPUFEATURES__
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+#include "CommonDef.h"
+#include <string>
+
+//! \ingroup TLibCommon
+//! \{
+
+// ====================================================================================================================
+// Type definition
+// ====================================================================================================================
+
+/// SIMD instruction set extensions, in increasing order: each level includes the ones below it
+enum SIMDExtension
+{
+  SIMD_NONE   = 0,
+  SIMD_SSE2   = 1,
+  SIMD_SSE41  = 2,
+  SIMD_AVX2   = 3,
+  SIMD_AVX512 = 4,   ///< AVX-512 F and BW
+  NUMBER_OF_SIMD_EXTENSIONS = 5
+};
+
+/// groups of kernels whose SIMD extension is selected together
+enum SIMDKernelGroup
+{
+  SIMD_KERNELS_DISTORTION       = 0,   ///< SAD, SSE and Hadamard distortions (TComRdCost)
+  SIMD_KERNELS_INTERPOLATION    = 1,   ///< luma and chroma interpolation filters (TComInterpolationFilter)
+  SIMD_KERNELS_TRANSFORM        = 2,   ///< core forward and inverse transforms (TComTrQuant)
+  SIMD_KERNELS_INTRA_PREDICTION = 3,   ///< angular, planar and DC intra prediction (TComPrediction)
+  SIMD_KERNELS_LOOP_FILTER      = 4,   ///< deblocking filter (TComLoopFilter)
+  SIMD_KERNELS_SAO              = 5,   ///< SAO offsets and encoder SAO statistics
+  SIMD_KERNELS_YUV_OPERATIONS   = 6,   ///< residual, reconstruction and averaging (TComYuv) and weighted prediction
+  SIMD_KERNELS_BITSTREAM        = 7,   ///< start code and emulation prevention scanning (TComBitStream)
+  NUMBER_OF_SIMD_KERNEL_GROUPS  = 8
+};
+
+// ====================================================================================================================
+// Macros
+// ====================================================================================================================
+
+// functions using a SIMD extension that the whole build is not compiled for are tagged with these, and must only be
+// called when getSIMDExtension() reports the extension as available for their kernel group
+#if defined(__GNUC__) || defined(__clang__)
+#define SIMD_TARGET_SSE41   __attribute__((target("sse4.1")))
+#define SIMD_TARGET_AVX2    __attribute__((target("avx2")))
+#define SIMD_TARGET_AVX512  __attribute__((target("avx512f,avx512bw")))
+#else
+#define SIMD_TARGET_SSE41
+#define SIMD_TARGET_AVX2
+#define SIMD_TARGET_AVX512
+#endif
+
+// ====================================================================================================================
+// Function declarations
+// ====================================================================================================================
+
+/// SIMD extension supported by both the processor and the operating system (detected once, with cpuid)
+SIMDExtension getDetectedSIMDExtension();
+
+extern SIMDExtension g_simdKernelExtensions[NUMBER_OF_SIMD_KERNEL_GROUPS];
+
+/// highest SIMD extension that the kernels of the group may use: the detected one, unless lowered by the HM_SIMD
+/// environment variable (read at start-up, in the format of parseSIMDExtensions()), setMaximumSIMDExtension() or
+/// parseSIMDExtensions()
+inline SIMDExtension getSIMDExtension( SIMDKernelGroup group )
+{
+  return g_simdKernelExtensions[group];
+}
+
+/// restricts the kernels of all groups to the given extension and below, e.g. SIMD_NONE runs the C code, which
+/// allows comparing the outputs. Must be called before the encoder or decoder is initialised.
+Void setMaximumSIMDExtension( SIMDExtension maximum );
+
+/// restricts the kernels of one group to the given extension and below
+Void setMaximumSIMDExtension( SIMDKernelGroup group, SIMDExtension maximum );
+
+/** applies a comma separated list of maximum extensions, e.g. "sse41" or "avx2,sao=none,transform=sse2": an extension
+ *  alone applies to all groups, group=extension to one group, and the groups that are not listed use the detected
+ *  extension. The extensions are none, sse2, sse41, avx2 and avx512,
+ *  the groups distortion, interpolation, transform, intra, loopfilter, sao, yuv and bitstream.
+ *  \returns false, without changing the selection, if the list is not valid
+ */
+Bool parseSIMDExtensions( const std::string& setting );
+
+const TChar* getSIMDExtensionName( SIMDExtension extension );
+const TChar* getSIMDKernelGroupName( SIMDKernelGroup group );
+
+//! \}
+
+#endif // __TCOMCPUFEATURES__
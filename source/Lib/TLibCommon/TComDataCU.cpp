@@ -2907,7 +2907,7 @@ Bool TComDataCU::xAddMVPCandWithScaling( AMVPInfo &info, const RefPicList eRefPi
 
   const Int  currPOC            = m_pcSlice->getPOC();
   const Int  currRefPOC         = m_pcSlice->getRefPic( eRefPicList, iRefIdx)->getPOC();
-  const Bool bIsCurrRefLongTerm = m_pcSlice->getRefPic( eRefPicList, iRefIdx)->getIsLongTerm();
+  const Bool bIsCurrRefLongTerm = m_pcSlice->getIsUsedAsLongTerm( eRefPicList, iRefIdx);
   const Int  neibPOC            = currPOC;
 
   for(Int predictorSource=0; predictorSource<2; predictorSource++) // examine the indicated reference picture list, then if not available, examine the other list.
@@ -2916,7 +2916,7 @@ Bool TComDataCU::xAddMVPCandWithScaling( AMVPInfo &info, const RefPicList eRefPi
     const Int        neibRefIdx       = neibCU->getCUMvField(eRefPicListIndex)->getRefIdx(neibPUPartIdx);
     if( neibRefIdx >= 0)
     {
-      const Bool bIsNeibRefLongTerm = neibCU->getSlice()->getRefPic( eRefPicListIndex, neibRefIdx )->getIsLongTerm();
+      const Bool bIsNeibRefLongTerm = neibCU->getSlice()->getIsUsedAsLongTerm( eRefPicListIndex, neibRefIdx );
 
       if ( bIsCurrRefLongTerm == bIsNeibRefLongTerm )
       {
@@ -2954,6 +2954,8 @@ Bool TComDataCU::xGetColMVP( const RefPicList eRefPicList, const Int ctuRsAddr,
 
   // use coldir.
   const TComPic    * const pColPic = getSlice()->getRefPic( RefPicList(getSlice()->isInterB() ? 1-getSlice()->getColFromL0Flag() : 0), getSlice()->getColRefIdx());
+  // the collocated picture may still be reconstructed by another thread (frame-parallel encoding or decoding).
+  pColPic->waitForReconRows( ctuRsAddr / pColPic->getFrameWidthInCtus() + 1 );
 #if REDUCED_ENCODER_MEMORY
   if (!pColPic->getPicSym()->hasDPBPerCtuData())
   {
@@ -3001,7 +3003,7 @@ Bool TComDataCU::xGetColMVP( const RefPicList eRefPicList, const Int ctuRsAddr,
     }
   }
 
-  const Bool bIsCurrRefLongTerm = m_pcSlice->getRefPic(eRefPicList, refIdx)->getIsLongTerm();
+  const Bool bIsCurrRefLongTerm = m_pcSlice->getIsUsedAsLongTerm(eRefPicList, refIdx);
 #if REDUCED_ENCODER_MEMORY
   const Bool bIsColRefLongTerm  = pColSlice->getIsUsedAsLongTerm(eColRefPicList, iColRefIdx);
 #else
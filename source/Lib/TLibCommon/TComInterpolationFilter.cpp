@@ -48,6 +48,11 @@
 
 #if VECTOR_CODING__INTERPOLATION_FILTER && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
 #include <emmintrin.h>
+#include "TComCpuFeatures.h"
+#endif
+#if VECTOR_CODING__INTERPOLATION_FILTER && VECTOR_CODING__AVX2
+#include <immintrin.h>
+#include "TComCpuFeatures.h"
 #endif
 
 //! \ingroup TLibCommon
@@ -178,6 +183,344 @@ inline __m128i simdClip3( __m128i mmMin , __m128i mmMax , __m128i mmPix )
 }
 #endif
 
+#if VECTOR_CODING__INTERPOLATION_FILTER && VECTOR_CODING__AVX2
+// ====================================================================================================================
+// AVX2 interpolation
+// ====================================================================================================================
+
+// A column strip of a block is filtered with vectors of numSamples samples, the filtered samples being computed in
+// 32 bits as in the C code. Without RExt__HIGH_BIT_DEPTH_SUPPORT, the 16-bit samples are multiplied by pairs of taps
+// with _mm256_madd_epi16 (the results fit in 16 bits for bit depths up to 12); with it, the 32-bit samples are
+// multiplied by each tap with _mm256_mullo_epi32.
+
+#if RExt__HIGH_BIT_DEPTH_SUPPORT==0
+/// number of coefficient vectors of an N-tap filter: pairs of 16-bit taps in 32-bit lanes
+#define SIMD_IF_NUM_COEFF_VECS(N) ((N)/2)
+
+SIMD_TARGET_AVX2 static inline Void simdIFMultiplyAdd( const __m256i a, const __m256i b, const __m256i coeffPair, __m256i& sumLo, __m256i& sumHi )
+{
+  sumLo = _mm256_add_epi32( sumLo, _mm256_madd_epi16( _mm256_unpacklo_epi16( a, b ), coeffPair ) );
+  sumHi = _mm256_add_epi32( sumHi, _mm256_madd_epi16( _mm256_unpackhi_epi16( a, b ), coeffPair ) );
+}
+SIMD_TARGET_AVX2 static inline Void simdIFMultiplyAdd( const __m128i a, const __m128i b, const __m128i coeffPair, __m128i& sumLo, __m128i& sumHi )
+{
+  sumLo = _mm_add_epi32( sumLo, _mm_madd_epi16( _mm_unpacklo_epi16( a, b ), coeffPair ) );
+  sumHi = _mm_add_epi32( sumHi, _mm_madd_epi16( _mm_unpackhi_epi16( a, b ), coeffPair ) );
+}
+SIMD_TARGET_AVX2 static inline __m256i simdIFRound( const __m256i sumLo, const __m256i sumHi, const __m128i shift ) { return _mm256_packs_epi32( _mm256_sra_epi32( sumLo, shift ), _mm256_sra_epi32( sumHi, shift ) ); }
+SIMD_TARGET_AVX2 static inline __m128i simdIFRound( const __m128i sumLo, const __m128i sumHi, const __m128i shift ) { return _mm_packs_epi32( _mm_sra_epi32( sumLo, shift ), _mm_sra_epi32( sumHi, shift ) ); }
+SIMD_TARGET_AVX2 static inline __m256i simdIFClip( const __m256i v, const __m256i maxVal ) { return _mm256_min_epi16( _mm256_max_epi16( v, _mm256_setzero_si256() ), maxVal ); }
+SIMD_TARGET_AVX2 static inline __m128i simdIFClip( const __m128i v, const __m128i maxVal ) { return _mm_min_epi16( _mm_max_epi16( v, _mm_setzero_si128() ), maxVal ); }
+
+/// filtered samples of the N vectors of samples taps[]
+template<Int N, typename Vec>
+SIMD_TARGET_AVX2
+static inline Vec simdIFFilter( const Vec* taps, const Vec* coeffs, const Vec offset, const __m128i shift )
+{
+  Vec sumLo = offset;
+  Vec sumHi = offset;
+  for( Int k = 0; k < N/2; k++ )
+  {
+    simdIFMultiplyAdd( taps[2*k], taps[2*k+1], coeffs[k], sumLo, sumHi );
+  }
+  return simdIFRound( sumLo, sumHi, shift );
+}
+
+/// 16, 8 and 4 samples of 16 bits
+struct SimdIF16x16 { typedef __m256i Vec; static const Int numSamples = 16;
+  SIMD_TARGET_AVX2 static inline Vec  load ( const Pel* src )          { return _mm256_loadu_si256( ( const __m256i* )src ); }
+  SIMD_TARGET_AVX2 static inline Void store( Pel* dst, const Vec v )   { _mm256_storeu_si256( ( __m256i* )dst, v ); }
+  SIMD_TARGET_AVX2 static inline Vec  set32( Int v )                   { return _mm256_set1_epi32( v ); }
+  SIMD_TARGET_AVX2 static inline Vec  setPel( Int v )                  { return _mm256_set1_epi16( v ); } };
+struct SimdIF16x8  { typedef __m128i Vec; static const Int numSamples = 8;
+  SIMD_TARGET_AVX2 static inline Vec  load ( const Pel* src )          { return _mm_loadu_si128( ( const __m128i* )src ); }
+  SIMD_TARGET_AVX2 static inline Void store( Pel* dst, const Vec v )   { _mm_storeu_si128( ( __m128i* )dst, v ); }
+  SIMD_TARGET_AVX2 static inline Vec  set32( Int v )                   { return _mm_set1_epi32( v ); }
+  SIMD_TARGET_AVX2 static inline Vec  setPel( Int v )                  { return _mm_set1_epi16( v ); } };
+struct SimdIF16x4  { typedef __m128i Vec; static const Int numSamples = 4;
+  SIMD_TARGET_AVX2 static inline Vec  load ( const Pel* src )          { return _mm_loadl_epi64( ( const __m128i* )src ); }
+  SIMD_TARGET_AVX2 static inline Void store( Pel* dst, const Vec v )   { _mm_storel_epi64( ( __m128i* )dst, v ); }
+  SIMD_TARGET_AVX2 static inline Vec  set32( Int v )                   { return _mm_set1_epi32( v ); }
+  SIMD_TARGET_AVX2 static inline Vec  setPel( Int v )                  { return _mm_set1_epi16( v ); } };
+
+template<typename T, Int N>
+SIMD_TARGET_AVX2
+static inline Void simdIFSetCoeffs( typename T::Vec* coeffs, const TFilterCoeff* c )
+{
+  for( Int k = 0; k < N/2; k++ )
+  {
+    coeffs[k] = T::set32( Int( ( UInt( c[2*k] ) & 0xffff ) | ( UInt( c[2*k+1] ) << 16 ) ) );
+  }
+}
+
+typedef SimdIF16x16 SimdIFWide;
+typedef SimdIF16x8  SimdIFMedium;
+typedef SimdIF16x4  SimdIFNarrow;
+#else
+/// number of coefficient vectors of an N-tap filter: one tap in each 32-bit lane
+#define SIMD_IF_NUM_COEFF_VECS(N) (N)
+
+SIMD_TARGET_AVX2 static inline __m256i simdIFMultiplyAdd( const __m256i sum, const __m256i a, const __m256i coeff ) { return _mm256_add_epi32( sum, _mm256_mullo_epi32( a, coeff ) ); }
+SIMD_TARGET_AVX2 static inline __m128i simdIFMultiplyAdd( const __m128i sum, const __m128i a, const __m128i coeff ) { return _mm_add_epi32( sum, _mm_mullo_epi32( a, coeff ) ); }
+SIMD_TARGET_AVX2 static inline __m256i simdIFRound( const __m256i sum, const __m128i shift ) { return _mm256_sra_epi32( sum, shift ); }
+SIMD_TARGET_AVX2 static inline __m128i simdIFRound( const __m128i sum, const __m128i shift ) { return _mm_sra_epi32( sum, shift ); }
+SIMD_TARGET_AVX2 static inline __m256i simdIFClip( const __m256i v, const __m256i maxVal ) { return _mm256_min_epi32( _mm256_max_epi32( v, _mm256_setzero_si256() ), maxVal ); }
+SIMD_TARGET_AVX2 static inline __m128i simdIFClip( const __m128i v, const __m128i maxVal ) { return _mm_min_epi32( _mm_max_epi32( v, _mm_setzero_si128() ), maxVal ); }
+
+/// filtered samples of the N vectors of samples taps[]
+template<Int N, typename Vec>
+SIMD_TARGET_AVX2
+static inline Vec simdIFFilter( const Vec* taps, const Vec* coeffs, const Vec offset, const __m128i shift )
+{
+  Vec sum = offset;
+  for( Int k = 0; k < N; k++ )
+  {
+    sum = simdIFMultiplyAdd( sum, taps[k], coeffs[k] );
+  }
+  return simdIFRound( sum, shift );
+}
+
+/// 8 and 4 samples of 32 bits
+struct SimdIF32x8 { typedef __m256i Vec; static const Int numSamples = 8;
+  SIMD_TARGET_AVX2 static inline Vec  load ( const Pel* src )          { return _mm256_loadu_si256( ( const __m256i* )src ); }
+  SIMD_TARGET_AVX2 static inline Void store( Pel* dst, const Vec v )   { _mm256_storeu_si256( ( __m256i* )dst, v ); }
+  SIMD_TARGET_AVX2 static inline Vec  set32( Int v )                   { return _mm256_set1_epi32( v ); }
+  SIMD_TARGET_AVX2 static inline Vec  setPel( Int v )                  { return _mm256_set1_epi32( v ); } };
+struct SimdIF32x4 { typedef __m128i Vec; static const Int numSamples = 4;
+  SIMD_TARGET_AVX2 static inline Vec  load ( const Pel* src )          { return _mm_loadu_si128( ( const __m128i* )src ); }
+  SIMD_TARGET_AVX2 static inline Void store( Pel* dst, const Vec v )   { _mm_storeu_si128( ( __m128i* )dst, v ); }
+  SIMD_TARGET_AVX2 static inline Vec  set32( Int v )                   { return _mm_set1_epi32( v ); }
+  SIMD_TARGET_AVX2 static inline Vec  setPel( Int v )                  { return _mm_set1_epi32( v ); } };
+
+template<typename T, Int N>
+SIMD_TARGET_AVX2
+static inline Void simdIFSetCoeffs( typename T::Vec* coeffs, const TFilterCoeff* c )
+{
+  for( Int k = 0; k < N; k++ )
+  {
+    coeffs[k] = T::set32( c[k] );
+  }
+}
+
+typedef SimdIF32x8 SimdIFWide;
+typedef SimdIF32x4 SimdIFMedium;
+typedef SimdIF32x4 SimdIFNarrow;
+#endif
+
+/// rounding of a filtering pass: (sum + offset) >> shift, clipped to [0, maxVal] in the last pass
+struct SimdIFRounding
+{
+  Int offset;
+  Int shift;
+  Pel maxVal;
+};
+
+/// C code of a filtering pass, for the columns [startCol, width) of a block
+template<Int N, Bool isLast>
+static Void simdIFFilterColumnsC( const Pel* src, Int srcStride, Int cStride, Pel* dst, Int dstStride, Int startCol, Int width, Int height, const TFilterCoeff* c, const SimdIFRounding& r )
+{
+  for( Int row = 0; row < height; row++, src += srcStride, dst += dstStride )
+  {
+    for( Int col = startCol; col < width; col++ )
+    {
+      Int sum = 0;
+      for( Int k = 0; k < N; k++ )
+      {
+        sum += src[col + k * cStride] * c[k];
+      }
+      Pel val = ( sum + r.offset ) >> r.shift;
+      if( isLast )
+      {
+        val = Clip3<Pel>( 0, r.maxVal, val );
+      }
+      dst[col] = val;
+    }
+  }
+}
+
+/// filtering pass of a column strip of T::numSamples samples (src: first tap of the first sample)
+template<typename T, Int N, Bool isLast>
+SIMD_TARGET_AVX2
+static Void simdIFFilterStripAVX2( const Pel* src, Int srcStride, Int cStride, Pel* dst, Int dstStride, Int height, const TFilterCoeff* c, const SimdIFRounding& r )
+{
+  typedef typename T::Vec Vec;
+  Vec coeffs[SIMD_IF_NUM_COEFF_VECS(N)];
+  simdIFSetCoeffs<T, N>( coeffs, c );
+  const Vec     offset = T::set32( r.offset );
+  const Vec     maxVal = T::setPel( r.maxVal );
+  const __m128i shift  = _mm_cvtsi32_si128( r.shift );
+
+  for( Int row = 0; row < height; row++, src += srcStride, dst += dstStride )
+  {
+    Vec taps[N];
+    for( Int k = 0; k < N; k++ )
+    {
+      taps[k] = T::load( src + k * cStride );
+    }
+    Vec filtered = simdIFFilter<N>( taps, coeffs, offset, shift );
+    if( isLast )
+    {
+      filtered = simdIFClip( filtered, maxVal );
+    }
+    T::store( dst, filtered );
+  }
+}
+
+/// filtering pass of a block, as TComInterpolationFilter::filter() (src: first tap of the first sample)
+template<Int N, Bool isLast>
+SIMD_TARGET_AVX2
+static Void simdIFFilterAVX2( const Pel* src, Int srcStride, Int cStride, Pel* dst, Int dstStride, Int width, Int height, const TFilterCoeff* c, const SimdIFRounding& r )
+{
+  Int col = 0;
+  for( ; col + SimdIFWide::numSamples <= width; col += SimdIFWide::numSamples )
+  {
+    simdIFFilterStripAVX2<SimdIFWide, N, isLast>( src + col, srcStride, cStride, dst + col, dstStride, height, c, r );
+  }
+  if( col + SimdIFMedium::numSamples <= width )
+  {
+    simdIFFilterStripAVX2<SimdIFMedium, N, isLast>( src + col, srcStride, cStride, dst + col, dstStride, height, c, r );
+    col += SimdIFMedium::numSamples;
+  }
+  if( col + SimdIFNarrow::numSamples <= width )
+  {
+    simdIFFilterStripAVX2<SimdIFNarrow, N, isLast>( src + col, srcStride, cStride, dst + col, dstStride, height, c, r );
+    col += SimdIFNarrow::numSamples;
+  }
+  simdIFFilterColumnsC<N, isLast>( src, srcStride, cStride, dst, dstStride, col, width, height, c, r );
+}
+
+/// horizontally filtered samples of a line of a column strip (src: first tap of the first sample)
+template<typename T, Int N>
+SIMD_TARGET_AVX2
+static inline typename T::Vec simdIFFilterLineAVX2( const Pel* src, const typename T::Vec* coeffs, const typename T::Vec offset, const __m128i shift )
+{
+  typename T::Vec taps[N];
+  for( Int k = 0; k < N; k++ )
+  {
+    taps[k] = T::load( src + k );
+  }
+  return simdIFFilter<N>( taps, coeffs, offset, shift );
+}
+
+/** horizontal then vertical filtering of a column strip of T::numSamples samples, without storing the horizontally
+ *  filtered samples: the NV last lines of them are kept in registers (src: first horizontal tap of the first vertical tap)
+ */
+template<typename T, Int NH, Int NV, Bool isLast>
+SIMD_TARGET_AVX2
+static Void simdIFFilterHorVerStripAVX2( const Pel* src, Int srcStride, Pel* dst, Int dstStride, Int height, const TFilterCoeff* cH, const TFilterCoeff* cV
+                                       , const SimdIFRounding& rH, const SimdIFRounding& rV )
+{
+  typedef typename T::Vec Vec;
+  Vec coeffsH[SIMD_IF_NUM_COEFF_VECS(NH)];
+  Vec coeffsV[SIMD_IF_NUM_COEFF_VECS(NV)];
+  simdIFSetCoeffs<T, NH>( coeffsH, cH );
+  simdIFSetCoeffs<T, NV>( coeffsV, cV );
+  const Vec     offsetH = T::set32( rH.offset );
+  const Vec     offsetV = T::set32( rV.offset );
+  const Vec     maxVal  = T::setPel( rV.maxVal );
+  const __m128i shiftH  = _mm_cvtsi32_si128( rH.shift );
+  const __m128i shiftV  = _mm_cvtsi32_si128( rV.shift );
+
+  Vec lines[NV];
+  for( Int k = 0; k < NV - 1; k++, src += srcStride )
+  {
+    lines[k] = simdIFFilterLineAVX2<T, NH>( src, coeffsH, offsetH, shiftH );
+  }
+  for( Int row = 0; row < height; row++, src += srcStride, dst += dstStride )
+  {
+    lines[NV - 1] = simdIFFilterLineAVX2<T, NH>( src, coeffsH, offsetH, shiftH );
+
+    Vec filtered = simdIFFilter<NV>( lines, coeffsV, offsetV, shiftV );
+    if( isLast )
+    {
+      filtered = simdIFClip( filtered, maxVal );
+    }
+    T::store( dst, filtered );
+
+    for( Int k = 0; k < NV - 1; k++ )
+    {
+      lines[k] = lines[k + 1];
+    }
+  }
+}
+
+/// C code of the horizontal then vertical filtering, for the columns [startCol, width) of a block
+template<Int NH, Int NV, Bool isLast>
+static Void simdIFFilterHorVerColumnsC( const Pel* src, Int srcStride, Pel* dst, Int dstStride, Int startCol, Int width, Int height, const TFilterCoeff* cH, const TFilterCoeff* cV
+                                      , const SimdIFRounding& rH, const SimdIFRounding& rV )
+{
+  for( Int col = startCol; col < width; col++ )
+  {
+    Pel lines[NV];
+    const Pel* srcCol = src + col;
+    for( Int row = 0; row < height + NV - 1; row++, srcCol += srcStride )
+    {
+      Int sum = 0;
+      for( Int k = 0; k < NH; k++ )
+      {
+        sum += srcCol[k] * cH[k];
+      }
+      lines[std::min( row, NV - 1 )] = ( sum + rH.offset ) >> rH.shift;
+
+      if( row >= NV - 1 )
+      {
+        sum = 0;
+        for( Int k = 0; k < NV; k++ )
+        {
+          sum += lines[k] * cV[k];
+        }
+        Pel val = ( sum + rV.offset ) >> rV.shift;
+        if( isLast )
+        {
+          val = Clip3<Pel>( 0, rV.maxVal, val );
+        }
+        dst[( row - ( NV - 1 ) ) * dstStride + col] = val;
+
+        for( Int k = 0; k < NV - 1; k++ )
+        {
+          lines[k] = lines[k + 1];
+        }
+      }
+    }
+  }
+}
+
+/// horizontal then vertical filtering of a block, as filterHor() and filterVer() (src: first taps of the first sample)
+template<Int NH, Int NV, Bool isLast>
+SIMD_TARGET_AVX2
+static Void simdIFFilterHorVerAVX2( const Pel* src, Int srcStride, Pel* dst, Int dstStride, Int width, Int height, const TFilterCoeff* cH, const TFilterCoeff* cV
+                                  , const SimdIFRounding& rH, const SimdIFRounding& rV )
+{
+  Int col = 0;
+  for( ; col + SimdIFWide::numSamples <= width; col += SimdIFWide::numSamples )
+  {
+    simdIFFilterHorVerStripAVX2<SimdIFWide, NH, NV, isLast>( src + col, srcStride, dst + col, dstStride, height, cH, cV, rH, rV );
+  }
+  if( col + SimdIFMedium::numSamples <= width )
+  {
+    simdIFFilterHorVerStripAVX2<SimdIFMedium, NH, NV, isLast>( src + col, srcStride, dst + col, dstStride, height, cH, cV, rH, rV );
+    col += SimdIFMedium::numSamples;
+  }
+  if( col + SimdIFNarrow::numSamples <= width )
+  {
+    simdIFFilterHorVerStripAVX2<SimdIFNarrow, NH, NV, isLast>( src + col, srcStride, dst + col, dstStride, height, cH, cV, rH, rV );
+    col += SimdIFNarrow::numSamples;
+  }
+
+  simdIFFilterHorVerColumnsC<NH, NV, isLast>( src, srcStride, dst, dstStride, col, width, height, cH, cV, rH, rV );
+}
+
+/// whether the AVX2 filters, which compute 16-bit samples with saturation, give the same output as the C code
+static inline Bool simdIFUseAVX2( Int bitDepth )
+{
+#if RExt__HIGH_BIT_DEPTH_SUPPORT
+  return getSIMDExtension( SIMD_KERNELS_INTERPOLATION ) >= SIMD_AVX2;
+#else
+  return bitDepth <= 12 && getSIMDExtension( SIMD_KERNELS_INTERPOLATION ) >= SIMD_AVX2;
+#endif
+}
+#endif
+
 // ====================================================================================================================
 // Private member functions
 // ====================================================================================================================
@@ -322,8 +665,17 @@ Void TComInterpolationFilter::filter(Int bitDepth, Pel const *src, Int srcStride
     maxVal = 0;
   }
 
+#if VECTOR_CODING__INTERPOLATION_FILTER && VECTOR_CODING__AVX2
+  if( simdIFUseAVX2( bitDepth ) )
+  {
+    const SimdIFRounding rounding = { offset, shift, maxVal };
+    simdIFFilterAVX2<N, isLast>( src, srcStride, cStride, dst, dstStride, width, height, coeff, rounding );
+    return;
+  }
+#endif
+
 #if VECTOR_CODING__INTERPOLATION_FILTER && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
-  if( bitDepth <= 10 )
+  if( bitDepth <= 10 && getSIMDExtension( SIMD_KERNELS_INTERPOLATION ) >= SIMD_SSE2 )
   {
     if( N == 8 && !( width & 0x07 ) )
     {
@@ -628,4 +980,91 @@ Void TComInterpolationFilter::filterVer(const ComponentID compID, Pel *src, Int
   }
 }
 
+/**
+ * \brief Filter a block of Luma/Chroma samples horizontally, then vertically
+ *
+ * \param  compID     Colour component ID
+ * \param  src        Pointer to source samples
+ * \param  srcStride  Stride of source samples
+ * \param  tmp        Pointer to a buffer of (height + number of taps - 1) lines for the horizontally filtered samples
+ * \param  tmpStride  Stride of the buffer
+ * \param  dst        Pointer to destination samples
+ * \param  dstStride  Stride of destination samples
+ * \param  width      Width of block
+ * \param  height     Height of block
+ * \param  fracX      Horizontal fractional sample offset
+ * \param  fracY      Vertical fractional sample offset
+ * \param  isLast     Flag indicating whether it is the last filtering operation
+ * \param  fmt        Chroma format
+ * \param  bitDepth   Bit depth
+ *
+ * \note Same output as filterHor() followed by filterVer(). The buffer is not used when the two filters are fused.
+ */
+Void TComInterpolationFilter::filterHorVer(const ComponentID compID, Pel *src, Int srcStride, Pel *tmp, Int tmpStride, Pel *dst, Int dstStride, Int width, Int height, Int fracX, Int fracY, Bool isLast, const ChromaFormat fmt, const Int bitDepth )
+{
+  const Int filterSize = isLuma(compID) ? NTAPS_LUMA : NTAPS_CHROMA;
+
+#if VECTOR_CODING__INTERPOLATION_FILTER && VECTOR_CODING__AVX2
+  if( simdIFUseAVX2( bitDepth ) )
+  {
+    const TFilterCoeff *coeffH, *coeffV;
+    if (isLuma(compID))
+    {
+      assert(fracX >= 0 && fracX < LUMA_INTERPOLATION_FILTER_SUB_SAMPLE_POSITIONS);
+      assert(fracY >= 0 && fracY < LUMA_INTERPOLATION_FILTER_SUB_SAMPLE_POSITIONS);
+      coeffH = m_lumaFilter[fracX];
+      coeffV = m_lumaFilter[fracY];
+    }
+    else
+    {
+      const UInt csx = getComponentScaleX(compID, fmt);
+      const UInt csy = getComponentScaleY(compID, fmt);
+      assert(fracX >=0 && csx<2 && (fracX<<(1-csx)) < CHROMA_INTERPOLATION_FILTER_SUB_SAMPLE_POSITIONS);
+      assert(fracY >=0 && csy<2 && (fracY<<(1-csy)) < CHROMA_INTERPOLATION_FILTER_SUB_SAMPLE_POSITIONS);
+      coeffH = m_chromaFilter[fracX<<(1-csx)];
+      coeffV = m_chromaFilter[fracY<<(1-csy)];
+    }
+
+    // rounding of filter<N, false, true, false> and of filter<N, true, false, isLast>
+    const Int headRoom = std::max<Int>(2, (IF_INTERNAL_PREC - bitDepth));
+    const SimdIFRounding roundingH = { -IF_INTERNAL_OFFS << (IF_FILTER_PREC - headRoom), IF_FILTER_PREC - headRoom, 0 };
+    SimdIFRounding       roundingV = { 0, IF_FILTER_PREC, 0 };
+    if (isLast)
+    {
+      roundingV.shift  = IF_FILTER_PREC + headRoom;
+      roundingV.offset = (1 << (roundingV.shift - 1)) + (IF_INTERNAL_OFFS << IF_FILTER_PREC);
+      roundingV.maxVal = (1 << bitDepth) - 1;
+    }
+
+    const Pel* srcFirstTap = src - ((filterSize>>1) - 1) * (srcStride + 1);
+    if (isLuma(compID))
+    {
+      if (isLast)
+      {
+        simdIFFilterHorVerAVX2<NTAPS_LUMA, NTAPS_LUMA, true >(srcFirstTap, srcStride, dst, dstStride, width, height, coeffH, coeffV, roundingH, roundingV);
+      }
+      else
+      {
+        simdIFFilterHorVerAVX2<NTAPS_LUMA, NTAPS_LUMA, false>(srcFirstTap, srcStride, dst, dstStride, width, height, coeffH, coeffV, roundingH, roundingV);
+      }
+    }
+    else
+    {
+      if (isLast)
+      {
+        simdIFFilterHorVerAVX2<NTAPS_CHROMA, NTAPS_CHROMA, true >(srcFirstTap, srcStride, dst, dstStride, width, height, coeffH, coeffV, roundingH, roundingV);
+      }
+      else
+      {
+        simdIFFilterHorVerAVX2<NTAPS_CHROMA, NTAPS_CHROMA, false>(srcFirstTap, srcStride, dst, dstStride, width, height, coeffH, coeffV, roundingH, roundingV);
+      }
+    }
+    return;
+  }
+#endif
+
+  filterHor(compID, src - ((filterSize>>1) -1)*srcStride, srcStride, tmp, tmpStride, width, height+filterSize-1, fracX, false,         fmt, bitDepth);
+  filterVer(compID, tmp + ((filterSize>>1) -1)*tmpStride, tmpStride, dst, dstStride, width, height,              fracY, false, isLast, fmt, bitDepth);
+}
+
 //! \}
@@ -74,6 +74,7 @@ public:
 
   Void filterHor(const ComponentID compID, Pel *src, Int srcStride, Pel *dst, Int dstStride, Int width, Int height, Int frac,               Bool isLast, const ChromaFormat fmt, const Int bitDepth );
   Void filterVer(const ComponentID compID, Pel *src, Int srcStride, Pel *dst, Int dstStride, Int width, Int height, Int frac, Bool isFirst, Bool isLast, const ChromaFormat fmt, const Int bitDepth );
+  Void filterHorVer(const ComponentID compID, Pel *src, Int srcStride, Pel *tmp, Int tmpStride, Pel *dst, Int dstStride, Int width, Int height, Int fracX, Int fracY, Bool isLast, const ChromaFormat fmt, const Int bitDepth );
 };
 
 //! \}
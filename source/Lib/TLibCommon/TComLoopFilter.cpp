@@ -39,6 +39,12 @@
 #include "TComSlice.h"
 #include "TComMv.h"
 #include "TComTU.h"
+#include "TComProfiler.h"
+
+#if VECTOR_CODING__DEBLOCKING_FILTER && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+#include <smmintrin.h>
+#include "TComCpuFeatures.h"
+#endif
 
 //! \ingroup TLibCommon
 //! \{
@@ -66,6 +72,239 @@ const UChar TComLoopFilter::sm_betaTable[MAX_QP + 1] =
   0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,6,7,8,9,10,11,12,13,14,15,16,17,18,20,22,24,26,28,30,32,34,36,38,40,42,44,46,48,50,52,54,56,58,60,62,64
 };
 
+#if VECTOR_CODING__DEBLOCKING_FILTER && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+// ====================================================================================================================
+// SSE4.1 deblocking
+// ====================================================================================================================
+
+// The samples across an edge are held in 32-bit lanes, one lane per line of the segment: m[k] holds sample k of the
+// four lines (k = 0..3 on the P side, 4..7 on the Q side, as in xPelFilterLuma).
+
+/// loads the samples piSrc[(k-4)*iOffset] (k = firstSample..firstSample+numSamples-1) of numLines lines (2 or 4,
+/// iSrcStep apart); the lanes of missing lines are set to zero
+SIMD_TARGET_SSE41
+static inline Void simdDeblockLoadSSE41( const Pel* piSrc, Int iOffset, Int iSrcStep, Int numLines, Int firstSample, Int numSamples, __m128i *m )
+{
+  if( iOffset == 1 ) // vertical edge: the lines are rows, transpose them
+  {
+    __m128i r[4];
+    for( Int l = 0; l < 4; l++ )
+    {
+      r[l] = ( l >= numLines )   ? _mm_setzero_si128() :
+             ( numSamples == 8 ) ? _mm_loadu_si128( ( const __m128i* )( piSrc + l * iSrcStep + firstSample - 4 ) )
+                                 : _mm_loadl_epi64( ( const __m128i* )( piSrc + l * iSrcStep + firstSample - 4 ) );
+    }
+    const __m128i t0 = _mm_unpacklo_epi16( r[0], r[1] );
+    const __m128i t1 = _mm_unpacklo_epi16( r[2], r[3] );
+    const __m128i t2 = _mm_unpackhi_epi16( r[0], r[1] );
+    const __m128i t3 = _mm_unpackhi_epi16( r[2], r[3] );
+    const __m128i u[4] = { _mm_unpacklo_epi32( t0, t1 ), _mm_unpackhi_epi32( t0, t1 ), _mm_unpacklo_epi32( t2, t3 ), _mm_unpackhi_epi32( t2, t3 ) };
+    for( Int k = 0; k < numSamples; k += 2 )
+    {
+      m[firstSample + k]     = _mm_cvtepi16_epi32( u[k >> 1] );
+      m[firstSample + k + 1] = _mm_cvtepi16_epi32( _mm_srli_si128( u[k >> 1], 8 ) );
+    }
+  }
+  else // horizontal edge: the lines are columns
+  {
+    for( Int k = firstSample; k < firstSample + numSamples; k++ )
+    {
+      if( numLines == 4 )
+      {
+        m[k] = _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* )( piSrc + ( k - 4 ) * iOffset ) ) );
+      }
+      else
+      {
+        Int pair;
+        memcpy( &pair, piSrc + ( k - 4 ) * iOffset, sizeof( pair ) );
+        m[k] = _mm_cvtepi16_epi32( _mm_cvtsi32_si128( pair ) );
+      }
+    }
+  }
+}
+
+SIMD_TARGET_SSE41
+static inline __m128i simdDeblockClip3SSE41( __m128i minVal, __m128i maxVal, __m128i x )
+{
+  return _mm_min_epi32( _mm_max_epi32( x, minVal ), maxVal );
+}
+
+/// Clip3(m-2*tc, m+2*tc, (sum + round) >> shift), as in the strong luma filter
+SIMD_TARGET_SSE41
+static inline __m128i simdDeblockStrongSSE41( __m128i m, __m128i tc2, __m128i sum, Int round, Int shift )
+{
+  sum = _mm_srai_epi32( _mm_add_epi32( sum, _mm_set1_epi32( round ) ), shift );
+  return simdDeblockClip3SSE41( _mm_sub_epi32( m, tc2 ), _mm_add_epi32( m, tc2 ), sum );
+}
+
+/// deblocking of a 4-line luma segment, including the filter decisions of xEdgeFilterLuma
+SIMD_TARGET_SSE41
+static Void simdEdgeFilterLumaSegmentSSE41( Pel* piSrc, Int iOffset, Int iSrcStep, Int iBeta, Int iTc, Int iSideThreshold, Int iThrCut, Bool bPartPNoFilter, Bool bPartQNoFilter, const Int bitDepthLuma )
+{
+  __m128i m[8];
+  simdDeblockLoadSSE41( piSrc, iOffset, iSrcStep, 4, 0, 8, m );
+
+  // decisions, from lines 0 and 3
+  const __m128i dpv = _mm_abs_epi32( _mm_add_epi32( _mm_sub_epi32( m[1], _mm_slli_epi32( m[2], 1 ) ), m[3] ) );
+  const __m128i dqv = _mm_abs_epi32( _mm_add_epi32( _mm_sub_epi32( m[4], _mm_slli_epi32( m[5], 1 ) ), m[6] ) );
+  const Int dp0 = _mm_cvtsi128_si32( dpv );
+  const Int dq0 = _mm_cvtsi128_si32( dqv );
+  const Int dp3 = _mm_extract_epi32( dpv, 3 );
+  const Int dq3 = _mm_extract_epi32( dqv, 3 );
+  const Int d0  = dp0 + dq0;
+  const Int d3  = dp3 + dq3;
+
+  if( d0 + d3 >= iBeta )
+  {
+    return;
+  }
+
+  const Bool bFilterP = ( dp0 + dp3 < iSideThreshold );
+  const Bool bFilterQ = ( dq0 + dq3 < iSideThreshold );
+
+  const __m128i dStrong = _mm_add_epi32( _mm_abs_epi32( _mm_sub_epi32( m[0], m[3] ) ), _mm_abs_epi32( _mm_sub_epi32( m[7], m[4] ) ) );
+  const __m128i dEdge   = _mm_abs_epi32( _mm_sub_epi32( m[3], m[4] ) );
+  const Bool sw = ( _mm_cvtsi128_si32( dStrong ) < ( iBeta >> 3 ) ) && ( 2 * d0 < ( iBeta >> 2 ) ) && ( _mm_cvtsi128_si32( dEdge ) < ( ( iTc * 5 + 1 ) >> 1 ) )
+               && ( _mm_extract_epi32( dStrong, 3 ) < ( iBeta >> 3 ) ) && ( 2 * d3 < ( iBeta >> 2 ) ) && ( _mm_extract_epi32( dEdge, 3 ) < ( ( iTc * 5 + 1 ) >> 1 ) );
+
+  __m128i out[8];
+  for( Int k = 0; k < 8; k++ )
+  {
+    out[k] = m[k];
+  }
+
+  if( sw )
+  {
+    const __m128i tc2 = _mm_set1_epi32( 2 * iTc );
+    const __m128i m34 = _mm_add_epi32( m[3], m[4] );
+    out[3] = simdDeblockStrongSSE41( m[3], tc2, _mm_add_epi32( _mm_add_epi32( m[1], m[5] ), _mm_slli_epi32( _mm_add_epi32( m[2], m34 ), 1 ) ), 4, 3 );
+    out[4] = simdDeblockStrongSSE41( m[4], tc2, _mm_add_epi32( _mm_add_epi32( m[2], m[6] ), _mm_slli_epi32( _mm_add_epi32( m34, m[5] ), 1 ) ), 4, 3 );
+    out[2] = simdDeblockStrongSSE41( m[2], tc2, _mm_add_epi32( _mm_add_epi32( m[1], m[2] ), m34 ), 2, 2 );
+    out[5] = simdDeblockStrongSSE41( m[5], tc2, _mm_add_epi32( _mm_add_epi32( m[5], m[6] ), m34 ), 2, 2 );
+    out[1] = simdDeblockStrongSSE41( m[1], tc2, _mm_add_epi32( _mm_add_epi32( _mm_slli_epi32( m[0], 1 ), _mm_add_epi32( m[1], _mm_slli_epi32( m[1], 1 ) ) ), _mm_add_epi32( m[2], m34 ) ), 4, 3 );
+    out[6] = simdDeblockStrongSSE41( m[6], tc2, _mm_add_epi32( _mm_add_epi32( _mm_slli_epi32( m[7], 1 ), _mm_add_epi32( m[6], _mm_slli_epi32( m[6], 1 ) ) ), _mm_add_epi32( m[5], m34 ) ), 4, 3 );
+  }
+  else
+  {
+    /* Weak filter */
+    const __m128i zero   = _mm_setzero_si128();
+    const __m128i maxPel = _mm_set1_epi32( ( 1 << bitDepthLuma ) - 1 );
+    const __m128i tc     = _mm_set1_epi32( iTc );
+    const __m128i tcHalf = _mm_set1_epi32( iTc >> 1 );
+    const __m128i d43    = _mm_sub_epi32( m[4], m[3] );
+    const __m128i d52    = _mm_sub_epi32( m[5], m[2] );
+    __m128i delta = _mm_add_epi32( _mm_sub_epi32( _mm_add_epi32( _mm_slli_epi32( d43, 3 ), d43 ), _mm_add_epi32( _mm_slli_epi32( d52, 1 ), d52 ) ), _mm_set1_epi32( 8 ) );
+    delta = _mm_srai_epi32( delta, 4 );
+
+    // lines with abs(delta) >= iThrCut are left unchanged
+    const __m128i filterLine = _mm_cmplt_epi32( _mm_abs_epi32( delta ), _mm_set1_epi32( iThrCut ) );
+    delta = simdDeblockClip3SSE41( _mm_sub_epi32( zero, tc ), tc, delta );
+
+    out[3] = simdDeblockClip3SSE41( zero, maxPel, _mm_add_epi32( m[3], delta ) );
+    out[4] = simdDeblockClip3SSE41( zero, maxPel, _mm_sub_epi32( m[4], delta ) );
+    if( bFilterP )
+    {
+      __m128i delta1 = _mm_srai_epi32( _mm_add_epi32( _mm_add_epi32( m[1], m[3] ), _mm_set1_epi32( 1 ) ), 1 );
+      delta1 = _mm_srai_epi32( _mm_add_epi32( _mm_sub_epi32( delta1, m[2] ), delta ), 1 );
+      delta1 = simdDeblockClip3SSE41( _mm_sub_epi32( zero, tcHalf ), tcHalf, delta1 );
+      out[2] = simdDeblockClip3SSE41( zero, maxPel, _mm_add_epi32( m[2], delta1 ) );
+    }
+    if( bFilterQ )
+    {
+      __m128i delta2 = _mm_srai_epi32( _mm_add_epi32( _mm_add_epi32( m[6], m[4] ), _mm_set1_epi32( 1 ) ), 1 );
+      delta2 = _mm_srai_epi32( _mm_sub_epi32( _mm_sub_epi32( delta2, m[5] ), delta ), 1 );
+      delta2 = simdDeblockClip3SSE41( _mm_sub_epi32( zero, tcHalf ), tcHalf, delta2 );
+      out[5] = simdDeblockClip3SSE41( zero, maxPel, _mm_add_epi32( m[5], delta2 ) );
+    }
+    for( Int k = 2; k < 6; k++ )
+    {
+      out[k] = _mm_blendv_epi8( m[k], out[k], filterLine );
+    }
+  }
+
+  if( bPartPNoFilter )
+  {
+    out[1] = m[1];
+    out[2] = m[2];
+    out[3] = m[3];
+  }
+  if( bPartQNoFilter )
+  {
+    out[4] = m[4];
+    out[5] = m[5];
+    out[6] = m[6];
+  }
+
+  if( iOffset == 1 )
+  {
+    // transpose back to rows of 8 samples
+    const __m128i v01 = _mm_packs_epi32( out[0], out[1] );
+    const __m128i v23 = _mm_packs_epi32( out[2], out[3] );
+    const __m128i v45 = _mm_packs_epi32( out[4], out[5] );
+    const __m128i v67 = _mm_packs_epi32( out[6], out[7] );
+    const __m128i w0 = _mm_unpacklo_epi16( v01, _mm_srli_si128( v01, 8 ) );
+    const __m128i w1 = _mm_unpacklo_epi16( v23, _mm_srli_si128( v23, 8 ) );
+    const __m128i w2 = _mm_unpacklo_epi16( v45, _mm_srli_si128( v45, 8 ) );
+    const __m128i w3 = _mm_unpacklo_epi16( v67, _mm_srli_si128( v67, 8 ) );
+    const __m128i x0 = _mm_unpacklo_epi32( w0, w1 );
+    const __m128i x1 = _mm_unpackhi_epi32( w0, w1 );
+    const __m128i x2 = _mm_unpacklo_epi32( w2, w3 );
+    const __m128i x3 = _mm_unpackhi_epi32( w2, w3 );
+    _mm_storeu_si128( ( __m128i* )( piSrc                - 4 ), _mm_unpacklo_epi64( x0, x2 ) );
+    _mm_storeu_si128( ( __m128i* )( piSrc +     iSrcStep - 4 ), _mm_unpackhi_epi64( x0, x2 ) );
+    _mm_storeu_si128( ( __m128i* )( piSrc + 2 * iSrcStep - 4 ), _mm_unpacklo_epi64( x1, x3 ) );
+    _mm_storeu_si128( ( __m128i* )( piSrc + 3 * iSrcStep - 4 ), _mm_unpackhi_epi64( x1, x3 ) );
+  }
+  else
+  {
+    for( Int k = 1; k < 7; k++ )
+    {
+      _mm_storel_epi64( ( __m128i* )( piSrc + ( k - 4 ) * iOffset ), _mm_packs_epi32( out[k], out[k] ) );
+    }
+  }
+}
+
+/// deblocking of 2 or 4 chroma lines (see xPelFilterChroma)
+SIMD_TARGET_SSE41
+static Void simdEdgeFilterChromaSegmentSSE41( Pel* piSrc, Int iOffset, Int iSrcStep, Int numLines, Int iTc, Bool bPartPNoFilter, Bool bPartQNoFilter, const Int bitDepthChroma )
+{
+  __m128i m[8];
+  simdDeblockLoadSSE41( piSrc, iOffset, iSrcStep, numLines, 2, 4, m );
+
+  const __m128i zero   = _mm_setzero_si128();
+  const __m128i maxPel = _mm_set1_epi32( ( 1 << bitDepthChroma ) - 1 );
+  const __m128i tc     = _mm_set1_epi32( iTc );
+
+  __m128i delta = _mm_add_epi32( _mm_slli_epi32( _mm_sub_epi32( m[4], m[3] ), 2 ), _mm_sub_epi32( m[2], m[5] ) );
+  delta = _mm_srai_epi32( _mm_add_epi32( delta, _mm_set1_epi32( 4 ) ), 3 );
+  delta = simdDeblockClip3SSE41( _mm_sub_epi32( zero, tc ), tc, delta );
+
+  const __m128i p0 = bPartPNoFilter ? m[3] : simdDeblockClip3SSE41( zero, maxPel, _mm_add_epi32( m[3], delta ) );
+  const __m128i q0 = bPartQNoFilter ? m[4] : simdDeblockClip3SSE41( zero, maxPel, _mm_sub_epi32( m[4], delta ) );
+
+  if( iOffset == 1 )
+  {
+    // one pair of samples per row
+    const __m128i p0q0 = _mm_unpacklo_epi16( _mm_packs_epi32( p0, p0 ), _mm_packs_epi32( q0, q0 ) );
+    Pel samples[8];
+    _mm_storeu_si128( ( __m128i* )samples, p0q0 );
+    for( Int l = 0; l < numLines; l++ )
+    {
+      piSrc[l * iSrcStep - 1] = samples[2 * l];
+      piSrc[l * iSrcStep    ] = samples[2 * l + 1];
+    }
+  }
+  else
+  {
+    Pel samples[16];
+    _mm_storeu_si128( ( __m128i* )samples,       _mm_packs_epi32( p0, p0 ) );
+    _mm_storeu_si128( ( __m128i* )( samples + 8 ), _mm_packs_epi32( q0, q0 ) );
+    memcpy( piSrc - iOffset, samples,     numLines * sizeof( Pel ) );
+    memcpy( piSrc,           samples + 8, numLines * sizeof( Pel ) );
+  }
+}
+#endif
+
 // ====================================================================================================================
 // Constructor / destructor / create / destroy
 // ====================================================================================================================
@@ -130,28 +369,28 @@ Void TComLoopFilter::destroy()
 Void TComLoopFilter::loopFilterPic( TComPic* pcPic )
 {
   // Horizontal filtering
-  for ( UInt ctuRsAddr = 0; ctuRsAddr < pcPic->getNumberOfCtusInFrame(); ctuRsAddr++ )
-  {
-    TComDataCU* pCtu = pcPic->getCtu( ctuRsAddr );
-
-    ::memset( m_aapucBS       [EDGE_VER], 0, sizeof( UChar ) * m_uiNumPartitions );
-    ::memset( m_aapbEdgeFilter[EDGE_VER], 0, sizeof( Bool  ) * m_uiNumPartitions );
-
-    // CU-based deblocking
-    xDeblockCU( pCtu, 0, 0, EDGE_VER );
-  }
+  xDeblockCtus( pcPic, 0, pcPic->getNumberOfCtusInFrame(), EDGE_VER );
 
   // Vertical filtering
-  for ( UInt ctuRsAddr = 0; ctuRsAddr < pcPic->getNumberOfCtusInFrame(); ctuRsAddr++ )
-  {
-    TComDataCU* pCtu = pcPic->getCtu( ctuRsAddr );
+  xDeblockCtus( pcPic, 0, pcPic->getNumberOfCtusInFrame(), EDGE_HOR );
+}
 
-    ::memset( m_aapucBS       [EDGE_HOR], 0, sizeof( UChar ) * m_uiNumPartitions );
-    ::memset( m_aapbEdgeFilter[EDGE_HOR], 0, sizeof( Bool  ) * m_uiNumPartitions );
+/**
+ - call deblocking function for every CU of one CTU row, vertical edges first.
+ .
+ The result is the same as that of loopFilterPic() when the rows are filtered from top to bottom, each one once the
+ CTU row below it has been reconstructed: the horizontal edges at the top of a row only modify the last three lines of
+ the row above, which the filtering of that row has neither modified nor read.
+ \param  pcPic   picture class (TComPic) pointer
+ \param  ctuRow  CTU row, in units of CTUs
+ */
+Void TComLoopFilter::loopFilterCtuRow( TComPic* pcPic, UInt ctuRow )
+{
+  const UInt frameWidthInCtus = pcPic->getFrameWidthInCtus();
+  const UInt startCtuRsAddr   = ctuRow * frameWidthInCtus;
 
-    // CU-based deblocking
-    xDeblockCU( pCtu, 0, 0, EDGE_HOR );
-  }
+  xDeblockCtus( pcPic, startCtuRsAddr, startCtuRsAddr + frameWidthInCtus, EDGE_VER );
+  xDeblockCtus( pcPic, startCtuRsAddr, startCtuRsAddr + frameWidthInCtus, EDGE_HOR );
 }
 
 
@@ -159,6 +398,21 @@ Void TComLoopFilter::loopFilterPic( TComPic* pcPic )
 // Protected member functions
 // ====================================================================================================================
 
+Void TComLoopFilter::xDeblockCtus( TComPic* pcPic, UInt startCtuRsAddr, UInt endCtuRsAddr, DeblockEdgeDir edgeDir )
+{
+  TComProfilingScope profilingScope( PROFILE_DEBLOCKING );
+  for ( UInt ctuRsAddr = startCtuRsAddr; ctuRsAddr < endCtuRsAddr; ctuRsAddr++ )
+  {
+    TComDataCU* pCtu = pcPic->getCtu( ctuRsAddr );
+
+    ::memset( m_aapucBS       [edgeDir], 0, sizeof( UChar ) * m_uiNumPartitions );
+    ::memset( m_aapbEdgeFilter[edgeDir], 0, sizeof( Bool  ) * m_uiNumPartitions );
+
+    // CU-based deblocking
+    xDeblockCU( pCtu, 0, 0, edgeDir );
+  }
+}
+
 /**
  Deblocking filter process in CU-based (the same function as conventional's)
 
@@ -629,45 +883,71 @@ Void TComLoopFilter::xEdgeFilterLuma( TComDataCU* const pcCU, const UInt uiAbsZo
       Int iThrCut = iTc*10;
 
 
+      if (bPCMFilter || ppsTransquantBypassEnabledFlag)
+      {
+        // Check if each of PUs is I_PCM with LF disabling
+        bPartPNoFilter = (bPCMFilter && pcCUP->getIPCMFlag(uiPartPIdx));
+        bPartQNoFilter = (bPCMFilter && pcCUQ->getIPCMFlag(uiPartQIdx));
+
+        // check if each of PUs is lossless coded
+        bPartPNoFilter = bPartPNoFilter || (pcCUP->isLosslessCoded(uiPartPIdx) );
+        bPartQNoFilter = bPartQNoFilter || (pcCUQ->isLosslessCoded(uiPartQIdx) );
+      }
+
       UInt  uiBlocksInPart = uiPelsInPart / 4 ? uiPelsInPart / 4 : 1;
       for (UInt iBlkIdx = 0; iBlkIdx<uiBlocksInPart; iBlkIdx ++)
       {
-        Int dp0 = xCalcDP( piTmpSrc+iSrcStep*(iIdx*uiPelsInPart+iBlkIdx*4+0), iOffset);
-        Int dq0 = xCalcDQ( piTmpSrc+iSrcStep*(iIdx*uiPelsInPart+iBlkIdx*4+0), iOffset);
-        Int dp3 = xCalcDP( piTmpSrc+iSrcStep*(iIdx*uiPelsInPart+iBlkIdx*4+3), iOffset);
-        Int dq3 = xCalcDQ( piTmpSrc+iSrcStep*(iIdx*uiPelsInPart+iBlkIdx*4+3), iOffset);
-        Int d0 = dp0 + dq0;
-        Int d3 = dp3 + dq3;
-
-        Int dp = dp0 + dp3;
-        Int dq = dq0 + dq3;
-        Int d =  d0 + d3;
-
-        if (bPCMFilter || ppsTransquantBypassEnabledFlag)
-        {
-          // Check if each of PUs is I_PCM with LF disabling
-          bPartPNoFilter = (bPCMFilter && pcCUP->getIPCMFlag(uiPartPIdx));
-          bPartQNoFilter = (bPCMFilter && pcCUQ->getIPCMFlag(uiPartQIdx));
-
-          // check if each of PUs is lossless coded
-          bPartPNoFilter = bPartPNoFilter || (pcCUP->isLosslessCoded(uiPartPIdx) );
-          bPartQNoFilter = bPartQNoFilter || (pcCUQ->isLosslessCoded(uiPartQIdx) );
-        }
+        xFilterLumaSegment( piTmpSrc+iSrcStep*(iIdx*uiPelsInPart+iBlkIdx*4), iOffset, iSrcStep, iBeta, iTc, iSideThreshold, iThrCut, bPartPNoFilter, bPartQNoFilter, bitDepthLuma );
+      }
+    }
+  }
+}
 
-        if (d < iBeta)
-        {
-          Bool bFilterP = (dp < iSideThreshold);
-          Bool bFilterQ = (dq < iSideThreshold);
+/**
+ - Decisions and deblocking of one segment of 4 luma lines across an edge
+ .
+ \param piSrc           pointer to the first line, at the first sample of the Q side
+ \param iOffset         offset between the samples of a line (1 for a vertical edge, the stride for a horizontal one)
+ \param iSrcStep        offset between the lines
+ \param iBeta           beta value
+ \param iTc             tc value
+ \param iSideThreshold  threshold of the decisions to filter the second samples of each side
+ \param iThrCut         threshold value for weak filter decision
+ \param bPartPNoFilter  indicator to disable filtering on partP
+ \param bPartQNoFilter  indicator to disable filtering on partQ
+ \param bitDepthLuma    luma bit depth
+*/
+Void TComLoopFilter::xFilterLumaSegment( Pel* piSrc, Int iOffset, Int iSrcStep, Int iBeta, Int iTc, Int iSideThreshold, Int iThrCut, Bool bPartPNoFilter, Bool bPartQNoFilter, const Int bitDepthLuma )
+{
+#if VECTOR_CODING__DEBLOCKING_FILTER && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+  if (getSIMDExtension( SIMD_KERNELS_LOOP_FILTER ) >= SIMD_SSE41)
+  {
+    simdEdgeFilterLumaSegmentSSE41( piSrc, iOffset, iSrcStep, iBeta, iTc, iSideThreshold, iThrCut, bPartPNoFilter, bPartQNoFilter, bitDepthLuma );
+    return;
+  }
+#endif
+  Int dp0 = xCalcDP( piSrc+iSrcStep*0, iOffset);
+  Int dq0 = xCalcDQ( piSrc+iSrcStep*0, iOffset);
+  Int dp3 = xCalcDP( piSrc+iSrcStep*3, iOffset);
+  Int dq3 = xCalcDQ( piSrc+iSrcStep*3, iOffset);
+  Int d0 = dp0 + dq0;
+  Int d3 = dp3 + dq3;
+
+  Int dp = dp0 + dp3;
+  Int dq = dq0 + dq3;
+  Int d =  d0 + d3;
+
+  if (d < iBeta)
+  {
+    Bool bFilterP = (dp < iSideThreshold);
+    Bool bFilterQ = (dq < iSideThreshold);
 
-          Bool sw =  xUseStrongFiltering( iOffset, 2*d0, iBeta, iTc, piTmpSrc+iSrcStep*(iIdx*uiPelsInPart+iBlkIdx*4+0))
-          && xUseStrongFiltering( iOffset, 2*d3, iBeta, iTc, piTmpSrc+iSrcStep*(iIdx*uiPelsInPart+iBlkIdx*4+3));
+    Bool sw =  xUseStrongFiltering( iOffset, 2*d0, iBeta, iTc, piSrc+iSrcStep*0)
+    && xUseStrongFiltering( iOffset, 2*d3, iBeta, iTc, piSrc+iSrcStep*3);
 
-          for ( Int i = 0; i < DEBLOCK_SMALLEST_BLOCK/2; i++)
-          {
-            xPelFilterLuma( piTmpSrc+iSrcStep*(iIdx*uiPelsInPart+iBlkIdx*4+i), iOffset, iTc, sw, bPartPNoFilter, bPartQNoFilter, iThrCut, bFilterP, bFilterQ, bitDepthLuma);
-          }
-        }
-      }
+    for ( Int i = 0; i < DEBLOCK_SMALLEST_BLOCK/2; i++)
+    {
+      xPelFilterLuma( piSrc+iSrcStep*i, iOffset, iTc, sw, bPartPNoFilter, bPartQNoFilter, iThrCut, bFilterP, bFilterQ, bitDepthLuma);
     }
   }
 }
@@ -804,15 +1084,44 @@ Void TComLoopFilter::xEdgeFilterChroma( TComDataCU* const pcCU, const UInt uiAbs
         Int iIndexTC = Clip3(0, MAX_QP+DEFAULT_INTRA_TC_OFFSET, iQP + DEFAULT_INTRA_TC_OFFSET*(ucBs - 1) + (tcOffsetDiv2 << 1));
         Int iTc =  sm_tcTable[iIndexTC]*iBitdepthScale;
 
-        for ( UInt uiStep = 0; uiStep < uiLoopLength; uiStep++ )
-        {
-          xPelFilterChroma( piTmpSrcChroma + iSrcStep*(uiStep+iIdx*uiLoopLength), iOffset, iTc , bPartPNoFilter, bPartQNoFilter, bitDepthChroma);
-        }
+        xFilterChromaLines( piTmpSrcChroma + iSrcStep*(iIdx*uiLoopLength), iOffset, iSrcStep, uiLoopLength, iTc, bPartPNoFilter, bPartQNoFilter, bitDepthChroma );
       }
     }
   }
 }
 
+/**
+ - Deblocking of chroma lines across an edge
+ .
+ \param piSrc           pointer to the first line, at the first sample of the Q side
+ \param iOffset         offset between the samples of a line (1 for a vertical edge, the stride for a horizontal one)
+ \param iSrcStep        offset between the lines
+ \param uiNumLines      number of lines
+ \param iTc             tc value
+ \param bPartPNoFilter  indicator to disable filtering on partP
+ \param bPartQNoFilter  indicator to disable filtering on partQ
+ \param bitDepthChroma  chroma bit depth
+*/
+Void TComLoopFilter::xFilterChromaLines( Pel* piSrc, Int iOffset, Int iSrcStep, UInt uiNumLines, Int iTc, Bool bPartPNoFilter, Bool bPartQNoFilter, const Int bitDepthChroma )
+{
+  UInt uiStep = 0;
+#if VECTOR_CODING__DEBLOCKING_FILTER && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+  if (getSIMDExtension( SIMD_KERNELS_LOOP_FILTER ) >= SIMD_SSE41)
+  {
+    for ( ; uiStep + 1 < uiNumLines; )
+    {
+      const Int numLines = (uiNumLines - uiStep >= 4) ? 4 : 2;
+      simdEdgeFilterChromaSegmentSSE41( piSrc + iSrcStep*uiStep, iOffset, iSrcStep, numLines, iTc, bPartPNoFilter, bPartQNoFilter, bitDepthChroma );
+      uiStep += numLines;
+    }
+  }
+#endif
+  for ( ; uiStep < uiNumLines; uiStep++ )
+  {
+    xPelFilterChroma( piSrc + iSrcStep*uiStep, iOffset, iTc , bPartPNoFilter, bPartQNoFilter, bitDepthChroma);
+  }
+}
+
 /**
  - Deblocking for the luminance component with strong or weak filter
  .
@@ -65,6 +65,8 @@ private:
 protected:
   /// CU-level deblocking function
   Void xDeblockCU                 ( TComDataCU* pcCU, UInt uiAbsZorderIdx, UInt uiDepth, DeblockEdgeDir edgeDir );
+  /// deblocking of the edges of one direction in the CTUs [startCtuRsAddr, endCtuRsAddr)
+  Void xDeblockCtus               ( TComPic* pcPic, UInt startCtuRsAddr, UInt endCtuRsAddr, DeblockEdgeDir edgeDir );
 
   // set / get functions
   Void xSetLoopfilterParam        ( TComDataCU* pcCU, UInt uiAbsZorderIdx );
@@ -107,6 +109,9 @@ protected:
   Void xEdgeFilterLuma            ( TComDataCU* const pcCU, const UInt uiAbsZorderIdx, const UInt uiDepth, const DeblockEdgeDir edgeDir, const Int iEdge );
   Void xEdgeFilterChroma          ( TComDataCU* const pcCU, const UInt uiAbsZorderIdx, const UInt uiDepth, const DeblockEdgeDir edgeDir, const Int iEdge );
 
+  Void xFilterLumaSegment        ( Pel* piSrc, Int iOffset, Int iSrcStep, Int iBeta, Int iTc, Int iSideThreshold, Int iThrCut, Bool bPartPNoFilter, Bool bPartQNoFilter, const Int bitDepthLuma );
+  Void xFilterChromaLines        ( Pel* piSrc, Int iOffset, Int iSrcStep, UInt uiNumLines, Int iTc, Bool bPartPNoFilter, Bool bPartQNoFilter, const Int bitDepthChroma );
+
   __inline Void xPelFilterLuma( Pel* piSrc, Int iOffset, Int tc, Bool sw, Bool bPartPNoFilter, Bool bPartQNoFilter, Int iThrCut, Bool bFilterSecondP, Bool bFilterSecondQ, const Int bitDepthLuma);
   __inline Void xPelFilterChroma( Pel* piSrc, Int iOffset, Int tc, Bool bPartPNoFilter, Bool bPartQNoFilter, const Int bitDepthChroma);
 
@@ -130,6 +135,8 @@ public:
 
   /// picture-level deblocking filter
   Void loopFilterPic( TComPic* pcPic );
+  /// deblocking filter of one CTU row; the rows are filtered from top to bottom, once the CTU row below has been reconstructed
+  Void loopFilterCtuRow( TComPic* pcPic, UInt ctuRow );
 
   static Int getBeta( Int qp )
   {
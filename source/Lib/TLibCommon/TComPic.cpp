@@ -213,6 +213,19 @@ Void TComPic::compressMotion()
   }
 }
 
+/** Compress the motion of the CTUs of one CTU row, once the motion of the row is no longer needed at full resolution.
+ */
+Void TComPic::compressMotionCtuRow(UInt ctuRow)
+{
+  TComPicSym* pPicSym = getPicSym();
+  const UInt frameWidthInCtus = pPicSym->getFrameWidthInCtus();
+  for ( UInt uiCUAddr = ctuRow * frameWidthInCtus; uiCUAddr < (ctuRow + 1) * frameWidthInCtus; uiCUAddr++ )
+  {
+    TComDataCU* pCtu = pPicSym->getCtu(uiCUAddr);
+    pCtu->compressMV();
+  }
+}
+
 Bool  TComPic::getSAOMergeAvailability(Int currAddr, Int mergeAddr)
 {
   Bool mergeCtbInSliceSeg = (mergeAddr >= getPicSym()->getCtuTsToRsAddrMap(getCtu(currAddr)->getSlice()->getSliceCurStartCtuTsAddr()));
@@ -43,6 +43,7 @@
 #include "TComPicSym.h"
 #include "TComPicYuv.h"
 #include "TComBitStream.h"
+#include "TComThreadPool.h"
 
 //! \ingroup TLibCommon
 //! \{
@@ -77,6 +78,8 @@ private:
   Bool                  m_isTop;
   Bool                  m_isField;
 
+  mutable TComProgressCounter m_reconRowProgress; // Number of CTU rows of the reconstruction that are final (in-loop filtered)
+
   std::vector<std::vector<TComDataCU*> > m_vSliceCUDataLink;
 
   SEIMessages  m_SEIs; ///< Any SEI messages that have been received.  If !NULL we own the object.
@@ -112,7 +115,7 @@ public:
   const TComPicSym* getPicSym() const              { return  &m_picSym;    }
   TComSlice*    getSlice(Int i)                    { return  m_picSym.getSlice(i);  }
   const TComSlice* getSlice(Int i) const           { return  m_picSym.getSlice(i);  }
-  Int           getPOC() const                     { return  m_picSym.getSlice(m_uiCurrSliceIdx)->getPOC();  }
+  Int           getPOC() const                     { return  m_picSym.getSlice(0)->getPOC();  }
   TComDataCU*   getCtu( UInt ctuRsAddr )           { return  m_picSym.getCtu( ctuRsAddr ); }
   const TComDataCU* getCtu( UInt ctuRsAddr ) const { return  m_picSym.getCtu( ctuRsAddr ); }
 
@@ -144,7 +147,13 @@ public:
   Void          setOutputMark (Bool b) { m_bNeededForOutput = b;     }
   Bool          getOutputMark () const      { return m_bNeededForOutput;  }
 
+  // progress of the reconstruction, for pictures that reference this picture while it is still being processed
+  Void          resetReconRowProgress()                { m_reconRowProgress.reset( 0 );            }
+  Void          setReconRowProgress( Int numCtuRows )  { m_reconRowProgress.set( numCtuRows );     }
+  Void          waitForReconRows( Int numCtuRows ) const { m_reconRowProgress.waitFor( numCtuRows ); }
+
   Void          compressMotion();
+  Void          compressMotionCtuRow( UInt ctuRow );
   UInt          getCurrSliceIdx() const           { return m_uiCurrSliceIdx;                }
   Void          setCurrSliceIdx(UInt i)      { m_uiCurrSliceIdx = i;                   }
   UInt          getNumAllocatedSlice() const      {return m_picSym.getNumAllocatedSlice();}
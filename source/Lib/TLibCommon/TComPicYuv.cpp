@@ -233,6 +233,17 @@ Void TComPicYuv::extendPicBorder ()
     return;
   }
 
+  extendPicBorderLines( 0, getHeight(COMPONENT_Y) );
+
+  m_bIsBorderExtended = true;
+}
+
+/** Extend the left and right borders of the luma lines [startLumaLine, endLumaLine) and of the corresponding chroma
+ * lines, as well as the top (bottom) border if the first (last) line of the picture is included.
+ * This allows the border of a picture to be extended in several steps while it is being reconstructed.
+ */
+Void TComPicYuv::extendPicBorderLines( const Int startLumaLine, const Int endLumaLine )
+{
   for(Int comp=0; comp<getNumberValidComponents(); comp++)
   {
     const ComponentID compId=ComponentID(comp);
@@ -242,10 +253,12 @@ Void TComPicYuv::extendPicBorder ()
     const Int height=getHeight(compId);
     const Int marginX=getMarginX(compId);
     const Int marginY=getMarginY(compId);
+    const Int startLine=startLumaLine >> getComponentScaleY(compId);
+    const Int endLine=min(height, endLumaLine >> getComponentScaleY(compId));
 
-    Pel*  pi = piTxt;
+    Pel*  pi = piTxt + startLine * stride;
     // do left and right margins
-    for (Int y = 0; y < height; y++)
+    for (Int y = startLine; y < endLine; y++)
     {
       for (Int x = 0; x < marginX; x++ )
       {
@@ -255,24 +268,26 @@ Void TComPicYuv::extendPicBorder ()
       pi += stride;
     }
 
-    // pi is now the (0,height) (bottom left of image within bigger picture
-    pi -= (stride + marginX);
-    // pi is now the (-marginX, height-1)
-    for (Int y = 0; y < marginY; y++ )
+    if (endLine == height)
     {
-      ::memcpy( pi + (y+1)*stride, pi, sizeof(Pel)*(width + (marginX<<1)) );
+      // pi is now the (-marginX, height-1)
+      pi = piTxt + (height-1) * stride - marginX;
+      for (Int y = 0; y < marginY; y++ )
+      {
+        ::memcpy( pi + (y+1)*stride, pi, sizeof(Pel)*(width + (marginX<<1)) );
+      }
     }
 
-    // pi is still (-marginX, height-1)
-    pi -= ((height-1) * stride);
-    // pi is now (-marginX, 0)
-    for (Int y = 0; y < marginY; y++ )
+    if (startLine == 0)
     {
-      ::memcpy( pi - (y+1)*stride, pi, sizeof(Pel)*(width + (marginX<<1)) );
+      // pi is now (-marginX, 0)
+      pi = piTxt - marginX;
+      for (Int y = 0; y < marginY; y++ )
+      {
+        ::memcpy( pi - (y+1)*stride, pi, sizeof(Pel)*(width + (marginX<<1)) );
+      }
     }
   }
-
-  m_bIsBorderExtended = true;
 }
 
 
@@ -162,12 +162,14 @@ public:
 
   //  Extend function of picture buffer
   Void          extendPicBorder   ();
+  Void          extendPicBorderLines( const Int startLumaLine, const Int endLumaLine ); ///< extend the borders next to the given lines only, without setting the border extension flag
 
   //  Dump picture
   Void          dump              (const std::string &fileName, const BitDepths &bitDepths, const Bool bAppend=false, const Bool bForceTo8Bit=false) const ;
 
   // Set border extension flag
   Void          setBorderExtension(Bool b) { m_bIsBorderExtended = b; }
+  Bool          getBorderExtension() const { return m_bIsBorderExtended; }
 };// END CLASS DEFINITION TComPicYuv
 
 
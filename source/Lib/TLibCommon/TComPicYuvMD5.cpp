@@ -32,6 +32,7 @@
  */
 
 #include "TComPicYuv.h"
+#include "TComProfiler.h"
 #include "libmd5/MD5.h"
 
 //! \ingroup TLibCommon
@@ -128,6 +129,7 @@ UInt compCRC(Int bitdepth, const Pel* plane, UInt width, UInt height, UInt strid
 
 UInt calcCRC(const TComPicYuv& pic, TComPictureHash &digest, const BitDepths &bitDepths)
 {
+  TComProfilingScope profilingScope( PROFILE_PICTURE_HASH );
   UInt digestLen=0;
   digest.hash.clear();
   for(Int chan=0; chan<pic.getNumberValidComponents(); chan++)
@@ -166,6 +168,7 @@ UInt compChecksum(Int bitdepth, const Pel* plane, UInt width, UInt height, UInt
 
 UInt calcChecksum(const TComPicYuv& pic, TComPictureHash &digest, const BitDepths &bitDepths)
 {
+  TComProfilingScope profilingScope( PROFILE_PICTURE_HASH );
   UInt digestLen=0;
   digest.hash.clear();
   for(Int chan=0; chan<pic.getNumberValidComponents(); chan++)
@@ -184,6 +187,7 @@ UInt calcChecksum(const TComPicYuv& pic, TComPictureHash &digest, const BitDepth
  */
 UInt calcMD5(const TComPicYuv& pic, TComPictureHash &digest, const BitDepths &bitDepths)
 {
+  TComProfilingScope profilingScope( PROFILE_PICTURE_HASH );
   /* choose an md5_plane packing function based on the system bitdepth */
   typedef Void (*MD5PlaneFunc)(MD5&, const Pel*, UInt, UInt, UInt);
   MD5PlaneFunc md5_plane_func;
@@ -40,6 +40,11 @@
 #include "TComPic.h"
 #include "TComTU.h"
 
+#if VECTOR_CODING__INTRA_PREDICTION && VECTOR_CODING__AVX2 && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+#include <immintrin.h>
+#include "TComCpuFeatures.h"
+#endif
+
 //! \ingroup TLibCommon
 //! \{
 
@@ -66,6 +71,261 @@ const UChar TComPrediction::m_aucIntraFilter[MAX_NUM_CHANNEL_TYPE][MAX_INTRA_FIL
 
 };
 
+#if VECTOR_CODING__INTRA_PREDICTION && VECTOR_CODING__AVX2 && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+// ====================================================================================================================
+// AVX2 intra prediction
+// ====================================================================================================================
+
+/// sum of the width samples above the block (width = 4, 8, 16, 32 or 64)
+SIMD_TARGET_AVX2
+static Int simdIntraSumAboveAVX2( const Pel* pAbove, Int width )
+{
+  if( width == 4 )
+  {
+    __m128i sum = _mm_madd_epi16( _mm_loadl_epi64( ( const __m128i* )pAbove ), _mm_set1_epi16( 1 ) );
+    sum = _mm_add_epi32( sum, _mm_shuffle_epi32( sum, 0x55 ) );
+    return _mm_cvtsi128_si32( sum );
+  }
+
+  __m128i sum = _mm_madd_epi16( _mm_loadu_si128( ( const __m128i* )pAbove ), _mm_set1_epi16( 1 ) );
+  if( width > 8 )
+  {
+    __m256i sum256 = _mm256_setzero_si256();
+    for( Int x = 0; x < width; x += 16 )
+    {
+      sum256 = _mm256_add_epi32( sum256, _mm256_madd_epi16( _mm256_loadu_si256( ( const __m256i* )( pAbove + x ) ), _mm256_set1_epi16( 1 ) ) );
+    }
+    sum = _mm_add_epi32( _mm256_castsi256_si128( sum256 ), _mm256_extracti128_si256( sum256, 1 ) );
+  }
+  sum = _mm_add_epi32( sum, _mm_shuffle_epi32( sum, 0x4e ) );
+  sum = _mm_add_epi32( sum, _mm_shuffle_epi32( sum, 0xb1 ) );
+  return _mm_cvtsi128_si32( sum );
+}
+
+/// fills a block (width = 4, 8, 16, 32 or 64) with a single value
+SIMD_TARGET_AVX2
+static Void simdIntraFillAVX2( Pel* pDst, Int dstStride, Int width, Int height, Pel value )
+{
+  const __m256i val = _mm256_set1_epi16( value );
+  for( Int y = 0; y < height; y++, pDst += dstStride )
+  {
+    if( width == 4 )
+    {
+      _mm_storel_epi64( ( __m128i* )pDst, _mm256_castsi256_si128( val ) );
+    }
+    else if( width == 8 )
+    {
+      _mm_storeu_si128( ( __m128i* )pDst, _mm256_castsi256_si128( val ) );
+    }
+    else
+    {
+      for( Int x = 0; x < width; x += 16 )
+      {
+        _mm256_storeu_si256( ( __m256i* )( pDst + x ), val );
+      }
+    }
+  }
+}
+
+/** angular projection of the main reference array, for a non-zero angle (see xPredIntraAng): each row is interpolated
+ *  between two reference samples, or copied when the projection falls on a full sample position.
+ */
+SIMD_TARGET_AVX2
+static Void simdIntraAngProjectAVX2( const Pel* refMain, Pel* pDst, Int dstStride, Int width, Int height, Int intraPredAngle )
+{
+  const __m256i offset = _mm256_set1_epi32( 16 );
+
+  for( Int y = 0, deltaPos = intraPredAngle; y < height; y++, deltaPos += intraPredAngle, pDst += dstStride )
+  {
+    const Int  deltaInt   = deltaPos >> 5;
+    const Int  deltaFract = deltaPos & ( 32 - 1 );
+    const Pel *pRM        = refMain + deltaInt + 1;
+
+    if( deltaFract )
+    {
+      // (32-deltaFract)*pRM[x] + deltaFract*pRM[x+1], with the two samples interleaved for madd
+      const __m256i weights = _mm256_set1_epi32( ( deltaFract << 16 ) | ( 32 - deltaFract ) );
+      if( width == 4 )
+      {
+        const __m128i pel = _mm_unpacklo_epi16( _mm_loadl_epi64( ( const __m128i* )pRM ), _mm_loadl_epi64( ( const __m128i* )( pRM + 1 ) ) );
+        __m128i sum = _mm_madd_epi16( pel, _mm256_castsi256_si128( weights ) );
+        sum = _mm_srai_epi32( _mm_add_epi32( sum, _mm256_castsi256_si128( offset ) ), 5 );
+        _mm_storel_epi64( ( __m128i* )pDst, _mm_packs_epi32( sum, sum ) );
+      }
+      else if( width == 8 )
+      {
+        const __m128i pel0  = _mm_loadu_si128( ( const __m128i* )pRM );
+        const __m128i pel1  = _mm_loadu_si128( ( const __m128i* )( pRM + 1 ) );
+        __m128i sumLo = _mm_madd_epi16( _mm_unpacklo_epi16( pel0, pel1 ), _mm256_castsi256_si128( weights ) );
+        __m128i sumHi = _mm_madd_epi16( _mm_unpackhi_epi16( pel0, pel1 ), _mm256_castsi256_si128( weights ) );
+        sumLo = _mm_srai_epi32( _mm_add_epi32( sumLo, _mm256_castsi256_si128( offset ) ), 5 );
+        sumHi = _mm_srai_epi32( _mm_add_epi32( sumHi, _mm256_castsi256_si128( offset ) ), 5 );
+        _mm_storeu_si128( ( __m128i* )pDst, _mm_packs_epi32( sumLo, sumHi ) );
+      }
+      else
+      {
+        for( Int x = 0; x < width; x += 16 )
+        {
+          const __m256i pel0  = _mm256_loadu_si256( ( const __m256i* )( pRM + x ) );
+          const __m256i pel1  = _mm256_loadu_si256( ( const __m256i* )( pRM + x + 1 ) );
+          __m256i sumLo = _mm256_madd_epi16( _mm256_unpacklo_epi16( pel0, pel1 ), weights );
+          __m256i sumHi = _mm256_madd_epi16( _mm256_unpackhi_epi16( pel0, pel1 ), weights );
+          sumLo = _mm256_srai_epi32( _mm256_add_epi32( sumLo, offset ), 5 );
+          sumHi = _mm256_srai_epi32( _mm256_add_epi32( sumHi, offset ), 5 );
+          _mm256_storeu_si256( ( __m256i* )( pDst + x ), _mm256_packs_epi32( sumLo, sumHi ) );
+        }
+      }
+    }
+    else
+    {
+      // Just copy the integer samples
+      if( width == 4 )
+      {
+        _mm_storel_epi64( ( __m128i* )pDst, _mm_loadl_epi64( ( const __m128i* )pRM ) );
+      }
+      else if( width == 8 )
+      {
+        _mm_storeu_si128( ( __m128i* )pDst, _mm_loadu_si128( ( const __m128i* )pRM ) );
+      }
+      else
+      {
+        for( Int x = 0; x < width; x += 16 )
+        {
+          _mm256_storeu_si256( ( __m256i* )( pDst + x ), _mm256_loadu_si256( ( const __m256i* )( pRM + x ) ) );
+        }
+      }
+    }
+  }
+}
+
+/// pDst[x*dstStride+y] = pSrc[y*srcStride+x], for a width x height block (multiples of 4)
+SIMD_TARGET_AVX2
+static Void simdIntraTransposeAVX2( const Pel* pSrc, Int srcStride, Pel* pDst, Int dstStride, Int width, Int height )
+{
+  if( ( ( width | height ) & 7 ) == 0 )
+  {
+    for( Int y = 0; y < height; y += 8 )
+    {
+      for( Int x = 0; x < width; x += 8 )
+      {
+        const Pel *src = pSrc + y * srcStride + x;
+        Pel       *dst = pDst + x * dstStride + y;
+        __m128i r[8], t[8], u[8];
+        for( Int i = 0; i < 8; i++ )
+        {
+          r[i] = _mm_loadu_si128( ( const __m128i* )( src + i * srcStride ) );
+        }
+        for( Int i = 0; i < 4; i++ )
+        {
+          t[i]     = _mm_unpacklo_epi16( r[2 * i], r[2 * i + 1] );
+          t[i + 4] = _mm_unpackhi_epi16( r[2 * i], r[2 * i + 1] );
+        }
+        for( Int i = 0; i < 8; i += 4 )
+        {
+          u[i]     = _mm_unpacklo_epi32( t[i],     t[i + 1] );
+          u[i + 1] = _mm_unpackhi_epi32( t[i],     t[i + 1] );
+          u[i + 2] = _mm_unpacklo_epi32( t[i + 2], t[i + 3] );
+          u[i + 3] = _mm_unpackhi_epi32( t[i + 2], t[i + 3] );
+        }
+        for( Int i = 0; i < 2; i++ )
+        {
+          _mm_storeu_si128( ( __m128i* )( dst + ( 4 * i     ) * dstStride ), _mm_unpacklo_epi64( u[4 * i],     u[4 * i + 2] ) );
+          _mm_storeu_si128( ( __m128i* )( dst + ( 4 * i + 1 ) * dstStride ), _mm_unpackhi_epi64( u[4 * i],     u[4 * i + 2] ) );
+          _mm_storeu_si128( ( __m128i* )( dst + ( 4 * i + 2 ) * dstStride ), _mm_unpacklo_epi64( u[4 * i + 1], u[4 * i + 3] ) );
+          _mm_storeu_si128( ( __m128i* )( dst + ( 4 * i + 3 ) * dstStride ), _mm_unpackhi_epi64( u[4 * i + 1], u[4 * i + 3] ) );
+        }
+      }
+    }
+  }
+  else
+  {
+    for( Int y = 0; y < height; y += 4 )
+    {
+      for( Int x = 0; x < width; x += 4 )
+      {
+        const Pel *src = pSrc + y * srcStride + x;
+        Pel       *dst = pDst + x * dstStride + y;
+        const __m128i t0 = _mm_unpacklo_epi16( _mm_loadl_epi64( ( const __m128i* )( src                 ) ), _mm_loadl_epi64( ( const __m128i* )( src +     srcStride ) ) );
+        const __m128i t1 = _mm_unpacklo_epi16( _mm_loadl_epi64( ( const __m128i* )( src + 2 * srcStride ) ), _mm_loadl_epi64( ( const __m128i* )( src + 3 * srcStride ) ) );
+        const __m128i u0 = _mm_unpacklo_epi32( t0, t1 );
+        const __m128i u1 = _mm_unpackhi_epi32( t0, t1 );
+        _mm_storel_epi64( ( __m128i* )( dst                 ), u0 );
+        _mm_storel_epi64( ( __m128i* )( dst +     dstStride ), _mm_unpackhi_epi64( u0, u0 ) );
+        _mm_storel_epi64( ( __m128i* )( dst + 2 * dstStride ), u1 );
+        _mm_storel_epi64( ( __m128i* )( dst + 3 * dstStride ), _mm_unpackhi_epi64( u1, u1 ) );
+      }
+    }
+  }
+}
+
+/// planar prediction (see xPredIntraPlanar), 4 or 8 columns at a time
+SIMD_TARGET_AVX2
+static Void simdIntraPlanarAVX2( const Pel* pSrc, Int srcStride, Pel* rpDst, Int dstStride, Int width, Int height )
+{
+  const Int shift1Dhor = g_aucConvertToBit[ width ] + 2;
+  const Int shift1Dver = g_aucConvertToBit[ height ] + 2;
+  const Int bottomLeft = pSrc[height*srcStride-1];
+  const Int topRight   = pSrc[width-srcStride];
+
+  Int leftColumn[MAX_CU_SIZE], rightColumn[MAX_CU_SIZE];
+  for( Int y = 0; y < height; y++ )
+  {
+    const Int left = pSrc[y*srcStride-1];
+    leftColumn[y]  = ( left << shift1Dhor ) + width;
+    rightColumn[y] = topRight - left;
+  }
+
+  if( width == 4 )
+  {
+    // horPred = leftColumn + (x+1)*rightColumn, vertPred = (topRow<<shift1Dver) + (y+1)*bottomRow
+    const __m128i xPlusOne  = _mm_setr_epi32( 1, 2, 3, 4 );
+    const __m128i topRow    = _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* )( pSrc - srcStride ) ) );
+    const __m128i bottomRow = _mm_sub_epi32( _mm_set1_epi32( bottomLeft ), topRow );
+    __m128i vertPred = _mm_slli_epi32( topRow, shift1Dver );
+    for( Int y = 0; y < height; y++ )
+    {
+      vertPred = _mm_add_epi32( vertPred, bottomRow );
+      const __m128i horPred = _mm_add_epi32( _mm_set1_epi32( leftColumn[y] ), _mm_mullo_epi32( xPlusOne, _mm_set1_epi32( rightColumn[y] ) ) );
+      const __m128i pred    = _mm_srai_epi32( _mm_add_epi32( horPred, vertPred ), shift1Dhor + 1 );
+      _mm_storel_epi64( ( __m128i* )( rpDst + y * dstStride ), _mm_packs_epi32( pred, pred ) );
+    }
+    return;
+  }
+
+  for( Int x = 0; x < width; x += 8 )
+  {
+    const __m256i xPlusOne  = _mm256_add_epi32( _mm256_setr_epi32( 1, 2, 3, 4, 5, 6, 7, 8 ), _mm256_set1_epi32( x ) );
+    const __m256i topRow    = _mm256_cvtepi16_epi32( _mm_loadu_si128( ( const __m128i* )( pSrc - srcStride + x ) ) );
+    const __m256i bottomRow = _mm256_sub_epi32( _mm256_set1_epi32( bottomLeft ), topRow );
+    __m256i vertPred = _mm256_slli_epi32( topRow, shift1Dver );
+    for( Int y = 0; y < height; y++ )
+    {
+      vertPred = _mm256_add_epi32( vertPred, bottomRow );
+      const __m256i horPred = _mm256_add_epi32( _mm256_set1_epi32( leftColumn[y] ), _mm256_mullo_epi32( xPlusOne, _mm256_set1_epi32( rightColumn[y] ) ) );
+      const __m256i pred    = _mm256_srai_epi32( _mm256_add_epi32( horPred, vertPred ), shift1Dhor + 1 );
+      _mm_storeu_si128( ( __m128i* )( rpDst + y * dstStride + x ), _mm_packs_epi32( _mm256_castsi256_si128( pred ), _mm256_extracti128_si256( pred, 1 ) ) );
+    }
+  }
+}
+
+/// top row of the DC filter (see xDCPredFiltering): pDst[x] = (pSrc[x-iSrcStride] + 3*pDst[x] + 2) >> 2, for x >= 1
+SIMD_TARGET_AVX2
+static Void simdIntraDCFilterTopRowAVX2( const Pel* pSrc, Int iSrcStride, Pel* pDst, Int iWidth )
+{
+  const Pel topLeft = pDst[0];
+  const __m128i offset = _mm_set1_epi32( 2 );
+  for( Int x = 0; x < iWidth; x += 4 )
+  {
+    const __m128i above = _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* )( pSrc + x - iSrcStride ) ) );
+    const __m128i pred  = _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* )( pDst + x ) ) );
+    __m128i sum = _mm_add_epi32( _mm_add_epi32( above, offset ), _mm_add_epi32( pred, _mm_add_epi32( pred, pred ) ) );
+    sum = _mm_srai_epi32( sum, 2 );
+    _mm_storel_epi64( ( __m128i* )( pDst + x ), _mm_packs_epi32( sum, sum ) );
+  }
+  pDst[0] = topLeft;
+}
+#endif
+
 // ====================================================================================================================
 // Constructor / destructor / initialize
 // ====================================================================================================================
@@ -186,6 +446,13 @@ Pel TComPrediction::predIntraGetPredValDC( const Pel* pSrc, Int iSrcStride, UInt
   Int iInd, iSum = 0;
   Pel pDcVal;
 
+#if VECTOR_CODING__INTRA_PREDICTION && VECTOR_CODING__AVX2 && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+  if( getSIMDExtension( SIMD_KERNELS_INTRA_PREDICTION ) >= SIMD_AVX2 )
+  {
+    iSum = simdIntraSumAboveAVX2( pSrc-iSrcStride, iWidth );
+  }
+  else
+#endif
   for (iInd = 0;iInd < iWidth;iInd++)
   {
     iSum += pSrc[iInd-iSrcStride];
@@ -245,6 +512,14 @@ Void TComPrediction::xPredIntraAng(       Int bitDepth,
   {
     const Pel dcval = predIntraGetPredValDC(pSrc, srcStride, width, height);
 
+#if VECTOR_CODING__INTRA_PREDICTION && VECTOR_CODING__AVX2 && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+    if( getSIMDExtension( SIMD_KERNELS_INTRA_PREDICTION ) >= SIMD_AVX2 )
+    {
+      simdIntraFillAVX2( pTrueDst, dstStrideTrue, width, height, dcval );
+      return;
+    }
+#endif
+
     for (Int y=height;y>0;y--, pTrueDst+=dstStrideTrue)
     {
       for (Int x=0; x<width;) // width is always a multiple of 4.
@@ -339,6 +614,12 @@ Void TComPrediction::xPredIntraAng(       Int bitDepth,
         }
       }
     }
+#if VECTOR_CODING__INTRA_PREDICTION && VECTOR_CODING__AVX2 && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+    else if( getSIMDExtension( SIMD_KERNELS_INTRA_PREDICTION ) >= SIMD_AVX2 )
+    {
+      simdIntraAngProjectAVX2( refMain, pDst, dstStride, width, height, intraPredAngle );
+    }
+#endif
     else
     {
       Pel *pDsty=pDst;
@@ -372,6 +653,13 @@ Void TComPrediction::xPredIntraAng(       Int bitDepth,
     }
 
     // Flip the block if this is the horizontal mode
+#if VECTOR_CODING__INTRA_PREDICTION && VECTOR_CODING__AVX2 && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+    if (!bIsModeVer && getSIMDExtension( SIMD_KERNELS_INTRA_PREDICTION ) >= SIMD_AVX2)
+    {
+      simdIntraTransposeAVX2( pDst, dstStride, pTrueDst, dstStrideTrue, width, height );
+    }
+    else
+#endif
     if (!bIsModeVer)
     {
       for (Int y=0; y<height; y++)
@@ -567,13 +855,35 @@ Void TComPrediction::xPredInterUni ( TComDataCU* pcCU, UInt uiPartAddr, Int iWid
   TComMv      cMv         = pcCU->getCUMvField( eRefPicList )->getMv( uiPartAddr );
   pcCU->clipMv(cMv);
 
+  TComPic*    pcRefPic    = pcCU->getSlice()->getRefPic( eRefPicList, iRefIdx );
+  xWaitForRefRows( pcCU, pcRefPic, uiPartAddr, cMv, iHeight );
+
   for (UInt comp=COMPONENT_Y; comp<pcYuvPred->getNumberValidComponents(); comp++)
   {
     const ComponentID compID=ComponentID(comp);
-    xPredInterBlk  (compID,  pcCU, pcCU->getSlice()->getRefPic( eRefPicList, iRefIdx )->getPicYuvRec(), uiPartAddr, &cMv, iWidth, iHeight, pcYuvPred, bi, pcCU->getSlice()->getSPS()->getBitDepth(toChannelType(compID)) );
+    xPredInterBlk  (compID,  pcCU, pcRefPic->getPicYuvRec(), uiPartAddr, &cMv, iWidth, iHeight, pcYuvPred, bi, pcCU->getSlice()->getSPS()->getBitDepth(toChannelType(compID)) );
   }
 }
 
+/** Wait until the reference picture rows read by the motion compensation of a partition are final.
+ * This only blocks when the reference picture is still being reconstructed by another thread (frame-parallel encoding or decoding).
+ * \param pcCU      CU containing the partition
+ * \param pcRefPic  reference picture
+ * \param partAddr  address of the partition within the CU
+ * \param mv        clipped motion vector (quarter-sample luma units)
+ * \param height    luma height of the partition
+ */
+Void TComPrediction::xWaitForRefRows( const TComDataCU* pcCU, const TComPic* pcRefPic, UInt partAddr, const TComMv& mv, Int height )
+{
+  const Int maxCUHeight = pcCU->getSlice()->getSPS()->getMaxCUHeight();
+  const Int partY       = pcCU->getCUPelY() + g_auiRasterToPelY[g_auiZscanToRaster[partAddr]];
+  // the luma interpolation filter reads NTAPS_LUMA/2 lines below the integer position, which also covers chroma
+  const Int bottomLine  = partY + height - 1 + ( mv.getVer() >> 2 ) + ( NTAPS_LUMA >> 1 ) + 1;
+  const Int ctuRow      = min( Int(pcRefPic->getFrameHeightInCtus()) - 1, max( 0, bottomLine ) / maxCUHeight );
+
+  pcRefPic->waitForReconRows( ctuRow + 1 );
+}
+
 Void TComPrediction::xPredInterBi ( TComDataCU* pcCU, UInt uiPartAddr, Int iWidth, Int iHeight, TComYuv* pcYuvPred )
 {
   TComYuv* pcMbYuv;
@@ -673,10 +983,7 @@ Void TComPrediction::xPredInterBlk(const ComponentID compID, TComDataCU *cu, TCo
     Int   tmpStride = m_filteredBlockTmp[0].getStride(compID);
     Pel*  tmp       = m_filteredBlockTmp[0].getAddr(compID);
 
-    const Int vFilterSize = isLuma(compID) ? NTAPS_LUMA : NTAPS_CHROMA;
-
-    m_if.filterHor(compID, ref - ((vFilterSize>>1) -1)*refStride, refStride, tmp, tmpStride, cxWidth, cxHeight+vFilterSize-1, xFrac, false,      chFmt, bitDepth);
-    m_if.filterVer(compID, tmp + ((vFilterSize>>1) -1)*tmpStride, tmpStride, dst, dstStride, cxWidth, cxHeight,               yFrac, false, !bi, chFmt, bitDepth);
+    m_if.filterHorVer(compID, ref, refStride, tmp, tmpStride, dst, dstStride, cxWidth, cxHeight, xFrac, yFrac, !bi, chFmt, bitDepth);
   }
 }
 
@@ -732,6 +1039,14 @@ Void TComPrediction::xPredIntraPlanar( const Pel* pSrc, Int srcStride, Pel* rpDs
 {
   assert(width <= height);
 
+#if VECTOR_CODING__INTRA_PREDICTION && VECTOR_CODING__AVX2 && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+  if( getSIMDExtension( SIMD_KERNELS_INTRA_PREDICTION ) >= SIMD_AVX2 )
+  {
+    simdIntraPlanarAVX2( pSrc, srcStride, rpDst, dstStride, width, height );
+    return;
+  }
+#endif
+
   Int leftColumn[MAX_CU_SIZE+1], topRow[MAX_CU_SIZE+1], bottomRow[MAX_CU_SIZE], rightColumn[MAX_CU_SIZE];
   UInt shift1Dhor = g_aucConvertToBit[ width ] + 2;
   UInt shift1Dver = g_aucConvertToBit[ height ] + 2;
@@ -801,6 +1116,13 @@ Void TComPrediction::xDCPredFiltering( const Pel* pSrc, Int iSrcStride, Pel* pDs
     pDst[0] = (Pel)((pSrc[-iSrcStride] + pSrc[-1] + 2 * pDst[0] + 2) >> 2);
 
     //top row (vertical filter)
+#if VECTOR_CODING__INTRA_PREDICTION && VECTOR_CODING__AVX2 && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+    if( getSIMDExtension( SIMD_KERNELS_INTRA_PREDICTION ) >= SIMD_AVX2 )
+    {
+      simdIntraDCFilterTopRowAVX2( pSrc, iSrcStride, pDst, iWidth );
+    }
+    else
+#endif
     for ( x = 1; x < iWidth; x++ )
     {
       pDst[x] = (Pel)((pSrc[x - iSrcStride] +  3 * pDst[x] + 2) >> 2);
@@ -0,0 +1,423 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TComProfiler.cpp
+    \brief    per-stage run-time profiling of the encoder and decoder
+*/
+
+#include "TComProfiler.h"
+#include "TComThreadPool.h"
+#include <stdio.h>
+
+#if defined( _MSC_VER ) && _MSC_VER < 1700
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <chrono>
+#endif
+
+#if defined(__i386__) || defined(__x86_64__) || defined(_M_IX86) || defined(_M_X64)
+#define PROFILER_TIMER_TSC 1
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#else
+#define PROFILER_TIMER_TSC 0
+#endif
+
+//! \ingroup TLibCommon
+//! \{
+
+// ====================================================================================================================
+// Tables
+// ====================================================================================================================
+
+static const TChar* const s_stageNames[NUMBER_OF_PROFILING_STAGES] =
+{
+  "intME", "fracME", "intra", "RQT", "RDOQ", "rate", "SAOdec", "entropy",
+  "NAL", "header", "parse", "pred", "itrans",
+  "deblock", "SAO", "hash", "I/O"
+};
+
+static const TChar* const s_stageDescriptions[NUMBER_OF_PROFILING_STAGES] =
+{
+  "integer motion estimation",
+  "fractional motion estimation",
+  "intra mode search",
+  "residual quadtree search",
+  "RDOQ",
+  "CABAC rate estimation",
+  "SAO decision",
+  "entropy coding",
+  "NAL unit parsing",
+  "slice header parsing",
+  "CABAC parsing",
+  "prediction",
+  "inverse transform",
+  "deblocking",
+  "SAO",
+  "picture hash",
+  "file I/O"
+};
+
+// ====================================================================================================================
+// Per-thread counters
+// ====================================================================================================================
+
+/// counters of one thread. Only the thread updates them, other threads may read them at any time
+struct ThreadProfilingCounters
+{
+  std::atomic<UInt64> time    [NUMBER_OF_PROFILING_STAGES];
+  std::atomic<UInt64> selfTime[NUMBER_OF_PROFILING_STAGES];
+  std::atomic<UInt64> calls   [NUMBER_OF_PROFILING_STAGES];
+
+  ThreadProfilingCounters()
+  {
+    for ( Int i = 0; i < NUMBER_OF_PROFILING_STAGES; i++ )
+    {
+      time[i] = 0;
+      selfTime[i] = 0;
+      calls[i] = 0;
+    }
+  }
+};
+
+/// counters of all threads that have profiled a stage. They are kept after the threads end
+class ThreadProfilingCountersList
+{
+public:
+  std::mutex                              m_mutex;
+  std::vector<ThreadProfilingCounters*>   m_counters;
+
+  ~ThreadProfilingCountersList()
+  {
+    for ( size_t i = 0; i < m_counters.size(); i++ )
+    {
+      delete m_counters[i];
+    }
+  }
+};
+
+static ThreadProfilingCountersList& getThreadCountersList()
+{
+  static ThreadProfilingCountersList list;
+  return list;
+}
+
+static THREAD_LOCAL ThreadProfilingCounters* t_pcThreadCounters = NULL;
+static THREAD_LOCAL TComProfilingScope*      t_pcCurrentScope   = NULL;
+
+static ThreadProfilingCounters* getThreadCounters()
+{
+  if ( t_pcThreadCounters == NULL )
+  {
+    ThreadProfilingCountersList& list = getThreadCountersList();
+    std::lock_guard<std::mutex> lock( list.m_mutex );
+    t_pcThreadCounters = new ThreadProfilingCounters;
+    list.m_counters.push_back( t_pcThreadCounters );
+  }
+  return t_pcThreadCounters;
+}
+
+static inline Void addToCounter( std::atomic<UInt64>& counter, UInt64 value )
+{
+  // a single writer: a relaxed load and store avoid the cost of a locked read-modify-write
+  counter.store( counter.load( std::memory_order_relaxed ) + value, std::memory_order_relaxed );
+}
+
+UInt64 TComProfiler::getTimeNs()
+{
+#if defined( _MSC_VER ) && _MSC_VER < 1700
+  // VS2010 has no <chrono>
+  LARGE_INTEGER frequency;
+  LARGE_INTEGER counter;
+  QueryPerformanceFrequency( &frequency );
+  QueryPerformanceCounter( &counter );
+  return UInt64( Double( counter.QuadPart ) * 1.0e9 / Double( frequency.QuadPart ) );
+#else
+  return UInt64( std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now().time_since_epoch() ).count() );
+#endif
+}
+
+/// time stamp counter, else nanoseconds
+static inline UInt64 readTimer()
+{
+#if PROFILER_TIMER_TSC
+  return __rdtsc();
+#else
+  return TComProfiler::getTimeNs();
+#endif
+}
+
+static UInt64 s_calibrationTimer = 0;   ///< timer and time when profiling was enabled
+static UInt64 s_calibrationTimeNs = 0;
+
+/// nanoseconds per timer tick, measured since profiling was enabled
+static Double getTimerPeriodNs()
+{
+#if PROFILER_TIMER_TSC
+  const UInt64 ticks = readTimer() - s_calibrationTimer;
+  const UInt64 time  = TComProfiler::getTimeNs() - s_calibrationTimeNs;
+  return ( ticks != 0 && time != 0 ) ? Double( time ) / Double( ticks ) : 1.0;
+#else
+  return 1.0;
+#endif
+}
+
+// ====================================================================================================================
+// TComProfilingCounters
+// ====================================================================================================================
+
+Void TComProfilingCounters::clear()
+{
+  for ( Int i = 0; i < NUMBER_OF_PROFILING_STAGES; i++ )
+  {
+    time[i] = 0;
+    selfTime[i] = 0;
+    calls[i] = 0;
+  }
+}
+
+Void TComProfilingCounters::subtract( const TComProfilingCounters& other )
+{
+  for ( Int i = 0; i < NUMBER_OF_PROFILING_STAGES; i++ )
+  {
+    time[i]     -= other.time[i];
+    selfTime[i] -= other.selfTime[i];
+    calls[i]    -= other.calls[i];
+  }
+}
+
+UInt64 TComProfilingCounters::getTotalSelfTime() const
+{
+  UInt64 total = 0;
+  for ( Int i = 0; i < NUMBER_OF_PROFILING_STAGES; i++ )
+  {
+    total += selfTime[i];
+  }
+  return total;
+}
+
+// ====================================================================================================================
+// TComProfilingScope
+// ====================================================================================================================
+
+Bool TComProfilingScope::s_bEnabled = false;
+
+Void TComProfilingScope::setEnabled( Bool bEnabled )
+{
+  if ( bEnabled && !s_bEnabled )
+  {
+    s_calibrationTimer  = readTimer();
+    s_calibrationTimeNs = TComProfiler::getTimeNs();
+  }
+  s_bEnabled = bEnabled;
+}
+
+Void TComProfilingScope::xStart()
+{
+  m_pcParent = t_pcCurrentScope;
+  for ( const TComProfilingScope* pcScope = m_pcParent; pcScope != NULL; pcScope = pcScope->m_pcParent )
+  {
+    if ( pcScope->m_stage == m_stage )
+    {
+      return;
+    }
+  }
+  m_bActive         = true;
+  m_nestedTime      = 0;
+  t_pcCurrentScope  = this;
+  m_startTime       = readTimer();
+}
+
+Void TComProfilingScope::xStop()
+{
+  const UInt64 time = readTimer() - m_startTime;
+
+  ThreadProfilingCounters* pcCounters = getThreadCounters();
+  addToCounter( pcCounters->time[m_stage],     time );
+  addToCounter( pcCounters->selfTime[m_stage], time - m_nestedTime );
+  addToCounter( pcCounters->calls[m_stage],    1 );
+
+  t_pcCurrentScope = m_pcParent;
+  if ( m_pcParent != NULL )
+  {
+    m_pcParent->m_nestedTime += time;
+  }
+}
+
+// ====================================================================================================================
+// TComProfiler
+// ====================================================================================================================
+
+Void TComProfiler::getCounters( TComProfilingCounters& counters )
+{
+  counters.clear();
+
+  ThreadProfilingCountersList& list = getThreadCountersList();
+  std::lock_guard<std::mutex> lock( list.m_mutex );
+  for ( size_t t = 0; t < list.m_counters.size(); t++ )
+  {
+    const ThreadProfilingCounters& threadCounters = *list.m_counters[t];
+    for ( Int i = 0; i < NUMBER_OF_PROFILING_STAGES; i++ )
+    {
+      counters.time[i]     += threadCounters.time[i].load( std::memory_order_relaxed );
+      counters.selfTime[i] += threadCounters.selfTime[i].load( std::memory_order_relaxed );
+      counters.calls[i]    += threadCounters.calls[i].load( std::memory_order_relaxed );
+    }
+  }
+}
+
+Double TComProfiler::getTimeMs( UInt64 ticks )
+{
+  return ticks * getTimerPeriodNs() / 1e6;
+}
+
+const TChar* TComProfiler::getStageName( ProfilingStage stage )
+{
+  return s_stageNames[stage];
+}
+
+const TChar* TComProfiler::getStageDescription( ProfilingStage stage )
+{
+  return s_stageDescriptions[stage];
+}
+
+Void TComProfiler::printSelfTimes( const TComProfilingCounters& counters )
+{
+  printf( "[ms" );
+  for ( Int i = 0; i < NUMBER_OF_PROFILING_STAGES; i++ )
+  {
+    if ( counters.calls[i] != 0 )
+    {
+      printf( " %s %.1f", s_stageNames[i], getTimeMs( counters.selfTime[i] ) );
+    }
+  }
+  printf( " ] " );
+}
+
+Void TComProfiler::printSummary( const TComProfilingCounters& counters, UInt numPictures )
+{
+  const UInt64 totalSelfTime = counters.getTotalSelfTime();
+
+  printf( "\n\nPROFILE --------------------------------------------------------\n" );
+  printf( "%-30s %12s %12s %12s %12s %7s\n", "Stage", "Calls", "Total (ms)", "Self (ms)", "Self/pic", "Share" );
+  for ( Int i = 0; i < NUMBER_OF_PROFILING_STAGES; i++ )
+  {
+    if ( counters.calls[i] != 0 )
+    {
+      printf( "%-30s %12llu %12.1f %12.2f %12.2f %6.2f%%\n", s_stageDescriptions[i], (unsigned long long)counters.calls[i],
+              getTimeMs( counters.time[i] ), getTimeMs( counters.selfTime[i] ),
+              numPictures != 0 ? getTimeMs( counters.selfTime[i] ) / numPictures : 0.0,
+              totalSelfTime != 0 ? 100.0 * counters.selfTime[i] / totalSelfTime : 0.0 );
+    }
+  }
+  printf( "Times are summed over all threads. The share is that of the profiled self time (%.1f ms).\n", getTimeMs( totalSelfTime ) );
+}
+
+// ====================================================================================================================
+// TComProfilingLog
+// ====================================================================================================================
+
+Void TComProfilingLog::reset()
+{
+  m_pictures.clear();
+  TComProfiler::getCounters( m_startCounters );
+  m_lastCounters = m_startCounters;
+}
+
+const TComProfilingCounters& TComProfilingLog::addPicture( Int poc )
+{
+  m_pictures.push_back( PictureEntry() );
+  PictureEntry& entry = m_pictures.back();
+  entry.poc = poc;
+
+  TComProfiler::getCounters( entry.counters );
+  const TComProfilingCounters currentCounters = entry.counters;
+  entry.counters.subtract( m_lastCounters );
+  m_lastCounters = currentCounters;
+
+  return entry.counters;
+}
+
+Void TComProfilingLog::getTotal( TComProfilingCounters& counters ) const
+{
+  TComProfiler::getCounters( counters );
+  counters.subtract( m_startCounters );
+}
+
+static Void writeJSONCounters( FILE* file, const TComProfilingCounters& counters )
+{
+  Bool bFirst = true;
+  fprintf( file, "{" );
+  for ( Int i = 0; i < NUMBER_OF_PROFILING_STAGES; i++ )
+  {
+    if ( counters.calls[i] != 0 )
+    {
+      fprintf( file, "%s\"%s\": { \"calls\": %llu, \"time_ms\": %.3f, \"self_ms\": %.3f }", bFirst ? " " : ", ",
+               s_stageNames[i], (unsigned long long)counters.calls[i], TComProfiler::getTimeMs( counters.time[i] ), TComProfiler::getTimeMs( counters.selfTime[i] ) );
+      bFirst = false;
+    }
+  }
+  fprintf( file, " }" );
+}
+
+Bool TComProfilingLog::writeJSON( const std::string& fileName ) const
+{
+  FILE* file = fopen( fileName.c_str(), "w" );
+  if ( file == NULL )
+  {
+    return false;
+  }
+
+  fprintf( file, "{\n  \"pictures\": [\n" );
+  for ( size_t p = 0; p < m_pictures.size(); p++ )
+  {
+    fprintf( file, "    { \"poc\": %d, \"stages\": ", m_pictures[p].poc );
+    writeJSONCounters( file, m_pictures[p].counters );
+    fprintf( file, " }%s\n", p + 1 < m_pictures.size() ? "," : "" );
+  }
+  fprintf( file, "  ],\n  \"total\": " );
+
+  TComProfilingCounters total;
+  getTotal( total );
+  writeJSONCounters( file, total );
+  fprintf( file, "\n}\n" );
+
+  return fclose( file ) == 0;
+}
+
+//! \}
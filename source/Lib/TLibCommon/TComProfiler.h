@@ -0,0 +1,197 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TComProfiler.h
+    \brief    per-stage run-time profiling of the encoder and decoder (header)
+*/
+
+#ifndef __TCOMPROFILER__
+#define __TCOMPROFILER__
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+#include "CommonDef.h"
+#include <string>
+#include <vector>
+
+//! \ingroup TLibCommon
+//! \{
+
+// ====================================================================================================================
+// Type definition
+// ====================================================================================================================
+
+/// stages whose run time and number of calls are measured by TComProfilingScope
+enum ProfilingStage
+{
+  PROFILE_ENC_INTEGER_ME        = 0,   ///< integer-pel motion search (TEncSearch::xPatternSearch, xPatternSearchFast)
+  PROFILE_ENC_FRACTIONAL_ME     = 1,   ///< half- and quarter-pel motion refinement (TEncSearch::xPatternSearchFracDIF)
+  PROFILE_ENC_INTRA_SEARCH      = 2,   ///< intra mode decision (TEncSearch::estIntraPredLumaQT, estIntraPredChromaQT)
+  PROFILE_ENC_RQT               = 3,   ///< residual quadtree search of intra and inter CUs
+  PROFILE_ENC_RDOQ              = 4,   ///< rate-distortion optimised quantisation (TComTrQuant::xRateDistOptQuant)
+  PROFILE_ENC_RATE_ESTIMATION   = 5,   ///< CABAC rate estimation: RDOQ bit tables and intra bit counting
+  PROFILE_ENC_SAO_DECISION      = 6,   ///< SAO statistics and parameter decision (TEncSampleAdaptiveOffset)
+  PROFILE_ENC_ENTROPY_CODING    = 7,   ///< final entropy coding of the slice data (TEncSlice::encodeSlice)
+  PROFILE_DEC_NAL_PARSING       = 8,   ///< reading of the NAL units from the byte stream and of their headers
+  PROFILE_DEC_SLICE_HEADER      = 9,   ///< slice header parsing (TDecCavlc::parseSliceHeader)
+  PROFILE_DEC_ENTROPY_DECODING  = 10,  ///< CABAC parsing of the CTUs, including the coefficients (TDecCu::decodeCtu)
+  PROFILE_DEC_PREDICTION        = 11,  ///< intra prediction and motion compensation of the decoder (TDecCu)
+  PROFILE_DEC_INVERSE_TRANSFORM = 12,  ///< dequantisation and inverse transform of the decoder (TDecCu)
+  PROFILE_DEBLOCKING            = 13,  ///< deblocking filter (TComLoopFilter)
+  PROFILE_SAO                   = 14,  ///< application of the SAO offsets (TComSampleAdaptiveOffset)
+  PROFILE_PICTURE_HASH          = 15,  ///< MD5, CRC and checksum of the decoded pictures
+  PROFILE_FILE_IO               = 16,  ///< reading and writing of YUV files and bitstreams
+  NUMBER_OF_PROFILING_STAGES    = 17
+};
+
+/// run time (in timer ticks, see TComProfiler::getTimeMs()) and number of calls of each stage
+struct TComProfilingCounters
+{
+  UInt64 time    [NUMBER_OF_PROFILING_STAGES];   ///< including the time of the stages nested in it
+  UInt64 selfTime[NUMBER_OF_PROFILING_STAGES];   ///< excluding the time of the stages nested in it
+  UInt64 calls   [NUMBER_OF_PROFILING_STAGES];
+
+  TComProfilingCounters() { clear(); }
+
+  Void   clear    ();
+  Void   subtract ( const TComProfilingCounters& other );
+  UInt64 getTotalSelfTime() const;
+};
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/** measures the time from its construction to its destruction as a call of a stage, on the counters of the calling
+ *  thread. The time spent in scopes of other stages constructed meanwhile by the same thread is not part of the
+ *  self time, and a scope nested in a scope of the same stage (e.g. in a recursion) is not counted.
+ *  When profiling is disabled, a scope costs a test of a global flag. Else it reads the time stamp counter, where
+ *  available.
+ */
+class TComProfilingScope
+{
+private:
+  static Bool         s_bEnabled;
+
+  ProfilingStage      m_stage;
+  Bool                m_bActive;
+  UInt64              m_startTime;
+  UInt64              m_nestedTime;           ///< time of the scopes of other stages nested in this one
+  TComProfilingScope* m_pcParent;
+
+  Void  xStart ();
+  Void  xStop  ();
+
+public:
+  TComProfilingScope( ProfilingStage stage ) : m_stage( stage ), m_bActive( false )
+  {
+    if ( s_bEnabled )
+    {
+      xStart();
+    }
+  }
+
+  ~TComProfilingScope()
+  {
+    if ( m_bActive )
+    {
+      xStop();
+    }
+  }
+
+  /// must be called before the encoding or decoding starts, not while scopes are measured
+  static Void  setEnabled ( Bool bEnabled );
+  static Bool  isEnabled  ()                  { return s_bEnabled;     }
+};
+
+/// access to the counters of all threads, and reporting
+class TComProfiler
+{
+public:
+  /// sum of the counters of all threads since the start of the process. Counters of other threads may be read while they
+  /// are being updated, in which case the calls in progress are missing
+  static Void         getCounters     ( TComProfilingCounters& counters );
+
+  /// converts timer ticks to milliseconds. The rate of the time stamp counter is measured since profiling was enabled
+  static Double       getTimeMs       ( UInt64 ticks );
+
+  /// monotonic wall-clock time in nanoseconds (std::chrono::steady_clock, or QueryPerformanceCounter with VS2010)
+  static UInt64       getTimeNs       ();
+
+  static const TChar* getStageName    ( ProfilingStage stage );   ///< short name, e.g. "RDOQ"
+  static const TChar* getStageDescription( ProfilingStage stage );
+
+  /// prints the self times, in ms, of the stages that have been called, followed by a space, as a part of a picture line
+  static Void         printSelfTimes  ( const TComProfilingCounters& counters );
+
+  /// prints a table of the calls, times and shares of the stages that have been called
+  static Void         printSummary    ( const TComProfilingCounters& counters, UInt numPictures );
+};
+
+/// per-picture record of the counters, written as a JSON file
+class TComProfilingLog
+{
+private:
+  struct PictureEntry
+  {
+    Int                   poc;
+    TComProfilingCounters counters;
+  };
+
+  TComProfilingCounters     m_startCounters;
+  TComProfilingCounters     m_lastCounters;
+  std::vector<PictureEntry> m_pictures;
+
+public:
+  Void  reset       ();   ///< discards the pictures and starts the next interval now
+
+  /** records the counters of the interval since the previous picture (or reset()) as those of the picture.
+   *  When several pictures are processed concurrently, this is the work done by all threads in the interval, not
+   *  exactly the work of the picture, but the sum over the pictures is exact.
+   *  \returns the counters of the picture
+   */
+  const TComProfilingCounters& addPicture( Int poc );
+
+  UInt  getNumPictures() const   { return UInt(m_pictures.size()); }
+  /// counters since reset(), including the work done after the last picture (e.g. writing it)
+  Void  getTotal    ( TComProfilingCounters& counters ) const;
+
+  /// writes the counters of the pictures and the total. \returns false if the file cannot be written
+  Bool  writeJSON   ( const std::string& fileName ) const;
+};
+
+//! \}
+
+#endif // __TCOMPROFILER__
@@ -43,8 +43,12 @@
 
 #if VECTOR_CODING__DISTORTION_CALCULATIONS && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
 #include <emmintrin.h>
+#include "TComCpuFeatures.h"
 #include <xmmintrin.h>
 #endif
+#if VECTOR_CODING__DISTORTION_CALCULATIONS && VECTOR_CODING__AVX2 && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+#include <immintrin.h>
+#endif
 
 //! \ingroup TLibCommon
 //! \{
@@ -167,6 +171,51 @@ Void TComRdCost::init()
   m_afpDistortFunc[DF_HADS64 ] = TComRdCost::xGetHADs;
   m_afpDistortFunc[DF_HADS16N] = TComRdCost::xGetHADs;
 
+#if VECTOR_CODING__DISTORTION_CALCULATIONS && VECTOR_CODING__AVX2 && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+  if( getSIMDExtension( SIMD_KERNELS_DISTORTION ) >= SIMD_AVX2 )
+  {
+    m_afpDistortFunc[DF_SSE    ] = TComRdCost::xGetSSEAVX2<0>;
+    m_afpDistortFunc[DF_SSE4   ] = TComRdCost::xGetSSEAVX2<4>;
+    m_afpDistortFunc[DF_SSE8   ] = TComRdCost::xGetSSEAVX2<8>;
+    m_afpDistortFunc[DF_SSE16  ] = TComRdCost::xGetSSEAVX2<16>;
+    m_afpDistortFunc[DF_SSE32  ] = TComRdCost::xGetSSEAVX2<32>;
+    m_afpDistortFunc[DF_SSE64  ] = TComRdCost::xGetSSEAVX2<64>;
+    m_afpDistortFunc[DF_SSE16N ] = TComRdCost::xGetSSEAVX2<0>;
+
+    m_afpDistortFunc[DF_SAD    ] = TComRdCost::xGetSADAVX2<0>;
+    m_afpDistortFunc[DF_SAD4   ] = TComRdCost::xGetSADAVX2<4>;
+    m_afpDistortFunc[DF_SAD8   ] = TComRdCost::xGetSADAVX2<8>;
+    m_afpDistortFunc[DF_SAD16  ] = TComRdCost::xGetSADAVX2<16>;
+    m_afpDistortFunc[DF_SAD32  ] = TComRdCost::xGetSADAVX2<32>;
+    m_afpDistortFunc[DF_SAD64  ] = TComRdCost::xGetSADAVX2<64>;
+    m_afpDistortFunc[DF_SAD16N ] = TComRdCost::xGetSAD16NAVX2;
+
+    m_afpDistortFunc[DF_SADS   ] = TComRdCost::xGetSADAVX2<0>;
+    m_afpDistortFunc[DF_SADS4  ] = TComRdCost::xGetSADAVX2<4>;
+    m_afpDistortFunc[DF_SADS8  ] = TComRdCost::xGetSADAVX2<8>;
+    m_afpDistortFunc[DF_SADS16 ] = TComRdCost::xGetSADAVX2<16>;
+    m_afpDistortFunc[DF_SADS32 ] = TComRdCost::xGetSADAVX2<32>;
+    m_afpDistortFunc[DF_SADS64 ] = TComRdCost::xGetSADAVX2<64>;
+    m_afpDistortFunc[DF_SADS16N] = TComRdCost::xGetSAD16NAVX2;
+
+    m_afpDistortFunc[DF_SAD12  ] = TComRdCost::xGetSADAVX2<12>;
+    m_afpDistortFunc[DF_SAD24  ] = TComRdCost::xGetSADAVX2<24>;
+    m_afpDistortFunc[DF_SAD48  ] = TComRdCost::xGetSADAVX2<48>;
+
+    m_afpDistortFunc[DF_SADS12 ] = TComRdCost::xGetSADAVX2<12>;
+    m_afpDistortFunc[DF_SADS24 ] = TComRdCost::xGetSADAVX2<24>;
+    m_afpDistortFunc[DF_SADS48 ] = TComRdCost::xGetSADAVX2<48>;
+
+    m_afpDistortFunc[DF_HADS   ] = TComRdCost::xGetHADsAVX2;
+    m_afpDistortFunc[DF_HADS4  ] = TComRdCost::xGetHADsAVX2;
+    m_afpDistortFunc[DF_HADS8  ] = TComRdCost::xGetHADsAVX2;
+    m_afpDistortFunc[DF_HADS16 ] = TComRdCost::xGetHADsAVX2;
+    m_afpDistortFunc[DF_HADS32 ] = TComRdCost::xGetHADsAVX2;
+    m_afpDistortFunc[DF_HADS64 ] = TComRdCost::xGetHADsAVX2;
+    m_afpDistortFunc[DF_HADS16N] = TComRdCost::xGetHADsAVX2;
+  }
+#endif
+
   m_costMode                   = COST_STANDARD_LOSSY;
 
   m_motionLambda               = 0;
@@ -531,7 +580,7 @@ Distortion TComRdCost::xGetSAD( DistParam* pcDtParam )
   Distortion uiSum = 0;
 
 #if VECTOR_CODING__DISTORTION_CALCULATIONS && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
-  if( pcDtParam->bitDepth <= 10 )
+  if( pcDtParam->bitDepth <= 10 && getSIMDExtension( SIMD_KERNELS_DISTORTION ) >= SIMD_SSE2 )
   {
     if( ( iCols & 0x07 ) == 0 )
     {
@@ -592,7 +641,7 @@ Distortion TComRdCost::xGetSAD4( DistParam* pcDtParam )
   Distortion uiSum = 0;
 
 #if VECTOR_CODING__DISTORTION_CALCULATIONS && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
-  if( pcDtParam->bitDepth <= 10 )
+  if( pcDtParam->bitDepth <= 10 && getSIMDExtension( SIMD_KERNELS_DISTORTION ) >= SIMD_SSE2 )
   {
     for( ; iRows != 0; iRows-=iSubStep )
     {
@@ -639,7 +688,7 @@ Distortion TComRdCost::xGetSAD8( DistParam* pcDtParam )
   Distortion uiSum = 0;
 
 #if VECTOR_CODING__DISTORTION_CALCULATIONS && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
-  if( pcDtParam->bitDepth <= 10 )
+  if( pcDtParam->bitDepth <= 10 && getSIMDExtension( SIMD_KERNELS_DISTORTION ) >= SIMD_SSE2 )
   {
     for( ; iRows != 0; iRows-=iSubStep )
     {
@@ -690,7 +739,7 @@ Distortion TComRdCost::xGetSAD16( DistParam* pcDtParam )
   Distortion uiSum = 0;
 
 #if VECTOR_CODING__DISTORTION_CALCULATIONS && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
-  if( pcDtParam->bitDepth <= 10 )
+  if( pcDtParam->bitDepth <= 10 && getSIMDExtension( SIMD_KERNELS_DISTORTION ) >= SIMD_SSE2 )
   {
     for( ; iRows != 0; iRows-=iSubStep )
     {
@@ -785,7 +834,7 @@ Distortion TComRdCost::xGetSAD16N( DistParam* pcDtParam )
   Distortion uiSum = 0;
 
 #if VECTOR_CODING__DISTORTION_CALCULATIONS && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
-  if( pcDtParam->bitDepth <= 10 )
+  if( pcDtParam->bitDepth <= 10 && getSIMDExtension( SIMD_KERNELS_DISTORTION ) >= SIMD_SSE2 )
   {
     for( ; iRows != 0; iRows-=iSubStep )
     {
@@ -846,7 +895,7 @@ Distortion TComRdCost::xGetSAD32( DistParam* pcDtParam )
   Distortion uiSum = 0;
 
 #if VECTOR_CODING__DISTORTION_CALCULATIONS && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
-  if( pcDtParam->bitDepth <= 10 )
+  if( pcDtParam->bitDepth <= 10 && getSIMDExtension( SIMD_KERNELS_DISTORTION ) >= SIMD_SSE2 )
   {
     for( ; iRows != 0; iRows-=iSubStep )
     {
@@ -921,7 +970,7 @@ Distortion TComRdCost::xGetSAD24( DistParam* pcDtParam )
   Distortion uiSum = 0;
 
 #if VECTOR_CODING__DISTORTION_CALCULATIONS && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
-  if( pcDtParam->bitDepth <= 10 )
+  if( pcDtParam->bitDepth <= 10 && getSIMDExtension( SIMD_KERNELS_DISTORTION ) >= SIMD_SSE2 )
   {
     for( ; iRows != 0; iRows-=iSubStep )
     {
@@ -988,7 +1037,7 @@ Distortion TComRdCost::xGetSAD64( DistParam* pcDtParam )
   Distortion uiSum = 0;
 
 #if VECTOR_CODING__DISTORTION_CALCULATIONS && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
-  if( pcDtParam->bitDepth <= 10 )
+  if( pcDtParam->bitDepth <= 10 && getSIMDExtension( SIMD_KERNELS_DISTORTION ) >= SIMD_SSE2 )
   {
     for( ; iRows != 0; iRows-=iSubStep )
     {
@@ -1095,7 +1144,7 @@ Distortion TComRdCost::xGetSAD48( DistParam* pcDtParam )
   Distortion uiSum = 0;
 
 #if VECTOR_CODING__DISTORTION_CALCULATIONS && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
-  if( pcDtParam->bitDepth <= 10 )
+  if( pcDtParam->bitDepth <= 10 && getSIMDExtension( SIMD_KERNELS_DISTORTION ) >= SIMD_SSE2 )
   {
     for( ; iRows != 0; iRows-=iSubStep )
     {
@@ -1649,7 +1698,7 @@ Distortion TComRdCost::xCalcHADs8x8( const Pel *piOrg, const Pel *piCur, Int iSt
   )
 {
 #if VECTOR_CODING__DISTORTION_CALCULATIONS && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
-  if( bitDepth <= 10 )
+  if( bitDepth <= 10 && getSIMDExtension( SIMD_KERNELS_DISTORTION ) >= SIMD_SSE2 )
   {
     return( simdHADs8x8( piOrg , piCur , iStrideOrg , iStrideCur ) );
   }
@@ -1823,4 +1872,378 @@ Distortion TComRdCost::xGetHADs( DistParam* pcDtParam )
   return ( uiSum >> DISTORTION_PRECISION_ADJUSTMENT(pcDtParam->bitDepth-8) );
 }
 
+#if VECTOR_CODING__DISTORTION_CALCULATIONS && VECTOR_CODING__AVX2 && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+// ====================================================================================================================
+// AVX2 distortion functions
+// ====================================================================================================================
+
+// The sums are accumulated in 32-bit lanes, which gives the same result as the C code since Distortion is 32 bits wide
+// in this configuration. The differences are computed in 16 bits, which holds for all bit depths that fit in a Pel.
+
+SIMD_TARGET_AVX2
+static inline UInt simdHorizontalSum32bAVX2( __m256i m )
+{
+  __m128i sum = _mm_add_epi32( _mm256_castsi256_si128( m ), _mm256_extracti128_si256( m, 1 ) );
+  sum = _mm_add_epi32( sum, _mm_shuffle_epi32( sum, _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+  sum = _mm_add_epi32( sum, _mm_shuffle_epi32( sum, _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+  return UInt( _mm_cvtsi128_si32( sum ) );
+}
+
+/// adds the absolute (bSSE: squared, then shifted if bShift) differences of 16 samples to the 32-bit lanes of sum
+template<Bool bSSE, Bool bShift>
+SIMD_TARGET_AVX2
+static inline __m256i simdAccumulateDiff16AVX2( __m256i sum, __m256i org, __m256i cur, __m128i shift )
+{
+  const __m256i diff = _mm256_sub_epi16( org, cur );
+  if( !bSSE )
+  {
+    return _mm256_add_epi32( sum, _mm256_madd_epi16( _mm256_abs_epi16( diff ), _mm256_set1_epi16( 1 ) ) );
+  }
+  if( !bShift )
+  {
+    return _mm256_add_epi32( sum, _mm256_madd_epi16( diff, diff ) );
+  }
+  // each square is shifted on its own, as in the C code
+  const __m256i lo = _mm256_cvtepi16_epi32( _mm256_castsi256_si128( diff ) );
+  const __m256i hi = _mm256_cvtepi16_epi32( _mm256_extracti128_si256( diff, 1 ) );
+  sum = _mm256_add_epi32( sum, _mm256_srl_epi32( _mm256_mullo_epi32( lo, lo ), shift ) );
+  return _mm256_add_epi32( sum, _mm256_srl_epi32( _mm256_mullo_epi32( hi, hi ), shift ) );
+}
+
+/// as simdAccumulateDiff16AVX2, for 8 samples (or 4, with the upper samples of org and cur set to zero)
+template<Bool bSSE, Bool bShift>
+SIMD_TARGET_AVX2
+static inline __m256i simdAccumulateDiff8AVX2( __m256i sum, __m128i org, __m128i cur, __m128i shift )
+{
+  const __m256i diff = _mm256_cvtepi16_epi32( _mm_sub_epi16( org, cur ) );
+  if( !bSSE )
+  {
+    return _mm256_add_epi32( sum, _mm256_abs_epi32( diff ) );
+  }
+  const __m256i square = _mm256_mullo_epi32( diff, diff );
+  return _mm256_add_epi32( sum, bShift ? _mm256_srl_epi32( square, shift ) : square );
+}
+
+SIMD_TARGET_AVX2
+static inline __m256i simdLoad2x128AVX2( const Pel* pLo, const Pel* pHi )
+{
+  return _mm256_inserti128_si256( _mm256_castsi128_si256( _mm_loadu_si128( ( const __m128i* )pLo ) ), _mm_loadu_si128( ( const __m128i* )pHi ), 1 );
+}
+
+SIMD_TARGET_AVX2
+static inline __m256i simdLoad4x64AVX2( const Pel* p, Int iStride )
+{
+  const __m128i lo = _mm_unpacklo_epi64( _mm_loadl_epi64( ( const __m128i* )p ), _mm_loadl_epi64( ( const __m128i* )( p + iStride ) ) );
+  const __m128i hi = _mm_unpacklo_epi64( _mm_loadl_epi64( ( const __m128i* )( p + 2 * iStride ) ), _mm_loadl_epi64( ( const __m128i* )( p + 3 * iStride ) ) );
+  return _mm256_inserti128_si256( _mm256_castsi128_si256( lo ), hi, 1 );
+}
+
+/** sum of absolute (bSSE: squared) differences of a block
+ * \param iWidth  block width known at compile time, 0: iCols (4 and 8 wide blocks are processed 4 and 2 rows at a time)
+ */
+template<Int iWidth, Bool bSSE, Bool bShift>
+SIMD_TARGET_AVX2
+static UInt simdGetDistortionAVX2( const Pel* piOrg, Int iStrideOrg, const Pel* piCur, Int iStrideCur, Int iCols, Int iRows, __m128i shift )
+{
+  __m256i sum  = _mm256_setzero_si256();
+  UInt    uiSum = 0;
+  Int     y     = 0;
+
+  if( iWidth == 4 )
+  {
+    for( ; y + 4 <= iRows; y += 4, piOrg += 4 * iStrideOrg, piCur += 4 * iStrideCur )
+    {
+      sum = simdAccumulateDiff16AVX2<bSSE, bShift>( sum, simdLoad4x64AVX2( piOrg, iStrideOrg ), simdLoad4x64AVX2( piCur, iStrideCur ), shift );
+    }
+  }
+  else if( iWidth == 8 || iWidth == 12 )
+  {
+    for( ; y + 2 <= iRows; y += 2, piOrg += 2 * iStrideOrg, piCur += 2 * iStrideCur )
+    {
+      sum = simdAccumulateDiff16AVX2<bSSE, bShift>( sum, simdLoad2x128AVX2( piOrg, piOrg + iStrideOrg ), simdLoad2x128AVX2( piCur, piCur + iStrideCur ), shift );
+      if( iWidth == 12 )
+      {
+        const __m128i org = _mm_unpacklo_epi64( _mm_loadl_epi64( ( const __m128i* )( piOrg + 8 ) ), _mm_loadl_epi64( ( const __m128i* )( piOrg + iStrideOrg + 8 ) ) );
+        const __m128i cur = _mm_unpacklo_epi64( _mm_loadl_epi64( ( const __m128i* )( piCur + 8 ) ), _mm_loadl_epi64( ( const __m128i* )( piCur + iStrideCur + 8 ) ) );
+        sum = simdAccumulateDiff8AVX2<bSSE, bShift>( sum, org, cur, shift );
+      }
+    }
+  }
+
+  // remaining rows, one at a time
+  const Int iRowWidth = iWidth ? iWidth : iCols;
+  for( ; y < iRows; y++, piOrg += iStrideOrg, piCur += iStrideCur )
+  {
+    Int x = 0;
+    for( ; x + 16 <= iRowWidth; x += 16 )
+    {
+      sum = simdAccumulateDiff16AVX2<bSSE, bShift>( sum, _mm256_loadu_si256( ( const __m256i* )( piOrg + x ) ), _mm256_loadu_si256( ( const __m256i* )( piCur + x ) ), shift );
+    }
+    if( x + 8 <= iRowWidth )
+    {
+      sum = simdAccumulateDiff8AVX2<bSSE, bShift>( sum, _mm_loadu_si128( ( const __m128i* )( piOrg + x ) ), _mm_loadu_si128( ( const __m128i* )( piCur + x ) ), shift );
+      x += 8;
+    }
+    if( x + 4 <= iRowWidth )
+    {
+      sum = simdAccumulateDiff8AVX2<bSSE, bShift>( sum, _mm_loadl_epi64( ( const __m128i* )( piOrg + x ) ), _mm_loadl_epi64( ( const __m128i* )( piCur + x ) ), shift );
+      x += 4;
+    }
+    for( ; x < iRowWidth; x++ )
+    {
+      const Int iTemp = piOrg[x] - piCur[x];
+      uiSum += bSSE ? UInt( ( iTemp * iTemp ) >> _mm_cvtsi128_si32( shift ) ) : UInt( abs( iTemp ) );
+    }
+  }
+
+  return uiSum + simdHorizontalSum32bAVX2( sum );
+}
+
+template<Int iWidth>
+Distortion TComRdCost::xGetSSEAVX2( DistParam* pcDtParam )
+{
+  if ( pcDtParam->bApplyWeight )
+  {
+    assert( iWidth == 0 || pcDtParam->iCols == iWidth );
+    return TComRdCostWeightPrediction::xGetSSEw( pcDtParam );
+  }
+  const UInt uiShift = DISTORTION_PRECISION_ADJUSTMENT((pcDtParam->bitDepth-8) << 1);
+
+  if( uiShift == 0 )
+  {
+    return simdGetDistortionAVX2<iWidth, true, false>( pcDtParam->pOrg, pcDtParam->iStrideOrg, pcDtParam->pCur, pcDtParam->iStrideCur,
+                                                      pcDtParam->iCols, pcDtParam->iRows, _mm_setzero_si128() );
+  }
+  return simdGetDistortionAVX2<iWidth, true, true>( pcDtParam->pOrg, pcDtParam->iStrideOrg, pcDtParam->pCur, pcDtParam->iStrideCur,
+                                                   pcDtParam->iCols, pcDtParam->iRows, _mm_cvtsi32_si128( uiShift ) );
+}
+
+template<Int iWidth>
+Distortion TComRdCost::xGetSADAVX2( DistParam* pcDtParam )
+{
+  if ( pcDtParam->bApplyWeight )
+  {
+    return TComRdCostWeightPrediction::xGetSADw( pcDtParam );
+  }
+  if( iWidth == 0 )
+  {
+    // like xGetSAD: all rows, and the early exit of the C code for the bit depths the SSE code does not handle
+    if( pcDtParam->bitDepth > 10 )
+    {
+      return xGetSAD( pcDtParam );
+    }
+    const Distortion uiSum = simdGetDistortionAVX2<0, false, false>( pcDtParam->pOrg, pcDtParam->iStrideOrg, pcDtParam->pCur, pcDtParam->iStrideCur,
+                                                                     pcDtParam->iCols, pcDtParam->iRows, _mm_setzero_si128() );
+    return ( uiSum >> DISTORTION_PRECISION_ADJUSTMENT(pcDtParam->bitDepth-8) );
+  }
+
+  const Int iSubShift = pcDtParam->iSubShift;
+  Distortion uiSum = simdGetDistortionAVX2<iWidth, false, false>( pcDtParam->pOrg, pcDtParam->iStrideOrg << iSubShift, pcDtParam->pCur, pcDtParam->iStrideCur << iSubShift,
+                                                                  iWidth, pcDtParam->iRows >> iSubShift, _mm_setzero_si128() );
+  uiSum <<= iSubShift;
+  return ( uiSum >> DISTORTION_PRECISION_ADJUSTMENT(pcDtParam->bitDepth-8) );
+}
+
+Distortion TComRdCost::xGetSAD16NAVX2( DistParam* pcDtParam )
+{
+  const Int iSubShift = pcDtParam->iSubShift;
+  Distortion uiSum = simdGetDistortionAVX2<0, false, false>( pcDtParam->pOrg, pcDtParam->iStrideOrg << iSubShift, pcDtParam->pCur, pcDtParam->iStrideCur << iSubShift,
+                                                             pcDtParam->iCols, pcDtParam->iRows >> iSubShift, _mm_setzero_si128() );
+  uiSum <<= iSubShift;
+  return ( uiSum >> DISTORTION_PRECISION_ADJUSTMENT(pcDtParam->bitDepth-8) );
+}
+
+/// one dimensional 8-point Hadamard transform across the eight registers
+SIMD_TARGET_AVX2
+static inline Void simdHAD1D8x32bAVX2( __m256i* m )
+{
+  for( Int iDist = 4; iDist > 0; iDist >>= 1 )
+  {
+    for( Int k = 0; k < 8; k++ )
+    {
+      if( ( k & iDist ) == 0 )
+      {
+        const __m256i a = m[k];
+        m[k]         = _mm256_add_epi32( a, m[k + iDist] );
+        m[k + iDist] = _mm256_sub_epi32( a, m[k + iDist] );
+      }
+    }
+  }
+}
+
+SIMD_TARGET_AVX2
+static inline Void simd8x8Transpose32bAVX2( __m256i* m )
+{
+  __m256i t[8], u[8];
+  for( Int k = 0; k < 8; k += 2 )
+  {
+    t[k]     = _mm256_unpacklo_epi32( m[k], m[k + 1] );
+    t[k + 1] = _mm256_unpackhi_epi32( m[k], m[k + 1] );
+  }
+  for( Int k = 0; k < 8; k += 4 )
+  {
+    u[k]     = _mm256_unpacklo_epi64( t[k],     t[k + 2] );
+    u[k + 1] = _mm256_unpackhi_epi64( t[k],     t[k + 2] );
+    u[k + 2] = _mm256_unpacklo_epi64( t[k + 1], t[k + 3] );
+    u[k + 3] = _mm256_unpackhi_epi64( t[k + 1], t[k + 3] );
+  }
+  for( Int k = 0; k < 4; k++ )
+  {
+    m[k]     = _mm256_permute2x128_si256( u[k], u[k + 4], 0x20 );
+    m[k + 4] = _mm256_permute2x128_si256( u[k], u[k + 4], 0x31 );
+  }
+}
+
+/// same result as xCalcHADs8x8
+SIMD_TARGET_AVX2
+static UInt simdHADs8x8AVX2( const Pel* piOrg, const Pel* piCur, Int iStrideOrg, Int iStrideCur )
+{
+  __m256i m[8];
+  for( Int k = 0; k < 8; k++, piOrg += iStrideOrg, piCur += iStrideCur )
+  {
+    m[k] = _mm256_cvtepi16_epi32( _mm_sub_epi16( _mm_loadu_si128( ( const __m128i* )piOrg ), _mm_loadu_si128( ( const __m128i* )piCur ) ) );
+  }
+
+  // vertical, then horizontal (the order of the coefficients does not matter for the sum)
+  simdHAD1D8x32bAVX2( m );
+  simd8x8Transpose32bAVX2( m );
+  simdHAD1D8x32bAVX2( m );
+
+  __m256i sum = _mm256_abs_epi32( m[0] );
+  for( Int k = 1; k < 8; k++ )
+  {
+    sum = _mm256_add_epi32( sum, _mm256_abs_epi32( m[k] ) );
+  }
+  return ( simdHorizontalSum32bAVX2( sum ) + 2 ) >> 2;
+}
+
+/** same result as xCalcHADs4x4 for two horizontally adjacent 4x4 blocks, or for one if bSingle
+ *  (the first block is in the lower 128-bit lane, the second one in the upper lane)
+ */
+template<Bool bSingle>
+SIMD_TARGET_AVX2
+static UInt simdHADs4x4PairAVX2( const Pel* piOrg, const Pel* piCur, Int iStrideOrg, Int iStrideCur )
+{
+  __m256i m[4];
+  for( Int k = 0; k < 4; k++, piOrg += iStrideOrg, piCur += iStrideCur )
+  {
+    const __m128i org = bSingle ? _mm_loadl_epi64( ( const __m128i* )piOrg ) : _mm_loadu_si128( ( const __m128i* )piOrg );
+    const __m128i cur = bSingle ? _mm_loadl_epi64( ( const __m128i* )piCur ) : _mm_loadu_si128( ( const __m128i* )piCur );
+    m[k] = _mm256_cvtepi16_epi32( _mm_sub_epi16( org, cur ) );
+  }
+
+  for( Int iPass = 0; iPass < 2; iPass++ )
+  {
+    const __m256i a0 = _mm256_add_epi32( m[0], m[2] );
+    const __m256i a1 = _mm256_add_epi32( m[1], m[3] );
+    const __m256i a2 = _mm256_sub_epi32( m[0], m[2] );
+    const __m256i a3 = _mm256_sub_epi32( m[1], m[3] );
+    m[0] = _mm256_add_epi32( a0, a1 );
+    m[1] = _mm256_sub_epi32( a0, a1 );
+    m[2] = _mm256_add_epi32( a2, a3 );
+    m[3] = _mm256_sub_epi32( a2, a3 );
+
+    if( iPass == 0 )
+    {
+      // transpose the 4x4 block of each 128-bit lane
+      const __m256i t0 = _mm256_unpacklo_epi32( m[0], m[1] );
+      const __m256i t1 = _mm256_unpackhi_epi32( m[0], m[1] );
+      const __m256i t2 = _mm256_unpacklo_epi32( m[2], m[3] );
+      const __m256i t3 = _mm256_unpackhi_epi32( m[2], m[3] );
+      m[0] = _mm256_unpacklo_epi64( t0, t2 );
+      m[1] = _mm256_unpackhi_epi64( t0, t2 );
+      m[2] = _mm256_unpacklo_epi64( t1, t3 );
+      m[3] = _mm256_unpackhi_epi64( t1, t3 );
+    }
+  }
+
+  __m256i sum = _mm256_add_epi32( _mm256_add_epi32( _mm256_abs_epi32( m[0] ), _mm256_abs_epi32( m[1] ) ),
+                                  _mm256_add_epi32( _mm256_abs_epi32( m[2] ), _mm256_abs_epi32( m[3] ) ) );
+  sum = _mm256_add_epi32( sum, _mm256_shuffle_epi32( sum, _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+  sum = _mm256_add_epi32( sum, _mm256_shuffle_epi32( sum, _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+
+  const UInt satd0 = ( UInt( _mm_cvtsi128_si32( _mm256_castsi256_si128( sum ) ) ) + 1 ) >> 1;
+  if( bSingle )
+  {
+    return satd0;
+  }
+  return satd0 + ( ( UInt( _mm_cvtsi128_si32( _mm256_extracti128_si256( sum, 1 ) ) ) + 1 ) >> 1 );
+}
+
+Distortion TComRdCost::xGetHADsAVX2( DistParam* pcDtParam )
+{
+  if ( pcDtParam->bApplyWeight )
+  {
+    return TComRdCostWeightPrediction::xGetHADsw( pcDtParam );
+  }
+  const Pel* piOrg      = pcDtParam->pOrg;
+  const Pel* piCur      = pcDtParam->pCur;
+  const Int  iRows      = pcDtParam->iRows;
+  const Int  iCols      = pcDtParam->iCols;
+  const Int  iStrideCur = pcDtParam->iStrideCur;
+  const Int  iStrideOrg = pcDtParam->iStrideOrg;
+  const Int  iStep      = pcDtParam->iStep;
+
+  Int  x, y;
+
+  Distortion uiSum = 0;
+
+  assert( iStep == 1 );
+
+  if( ( iRows % 8 == 0) && (iCols % 8 == 0) )
+  {
+    Int  iOffsetOrg = iStrideOrg<<3;
+    Int  iOffsetCur = iStrideCur<<3;
+    for ( y=0; y<iRows; y+= 8 )
+    {
+      for ( x=0; x<iCols; x+= 8 )
+      {
+        uiSum += simdHADs8x8AVX2( &piOrg[x], &piCur[x*iStep], iStrideOrg, iStrideCur );
+      }
+      piOrg += iOffsetOrg;
+      piCur += iOffsetCur;
+    }
+  }
+  else if( ( iRows % 4 == 0) && (iCols % 4 == 0) )
+  {
+    Int  iOffsetOrg = iStrideOrg<<2;
+    Int  iOffsetCur = iStrideCur<<2;
+
+    for ( y=0; y<iRows; y+= 4 )
+    {
+      for ( x=0; x+8<=iCols; x+= 8 )
+      {
+        uiSum += simdHADs4x4PairAVX2<false>( &piOrg[x], &piCur[x*iStep], iStrideOrg, iStrideCur );
+      }
+      if( x < iCols )
+      {
+        uiSum += simdHADs4x4PairAVX2<true>( &piOrg[x], &piCur[x*iStep], iStrideOrg, iStrideCur );
+      }
+      piOrg += iOffsetOrg;
+      piCur += iOffsetCur;
+    }
+  }
+  else if( ( iRows % 2 == 0) && (iCols % 2 == 0) )
+  {
+    Int  iOffsetOrg = iStrideOrg<<1;
+    Int  iOffsetCur = iStrideCur<<1;
+    for ( y=0; y<iRows; y+=2 )
+    {
+      for ( x=0; x<iCols; x+=2 )
+      {
+        uiSum += xCalcHADs2x2( &piOrg[x], &piCur[x*iStep], iStrideOrg, iStrideCur, iStep );
+      }
+      piOrg += iOffsetOrg;
+      piCur += iOffsetCur;
+    }
+  }
+  else
+  {
+    assert(false);
+  }
+
+  return ( uiSum >> DISTORTION_PRECISION_ADJUSTMENT(pcDtParam->bitDepth-8) );
+}
+#endif
+
 //! \}
@@ -204,6 +204,16 @@ private:
 #endif
                                       );
 
+#if VECTOR_CODING__DISTORTION_CALCULATIONS && VECTOR_CODING__AVX2 && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+  // AVX2 versions, selected by init() when the processor supports them (iWidth = 0: any block width)
+  template<Int iWidth>
+  static Distortion xGetSSEAVX2       ( DistParam* pcDtParam );
+  template<Int iWidth>
+  static Distortion xGetSADAVX2       ( DistParam* pcDtParam );
+  static Distortion xGetSAD16NAVX2    ( DistParam* pcDtParam );
+  static Distortion xGetHADsAVX2      ( DistParam* pcDtParam );
+#endif
+
 public:
 
   Distortion   getDistPart(Int bitDepth, const Pel* piCur, Int iCurStride, const Pel* piOrg, Int iOrgStride, UInt uiBlkWidth, UInt uiBlkHeight, const ComponentID compID, DFunc eDFunc = DF_SSE );
@@ -42,6 +42,7 @@
 #include <iomanip>
 #include <assert.h>
 #include "TComDataCU.h"
+#include "ContextTables.h"
 #include "Debug.h"
 // ====================================================================================================================
 // Initialize / destroy functions
@@ -258,6 +259,76 @@ Void initROM()
       //--------------------------------------------------------------------------------------------------
     }
   }
+
+  // initialise the significance map context increments
+  // (the scan within a coefficient group is the 4x4 scan of the same type for every TU size)
+  for (UInt channelTypeIndex = 0; channelTypeIndex < MAX_NUM_CHANNEL_TYPE; channelTypeIndex++)
+  {
+    for (UInt contextTypeIndex = 0; contextTypeIndex < CONTEXT_NUMBER_OF_TYPES; contextTypeIndex++)
+    {
+      for (UInt scanTypeIndex = 0; scanTypeIndex < SCAN_NUMBER_OF_TYPES; scanTypeIndex++)
+      {
+        const UInt *groupScan = g_scanOrder[SCAN_UNGROUPED][scanTypeIndex][MLS_CG_LOG2_WIDTH][MLS_CG_LOG2_HEIGHT];
+
+        UInt firstContext = significanceMapContextSetStart[channelTypeIndex][contextTypeIndex];
+        if ((contextTypeIndex == CONTEXT_TYPE_8x8) && (scanTypeIndex != SCAN_DIAG))
+        {
+          firstContext += nonDiagonalScan8x8ContextOffset[channelTypeIndex];
+        }
+
+        for (Int patternSigCtx = 0; patternSigCtx < NUMBER_OF_SIG_CTX_PATTERNS; patternSigCtx++)
+        {
+          for (UInt notFirstGroup = 0; notFirstGroup < 2; notFirstGroup++)
+          {
+            for (UInt scanPosition = 0; scanPosition < (1 << MLS_CG_SIZE); scanPosition++)
+            {
+              const UInt posX = groupScan[scanPosition] & ((1 << MLS_CG_LOG2_WIDTH) - 1);
+              const UInt posY = groupScan[scanPosition] >> MLS_CG_LOG2_WIDTH;
+
+              UInt context;
+
+              if (contextTypeIndex == CONTEXT_TYPE_SINGLE)
+              {
+                context = firstContext; //single context mode
+              }
+              else if ((notFirstGroup == 0) && (posX + posY == 0))
+              {
+                context = 0; //special case for the DC context variable
+              }
+              else if (contextTypeIndex == CONTEXT_TYPE_4x4)
+              {
+                context = firstContext + ctxIndMap4x4[(posY << MLS_CG_LOG2_WIDTH) + posX];
+              }
+              else
+              {
+                UInt cnt;
+
+                switch (patternSigCtx)
+                {
+                  case 0: //neither neighbouring group is significant: first N coefficients in scan order use 2; the next few use 1; the rest use 0.
+                    cnt = ((posX + posY) >= NEIGHBOURHOOD_00_CONTEXT_1_THRESHOLD_4x4) ? 0 : (((posX + posY) >= NEIGHBOURHOOD_00_CONTEXT_2_THRESHOLD_4x4) ? 1 : 2);
+                    break;
+                  case 1: //right group is significant, below is not: top quarter uses 2; second-from-top quarter uses 1; bottom half uses 0
+                    cnt = (posY >= ((1 << MLS_CG_LOG2_HEIGHT) >> 1)) ? 0 : ((posY >= ((1 << MLS_CG_LOG2_HEIGHT) >> 2)) ? 1 : 2);
+                    break;
+                  case 2: //below group is significant, right is not: left quarter uses 2; second-from-left quarter uses 1; right half uses 0
+                    cnt = (posX >= ((1 << MLS_CG_LOG2_WIDTH) >> 1)) ? 0 : ((posX >= ((1 << MLS_CG_LOG2_WIDTH) >> 2)) ? 1 : 2);
+                    break;
+                  default: //both neighbouring groups are significant
+                    cnt = 2;
+                    break;
+                }
+
+                context = firstContext + (notFirstGroup ? notFirstGroupNeighbourhoodContextOffset[channelTypeIndex] : 0) + cnt;
+              }
+
+              g_sigCtxIncInGroup[channelTypeIndex][contextTypeIndex][scanTypeIndex][patternSigCtx][notFirstGroup][scanPosition] = UChar(context);
+            }
+          }
+        }
+      }
+    }
+  }
 }
 
 Void destroyROM()
@@ -595,6 +666,8 @@ const UInt ctxIndMap4x4[4*4] =
 };
 
 const UInt g_uiMinInGroup[ LAST_SIGNIFICANT_GROUPS ] = {0,1,2,3,4,6,8,12,16,24};
+UChar g_sigCtxIncInGroup[MAX_NUM_CHANNEL_TYPE][CONTEXT_NUMBER_OF_TYPES][SCAN_NUMBER_OF_TYPES][NUMBER_OF_SIG_CTX_PATTERNS][2][1 << MLS_CG_SIZE];
+
 const UInt g_uiGroupIdx[ MAX_TU_SIZE ]   = {0,1,2,3,4,4,5,5,6,6,6,6,7,7,7,7,8,8,8,8,8,8,8,8,9,9,9,9,9,9,9,9};
 
 const TChar *MatrixType[SCALING_LIST_SIZE_NUM][SCALING_LIST_NUM] =
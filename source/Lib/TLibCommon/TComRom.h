@@ -102,6 +102,12 @@ extern const UChar  g_aucChromaScale[NUM_CHROMA_FORMAT][chromaQPMappingTableSize
 
 extern const UInt   ctxIndMap4x4[4*4];
 
+static const Int    NUMBER_OF_SIG_CTX_PATTERNS = 4; ///< values of patternSigCtx: significance of the right (bit 0) and lower (bit 1) coefficient groups
+
+// context increments of significant_coeff_flag for each scan position within a coefficient group, by channel type, context type
+// (TU size class or single context), scan, patternSigCtx and whether the group is not the first (DC) group of the TU
+extern       UChar  g_sigCtxIncInGroup[MAX_NUM_CHANNEL_TYPE][CONTEXT_NUMBER_OF_TYPES][SCAN_NUMBER_OF_TYPES][NUMBER_OF_SIG_CTX_PATTERNS][2][1 << MLS_CG_SIZE];
+
 extern const UInt   g_uiGroupIdx[ MAX_TU_SIZE ];
 extern const UInt   g_uiMinInGroup[ LAST_SIGNIFICANT_GROUPS ];
 
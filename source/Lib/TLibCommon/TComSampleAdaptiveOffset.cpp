@@ -36,11 +36,17 @@
 */
 
 #include "TComSampleAdaptiveOffset.h"
+#include "TComProfiler.h"
 #include <string.h>
 #include <stdlib.h>
 #include <stdio.h>
 #include <math.h>
 
+#if VECTOR_CODING__SAO && VECTOR_CODING__AVX2 && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+#include <immintrin.h>
+#include "TComCpuFeatures.h"
+#endif
+
 //! \ingroup TLibCommon
 //! \{
 
@@ -101,9 +107,174 @@ const SAOBlkParam& SAOBlkParam::operator= (const SAOBlkParam& src)
 
 }
 
+#if VECTOR_CODING__SAO && VECTOR_CODING__AVX2 && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+// ====================================================================================================================
+// AVX2 SAO
+// ====================================================================================================================
+
+/// offsets of SAO classes 0..31, as byte tables for _mm256_shuffle_epi8
+struct SAOOffsetTableAVX2
+{
+  __m256i lowBytes[2];  ///< low bytes of the offsets of classes 0..15 and 16..31, in both 128-bit lanes
+  __m256i highBytes[2]; ///< high bytes of the offsets of classes 0..15 and 16..31, in both 128-bit lanes
+};
+
+SIMD_TARGET_AVX2
+static Void simdSaoSetOffsetTableAVX2( SAOOffsetTableAVX2 &table, const Int* offset, Int numClasses )
+{
+  UChar lowBytes[32] = { 0 };
+  UChar highBytes[32] = { 0 };
+  for( Int i = 0; i < numClasses; i++ )
+  {
+    lowBytes[i]  = UChar( offset[i] & 0xff );
+    highBytes[i] = UChar( ( offset[i] >> 8 ) & 0xff );
+  }
+  for( Int t = 0; t < 2; t++ )
+  {
+    table.lowBytes[t]  = _mm256_broadcastsi128_si256( _mm_loadu_si128( ( const __m128i* )( lowBytes  + 16 * t ) ) );
+    table.highBytes[t] = _mm256_broadcastsi128_si256( _mm_loadu_si128( ( const __m128i* )( highBytes + 16 * t ) ) );
+  }
+}
+
+/// offset of the class of each 16-bit lane (class = 0..31, or 0..15 when !bUpperClasses)
+template<Bool bUpperClasses>
+SIMD_TARGET_AVX2
+static inline __m256i simdSaoLookupAVX2( const SAOOffsetTableAVX2 &table, const __m256i classIdx )
+{
+  const __m256i lowIdx    = _mm256_and_si256( classIdx, _mm256_set1_epi16( 15 ) );
+  const __m256i byteIdx   = _mm256_or_si256( lowIdx, _mm256_slli_epi16( lowIdx, 8 ) );
+  __m256i       lowBytes  = _mm256_shuffle_epi8( table.lowBytes[0],  byteIdx );
+  __m256i       highBytes = _mm256_shuffle_epi8( table.highBytes[0], byteIdx );
+  if( bUpperClasses )
+  {
+    const __m256i upper = _mm256_cmpgt_epi16( classIdx, _mm256_set1_epi16( 15 ) );
+    lowBytes  = _mm256_blendv_epi8( lowBytes,  _mm256_shuffle_epi8( table.lowBytes[1],  byteIdx ), upper );
+    highBytes = _mm256_blendv_epi8( highBytes, _mm256_shuffle_epi8( table.highBytes[1], byteIdx ), upper );
+  }
+  return _mm256_or_si256( _mm256_and_si256( lowBytes, _mm256_set1_epi16( 0xff ) ), _mm256_slli_epi16( highBytes, 8 ) );
+}
+
+/// edge class + 2 (0..4) of 16 samples, from the neighbours at -neighbourOffset and +neighbourOffset
+SIMD_TARGET_AVX2
+static inline __m256i simdSaoEdgeClassAVX2( const Pel* src, Int neighbourOffset )
+{
+  const __m256i cur = _mm256_loadu_si256( ( const __m256i* )src );
+  const __m256i n0  = _mm256_loadu_si256( ( const __m256i* )( src - neighbourOffset ) );
+  const __m256i n1  = _mm256_loadu_si256( ( const __m256i* )( src + neighbourOffset ) );
+  // sgn(cur - n) = (n > cur) - (cur > n), as 0 / -1 masks
+  __m256i edgeClass = _mm256_sub_epi16( _mm256_cmpgt_epi16( n0, cur ), _mm256_cmpgt_epi16( cur, n0 ) );
+  edgeClass = _mm256_add_epi16( edgeClass, _mm256_sub_epi16( _mm256_cmpgt_epi16( n1, cur ), _mm256_cmpgt_epi16( cur, n1 ) ) );
+  return _mm256_add_epi16( edgeClass, _mm256_set1_epi16( 2 ) );
+}
+
+/** edge offset of the samples [startX, endX) x [startY, endY) of a block: the edge class of a sample is derived from its
+ *  neighbours at -neighbourOffset and +neighbourOffset (offset points to the offsets of the edge classes -2..2).
+ */
+SIMD_TARGET_AVX2
+static Void simdSaoEdgeOffsetAVX2( const SAOOffsetTableAVX2 &table, const Int* offset, const Pel* srcBlk, Pel* resBlk, Int srcStride, Int resStride,
+                                   Int startX, Int endX, Int startY, Int endY, Int neighbourOffset, Int maxSampleValueIncl )
+{
+  const __m256i maxVal = _mm256_set1_epi16( maxSampleValueIncl );
+  for( Int y = startY; y < endY; y++ )
+  {
+    const Pel *srcLine = srcBlk + y * srcStride;
+    Pel       *resLine = resBlk + y * resStride;
+    Int x = startX;
+    for( ; x + 16 <= endX; x += 16 )
+    {
+      const __m256i sum = _mm256_adds_epi16( _mm256_loadu_si256( ( const __m256i* )( srcLine + x ) ), simdSaoLookupAVX2<false>( table, simdSaoEdgeClassAVX2( srcLine + x, neighbourOffset ) ) );
+      _mm256_storeu_si256( ( __m256i* )( resLine + x ), _mm256_min_epi16( _mm256_max_epi16( sum, _mm256_setzero_si256() ), maxVal ) );
+    }
+    for( ; x < endX; x++ )
+    {
+      const Int edgeType = sgn( srcLine[x] - srcLine[x - neighbourOffset] ) + sgn( srcLine[x] - srcLine[x + neighbourOffset] );
+      resLine[x] = Clip3<Int>( 0, maxSampleValueIncl, srcLine[x] + offset[edgeType] );
+    }
+  }
+}
+
+/// band offset of a block
+SIMD_TARGET_AVX2
+static Void simdSaoBandOffsetAVX2( const Int* offset, const Pel* srcLine, Pel* resLine, Int srcStride, Int resStride, Int width, Int height, Int channelBitDepth )
+{
+  const Int     shiftBits          = channelBitDepth - NUM_SAO_BO_CLASSES_LOG2;
+  const Int     maxSampleValueIncl = ( 1 << channelBitDepth ) - 1;
+  const __m256i maxVal             = _mm256_set1_epi16( maxSampleValueIncl );
+  SAOOffsetTableAVX2 table;
+  simdSaoSetOffsetTableAVX2( table, offset, NUM_SAO_BO_CLASSES );
+
+  for( Int y = 0; y < height; y++, srcLine += srcStride, resLine += resStride )
+  {
+    Int x = 0;
+    for( ; x + 16 <= width; x += 16 )
+    {
+      const __m256i src  = _mm256_loadu_si256( ( const __m256i* )( srcLine + x ) );
+      const __m256i band = _mm256_srl_epi16( src, _mm_cvtsi32_si128( shiftBits ) );
+      const __m256i sum  = _mm256_adds_epi16( src, simdSaoLookupAVX2<true>( table, band ) );
+      _mm256_storeu_si256( ( __m256i* )( resLine + x ), _mm256_min_epi16( _mm256_max_epi16( sum, _mm256_setzero_si256() ), maxVal ) );
+    }
+    for( ; x < width; x++ )
+    {
+      resLine[x] = Clip3<Int>( 0, maxSampleValueIncl, srcLine[x] + offset[srcLine[x] >> shiftBits] );
+    }
+  }
+}
+
+/// offsetBlock with the same arguments: the regions filtered by the C code, with the edge classes derived directly from the samples
+static Void simdSaoOffsetBlockAVX2( const Int channelBitDepth, Int typeIdx, Int* offset, Pel* srcBlk, Pel* resBlk, Int srcStride, Int resStride, Int width, Int height,
+                                    Bool isLeftAvail, Bool isRightAvail, Bool isAboveAvail, Bool isBelowAvail, Bool isAboveLeftAvail, Bool isAboveRightAvail, Bool isBelowLeftAvail, Bool isBelowRightAvail )
+{
+  if( typeIdx == SAO_TYPE_BO )
+  {
+    simdSaoBandOffsetAVX2( offset, srcBlk, resBlk, srcStride, resStride, width, height, channelBitDepth );
+    return;
+  }
+
+  const Int maxSampleValueIncl = ( 1 << channelBitDepth ) - 1;
+  const Int startX = isLeftAvail ? 0 : 1;
+  const Int endX   = isRightAvail ? width : ( width - 1 );
+  SAOOffsetTableAVX2 table;
+  simdSaoSetOffsetTableAVX2( table, offset, NUM_SAO_EO_CLASSES );
+  offset += 2;
+
+  switch( typeIdx )
+  {
+  case SAO_TYPE_EO_0:
+    simdSaoEdgeOffsetAVX2( table, offset, srcBlk, resBlk, srcStride, resStride, startX, endX, 0, height, 1, maxSampleValueIncl );
+    break;
+  case SAO_TYPE_EO_90:
+    simdSaoEdgeOffsetAVX2( table, offset, srcBlk, resBlk, srcStride, resStride, 0, width, isAboveAvail ? 0 : 1, isBelowAvail ? height : ( height - 1 ), srcStride, maxSampleValueIncl );
+    break;
+  case SAO_TYPE_EO_135:
+    simdSaoEdgeOffsetAVX2( table, offset, srcBlk, resBlk, srcStride, resStride, isAboveLeftAvail ? 0 : 1, isAboveAvail ? endX : 1, 0, 1, srcStride + 1, maxSampleValueIncl );
+    simdSaoEdgeOffsetAVX2( table, offset, srcBlk, resBlk, srcStride, resStride, startX, endX, 1, height - 1, srcStride + 1, maxSampleValueIncl );
+    simdSaoEdgeOffsetAVX2( table, offset, srcBlk, resBlk, srcStride, resStride, isBelowAvail ? startX : ( width - 1 ), isBelowRightAvail ? width : ( width - 1 ), height - 1, height, srcStride + 1, maxSampleValueIncl );
+    break;
+  case SAO_TYPE_EO_45:
+    simdSaoEdgeOffsetAVX2( table, offset, srcBlk, resBlk, srcStride, resStride, isAboveAvail ? startX : ( width - 1 ), isAboveRightAvail ? width : ( width - 1 ), 0, 1, srcStride - 1, maxSampleValueIncl );
+    simdSaoEdgeOffsetAVX2( table, offset, srcBlk, resBlk, srcStride, resStride, startX, endX, 1, height - 1, srcStride - 1, maxSampleValueIncl );
+    simdSaoEdgeOffsetAVX2( table, offset, srcBlk, resBlk, srcStride, resStride, isBelowLeftAvail ? 0 : 1, isBelowAvail ? endX : 1, height - 1, height, srcStride - 1, maxSampleValueIncl );
+    break;
+  default:
+    {
+      printf("Not a supported SAO types\n");
+      assert(0);
+      exit(-1);
+    }
+  }
+}
+#endif
+
 TComSampleAdaptiveOffset::TComSampleAdaptiveOffset()
 {
-  m_tempPicYuv = NULL;
+  for(Int compIdx = 0; compIdx < MAX_NUM_COMPONENT; compIdx++)
+  {
+    m_ctuBuf          [compIdx] = NULL;
+    m_ctuBufStride    [compIdx] = 0;
+    m_bottomLineBuf[0][compIdx] = NULL;
+    m_bottomLineBuf[1][compIdx] = NULL;
+    m_rightColumnBuf  [compIdx] = NULL;
+  }
   m_lineBufWidth = 0;
   m_signLineBuf1 = NULL;
   m_signLineBuf2 = NULL;
@@ -140,11 +311,19 @@ Void TComSampleAdaptiveOffset::create( Int picWidth, Int picHeight, ChromaFormat
   m_numCTUInHeight  = (m_picHeight/m_maxCUHeight) + ((m_picHeight % m_maxCUHeight)?1:0);
   m_numCTUsPic      = m_numCTUInHeight*m_numCTUInWidth;
 
-  //temporary picture buffer
-  if ( !m_tempPicYuv )
+  //deblocked samples of the current CTU and of its neighbours
+  for(Int compIdx = 0; compIdx < getNumberValidComponents(m_chromaFormatIDC); compIdx++)
   {
-    m_tempPicYuv = new TComPicYuv;
-    m_tempPicYuv->create( m_picWidth, m_picHeight, m_chromaFormatIDC, m_maxCUWidth, m_maxCUHeight, maxCUDepth, true );
+    const ComponentID component = ComponentID(compIdx);
+    const Int ctuWidth     = m_maxCUWidth  >> getComponentScaleX(component, m_chromaFormatIDC);
+    const Int ctuHeight    = m_maxCUHeight >> getComponentScaleY(component, m_chromaFormatIDC);
+    const Int compPicWidth = m_picWidth    >> getComponentScaleX(component, m_chromaFormatIDC);
+
+    m_ctuBufStride    [compIdx] = ctuWidth + 2;
+    m_ctuBuf          [compIdx] = new Pel[(ctuWidth + 2) * (ctuHeight + 2)];
+    m_bottomLineBuf[0][compIdx] = new Pel[compPicWidth];
+    m_bottomLineBuf[1][compIdx] = new Pel[compPicWidth];
+    m_rightColumnBuf  [compIdx] = new Pel[ctuHeight];
   }
 
   //bit-depth related
@@ -156,11 +335,16 @@ Void TComSampleAdaptiveOffset::create( Int picWidth, Int picHeight, ChromaFormat
 
 Void TComSampleAdaptiveOffset::destroy()
 {
-  if ( m_tempPicYuv )
+  for(Int compIdx = 0; compIdx < MAX_NUM_COMPONENT; compIdx++)
   {
-    m_tempPicYuv->destroy();
-    delete m_tempPicYuv;
-    m_tempPicYuv = NULL;
+    delete[] m_ctuBuf          [compIdx];
+    delete[] m_bottomLineBuf[0][compIdx];
+    delete[] m_bottomLineBuf[1][compIdx];
+    delete[] m_rightColumnBuf  [compIdx];
+    m_ctuBuf          [compIdx] = NULL;
+    m_bottomLineBuf[0][compIdx] = NULL;
+    m_bottomLineBuf[1][compIdx] = NULL;
+    m_rightColumnBuf  [compIdx] = NULL;
   }
 }
 
@@ -333,6 +517,15 @@ Void TComSampleAdaptiveOffset::offsetBlock(const Int channelBitDepth, Int typeId
     m_signLineBuf2 = new SChar[m_lineBufWidth+1];
   }
 
+#if VECTOR_CODING__SAO && VECTOR_CODING__AVX2 && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+  if( getSIMDExtension( SIMD_KERNELS_SAO ) >= SIMD_AVX2 )
+  {
+    simdSaoOffsetBlockAVX2( channelBitDepth, typeIdx, offset, srcBlk, resBlk, srcStride, resStride, width, height
+                          , isLeftAvail, isRightAvail, isAboveAvail, isBelowAvail, isAboveLeftAvail, isAboveRightAvail, isBelowLeftAvail, isBelowRightAvail );
+    return;
+  }
+#endif
+
   const Int maxSampleValueIncl = (1<< channelBitDepth )-1;
 
   Int x,y, startX, startY, endX, endY, edgeType;
@@ -551,8 +744,19 @@ Void TComSampleAdaptiveOffset::offsetBlock(const Int channelBitDepth, Int typeId
   }
 }
 
-Void TComSampleAdaptiveOffset::offsetCTU(Int ctuRsAddr, TComPicYuv* srcYuv, TComPicYuv* resYuv, SAOBlkParam& saoblkParam, TComPic* pPic)
+/** Apply the SAO offsets of a CTU in place.
+ * \param ctuRsAddr   CTU address, in raster scan order
+ * \param picYuv      deblocked picture, offset in place
+ * \param saoblkParam reconstructed SAO parameters of the CTU
+ * \param pPic        picture (TComPic) pointer
+ *
+ * \note The CTUs of a picture must all be processed, in raster scan order: the offsets of a CTU are derived from the
+ *       deblocked samples of its neighbours, and those of the CTUs above and to the left, which have already been offset,
+ *       are taken from the bottom line and right column saved when they were processed.
+ */
+Void TComSampleAdaptiveOffset::offsetCTU(Int ctuRsAddr, TComPicYuv* picYuv, SAOBlkParam& saoblkParam, TComPic* pPic)
 {
+  TComProfilingScope profilingScope( PROFILE_SAO );
   Bool isLeftAvail,isRightAvail,isAboveAvail,isBelowAvail,isAboveLeftAvail,isAboveRightAvail,isBelowLeftAvail,isBelowRightAvail;
 
   const Int numberOfComponents = getNumberValidComponents(m_chromaFormatIDC);
@@ -564,15 +768,15 @@ Void TComSampleAdaptiveOffset::offsetCTU(Int ctuRsAddr, TComPicYuv* srcYuv, TCom
       bAllOff=false;
     }
   }
-  if (bAllOff)
-  {
-    return;
-  }
 
   //block boundary availability
-  pPic->getPicSym()->deriveLoopFilterBoundaryAvailibility(ctuRsAddr, isLeftAvail,isRightAvail,isAboveAvail,isBelowAvail,isAboveLeftAvail,isAboveRightAvail,isBelowLeftAvail,isBelowRightAvail);
+  if (!bAllOff)
+  {
+    pPic->getPicSym()->deriveLoopFilterBoundaryAvailibility(ctuRsAddr, isLeftAvail,isRightAvail,isAboveAvail,isBelowAvail,isAboveLeftAvail,isAboveRightAvail,isBelowLeftAvail,isBelowRightAvail);
+  }
 
-  Int yPos   = (ctuRsAddr / m_numCTUInWidth)*m_maxCUHeight;
+  const Int ctuRow = ctuRsAddr / m_numCTUInWidth;
+  Int yPos   = ctuRow*m_maxCUHeight;
   Int xPos   = (ctuRsAddr % m_numCTUInWidth)*m_maxCUWidth;
   Int height = (yPos + m_maxCUHeight > m_picHeight)?(m_picHeight- yPos):m_maxCUHeight;
   Int width  = (xPos + m_maxCUWidth  > m_picWidth )?(m_picWidth - xPos):m_maxCUWidth;
@@ -582,30 +786,71 @@ Void TComSampleAdaptiveOffset::offsetCTU(Int ctuRsAddr, TComPicYuv* srcYuv, TCom
     const ComponentID component = ComponentID(compIdx);
     SAOOffset& ctbOffset = saoblkParam[compIdx];
 
-    if(ctbOffset.modeIdc != SAO_MODE_OFF)
+    const UInt componentScaleX = getComponentScaleX(component, pPic->getChromaFormat());
+    const UInt componentScaleY = getComponentScaleY(component, pPic->getChromaFormat());
+
+    Int  blkWidth   = (width  >> componentScaleX);
+    Int  blkHeight  = (height >> componentScaleY);
+    Int  blkXPos    = (xPos   >> componentScaleX);
+    Int  blkYPos    = (yPos   >> componentScaleY);
+
+    Int  picStride  = picYuv->getStride(component);
+    Pel* picBlk     = picYuv->getAddr(component) + blkYPos*picStride + blkXPos;
+
+    Pel* aboveLine   = m_bottomLineBuf[(ctuRow + 1) & 1][compIdx] + blkXPos;
+    Pel* bottomLine  = m_bottomLineBuf[ctuRow & 1][compIdx] + blkXPos;
+    Pel* rightColumn = m_rightColumnBuf[compIdx];
+
+    if(ctbOffset.modeIdc == SAO_MODE_OFF)
+    {
+      ::memcpy(bottomLine, picBlk + (blkHeight-1)*picStride, blkWidth*sizeof(Pel));
+      for(Int y = 0; y < blkHeight; y++)
+      {
+        rightColumn[y] = picBlk[y*picStride + blkWidth-1];
+      }
+      continue;
+    }
+
+    //deblocked samples of the CTU, and of its neighbours within the picture
+    const Int ctuStride = m_ctuBufStride[compIdx];
+    Pel*      ctuBlk    = m_ctuBuf[compIdx] + ctuStride + 1;
+    const Bool hasLeft  = (blkXPos > 0);
+    const Bool hasRight = (blkXPos + blkWidth  < picYuv->getWidth (component));
+    const Bool hasAbove = (blkYPos > 0);
+    const Bool hasBelow = (blkYPos + blkHeight < picYuv->getHeight(component));
+    const Int  startX   = hasLeft  ? -1 : 0;
+    const Int  endX     = hasRight ? (blkWidth + 1) : blkWidth;
+
+    if (hasAbove)
+    {
+      ::memcpy(ctuBlk - ctuStride + startX, aboveLine + startX, (endX - startX)*sizeof(Pel));
+    }
+    for(Int y = 0; y < blkHeight; y++)
+    {
+      if (hasLeft)
+      {
+        ctuBlk[y*ctuStride - 1] = rightColumn[y];
+      }
+      ::memcpy(ctuBlk + y*ctuStride, picBlk + y*picStride, endX*sizeof(Pel));
+    }
+    if (hasBelow)
+    {
+      ::memcpy(ctuBlk + blkHeight*ctuStride + startX, picBlk + blkHeight*picStride + startX, (endX - startX)*sizeof(Pel));
+    }
+
+    ::memcpy(bottomLine, ctuBlk + (blkHeight-1)*ctuStride, blkWidth*sizeof(Pel));
+    for(Int y = 0; y < blkHeight; y++)
     {
-      const UInt componentScaleX = getComponentScaleX(component, pPic->getChromaFormat());
-      const UInt componentScaleY = getComponentScaleY(component, pPic->getChromaFormat());
-
-      Int  blkWidth   = (width  >> componentScaleX);
-      Int  blkHeight  = (height >> componentScaleY);
-      Int  blkXPos    = (xPos   >> componentScaleX);
-      Int  blkYPos    = (yPos   >> componentScaleY);
-
-      Int  srcStride  = srcYuv->getStride(component);
-      Pel* srcBlk     = srcYuv->getAddr(component) + blkYPos*srcStride + blkXPos;
-
-      Int  resStride  = resYuv->getStride(component);
-      Pel* resBlk     = resYuv->getAddr(component) + blkYPos*resStride + blkXPos;
-
-      offsetBlock( pPic->getPicSym()->getSPS().getBitDepth(toChannelType(component)), ctbOffset.typeIdc, ctbOffset.offset
-                  , srcBlk, resBlk, srcStride, resStride, blkWidth, blkHeight
-                  , isLeftAvail, isRightAvail
-                  , isAboveAvail, isBelowAvail
-                  , isAboveLeftAvail, isAboveRightAvail
-                  , isBelowLeftAvail, isBelowRightAvail
-                  );
+      rightColumn[y] = ctuBlk[y*ctuStride + blkWidth-1];
     }
+
+    offsetBlock( pPic->getPicSym()->getSPS().getBitDepth(toChannelType(component)), ctbOffset.typeIdc, ctbOffset.offset
+                , ctuBlk, picBlk, ctuStride, picStride, blkWidth, blkHeight
+                , isLeftAvail, isRightAvail
+                , isAboveAvail, isBelowAvail
+                , isAboveLeftAvail, isAboveRightAvail
+                , isBelowLeftAvail, isBelowRightAvail
+                );
   } //compIdx
 
 }
@@ -628,15 +873,43 @@ Void TComSampleAdaptiveOffset::SAOProcess(TComPic* pDecPic)
   }
 
   TComPicYuv* resYuv = pDecPic->getPicYuvRec();
-  TComPicYuv* srcYuv = m_tempPicYuv;
-  resYuv->copyToPic(srcYuv);
   for(Int ctuRsAddr= 0; ctuRsAddr < m_numCTUsPic; ctuRsAddr++)
   {
-    offsetCTU(ctuRsAddr, srcYuv, resYuv, (pDecPic->getPicSym()->getSAOBlkParam())[ctuRsAddr], pDecPic);
+    offsetCTU(ctuRsAddr, resYuv, (pDecPic->getPicSym()->getSAOBlkParam())[ctuRsAddr], pDecPic);
   } //ctu
 }
 
 
+/** SAO process of one CTU row.
+ * \param pDecPic picture (TComPic) pointer
+ * \param ctuRow  CTU row, in units of CTUs
+ *
+ * \note Reconstructs the SAO parameters of the CTUs of the row and applies the offsets. The rows are processed from top to
+ *       bottom, each one once it and the first line of the row below it have been deblocked: the deblocked bottom line of
+ *       the row above is kept by offsetCTU().
+ */
+Void TComSampleAdaptiveOffset::SAOProcessCtuRow(TComPic* pDecPic, Int ctuRow)
+{
+  const Int startCtuRsAddr     = ctuRow * m_numCTUInWidth;
+  const Int endCtuRsAddr       = startCtuRsAddr + m_numCTUInWidth;
+  SAOBlkParam* saoBlkParams    = pDecPic->getPicSym()->getSAOBlkParam();
+
+  TComPicYuv* resYuv = pDecPic->getPicYuvRec();
+
+  for(Int ctuRsAddr = startCtuRsAddr; ctuRsAddr < endCtuRsAddr; ctuRsAddr++)
+  {
+    SAOBlkParam* mergeList[NUM_SAO_MERGE_TYPES] = { NULL };
+    getMergeList(pDecPic, ctuRsAddr, saoBlkParams, mergeList);
+
+    reconstructBlkSAOParam(saoBlkParams[ctuRsAddr], mergeList);
+  }
+
+  for(Int ctuRsAddr = startCtuRsAddr; ctuRsAddr < endCtuRsAddr; ctuRsAddr++)
+  {
+    offsetCTU(ctuRsAddr, resYuv, saoBlkParams[ctuRsAddr], pDecPic);
+  }
+}
+
 /** PCM LF disable process.
  * \param pcPic picture (TComPic) pointer
  *
@@ -647,16 +920,38 @@ Void TComSampleAdaptiveOffset::PCMLFDisableProcess (TComPic* pcPic)
   xPCMRestoration(pcPic);
 }
 
+/** PCM LF disable process of one CTU row, once the SAO offsets of the row have been applied.
+ * \param pcPic  picture (TComPic) pointer
+ * \param ctuRow CTU row, in units of CTUs
+ */
+Void TComSampleAdaptiveOffset::PCMLFDisableProcessCtuRow (TComPic* pcPic, Int ctuRow)
+{
+  xPCMRestoration(pcPic, ctuRow * m_numCTUInWidth, (ctuRow + 1) * m_numCTUInWidth);
+}
+
 /** Picture-level PCM restoration.
  * \param pcPic picture (TComPic) pointer
  */
 Void TComSampleAdaptiveOffset::xPCMRestoration(TComPic* pcPic)
 {
-  Bool  bPCMFilter = (pcPic->getSlice(0)->getSPS()->getUsePCM() && pcPic->getSlice(0)->getSPS()->getPCMFilterDisableFlag())? true : false;
+  xPCMRestoration(pcPic, 0, pcPic->getNumberOfCtusInFrame());
+}
+
+/** PCM restoration of the CTUs [startCtuRsAddr, endCtuRsAddr).
+ * \param pcPic picture (TComPic) pointer
+ *
+ * \note The parameter sets are taken from the picture symbols rather than from the slices of the picture, as further slices
+ *       may be added to the picture while its first CTU rows are being filtered.
+ */
+Void TComSampleAdaptiveOffset::xPCMRestoration(TComPic* pcPic, UInt startCtuRsAddr, UInt endCtuRsAddr)
+{
+  const TComSPS &sps = pcPic->getPicSym()->getSPS();
+  const TComPPS &pps = pcPic->getPicSym()->getPPS();
+  Bool  bPCMFilter = (sps.getUsePCM() && sps.getPCMFilterDisableFlag())? true : false;
 
-  if(bPCMFilter || pcPic->getSlice(0)->getPPS()->getTransquantBypassEnabledFlag())
+  if(bPCMFilter || pps.getTransquantBypassEnabledFlag())
   {
-    for( UInt ctuRsAddr = 0; ctuRsAddr < pcPic->getNumberOfCtusInFrame() ; ctuRsAddr++ )
+    for( UInt ctuRsAddr = startCtuRsAddr; ctuRsAddr < endCtuRsAddr ; ctuRsAddr++ )
     {
       TComDataCU* pcCU = pcPic->getCtu(ctuRsAddr);
 
@@ -692,7 +987,7 @@ Void TComSampleAdaptiveOffset::xPCMCURestoration ( TComDataCU* pcCU, UInt uiAbsZ
   }
 
   // restore PCM samples
-  if ((pcCU->getIPCMFlag(uiAbsZorderIdx)&& pcPic->getSlice(0)->getSPS()->getPCMFilterDisableFlag()) || pcCU->isLosslessCoded( uiAbsZorderIdx))
+  if ((pcCU->getIPCMFlag(uiAbsZorderIdx)&& pcPic->getPicSym()->getSPS().getPCMFilterDisableFlag()) || pcCU->isLosslessCoded( uiAbsZorderIdx))
   {
     const UInt numComponents=pcPic->getNumberValidComponents();
     for(UInt comp=0; comp<numComponents; comp++)
@@ -70,6 +70,10 @@ public:
   Void destroy();
   Void reconstructBlkSAOParams(TComPic* pic, SAOBlkParam* saoBlkParams);
   Void PCMLFDisableProcess (TComPic* pcPic);
+
+  // CTU-row-wise processing, as an alternative to reconstructBlkSAOParams(), SAOProcess() and PCMLFDisableProcess()
+  Void SAOProcessCtuRow(TComPic* pDecPic, Int ctuRow);
+  Void PCMLFDisableProcessCtuRow(TComPic* pcPic, Int ctuRow);
   static Int getMaxOffsetQVal(const Int channelBitDepth) { return (1<<(std::min<Int>(channelBitDepth,MAX_SAO_TRUNCATED_BITDEPTH)-5))-1; } //Table 9-32, inclusive
 
 protected:
@@ -78,13 +82,19 @@ protected:
   Void invertQuantOffsets(ComponentID compIdx, Int typeIdc, Int typeAuxInfo, Int* dstOffsets, Int* srcOffsets);
   Void reconstructBlkSAOParam(SAOBlkParam& recParam, SAOBlkParam* mergeList[NUM_SAO_MERGE_TYPES]);
   Int  getMergeList(TComPic* pic, Int ctuRsAddr, SAOBlkParam* blkParams, SAOBlkParam* mergeList[NUM_SAO_MERGE_TYPES]);
-  Void offsetCTU(Int ctuRsAddr, TComPicYuv* srcYuv, TComPicYuv* resYuv, SAOBlkParam& saoblkParam, TComPic* pPic);
+  Void offsetCTU(Int ctuRsAddr, TComPicYuv* picYuv, SAOBlkParam& saoblkParam, TComPic* pPic);
   Void xPCMRestoration(TComPic* pcPic);
+  Void xPCMRestoration(TComPic* pcPic, UInt startCtuRsAddr, UInt endCtuRsAddr);
   Void xPCMCURestoration ( TComDataCU* pcCU, UInt uiAbsZorderIdx, UInt uiDepth );
   Void xPCMSampleRestoration (TComDataCU* pcCU, UInt uiAbsZorderIdx, UInt uiDepth, const ComponentID compID);
 protected:
   UInt m_offsetStepLog2[MAX_NUM_COMPONENT]; //offset step
-  TComPicYuv*   m_tempPicYuv; //temporary buffer
+
+  // deblocked samples needed by offsetCTU() once the neighbouring CTUs have been offset in place
+  Pel* m_ctuBuf[MAX_NUM_COMPONENT];              //deblocked samples of the current CTU, with one sample of its neighbours on each side
+  Int  m_ctuBufStride[MAX_NUM_COMPONENT];
+  Pel* m_bottomLineBuf[2][MAX_NUM_COMPONENT];    //deblocked bottom line of the CTUs of the even and odd CTU rows
+  Pel* m_rightColumnBuf[MAX_NUM_COMPONENT];      //deblocked right column of the previous CTU of the row
   Int m_picWidth;
   Int m_picHeight;
   Int m_maxCUWidth;
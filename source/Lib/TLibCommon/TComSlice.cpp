@@ -204,13 +204,11 @@ Void  TComSlice::sortPicList        (TComList<TComPic*>& rcListPic)
       iterPicExtract++;
     }
     pcPicExtract = *(iterPicExtract);
-    pcPicExtract->setCurrSliceIdx(0);
 
     iterPicInsert = rcListPic.begin();
     while (iterPicInsert != iterPicExtract)
     {
       pcPicInsert = *(iterPicInsert);
-      pcPicInsert->setCurrSliceIdx(0);
       if (pcPicInsert->getPOC() >= pcPicExtract->getPOC())
       {
         break;
@@ -600,7 +598,6 @@ Void TComSlice::decodingRefreshMarking(Int& pocCRA, Bool& bRefreshPending, TComL
     while (iterPic != rcListPic.end())
     {
       rpcPic = *(iterPic);
-      rpcPic->setCurrSliceIdx(0);
       if (rpcPic->getPOC() != pocCurr)
       {
         rpcPic->getSlice(0)->setReferenced(false);
@@ -0,0 +1,372 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TComThreadPool.cpp
+    \brief    thread pool and synchronisation helpers
+*/
+
+#include "TComThreadPool.h"
+
+//! \ingroup TLibCommon
+//! \{
+
+// ====================================================================================================================
+// TComProgressCounter
+// ====================================================================================================================
+
+Void TComProgressCounter::reset( Int value )
+{
+  std::lock_guard<std::mutex> lock( m_mutex );
+  m_value = value;
+}
+
+Void TComProgressCounter::set( Int value )
+{
+  {
+    std::lock_guard<std::mutex> lock( m_mutex );
+    m_value = value;
+  }
+  m_cond.notify_all();
+}
+
+Int TComProgressCounter::get()
+{
+  return m_value;
+}
+
+Void TComProgressCounter::waitFor( Int value )
+{
+  if( m_value >= value )
+  {
+    return;
+  }
+  std::unique_lock<std::mutex> lock( m_mutex );
+  while( m_value < value )
+  {
+    m_cond.wait( lock );
+  }
+}
+
+// ====================================================================================================================
+// TComThreadPool
+// ====================================================================================================================
+
+// pool and index of the worker thread running on the current thread (NULL/0 for threads outside any pool)
+static THREAD_LOCAL const TComThreadPool* s_pcCurrPool   = NULL;
+static THREAD_LOCAL Int                   s_currThreadIdx = 0;
+
+TComThreadPool::TComThreadPool()
+ : m_queues(NULL)
+ , m_numQueues(0)
+ , m_numQueuedTasks(0)
+ , m_numEvents(0)
+ , m_bStop(false)
+{
+}
+
+TComThreadPool::~TComThreadPool()
+{
+  destroy();
+}
+
+Void TComThreadPool::create( Int numThreads )
+{
+  assert( m_threads.empty() && m_queues == NULL );
+  m_bStop          = false;
+  m_numQueuedTasks = 0;
+  m_numQueues      = numThreads;
+  m_queues         = new TaskQueue[m_numQueues];
+  for( Int threadIdx = 1; threadIdx < numThreads; threadIdx++ )
+  {
+    m_threads.push_back( std::thread( &TComThreadPool::xWorkerThread, this, threadIdx ) );
+  }
+}
+
+Void TComThreadPool::destroy()
+{
+  {
+    std::lock_guard<std::mutex> lock( m_mutex );
+    m_bStop = true;
+  }
+  m_taskAvailable.notify_all();
+  for( UInt i = 0; i < m_threads.size(); i++ )
+  {
+    m_threads[i].join();
+  }
+  m_threads.clear();
+  delete [] m_queues;
+  m_queues    = NULL;
+  m_numQueues = 0;
+}
+
+Void TComThreadPool::addTask( TaskFunc func, Void* param, TComTaskGroup& group )
+{
+  Task task;
+  task.func  = func;
+  task.param = param;
+  task.group = &group;
+  group.m_numPendingTasks++;
+  xPushTask( task );
+}
+
+Void TComThreadPool::addDependentTask( TaskFunc func, Void* param, TComTaskGroup& group, TComTaskDependency& dependency, Int numDependencies )
+{
+  if( numDependencies == 0 )
+  {
+    addTask( func, param, group );
+    return;
+  }
+  group.m_numPendingTasks++;
+  dependency.m_func                   = func;
+  dependency.m_param                  = param;
+  dependency.m_group                  = &group;
+  dependency.m_numPendingDependencies = numDependencies;
+}
+
+Void TComThreadPool::resolveDependency( TComTaskDependency& dependency )
+{
+  assert( dependency.m_numPendingDependencies > 0 );
+  if( --dependency.m_numPendingDependencies > 0 )
+  {
+    return;
+  }
+  Task task;
+  task.func  = dependency.m_func;
+  task.param = dependency.m_param;
+  task.group = dependency.m_group;
+  xPushTask( task );
+}
+
+Void TComThreadPool::waitForTasks( TComTaskGroup& group )
+{
+  const Int threadIdx = xGetThreadIdx();
+  while( group.m_numPendingTasks > 0 )
+  {
+    // only tasks of the group are executed here: other tasks may block on work that the caller still has to do.
+    const UInt numEvents = m_numEvents;
+    Task       task;
+    if( xFindTask( threadIdx, &group, task ) )
+    {
+      xRunTask( task, threadIdx );
+      continue;
+    }
+    // sleep until a task is queued or a group completes after the search started
+    std::unique_lock<std::mutex> lock( m_mutex );
+    while( group.m_numPendingTasks > 0 && m_numEvents == numEvents )
+    {
+      m_taskDone.wait( lock );
+    }
+  }
+}
+
+Int TComThreadPool::xGetThreadIdx() const
+{
+  return s_pcCurrPool == this ? s_currThreadIdx : 0;
+}
+
+/** Queues a task on the queue of the calling thread and wakes up a sleeping worker thread and the waiting threads.
+ */
+Void TComThreadPool::xPushTask( const Task& task )
+{
+  TaskQueue& queue = m_queues[xGetThreadIdx()];
+  {
+    std::lock_guard<std::mutex> lock( queue.mutex );
+    queue.tasks.push_back( task );
+  }
+  m_numQueuedTasks++;
+  xSignalEvent( &m_taskAvailable );   // a thread waiting for the group of the task may run it as well
+}
+
+/** Removes the oldest task of a queue, optionally restricted to one group.
+ */
+Bool TComThreadPool::xPopTask( TaskQueue& queue, const TComTaskGroup* group, Task& task )
+{
+  std::lock_guard<std::mutex> lock( queue.mutex );
+  for( std::deque<Task>::iterator it = queue.tasks.begin(); it != queue.tasks.end(); it++ )
+  {
+    if( group == NULL || it->group == group )
+    {
+      task = *it;
+      queue.tasks.erase( it );
+      m_numQueuedTasks--;
+      return true;
+    }
+  }
+  return false;
+}
+
+/** Removes the next task to be run by the given thread, optionally restricted to one group.
+ * The oldest task of the thread's own queue is preferred, then the oldest task added from outside the pool, then the oldest
+ * task of another worker thread.
+ */
+Bool TComThreadPool::xFindTask( Int threadIdx, const TComTaskGroup* group, Task& task )
+{
+  if( m_numQueuedTasks == 0 )
+  {
+    return false;
+  }
+  if( xPopTask( m_queues[threadIdx], group, task ) )
+  {
+    return true;
+  }
+  for( Int i = 0; i < m_numQueues; i++ )
+  {
+    if( i != threadIdx && xPopTask( m_queues[i], group, task ) )
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+Void TComThreadPool::xRunTask( const Task& task, Int threadIdx )
+{
+  task.func( task.param, threadIdx );
+
+  // the group may be destroyed by its waiting thread as soon as its counter reaches zero
+  if( --task.group->m_numPendingTasks == 0 )
+  {
+    xSignalEvent( NULL );
+  }
+}
+
+/** Counts a queued task or a completed group, and wakes up the threads waiting for one. The counter is modified while
+ * holding the mutex, so that a thread that has checked it before sleeping is always woken up.
+ */
+Void TComThreadPool::xSignalEvent( std::condition_variable* pcWakeOne )
+{
+  {
+    std::lock_guard<std::mutex> lock( m_mutex );
+    m_numEvents++;
+  }
+  if( pcWakeOne )
+  {
+    pcWakeOne->notify_one();
+  }
+  m_taskDone.notify_all();
+}
+
+Void TComThreadPool::xWorkerThread( Int threadIdx )
+{
+  s_pcCurrPool    = this;
+  s_currThreadIdx = threadIdx;
+
+  while( true )
+  {
+    const UInt numEvents = m_numEvents;
+    Task       task;
+    if( xFindTask( threadIdx, NULL, task ) )
+    {
+      xRunTask( task, threadIdx );
+      continue;
+    }
+    std::unique_lock<std::mutex> lock( m_mutex );
+    while( m_numEvents == numEvents && !m_bStop )
+    {
+      m_taskAvailable.wait( lock );
+    }
+    if( m_bStop && m_numQueuedTasks == 0 )
+    {
+      return;
+    }
+  }
+}
+
+#if THREAD_SUPPORT_WIN32
+// ====================================================================================================================
+// Win32 implementation of the thread support classes
+// ====================================================================================================================
+
+#ifndef _WIN32_WINNT
+#define _WIN32_WINNT 0x0600
+#endif
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#include <process.h>
+
+namespace std
+{
+
+Void mutex::lock()
+{
+  AcquireSRWLockExclusive( (PSRWLOCK)&m_srwLock );
+}
+
+Void mutex::unlock()
+{
+  ReleaseSRWLockExclusive( (PSRWLOCK)&m_srwLock );
+}
+
+Void condition_variable::wait( unique_lock<std::mutex>& lock )
+{
+  SleepConditionVariableSRW( (PCONDITION_VARIABLE)&m_conditionVariable, (PSRWLOCK)&lock.mutex()->m_srwLock, INFINITE, 0 );
+}
+
+Void condition_variable::notify_one()
+{
+  WakeConditionVariable( (PCONDITION_VARIABLE)&m_conditionVariable );
+}
+
+Void condition_variable::notify_all()
+{
+  WakeAllConditionVariable( (PCONDITION_VARIABLE)&m_conditionVariable );
+}
+
+Void thread::xStart( Function* pcFunction )
+{
+  // _beginthreadex() rather than CreateThread() initialises the C run-time library for the thread
+  m_handle = (Void*)_beginthreadex( NULL, 0, xThreadFunction, pcFunction, 0, NULL );
+  assert( m_handle != NULL );
+}
+
+UInt __stdcall thread::xThreadFunction( Void* param )
+{
+  Function* pcFunction = (Function*)param;
+  pcFunction->run();
+  delete pcFunction;
+  return 0;
+}
+
+Void thread::join()
+{
+  WaitForSingleObject( (HANDLE)m_handle, INFINITE );
+  CloseHandle( (HANDLE)m_handle );
+  m_handle = NULL;
+}
+
+}
+
+#endif // THREAD_SUPPORT_WIN32
+
+//! \}
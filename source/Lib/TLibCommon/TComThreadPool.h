@@ -0,0 +1,368 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TComThreadPool.h
+    \brief    thread pool and synchronisation helpers (header)
+*/
+
+#ifndef __TCOMTHREADPOOL__
+#define __TCOMTHREADPOOL__
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+#include "CommonDef.h"
+
+#include <deque>
+#include <vector>
+#if defined( _MSC_VER ) && _MSC_VER < 1700
+#define THREAD_SUPPORT_WIN32        1 ///< VS2010 has no <thread>, <mutex>, <atomic> and <condition_variable>: the parts used by HM are implemented below
+#include <intrin.h>
+#else
+#define THREAD_SUPPORT_WIN32        0
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#endif
+
+//! \ingroup TLibCommon
+//! \{
+
+#if THREAD_SUPPORT_WIN32
+// ====================================================================================================================
+// Subset of the C++11 thread support library, on top of the Win32 threads, slim reader/writer locks, condition
+// variables (Windows Vista or later) and interlocked operations. The Win32 objects are kept as opaque pointers, so
+// that windows.h is only included by TComThreadPool.cpp
+// ====================================================================================================================
+
+namespace std
+{
+
+class mutex
+{
+  friend class condition_variable;
+private:
+  Void*   m_srwLock;                        ///< SRWLOCK
+
+  mutex( const mutex& );
+  mutex& operator= ( const mutex& );
+
+public:
+  mutex() : m_srwLock( NULL ) {}
+
+  Void  lock   ();
+  Void  unlock ();
+};
+
+template <typename M>
+class lock_guard
+{
+private:
+  M&      m_mutex;
+
+  lock_guard( const lock_guard& );
+  lock_guard& operator= ( const lock_guard& );
+
+public:
+  explicit lock_guard( M& m ) : m_mutex( m ) { m_mutex.lock();   }
+  ~lock_guard()                              { m_mutex.unlock(); }
+};
+
+template <typename M>
+class unique_lock
+{
+private:
+  M*      m_pMutex;
+  Bool    m_bOwns;
+
+  unique_lock( const unique_lock& );
+  unique_lock& operator= ( const unique_lock& );
+
+public:
+  explicit unique_lock( M& m ) : m_pMutex( &m ), m_bOwns( true ) { m_pMutex->lock(); }
+  ~unique_lock()                                                 { if( m_bOwns ) { m_pMutex->unlock(); } }
+
+  Void  lock      ()                { m_pMutex->lock();   m_bOwns = true;  }
+  Void  unlock    ()                { m_pMutex->unlock(); m_bOwns = false; }
+  Bool  owns_lock () const          { return m_bOwns;  }
+  M*    mutex     () const          { return m_pMutex; }
+};
+
+class condition_variable
+{
+private:
+  Void*   m_conditionVariable;              ///< CONDITION_VARIABLE
+
+  condition_variable( const condition_variable& );
+  condition_variable& operator= ( const condition_variable& );
+
+public:
+  condition_variable() : m_conditionVariable( NULL ) {}
+
+  Void  wait       ( unique_lock<std::mutex>& lock );
+  Void  notify_one ();
+  Void  notify_all ();
+};
+
+enum memory_order
+{
+  memory_order_relaxed,
+  memory_order_consume,
+  memory_order_acquire,
+  memory_order_release,
+  memory_order_acq_rel,
+  memory_order_seq_cst
+};
+
+/// interlocked compare-and-exchange on 4 and 8 byte words
+template <Int size> struct AtomicWord;
+template <> struct AtomicWord<4>
+{
+  typedef long    Word;
+  static Word compareExchange( volatile Word* pWord, Word desired, Word expected ) { return _InterlockedCompareExchange( pWord, desired, expected ); }
+};
+template <> struct AtomicWord<8>
+{
+  typedef __int64 Word;
+  static Word compareExchange( volatile Word* pWord, Word desired, Word expected ) { return _InterlockedCompareExchange64( pWord, desired, expected ); }
+};
+
+/// atomic integer of 4 or 8 bytes. All operations are sequentially consistent
+template <typename T>
+class atomic
+{
+private:
+  typedef AtomicWord<sizeof( T )>   Ops;
+  typedef typename Ops::Word        Word;
+
+  mutable volatile Word m_value;
+
+  atomic( const atomic& );
+  atomic& operator= ( const atomic& );
+
+public:
+  atomic()                                        {}
+  atomic( T value ) : m_value( Word( value ) )    {}
+
+  T     load      ( memory_order = memory_order_seq_cst ) const   { return T( Ops::compareExchange( &m_value, 0, 0 ) ); }
+  Void  store     ( T value, memory_order = memory_order_seq_cst ) { exchange( value ); }
+  T     exchange  ( T value )
+  {
+    Word expected = m_value;
+    Word previous;
+    while( ( previous = Ops::compareExchange( &m_value, Word( value ), expected ) ) != expected )
+    {
+      expected = previous;
+    }
+    return T( previous );
+  }
+  T     fetch_add ( T value )
+  {
+    Word expected = m_value;
+    Word previous;
+    while( ( previous = Ops::compareExchange( &m_value, Word( T( expected ) + value ), expected ) ) != expected )
+    {
+      expected = previous;
+    }
+    return T( previous );
+  }
+
+  operator T    () const                { return load();                 }
+  T  operator=  ( T value )             { store( value ); return value;  }
+  T  operator++ ()                      { return fetch_add( T( 1 ) ) + T( 1 ); }
+  T  operator++ ( Int )                 { return fetch_add( T( 1 ) );          }
+  T  operator-- ()                      { return fetch_add( T( 0 ) - T( 1 ) ) - T( 1 ); }
+  T  operator-- ( Int )                 { return fetch_add( T( 0 ) - T( 1 ) );          }
+};
+
+/// thread running a member function with an Int argument, which is all that TComThreadPool needs
+class thread
+{
+private:
+  struct Function
+  {
+    virtual      ~Function() {}
+    virtual Void  run      () = 0;
+  };
+
+  template <typename C>
+  struct MemberFunction : public Function
+  {
+    Void ( C::*m_func )( Int );
+    C*      m_pcObject;
+    Int     m_arg;
+
+    MemberFunction( Void ( C::*func )( Int ), C* pcObject, Int arg ) : m_func( func ), m_pcObject( pcObject ), m_arg( arg ) {}
+    Void  run() { ( m_pcObject->*m_func )( m_arg ); }
+  };
+
+  Void*   m_handle;                         ///< HANDLE
+
+  Void  xStart ( Function* pcFunction );
+  static UInt __stdcall xThreadFunction( Void* param );
+
+  thread( const thread& );
+  thread& operator= ( const thread& );
+
+public:
+  thread() : m_handle( NULL ) {}
+  template <typename C>
+  thread( Void ( C::*func )( Int ), C* pcObject, Int arg ) : m_handle( NULL ) { xStart( new MemberFunction<C>( func, pcObject, arg ) ); }
+  thread( thread&& other ) : m_handle( other.m_handle ) { other.m_handle = NULL; }
+  thread& operator= ( thread&& other )      { assert( m_handle == NULL ); m_handle = other.m_handle; other.m_handle = NULL; return *this; }
+  ~thread()                                 { assert( m_handle == NULL ); }
+
+  Bool  joinable () const                   { return m_handle != NULL; }
+  Void  join     ();
+};
+
+}
+
+#endif // THREAD_SUPPORT_WIN32
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// monotonically increasing counter that other threads can wait on (e.g. number of CTUs completed in a CTU row)
+class TComProgressCounter
+{
+private:
+  std::mutex              m_mutex;
+  std::condition_variable m_cond;
+  std::atomic<Int>        m_value;                    ///< only modified while holding m_mutex, may be read without it
+
+public:
+  TComProgressCounter() : m_value(0) {}
+
+  Void  reset   ( Int value = 0 );
+  Void  set     ( Int value );                ///< set a new value and wake up all waiting threads
+  Int   get     ();
+  Void  waitFor ( Int value );                ///< block until the counter has reached at least the given value
+};
+
+/// set of tasks whose completion can be waited for as a whole
+class TComTaskGroup
+{
+  friend class TComThreadPool;
+private:
+  std::atomic<Int> m_numPendingTasks;
+
+public:
+  TComTaskGroup() : m_numPendingTasks(0) {}
+};
+
+/// task that is only queued once a number of other events have been signalled (e.g. the CTU rows it depends on have been decoded)
+class TComTaskDependency
+{
+  friend class TComThreadPool;
+private:
+  std::atomic<Int> m_numPendingDependencies;
+  Void           (*m_func)( Void* param, Int threadIdx );
+  Void*            m_param;
+  TComTaskGroup*   m_group;
+
+public:
+  TComTaskDependency() : m_numPendingDependencies(0), m_func(NULL), m_param(NULL), m_group(NULL) {}
+};
+
+/// fixed-size pool of worker threads executing queued tasks, with one task queue per thread.
+/// Tasks added from inside a task go to the queue of the thread running it, tasks added from outside the pool go to queue 0.
+/// A thread runs the oldest task of its own queue, then steals the oldest task of queue 0 and of the other queues, so that a
+/// task never waits for a later task of its group that the same thread would have to run (e.g. WPP rows).
+/// Each queue has its own lock: a thread only contends with the threads stealing from its queue. A mutex shared by all
+/// threads is only taken to sleep when no task can be found, and to wake sleeping threads up.
+class TComThreadPool
+{
+public:
+  typedef Void (*TaskFunc)( Void* param, Int threadIdx );
+
+private:
+  struct Task
+  {
+    TaskFunc       func;
+    Void*          param;
+    TComTaskGroup* group;
+  };
+
+  struct TaskQueue
+  {
+    std::mutex       mutex;
+    std::deque<Task> tasks;
+  };
+
+  std::vector<std::thread>  m_threads;
+  TaskQueue*                m_queues;                 ///< [0]: tasks added from outside the pool, [i]: tasks added by worker thread i
+  Int                       m_numQueues;
+  std::atomic<Int>          m_numQueuedTasks;
+  std::atomic<UInt>         m_numEvents;              ///< number of tasks queued and of groups completed; only modified while holding m_mutex
+  std::mutex                m_mutex;
+  std::condition_variable   m_taskAvailable;          ///< signalled when a task is queued
+  std::condition_variable   m_taskDone;               ///< signalled when a group completes or a task is queued
+  Bool                      m_bStop;
+
+  Int   xGetThreadIdx     () const;
+  Void  xPushTask         ( const Task& task );
+  Bool  xPopTask          ( TaskQueue& queue, const TComTaskGroup* group, Task& task );
+  Bool  xFindTask         ( Int threadIdx, const TComTaskGroup* group, Task& task );
+  Void  xRunTask          ( const Task& task, Int threadIdx );
+  Void  xSignalEvent      ( std::condition_variable* pcWakeOne );
+  Void  xWorkerThread     ( Int threadIdx );
+
+public:
+  TComThreadPool();
+  virtual ~TComThreadPool();
+
+  /// numThreads includes the thread that calls waitForTasks(), so numThreads-1 worker threads are started
+  Void  create            ( Int numThreads );
+  Void  destroy           ();
+
+  /// number of threads that may execute tasks concurrently. Task functions receive a thread index in [0, getNumThreads())
+  Int   getNumThreads     () const    { return Int(m_threads.size()) + 1; }
+
+  Void  addTask           ( TaskFunc func, Void* param, TComTaskGroup& group );
+
+  /// add a task that is queued after resolveDependency() has been called numDependencies times for the given dependency object
+  Void  addDependentTask  ( TaskFunc func, Void* param, TComTaskGroup& group, TComTaskDependency& dependency, Int numDependencies );
+  Void  resolveDependency ( TComTaskDependency& dependency );
+
+  /// wait until all tasks of the group have completed. The calling thread executes queued tasks of the group while waiting,
+  /// with thread index 0 when called from outside the pool
+  Void  waitForTasks      ( TComTaskGroup& group );
+};
+
+//! \}
+
+#endif // __TCOMTHREADPOOL__
@@ -44,6 +44,12 @@
 #include "ContextTables.h"
 #include "TComTU.h"
 #include "Debug.h"
+#include "TComProfiler.h"
+
+#if VECTOR_CODING__TRANSFORM && VECTOR_CODING__AVX2
+#include <immintrin.h>
+#include "TComCpuFeatures.h"
+#endif
 
 typedef struct
 {
@@ -847,6 +853,382 @@ Void partialButterflyInverse32(TCoeff *src, TCoeff *dst, Int shift, Int line, co
   }
 }
 
+#if VECTOR_CODING__TRANSFORM && VECTOR_CODING__AVX2
+// ====================================================================================================================
+// AVX2 transforms
+// ====================================================================================================================
+
+// Each register holds the same sample (or coefficient) of several lines, so that the 1D transforms are computed for
+// TR_LANES lines at once with the arithmetic of the C code: 32-bit lanes that wrap like TCoeff, or 64-bit lanes when
+// TCoeff is 64 bits wide (the multiplications then use the lower 32 bits of the operands, which hold the complete
+// value for every input allowed by the dynamic range).
+
+static const Int TR_LANES = Int( sizeof( __m256i ) / sizeof( TCoeff ) );
+
+SIMD_TARGET_AVX2
+static inline __m256i simdTrSet1( TCoeff value )
+{
+#if RExt__HIGH_BIT_DEPTH_SUPPORT
+  return _mm256_set1_epi64x( value );
+#else
+  return _mm256_set1_epi32( value );
+#endif
+}
+
+SIMD_TARGET_AVX2
+static inline __m256i simdTrAdd( __m256i a, __m256i b )
+{
+#if RExt__HIGH_BIT_DEPTH_SUPPORT
+  return _mm256_add_epi64( a, b );
+#else
+  return _mm256_add_epi32( a, b );
+#endif
+}
+
+SIMD_TARGET_AVX2
+static inline __m256i simdTrSub( __m256i a, __m256i b )
+{
+#if RExt__HIGH_BIT_DEPTH_SUPPORT
+  return _mm256_sub_epi64( a, b );
+#else
+  return _mm256_sub_epi32( a, b );
+#endif
+}
+
+/// returns x * c
+SIMD_TARGET_AVX2
+static inline __m256i simdTrMul( __m256i x, TMatrixCoeff c )
+{
+#if RExt__HIGH_BIT_DEPTH_SUPPORT
+  return _mm256_mul_epi32( x, _mm256_set1_epi64x( c ) );
+#else
+  return _mm256_mullo_epi32( x, _mm256_set1_epi32( c ) );
+#endif
+}
+
+/// returns (x + add) >> shift
+SIMD_TARGET_AVX2
+static inline __m256i simdTrRoundShift( __m256i x, __m256i add, Int shift )
+{
+  x = simdTrAdd( x, add );
+#if RExt__HIGH_BIT_DEPTH_SUPPORT
+  // there is no arithmetic 64-bit shift in AVX2: shift in the sign bits separately
+  const __m256i sign = _mm256_cmpgt_epi64( _mm256_setzero_si256(), x );
+  return _mm256_or_si256( _mm256_srl_epi64( x, _mm_cvtsi32_si128( shift ) ), _mm256_sll_epi64( sign, _mm_cvtsi32_si128( 64 - shift ) ) );
+#else
+  return _mm256_sra_epi32( x, _mm_cvtsi32_si128( shift ) );
+#endif
+}
+
+SIMD_TARGET_AVX2
+static inline __m256i simdTrClip( __m256i x, __m256i minimum, __m256i maximum )
+{
+#if RExt__HIGH_BIT_DEPTH_SUPPORT
+  x = _mm256_blendv_epi8( x, minimum, _mm256_cmpgt_epi64( minimum, x ) );
+  return _mm256_blendv_epi8( x, maximum, _mm256_cmpgt_epi64( x, maximum ) );
+#else
+  return _mm256_min_epi32( _mm256_max_epi32( x, minimum ), maximum );
+#endif
+}
+
+/// dst[c * dstStride + r] = src[r * srcStride + c], for a rows x cols block (multiples of 4)
+SIMD_TARGET_AVX2
+static Void simdTrTranspose( const TCoeff *src, Int srcStride, TCoeff *dst, Int dstStride, Int rows, Int cols )
+{
+  for( Int r = 0; r < rows; r += 4 )
+  {
+    for( Int c = 0; c < cols; c += 4 )
+    {
+      const TCoeff *s = src + r * srcStride + c;
+      TCoeff       *d = dst + c * dstStride + r;
+#if RExt__HIGH_BIT_DEPTH_SUPPORT
+      const __m256i a0 = _mm256_loadu_si256( ( const __m256i* )( s                 ) );
+      const __m256i a1 = _mm256_loadu_si256( ( const __m256i* )( s +     srcStride ) );
+      const __m256i a2 = _mm256_loadu_si256( ( const __m256i* )( s + 2 * srcStride ) );
+      const __m256i a3 = _mm256_loadu_si256( ( const __m256i* )( s + 3 * srcStride ) );
+      const __m256i t0 = _mm256_unpacklo_epi64( a0, a1 );
+      const __m256i t1 = _mm256_unpackhi_epi64( a0, a1 );
+      const __m256i t2 = _mm256_unpacklo_epi64( a2, a3 );
+      const __m256i t3 = _mm256_unpackhi_epi64( a2, a3 );
+      _mm256_storeu_si256( ( __m256i* )( d                 ), _mm256_permute2x128_si256( t0, t2, 0x20 ) );
+      _mm256_storeu_si256( ( __m256i* )( d +     dstStride ), _mm256_permute2x128_si256( t1, t3, 0x20 ) );
+      _mm256_storeu_si256( ( __m256i* )( d + 2 * dstStride ), _mm256_permute2x128_si256( t0, t2, 0x31 ) );
+      _mm256_storeu_si256( ( __m256i* )( d + 3 * dstStride ), _mm256_permute2x128_si256( t1, t3, 0x31 ) );
+#else
+      const __m128i a0 = _mm_loadu_si128( ( const __m128i* )( s                 ) );
+      const __m128i a1 = _mm_loadu_si128( ( const __m128i* )( s +     srcStride ) );
+      const __m128i a2 = _mm_loadu_si128( ( const __m128i* )( s + 2 * srcStride ) );
+      const __m128i a3 = _mm_loadu_si128( ( const __m128i* )( s + 3 * srcStride ) );
+      const __m128i t0 = _mm_unpacklo_epi32( a0, a1 );
+      const __m128i t1 = _mm_unpacklo_epi32( a2, a3 );
+      const __m128i t2 = _mm_unpackhi_epi32( a0, a1 );
+      const __m128i t3 = _mm_unpackhi_epi32( a2, a3 );
+      _mm_storeu_si128( ( __m128i* )( d                 ), _mm_unpacklo_epi64( t0, t1 ) );
+      _mm_storeu_si128( ( __m128i* )( d +     dstStride ), _mm_unpackhi_epi64( t0, t1 ) );
+      _mm_storeu_si128( ( __m128i* )( d + 2 * dstStride ), _mm_unpacklo_epi64( t2, t3 ) );
+      _mm_storeu_si128( ( __m128i* )( d + 3 * dstStride ), _mm_unpackhi_epi64( t2, t3 ) );
+#endif
+    }
+  }
+}
+
+/** partial butterfly of an N-point transform, on its M-point even part (M = N: the whole transform).
+ *  forward: out[k] = sum of mat[k][n] * x[n], for the rows k that are odd multiples of N/M (and 0 when M = 2)
+ *  inverse: out[n] = sum of mat[k][n] * x[k], for the first M samples of the even part
+ */
+template<Int N, Int M>
+struct TrButterflyAVX2
+{
+  SIMD_TARGET_AVX2
+  static inline Void forward( const TMatrixCoeff (*mat)[N], const __m256i *x, __m256i *out )
+  {
+    const Int step = N / M;
+    __m256i e[M / 2], o[M / 2];
+    for( Int i = 0; i < M / 2; i++ )
+    {
+      e[i] = simdTrAdd( x[i], x[M - 1 - i] );
+      o[i] = simdTrSub( x[i], x[M - 1 - i] );
+    }
+    for( Int k = step; k < N; k += 2 * step )
+    {
+      __m256i sum = simdTrMul( o[0], mat[k][0] );
+      for( Int i = 1; i < M / 2; i++ )
+      {
+        sum = simdTrAdd( sum, simdTrMul( o[i], mat[k][i] ) );
+      }
+      out[k] = sum;
+    }
+    TrButterflyAVX2<N, M / 2>::forward( mat, e, out );
+  }
+
+  SIMD_TARGET_AVX2
+  static inline Void inverse( const TMatrixCoeff (*mat)[N], const __m256i *x, __m256i *out )
+  {
+    const Int step = N / M;
+    __m256i e[M / 2], o[M / 2];
+    TrButterflyAVX2<N, M / 2>::inverse( mat, x, e );
+    for( Int i = 0; i < M / 2; i++ )
+    {
+      __m256i sum = simdTrMul( x[step], mat[step][i] );
+      for( Int k = 3 * step; k < N; k += 2 * step )
+      {
+        sum = simdTrAdd( sum, simdTrMul( x[k], mat[k][i] ) );
+      }
+      o[i] = sum;
+    }
+    for( Int i = 0; i < M / 2; i++ )
+    {
+      out[i]         = simdTrAdd( e[i], o[i] );
+      out[M - 1 - i] = simdTrSub( e[i], o[i] );
+    }
+  }
+};
+
+template<Int N>
+struct TrButterflyAVX2<N, 2>
+{
+  SIMD_TARGET_AVX2
+  static inline Void forward( const TMatrixCoeff (*mat)[N], const __m256i *x, __m256i *out )
+  {
+    out[0]     = simdTrAdd( simdTrMul( x[0], mat[0][0]     ), simdTrMul( x[1], mat[0][1]     ) );
+    out[N / 2] = simdTrAdd( simdTrMul( x[0], mat[N / 2][0] ), simdTrMul( x[1], mat[N / 2][1] ) );
+  }
+
+  SIMD_TARGET_AVX2
+  static inline Void inverse( const TMatrixCoeff (*mat)[N], const __m256i *x, __m256i *out )
+  {
+    out[0] = simdTrAdd( simdTrMul( x[0], mat[0][0] ), simdTrMul( x[N / 2], mat[N / 2][0] ) );
+    out[1] = simdTrAdd( simdTrMul( x[0], mat[0][1] ), simdTrMul( x[N / 2], mat[N / 2][1] ) );
+  }
+};
+
+/** forward 1D transform of the lines of src (lines x N, row by row) into dst (N x lines), as partialButterflyN,
+ *  or fastForwardDst when useDST (mat is then the DST matrix)
+ */
+template<Int N>
+SIMD_TARGET_AVX2
+static Void simdForwardTransformAVX2( const TMatrixCoeff (*mat)[N], const TCoeff *src, TCoeff *dst, Int shift, Int lines, Bool useDST )
+{
+  const __m256i add    = simdTrSet1( (shift > 0) ? (1<<(shift-1)) : 0 );
+  const Int     stride = ( lines + TR_LANES - 1 ) & ~( TR_LANES - 1 );
+
+  // with fewer lines than lanes, the unused lanes are computed from zeros and dropped
+  TCoeff in [MAX_TU_SIZE * MAX_TU_SIZE];
+  TCoeff out[MAX_TU_SIZE * MAX_TU_SIZE];
+  simdTrTranspose( src, N, in, stride, lines, N );
+  for( Int n = 0; n < N && stride != lines; n++ )
+  {
+    memset( in + n * stride + lines, 0, ( stride - lines ) * sizeof( TCoeff ) );
+  }
+  TCoeff *pOut = ( stride == lines ) ? dst : out;
+
+  for( Int j = 0; j < lines; j += TR_LANES )
+  {
+    __m256i x[N], y[N];
+    for( Int n = 0; n < N; n++ )
+    {
+      x[n] = _mm256_loadu_si256( ( const __m256i* )( in + n * stride + j ) );
+    }
+    if( useDST )
+    {
+      for( Int k = 0; k < N; k++ )
+      {
+        y[k] = simdTrMul( x[0], mat[k][0] );
+        for( Int n = 1; n < N; n++ )
+        {
+          y[k] = simdTrAdd( y[k], simdTrMul( x[n], mat[k][n] ) );
+        }
+      }
+    }
+    else
+    {
+      TrButterflyAVX2<N, N>::forward( mat, x, y );
+    }
+    for( Int k = 0; k < N; k++ )
+    {
+      _mm256_storeu_si256( ( __m256i* )( pOut + k * stride + j ), simdTrRoundShift( y[k], add, shift ) );
+    }
+  }
+
+  for( Int k = 0; k < N && stride != lines; k++ )
+  {
+    memcpy( dst + k * lines, out + k * stride, lines * sizeof( TCoeff ) );
+  }
+}
+
+/** inverse 1D transform of src (N x lines) into the lines of dst (lines x N, row by row), as partialButterflyInverseN,
+ *  or fastInverseDst when useDST (mat is then the DST matrix)
+ */
+template<Int N>
+SIMD_TARGET_AVX2
+static Void simdInverseTransformAVX2( const TMatrixCoeff (*mat)[N], const TCoeff *src, TCoeff *dst, Int shift, Int lines, Bool useDST, const TCoeff outputMinimum, const TCoeff outputMaximum )
+{
+  const __m256i add     = simdTrSet1( (shift > 0) ? (1<<(shift-1)) : 0 );
+  const __m256i minimum = simdTrSet1( outputMinimum );
+  const __m256i maximum = simdTrSet1( outputMaximum );
+  const Int     stride  = ( lines + TR_LANES - 1 ) & ~( TR_LANES - 1 );
+
+  TCoeff in [MAX_TU_SIZE * MAX_TU_SIZE];
+  TCoeff out[MAX_TU_SIZE * MAX_TU_SIZE];
+  if( stride != lines )
+  {
+    for( Int k = 0; k < N; k++ )
+    {
+      memcpy( in + k * stride, src + k * lines, lines * sizeof( TCoeff ) );
+      memset( in + k * stride + lines, 0, ( stride - lines ) * sizeof( TCoeff ) );
+    }
+    src = in;
+  }
+
+  for( Int j = 0; j < lines; j += TR_LANES )
+  {
+    __m256i x[N], y[N];
+    for( Int k = 0; k < N; k++ )
+    {
+      x[k] = _mm256_loadu_si256( ( const __m256i* )( src + k * stride + j ) );
+    }
+    if( useDST )
+    {
+      for( Int n = 0; n < N; n++ )
+      {
+        y[n] = simdTrMul( x[0], mat[0][n] );
+        for( Int k = 1; k < N; k++ )
+        {
+          y[n] = simdTrAdd( y[n], simdTrMul( x[k], mat[k][n] ) );
+        }
+      }
+    }
+    else
+    {
+      TrButterflyAVX2<N, N>::inverse( mat, x, y );
+    }
+    for( Int n = 0; n < N; n++ )
+    {
+      _mm256_storeu_si256( ( __m256i* )( out + n * stride + j ), simdTrClip( simdTrRoundShift( y[n], add, shift ), minimum, maximum ) );
+    }
+  }
+
+  simdTrTranspose( out, stride, dst, N, N, lines );
+}
+
+/// same as xTrMxN
+static Void xTrMxNAVX2( Int bitDepth, TCoeff *block, TCoeff *coeff, Int iWidth, Int iHeight, Bool useDST, const Int maxLog2TrDynamicRange )
+{
+  const Int TRANSFORM_MATRIX_SHIFT = g_transformMatrixShift[TRANSFORM_FORWARD];
+
+  const Int shift_1st = ((g_aucConvertToBit[iWidth] + 2) +  bitDepth + TRANSFORM_MATRIX_SHIFT) - maxLog2TrDynamicRange;
+  const Int shift_2nd = (g_aucConvertToBit[iHeight] + 2) + TRANSFORM_MATRIX_SHIFT;
+
+  assert(shift_1st >= 0);
+  assert(shift_2nd >= 0);
+
+  const Bool useDST4x4 = useDST && iWidth == 4 && iHeight == 4;
+  const TMatrixCoeff (*mat4)[4] = useDST4x4 ? g_as_DST_MAT_4[TRANSFORM_FORWARD] : g_aiT4[TRANSFORM_FORWARD];
+
+  TCoeff tmp[ MAX_TU_SIZE * MAX_TU_SIZE ];
+
+  switch (iWidth)
+  {
+    case  4: simdForwardTransformAVX2< 4>( mat4,                       block, tmp, shift_1st, iHeight, useDST4x4 ); break;
+    case  8: simdForwardTransformAVX2< 8>( g_aiT8 [TRANSFORM_FORWARD], block, tmp, shift_1st, iHeight, false );     break;
+    case 16: simdForwardTransformAVX2<16>( g_aiT16[TRANSFORM_FORWARD], block, tmp, shift_1st, iHeight, false );     break;
+    case 32: simdForwardTransformAVX2<32>( g_aiT32[TRANSFORM_FORWARD], block, tmp, shift_1st, iHeight, false );     break;
+    default:
+      assert(0); exit (1); break;
+  }
+
+  switch (iHeight)
+  {
+    case  4: simdForwardTransformAVX2< 4>( mat4,                       tmp, coeff, shift_2nd, iWidth, useDST4x4 ); break;
+    case  8: simdForwardTransformAVX2< 8>( g_aiT8 [TRANSFORM_FORWARD], tmp, coeff, shift_2nd, iWidth, false );     break;
+    case 16: simdForwardTransformAVX2<16>( g_aiT16[TRANSFORM_FORWARD], tmp, coeff, shift_2nd, iWidth, false );     break;
+    case 32: simdForwardTransformAVX2<32>( g_aiT32[TRANSFORM_FORWARD], tmp, coeff, shift_2nd, iWidth, false );     break;
+    default:
+      assert(0); exit (1); break;
+  }
+}
+
+/// same as xITrMxN
+static Void xITrMxNAVX2( Int bitDepth, TCoeff *coeff, TCoeff *block, Int iWidth, Int iHeight, Bool useDST, const Int maxLog2TrDynamicRange )
+{
+  const Int TRANSFORM_MATRIX_SHIFT = g_transformMatrixShift[TRANSFORM_INVERSE];
+
+  Int shift_1st = TRANSFORM_MATRIX_SHIFT + 1; //1 has been added to shift_1st at the expense of shift_2nd
+  Int shift_2nd = (TRANSFORM_MATRIX_SHIFT + maxLog2TrDynamicRange - 1) - bitDepth;
+  const TCoeff clipMinimum = -(1 << maxLog2TrDynamicRange);
+  const TCoeff clipMaximum =  (1 << maxLog2TrDynamicRange) - 1;
+
+  assert(shift_1st >= 0);
+  assert(shift_2nd >= 0);
+
+  const Bool useDST4x4 = useDST && iWidth == 4 && iHeight == 4;
+  const TMatrixCoeff (*mat4)[4] = useDST4x4 ? g_as_DST_MAT_4[TRANSFORM_INVERSE] : g_aiT4[TRANSFORM_INVERSE];
+
+  TCoeff tmp[MAX_TU_SIZE * MAX_TU_SIZE];
+
+  switch (iHeight)
+  {
+    case  4: simdInverseTransformAVX2< 4>( mat4,                       coeff, tmp, shift_1st, iWidth, useDST4x4, clipMinimum, clipMaximum ); break;
+    case  8: simdInverseTransformAVX2< 8>( g_aiT8 [TRANSFORM_INVERSE], coeff, tmp, shift_1st, iWidth, false,     clipMinimum, clipMaximum ); break;
+    case 16: simdInverseTransformAVX2<16>( g_aiT16[TRANSFORM_INVERSE], coeff, tmp, shift_1st, iWidth, false,     clipMinimum, clipMaximum ); break;
+    case 32: simdInverseTransformAVX2<32>( g_aiT32[TRANSFORM_INVERSE], coeff, tmp, shift_1st, iWidth, false,     clipMinimum, clipMaximum ); break;
+    default:
+      assert(0); exit (1); break;
+  }
+
+  // Clipping here is not in the standard, but is used to protect the "Pel" data type into which the inverse-transformed samples will be copied
+  switch (iWidth)
+  {
+    case  4: simdInverseTransformAVX2< 4>( mat4,                       tmp, block, shift_2nd, iHeight, useDST4x4, std::numeric_limits<Pel>::min(), std::numeric_limits<Pel>::max() ); break;
+    case  8: simdInverseTransformAVX2< 8>( g_aiT8 [TRANSFORM_INVERSE], tmp, block, shift_2nd, iHeight, false,     std::numeric_limits<Pel>::min(), std::numeric_limits<Pel>::max() ); break;
+    case 16: simdInverseTransformAVX2<16>( g_aiT16[TRANSFORM_INVERSE], tmp, block, shift_2nd, iHeight, false,     std::numeric_limits<Pel>::min(), std::numeric_limits<Pel>::max() ); break;
+    case 32: simdInverseTransformAVX2<32>( g_aiT32[TRANSFORM_INVERSE], tmp, block, shift_2nd, iHeight, false,     std::numeric_limits<Pel>::min(), std::numeric_limits<Pel>::max() ); break;
+    default:
+      assert(0); exit (1); break;
+  }
+}
+#endif
+
 /** MxN forward transform (2D)
 *  \param bitDepth              [in]  bit depth
 *  \param block                 [in]  residual block
@@ -859,6 +1241,14 @@ Void partialButterflyInverse32(TCoeff *src, TCoeff *dst, Int shift, Int line, co
 */
 Void xTrMxN(Int bitDepth, TCoeff *block, TCoeff *coeff, Int iWidth, Int iHeight, Bool useDST, const Int maxLog2TrDynamicRange)
 {
+#if VECTOR_CODING__TRANSFORM && VECTOR_CODING__AVX2
+  if( getSIMDExtension( SIMD_KERNELS_TRANSFORM ) >= SIMD_AVX2 )
+  {
+    xTrMxNAVX2( bitDepth, block, coeff, iWidth, iHeight, useDST, maxLog2TrDynamicRange );
+    return;
+  }
+#endif
+
   const Int TRANSFORM_MATRIX_SHIFT = g_transformMatrixShift[TRANSFORM_FORWARD];
 
   const Int shift_1st = ((g_aucConvertToBit[iWidth] + 2) +  bitDepth + TRANSFORM_MATRIX_SHIFT) - maxLog2TrDynamicRange;
@@ -926,6 +1316,14 @@ Void xTrMxN(Int bitDepth, TCoeff *block, TCoeff *coeff, Int iWidth, Int iHeight,
 */
 Void xITrMxN(Int bitDepth, TCoeff *coeff, TCoeff *block, Int iWidth, Int iHeight, Bool useDST, const Int maxLog2TrDynamicRange)
 {
+#if VECTOR_CODING__TRANSFORM && VECTOR_CODING__AVX2
+  if( getSIMDExtension( SIMD_KERNELS_TRANSFORM ) >= SIMD_AVX2 )
+  {
+    xITrMxNAVX2( bitDepth, coeff, block, iWidth, iHeight, useDST, maxLog2TrDynamicRange );
+    return;
+  }
+#endif
+
   const Int TRANSFORM_MATRIX_SHIFT = g_transformMatrixShift[TRANSFORM_INVERSE];
 
   Int shift_1st = TRANSFORM_MATRIX_SHIFT + 1; //1 has been added to shift_1st at the expense of shift_2nd
@@ -1929,6 +2327,34 @@ Void TComTrQuant::invRdpcmNxN( TComTU& rTu, const ComponentID compID, Pel* pcRes
 // Logical transform
 // ------------------------------------------------------------------------------------------------
 
+/** Core NxN forward transform (2D) of a block of residuals, without the HM interface of xT()
+ *  \param bitDepth bit depth of channel
+ *  \param block input data (residual)
+ *  \param coeff output data (transform coefficients)
+ *  \param iWidth transform width
+ *  \param iHeight transform height
+ *  \param useDST
+ *  \param maxLog2TrDynamicRange
+ */
+Void TComTrQuant::coreTransform( Int bitDepth, TCoeff *block, TCoeff *coeff, Int iWidth, Int iHeight, Bool useDST, const Int maxLog2TrDynamicRange )
+{
+  xTrMxN( bitDepth, block, coeff, iWidth, iHeight, useDST, maxLog2TrDynamicRange );
+}
+
+/** Core NxN inverse transform (2D) of a block of coefficients, without the HM interface of xIT()
+ *  \param bitDepth bit depth of channel
+ *  \param coeff input data (transform coefficients)
+ *  \param block output data (residual)
+ *  \param iWidth transform width
+ *  \param iHeight transform height
+ *  \param useDST
+ *  \param maxLog2TrDynamicRange
+ */
+Void TComTrQuant::coreInvTransform( Int bitDepth, TCoeff *coeff, TCoeff *block, Int iWidth, Int iHeight, Bool useDST, const Int maxLog2TrDynamicRange )
+{
+  xITrMxN( bitDepth, coeff, block, iWidth, iHeight, useDST, maxLog2TrDynamicRange );
+}
+
 /** Wrapper function between HM interface and core NxN forward transform (2D)
  *  \param channelBitDepth bit depth of channel
  *  \param useDST
@@ -2126,6 +2552,7 @@ Void TComTrQuant::xRateDistOptQuant                 (       TComTU       &rTu,
                                                       const ComponentID   compID,
                                                       const QpParam      &cQP  )
 {
+  TComProfilingScope profilingScope( PROFILE_ENC_RDOQ );
   const TComRectangle  & rect             = rTu.getRect(compID);
   const UInt             uiWidth          = rect.width;
   const UInt             uiHeight         = rect.height;
@@ -2156,7 +2583,6 @@ Void TComTrQuant::xRateDistOptQuant                 (       TComTU       &rTu,
         UInt uiGoRiceParam                     = initialGolombRiceParameter;
   Double     d64BlockUncodedCost               = 0;
   const UInt uiLog2BlockWidth                  = g_aucConvertToBit[ uiWidth  ] + 2;
-  const UInt uiLog2BlockHeight                 = g_aucConvertToBit[ uiHeight ] + 2;
   const UInt uiMaxNumCoeff                     = uiWidth * uiHeight;
   assert(compID<MAX_NUM_COMPONENT);
 
@@ -2232,7 +2658,8 @@ Void TComTrQuant::xRateDistOptQuant                 (       TComTU       &rTu,
 
     memset( &rdStats, 0, sizeof (coeffGroupRDStats));
 
-    const Int patternSigCtx = TComTrQuant::calcPatternSigCtx(uiSigCoeffGroupFlag, uiCGPosX, uiCGPosY, codingParameters.widthInGroups, codingParameters.heightInGroups);
+    const Int    patternSigCtx    = TComTrQuant::calcPatternSigCtx(uiSigCoeffGroupFlag, uiCGPosX, uiCGPosY, codingParameters.widthInGroups, codingParameters.heightInGroups);
+    const UChar *sigCtxIncInGroup = getSigCtxIncInGroup(codingParameters, patternSigCtx, iCGScanPos);
 
     for (Int iScanPosinCG = uiCGSize-1; iScanPosinCG >= 0; iScanPosinCG--)
     {
@@ -2284,7 +2711,7 @@ Void TComTrQuant::xRateDistOptQuant                 (       TComTU       &rTu,
         }
         else
         {
-          UShort uiCtxSig      = significanceMapContextOffset + getSigCtxInc( patternSigCtx, codingParameters, iScanPos, uiLog2BlockWidth, uiLog2BlockHeight, channelType );
+          UShort uiCtxSig      = significanceMapContextOffset + sigCtxIncInGroup[ iScanPosinCG ];
 
           uiLevel              = xGetCodedLevel( pdCostCoeff[ iScanPos ], pdCostCoeff0[ iScanPos ], pdCostSig[ iScanPos ],
                                                   lLevelDouble, uiMaxAbsLevel, uiCtxSig, uiOneCtx, uiAbsCtx, uiGoRiceParam,
@@ -2372,7 +2799,7 @@ Void TComTrQuant::xRateDistOptQuant                 (       TComTU       &rTu,
       {
         if (uiSigCoeffGroupFlag[ uiCGBlkPos ] == 0)
         {
-          UInt  uiCtxSig = getSigCoeffGroupCtxInc( uiSigCoeffGroupFlag, uiCGPosX, uiCGPosY, codingParameters.widthInGroups, codingParameters.heightInGroups );
+          UInt  uiCtxSig = getSigCoeffGroupCtxInc( patternSigCtx );
           d64BaseCost += xGetRateSigCoeffGroup(0, uiCtxSig) - rdStats.d64SigCost;;
           pdCostCoeffGroupSig[ iCGScanPos ] = xGetRateSigCoeffGroup(0, uiCtxSig);
         }
@@ -2389,7 +2816,7 @@ Void TComTrQuant::xRateDistOptQuant                 (       TComTU       &rTu,
             Double d64CostZeroCG = d64BaseCost;
 
             // add SigCoeffGroupFlag cost to total cost
-            UInt  uiCtxSig = getSigCoeffGroupCtxInc( uiSigCoeffGroupFlag, uiCGPosX, uiCGPosY, codingParameters.widthInGroups, codingParameters.heightInGroups );
+            UInt  uiCtxSig = getSigCoeffGroupCtxInc( patternSigCtx );
 
             if (iCGScanPos < iCGLastScanPos)
             {
@@ -2695,114 +3122,6 @@ Int  TComTrQuant::calcPatternSigCtx( const UInt* sigCoeffGroupFlag, UInt uiCGPos
 }
 
 
-/** Context derivation process of coeff_abs_significant_flag
- * \param patternSigCtx pattern for current coefficient group
- * \param codingParameters coding parameters for the TU (includes the scan)
- * \param scanPosition current position in scan order
- * \param log2BlockWidth log2 width of the block
- * \param log2BlockHeight log2 height of the block
- * \param chanType channel type (CHANNEL_TYPE_LUMA/CHROMA)
- * \returns ctxInc for current scan position
- */
-Int TComTrQuant::getSigCtxInc    (       Int                        patternSigCtx,
-                                   const TUEntropyCodingParameters &codingParameters,
-                                   const Int                        scanPosition,
-                                   const Int                        log2BlockWidth,
-                                   const Int                        log2BlockHeight,
-                                   const ChannelType                chanType)
-{
-  if (codingParameters.firstSignificanceMapContext == significanceMapContextSetStart[chanType][CONTEXT_TYPE_SINGLE])
-  {
-    //single context mode
-    return significanceMapContextSetStart[chanType][CONTEXT_TYPE_SINGLE];
-  }
-
-  const UInt rasterPosition = codingParameters.scan[scanPosition];
-  const UInt posY           = rasterPosition >> log2BlockWidth;
-  const UInt posX           = rasterPosition - (posY << log2BlockWidth);
-
-  if ((posX + posY) == 0)
-  {
-    return 0; //special case for the DC context variable
-  }
-
-  Int offset = MAX_INT;
-
-  if ((log2BlockWidth == 2) && (log2BlockHeight == 2)) //4x4
-  {
-    offset = ctxIndMap4x4[ (4 * posY) + posX ];
-  }
-  else
-  {
-    Int cnt = 0;
-
-    switch (patternSigCtx)
-    {
-      //------------------
-
-      case 0: //neither neighbouring group is significant
-        {
-          const Int posXinSubset     = posX & ((1 << MLS_CG_LOG2_WIDTH)  - 1);
-          const Int posYinSubset     = posY & ((1 << MLS_CG_LOG2_HEIGHT) - 1);
-          const Int posTotalInSubset = posXinSubset + posYinSubset;
-
-          //first N coefficients in scan order use 2; the next few use 1; the rest use 0.
-          const UInt context1Threshold = NEIGHBOURHOOD_00_CONTEXT_1_THRESHOLD_4x4;
-          const UInt context2Threshold = NEIGHBOURHOOD_00_CONTEXT_2_THRESHOLD_4x4;
-
-          cnt = (posTotalInSubset >= context1Threshold) ? 0 : ((posTotalInSubset >= context2Threshold) ? 1 : 2);
-        }
-        break;
-
-      //------------------
-
-      case 1: //right group is significant, below is not
-        {
-          const Int posYinSubset = posY & ((1 << MLS_CG_LOG2_HEIGHT) - 1);
-          const Int groupHeight  = 1 << MLS_CG_LOG2_HEIGHT;
-
-          cnt = (posYinSubset >= (groupHeight >> 1)) ? 0 : ((posYinSubset >= (groupHeight >> 2)) ? 1 : 2); //top quarter uses 2; second-from-top quarter uses 1; bottom half uses 0
-        }
-        break;
-
-      //------------------
-
-      case 2: //below group is significant, right is not
-        {
-          const Int posXinSubset = posX & ((1 << MLS_CG_LOG2_WIDTH)  - 1);
-          const Int groupWidth   = 1 << MLS_CG_LOG2_WIDTH;
-
-          cnt = (posXinSubset >= (groupWidth >> 1)) ? 0 : ((posXinSubset >= (groupWidth >> 2)) ? 1 : 2); //left quarter uses 2; second-from-left quarter uses 1; right half uses 0
-        }
-        break;
-
-      //------------------
-
-      case 3: //both neighbouring groups are significant
-        {
-          cnt = 2;
-        }
-        break;
-
-      //------------------
-
-      default:
-        std::cerr << "ERROR: Invalid patternSigCtx \"" << Int(patternSigCtx) << "\" in getSigCtxInc" << std::endl;
-        exit(1);
-        break;
-    }
-
-    //------------------------------------------------
-
-    const Bool notFirstGroup = ((posX >> MLS_CG_LOG2_WIDTH) + (posY >> MLS_CG_LOG2_HEIGHT)) > 0;
-
-    offset = (notFirstGroup ? notFirstGroupNeighbourhoodContextOffset[chanType] : 0) + cnt;
-  }
-
-  return codingParameters.firstSignificanceMapContext + offset;
-}
-
-
 /** Get the best level in RD sense
  *
  * \returns best quantized transform level for given scan position
@@ -3012,36 +3331,6 @@ __inline Double TComTrQuant::xGetIEPRate      (
   return 32768;
 }
 
-/** Context derivation process of coeff_abs_significant_flag
- * \param uiSigCoeffGroupFlag significance map of L1
- * \param uiCGPosX column of current scan position
- * \param uiCGPosY row of current scan position
- * \param widthInGroups width of the block
- * \param heightInGroups height of the block
- * \returns ctxInc for current scan position
- */
-UInt TComTrQuant::getSigCoeffGroupCtxInc  (const UInt*  uiSigCoeffGroupFlag,
-                                           const UInt   uiCGPosX,
-                                           const UInt   uiCGPosY,
-                                           const UInt   widthInGroups,
-                                           const UInt   heightInGroups)
-{
-  UInt sigRight = 0;
-  UInt sigLower = 0;
-
-  if (uiCGPosX < (widthInGroups  - 1))
-  {
-    sigRight = ((uiSigCoeffGroupFlag[ (uiCGPosY * widthInGroups) + uiCGPosX + 1 ] != 0) ? 1 : 0);
-  }
-  if (uiCGPosY < (heightInGroups - 1))
-  {
-    sigLower = ((uiSigCoeffGroupFlag[ (uiCGPosY + 1) * widthInGroups + uiCGPosX ] != 0) ? 1 : 0);
-  }
-
-  return ((sigRight + sigLower) != 0) ? 1 : 0;
-}
-
-
 /** set quantized matrix coefficient for encode
  * \param scalingList            quantized matrix address
  * \param format                 chroma format
@@ -147,28 +147,29 @@ public:
 #if RDOQ_CHROMA_LAMBDA
   Void setLambdas(const Double lambdas[MAX_NUM_COMPONENT]) { for (UInt component = 0; component < MAX_NUM_COMPONENT; component++) m_lambdas[component] = lambdas[component]; }
   Void selectLambda(const ComponentID compIdx) { m_dLambda = m_lambdas[compIdx]; }
+  const Double* getLambdas() const { return m_lambdas; }
 #else
   Void setLambda(Double dLambda) { m_dLambda = dLambda;}
+  Double getLambda() const { return m_dLambda; }
 #endif
   Void setRDOQOffset( UInt uiRDOQOffset ) { m_uiRDOQOffset = uiRDOQOffset; }
 
   estBitsSbacStruct* m_pcEstBitsSbac;
 
+  // core transforms (DCT, or DST for 4x4 intra luma), on blocks of width x height values
+  static Void     coreTransform    ( Int bitDepth, TCoeff *block, TCoeff *coeff, Int iWidth, Int iHeight, Bool useDST, const Int maxLog2TrDynamicRange );
+  static Void     coreInvTransform ( Int bitDepth, TCoeff *coeff, TCoeff *block, Int iWidth, Int iHeight, Bool useDST, const Int maxLog2TrDynamicRange );
+
   static Int      calcPatternSigCtx( const UInt* sigCoeffGroupFlag, UInt uiCGPosX, UInt uiCGPosY, UInt widthInGroups, UInt heightInGroups );
 
-  static Int      getSigCtxInc     ( Int                              patternSigCtx,
-                                     const TUEntropyCodingParameters &codingParameters,
-                                     const Int                        scanPosition,
-                                     const Int                        log2BlockWidth,
-                                     const Int                        log2BlockHeight,
-                                     const ChannelType                chanType
-                                    );
+  /// context increments of significant_coeff_flag for the scan positions of a coefficient group, looked up in g_sigCtxIncInGroup
+  static const UChar* getSigCtxIncInGroup( const TUEntropyCodingParameters &codingParameters, Int patternSigCtx, Int subSet )
+  {
+    return codingParameters.sigCtxIncInGroup + (((patternSigCtx << 1) + (subSet != 0 ? 1 : 0)) << MLS_CG_SIZE);
+  }
 
-  static UInt getSigCoeffGroupCtxInc  (const UInt*  uiSigCoeffGroupFlag,
-                                       const UInt   uiCGPosX,
-                                       const UInt   uiCGPosY,
-                                       const UInt   widthInGroups,
-                                       const UInt   heightInGroups);
+  /// context increment of coded_sub_block_flag, from the pattern of the coefficient group in a TU with more than one group
+  static UInt     getSigCoeffGroupCtxInc( Int patternSigCtx ) { return (patternSigCtx != 0) ? 1 : 0; }
 
   Void initScalingList                      ();
   Void destroyScalingList                   ();
@@ -230,6 +231,8 @@ protected:
   Double    m_errScaleNoScalingList[SCALING_LIST_SIZE_NUM][SCALING_LIST_NUM][SCALING_LIST_REM_NUM]; ///< array of quantization matrix coefficient 4x4
 
 private:
+  friend class TBenchQuant; ///< kernel benchmark of xQuant() and xDeQuant() (TAppBench)
+
   // forward Transform
   Void xT   ( const Int channelBitDepth, Bool useDST, Pel* piBlkResi, UInt uiStride, TCoeff* psCoeff, Int iWidth, Int iHeight, const Int maxLog2TrDynamicRange );
 
@@ -42,6 +42,11 @@
 #include "TComInterpolationFilter.h"
 #include "TComWeightPrediction.h"
 
+#if VECTOR_CODING__YUV_OPERATIONS && VECTOR_CODING__AVX2
+#include <immintrin.h>
+#include "TComCpuFeatures.h"
+#endif
+
 
 static inline Pel weightBidir( Int w0, Pel P0, Int w1, Pel P1, Int round, Int shift, Int offset, Int clipBD)
 {
@@ -65,6 +70,115 @@ static inline Pel noWeightOffsetUnidir( Pel P0, Int round, Int shift, Int clipBD
 }
 
 
+#if VECTOR_CODING__YUV_OPERATIONS && VECTOR_CODING__AVX2
+// ====================================================================================================================
+// AVX2 weighted prediction
+// ====================================================================================================================
+
+// The samples are processed 8 at a time in 32-bit lanes, and the last width%4 columns with the C functions above.
+
+/// numSamples (8 or 4) samples, in 32-bit lanes
+SIMD_TARGET_AVX2
+static inline __m256i simdWPLoadAVX2( const Pel* src, Int numSamples )
+{
+#if RExt__HIGH_BIT_DEPTH_SUPPORT
+  return numSamples == 8 ? _mm256_loadu_si256( ( const __m256i* )src ) : _mm256_zextsi128_si256( _mm_loadu_si128( ( const __m128i* )src ) );
+#else
+  return _mm256_cvtepi16_epi32( numSamples == 8 ? _mm_loadu_si128( ( const __m128i* )src ) : _mm_loadl_epi64( ( const __m128i* )src ) );
+#endif
+}
+
+/// stores numSamples (8 or 4) clipped samples, with the conversion to Pel of the C code
+SIMD_TARGET_AVX2
+static inline Void simdWPStoreAVX2( Pel* dst, const __m256i v, Int numSamples )
+{
+#if RExt__HIGH_BIT_DEPTH_SUPPORT
+  if( numSamples == 8 )
+  {
+    _mm256_storeu_si256( ( __m256i* )dst, v );
+  }
+  else
+  {
+    _mm_storeu_si128( ( __m128i* )dst, _mm256_castsi256_si128( v ) );
+  }
+#else
+  const __m128i packed = _mm_packus_epi32( _mm256_castsi256_si128( v ), _mm256_extracti128_si256( v, 1 ) );
+  if( numSamples == 8 )
+  {
+    _mm_storeu_si128( ( __m128i* )dst, packed );
+  }
+  else
+  {
+    _mm_storel_epi64( ( __m128i* )dst, packed );
+  }
+#endif
+}
+
+/// clip( ( w0*(P0+IF_INTERNAL_OFFS) + w1*(P1+IF_INTERNAL_OFFS) + roundOffset ) >> shift ), as weightBidir()
+SIMD_TARGET_AVX2
+static Void simdWeightBidirAVX2( const Pel* pSrc0, Int iSrc0Stride, const Pel* pSrc1, Int iSrc1Stride, Pel* pDst, Int iDstStride, Int iWidth, Int iHeight,
+                                 Int w0, Int w1, Int round, Int shift, Int offset, Int clipBD )
+{
+  const __m256i vW0          = _mm256_set1_epi32( w0 );
+  const __m256i vW1          = _mm256_set1_epi32( w1 );
+  const __m256i vInternalOff = _mm256_set1_epi32( IF_INTERNAL_OFFS );
+  const __m256i vRoundOffset = _mm256_set1_epi32( round + ( offset << ( shift - 1 ) ) );
+  const __m128i vShift       = _mm_cvtsi32_si128( shift );
+  const __m256i vMax         = _mm256_set1_epi32( ( 1 << clipBD ) - 1 );
+
+  for( Int y = 0; y < iHeight; y++, pSrc0 += iSrc0Stride, pSrc1 += iSrc1Stride, pDst += iDstStride )
+  {
+    Int x = 0;
+    for( Int numSamples = 8; numSamples >= 4; numSamples -= 4 )
+    {
+      for( ; x + numSamples <= iWidth; x += numSamples )
+      {
+        const __m256i p0  = _mm256_add_epi32( simdWPLoadAVX2( pSrc0 + x, numSamples ), vInternalOff );
+        const __m256i p1  = _mm256_add_epi32( simdWPLoadAVX2( pSrc1 + x, numSamples ), vInternalOff );
+        const __m256i sum = _mm256_add_epi32( _mm256_add_epi32( _mm256_mullo_epi32( p0, vW0 ), _mm256_mullo_epi32( p1, vW1 ) ), vRoundOffset );
+        const __m256i val = _mm256_sra_epi32( sum, vShift );
+        simdWPStoreAVX2( pDst + x, _mm256_min_epi32( _mm256_max_epi32( val, _mm256_setzero_si256() ), vMax ), numSamples );
+      }
+    }
+    for( ; x < iWidth; x++ )
+    {
+      pDst[x] = weightBidir( w0, pSrc0[x], w1, pSrc1[x], round, shift, offset, clipBD );
+    }
+  }
+}
+
+/// clip( ( ( w0*(P0+IF_INTERNAL_OFFS) + round ) >> shift ) + offset ), as weightUnidir() and, with w0 = 1, noWeightUnidir()
+SIMD_TARGET_AVX2
+static Void simdWeightUnidirAVX2( const Pel* pSrc0, Int iSrc0Stride, Pel* pDst, Int iDstStride, Int iWidth, Int iHeight,
+                                  Int w0, Int round, Int shift, Int offset, Int clipBD )
+{
+  const __m256i vW0          = _mm256_set1_epi32( w0 );
+  const __m256i vInternalOff = _mm256_set1_epi32( IF_INTERNAL_OFFS );
+  const __m256i vRound       = _mm256_set1_epi32( round );
+  const __m256i vOffset      = _mm256_set1_epi32( offset );
+  const __m128i vShift       = _mm_cvtsi32_si128( shift );
+  const __m256i vMax         = _mm256_set1_epi32( ( 1 << clipBD ) - 1 );
+
+  for( Int y = 0; y < iHeight; y++, pSrc0 += iSrc0Stride, pDst += iDstStride )
+  {
+    Int x = 0;
+    for( Int numSamples = 8; numSamples >= 4; numSamples -= 4 )
+    {
+      for( ; x + numSamples <= iWidth; x += numSamples )
+      {
+        const __m256i p0  = _mm256_add_epi32( simdWPLoadAVX2( pSrc0 + x, numSamples ), vInternalOff );
+        const __m256i val = _mm256_add_epi32( _mm256_sra_epi32( _mm256_add_epi32( _mm256_mullo_epi32( p0, vW0 ), vRound ), vShift ), vOffset );
+        simdWPStoreAVX2( pDst + x, _mm256_min_epi32( _mm256_max_epi32( val, _mm256_setzero_si256() ), vMax ), numSamples );
+      }
+    }
+    for( ; x < iWidth; x++ )
+    {
+      pDst[x] = weightUnidir( w0, pSrc0[x], round, shift, offset, clipBD );
+    }
+  }
+}
+#endif
+
 // ====================================================================================================================
 // Class definition
 // ====================================================================================================================
@@ -116,6 +230,14 @@ Void TComWeightPrediction::addWeightBi( const TComYuv              *pcYuvSrc0,
     const UInt iSrc1Stride = pcYuvSrc1->getStride(compID);
     const UInt iDstStride  = rpcYuvDst->getStride(compID);
 
+#if VECTOR_CODING__YUV_OPERATIONS && VECTOR_CODING__AVX2
+    if( getSIMDExtension( SIMD_KERNELS_YUV_OPERATIONS ) >= SIMD_AVX2 )
+    {
+      simdWeightBidirAVX2( pSrc0, iSrc0Stride, pSrc1, iSrc1Stride, pDst, iDstStride, iWidth, iHeight, w0, w1, round, shift, offset, clipBD );
+      continue;
+    }
+#endif
+
     for ( Int y = iHeight-1; y >= 0; y-- )
     {
       // do it in batches of 4 (partial unroll)
@@ -171,6 +293,21 @@ Void TComWeightPrediction::addWeightUni( const TComYuv        *const pcYuvSrc0,
     const Int  iHeight     = uiHeight>>csy;
     const Int  iWidth      = uiWidth>>csx;
 
+#if VECTOR_CODING__YUV_OPERATIONS && VECTOR_CODING__AVX2
+    if( getSIMDExtension( SIMD_KERNELS_YUV_OPERATIONS ) >= SIMD_AVX2 )
+    {
+      if (w0 != 1 << wp0[compID].shift)
+      {
+        simdWeightUnidirAVX2( pSrc0, iSrc0Stride, pDst, iDstStride, iWidth, iHeight, w0, (shift > 0) ? (1<<(shift-1)) : 0, shift, offset, clipBD );
+      }
+      else
+      {
+        simdWeightUnidirAVX2( pSrc0, iSrc0Stride, pDst, iDstStride, iWidth, iHeight, 1, (shiftNum > 0) ? (1<<(shiftNum-1)) : 0, shiftNum, offset, clipBD );
+      }
+      continue;
+    }
+#endif
+
     if (w0 != 1 << wp0[compID].shift)
     {
       const Int  round       = (shift > 0) ? (1<<(shift-1)) : 0;
@@ -45,9 +45,139 @@
 #include "TComYuv.h"
 #include "TComInterpolationFilter.h"
 
+#if VECTOR_CODING__YUV_OPERATIONS && VECTOR_CODING__AVX2
+#include <immintrin.h>
+#include "TComCpuFeatures.h"
+#endif
+
 //! \ingroup TLibCommon
 //! \{
 
+#if VECTOR_CODING__YUV_OPERATIONS && VECTOR_CODING__AVX2
+// ====================================================================================================================
+// AVX2 sample operations
+// ====================================================================================================================
+
+// The samples are processed 8 at a time in 32-bit lanes, and stored with the truncation of the conversion of the Int
+// result to Pel of the C code.
+
+/// numSamples (8 or 4) samples, in 32-bit lanes
+SIMD_TARGET_AVX2
+static inline __m256i simdLoadPelsAVX2( const Pel* src, Int numSamples )
+{
+#if RExt__HIGH_BIT_DEPTH_SUPPORT
+  return numSamples == 8 ? _mm256_loadu_si256( ( const __m256i* )src ) : _mm256_zextsi128_si256( _mm_loadu_si128( ( const __m128i* )src ) );
+#else
+  return _mm256_cvtepi16_epi32( numSamples == 8 ? _mm_loadu_si128( ( const __m128i* )src ) : _mm_loadl_epi64( ( const __m128i* )src ) );
+#endif
+}
+
+SIMD_TARGET_AVX2
+static inline Void simdStorePelsAVX2( Pel* dst, const __m256i v, Int numSamples )
+{
+#if RExt__HIGH_BIT_DEPTH_SUPPORT
+  if( numSamples == 8 )
+  {
+    _mm256_storeu_si256( ( __m256i* )dst, v );
+  }
+  else
+  {
+    _mm_storeu_si128( ( __m128i* )dst, _mm256_castsi256_si128( v ) );
+  }
+#else
+  // low 16 bits of each lane
+  const __m256i lowHalves = _mm256_shuffle_epi8( v, _mm256_setr_epi8( 0, 1, 4, 5, 8, 9, 12, 13, -1, -1, -1, -1, -1, -1, -1, -1,
+                                                                      0, 1, 4, 5, 8, 9, 12, 13, -1, -1, -1, -1, -1, -1, -1, -1 ) );
+  const __m128i packed    = _mm256_castsi256_si128( _mm256_permute4x64_epi64( lowHalves, 0x08 ) );
+  if( numSamples == 8 )
+  {
+    _mm_storeu_si128( ( __m128i* )dst, packed );
+  }
+  else
+  {
+    _mm_storel_epi64( ( __m128i* )dst, packed );
+  }
+#endif
+}
+
+/** dst = op( src0, src1 ) for a block: op computes 8 samples in 32-bit lanes with op.simd(), and one sample with
+ *  op.scalar() for the last columns of widths that are not multiples of 4
+ */
+template<typename Op>
+SIMD_TARGET_AVX2
+static Void simdYuvOperationAVX2( const Pel* src0, Int src0Stride, const Pel* src1, Int src1Stride, Pel* dst, Int dstStride, Int width, Int height, const Op& op )
+{
+  for( Int y = 0; y < height; y++, src0 += src0Stride, src1 += src1Stride, dst += dstStride )
+  {
+    Int x = 0;
+    for( ; x + 8 <= width; x += 8 )
+    {
+      simdStorePelsAVX2( dst + x, op.simd( simdLoadPelsAVX2( src0 + x, 8 ), simdLoadPelsAVX2( src1 + x, 8 ) ), 8 );
+    }
+    if( x + 4 <= width )
+    {
+      simdStorePelsAVX2( dst + x, op.simd( simdLoadPelsAVX2( src0 + x, 4 ), simdLoadPelsAVX2( src1 + x, 4 ) ), 4 );
+      x += 4;
+    }
+    for( ; x < width; x++ )
+    {
+      dst[x] = op.scalar( src0[x], src1[x] );
+    }
+  }
+}
+
+/// src0 + src1, clipped to the bit depth
+struct SimdYuvAddClip
+{
+  __m256i maxVal;
+  Int     clipBD;
+  SIMD_TARGET_AVX2 SimdYuvAddClip( Int bitDepth ) : maxVal( _mm256_set1_epi32( ( 1 << bitDepth ) - 1 ) ), clipBD( bitDepth ) {}
+  SIMD_TARGET_AVX2 inline __m256i simd( const __m256i a, const __m256i b ) const { return _mm256_min_epi32( _mm256_max_epi32( _mm256_add_epi32( a, b ), _mm256_setzero_si256() ), maxVal ); }
+  inline Pel scalar( Pel a, Pel b ) const { return Pel( ClipBD<Int>( Int( a ) + Int( b ), clipBD ) ); }
+};
+
+/// src0 - src1
+struct SimdYuvSubtract
+{
+  SIMD_TARGET_AVX2 inline __m256i simd( const __m256i a, const __m256i b ) const { return _mm256_sub_epi32( a, b ); }
+  inline Pel scalar( Pel a, Pel b ) const { return a - b; }
+};
+
+/// average of two intermediate predictions, clipped to the bit depth
+struct SimdYuvAverage
+{
+  __m256i maxVal;
+  __m256i offsetVec;
+  __m128i shiftVec;
+  Int     offset;
+  Int     shift;
+  Int     clipBD;
+  SIMD_TARGET_AVX2 SimdYuvAverage( Int off, Int sh, Int bitDepth )
+    : maxVal( _mm256_set1_epi32( ( 1 << bitDepth ) - 1 ) ), offsetVec( _mm256_set1_epi32( off ) ), shiftVec( _mm_cvtsi32_si128( sh ) ), offset( off ), shift( sh ), clipBD( bitDepth ) {}
+  SIMD_TARGET_AVX2 inline __m256i simd( const __m256i a, const __m256i b ) const
+  {
+    const __m256i sum = _mm256_sra_epi32( _mm256_add_epi32( _mm256_add_epi32( a, b ), offsetVec ), shiftVec );
+    return _mm256_min_epi32( _mm256_max_epi32( sum, _mm256_setzero_si256() ), maxVal );
+  }
+  inline Pel scalar( Pel a, Pel b ) const { return ClipBD( rightShift( ( a + b + offset ), shift ), clipBD ); }
+};
+
+/// 2 * src0 - src1, optionally clipped to the bit depth
+template<Bool bClip>
+struct SimdYuvRemoveHighFreq
+{
+  __m256i maxVal;
+  Int     clipBD;
+  SIMD_TARGET_AVX2 SimdYuvRemoveHighFreq( Int bitDepth ) : maxVal( _mm256_set1_epi32( ( 1 << bitDepth ) - 1 ) ), clipBD( bitDepth ) {}
+  SIMD_TARGET_AVX2 inline __m256i simd( const __m256i a, const __m256i b ) const
+  {
+    const __m256i val = _mm256_sub_epi32( _mm256_add_epi32( a, a ), b );
+    return bClip ? _mm256_min_epi32( _mm256_max_epi32( val, _mm256_setzero_si256() ), maxVal ) : val;
+  }
+  inline Pel scalar( Pel a, Pel b ) const { return bClip ? ClipBD( ( 2 * a ) - b, clipBD ) : ( 2 * a ) - b; }
+};
+#endif
+
 TComYuv::TComYuv()
 {
   for(Int comp=0; comp<MAX_NUM_COMPONENT; comp++)
@@ -299,6 +429,14 @@ Void TComYuv::addClip( const TComYuv* pcYuvSrc0, const TComYuv* pcYuvSrc1, const
     const Int bitDepthDelta = clipBitDepths.stream[toChannelType(compID)] - clipbd;
 #endif
 
+#if VECTOR_CODING__YUV_OPERATIONS && VECTOR_CODING__AVX2 && !O0043_BEST_EFFORT_DECODING
+    if( getSIMDExtension( SIMD_KERNELS_YUV_OPERATIONS ) >= SIMD_AVX2 )
+    {
+      simdYuvOperationAVX2( pSrc0, iSrc0Stride, pSrc1, iSrc1Stride, pDst, iDstStride, uiPartWidth, uiPartHeight, SimdYuvAddClip( clipbd ) );
+      continue;
+    }
+#endif
+
     for ( Int y = uiPartHeight-1; y >= 0; y-- )
     {
       for ( Int x = uiPartWidth-1; x >= 0; x-- )
@@ -335,6 +473,14 @@ Void TComYuv::subtract( const TComYuv* pcYuvSrc0, const TComYuv* pcYuvSrc1, cons
     const Int  iSrc1Stride = pcYuvSrc1->getStride(compID);
     const Int  iDstStride  = getStride(compID);
 
+#if VECTOR_CODING__YUV_OPERATIONS && VECTOR_CODING__AVX2
+    if( getSIMDExtension( SIMD_KERNELS_YUV_OPERATIONS ) >= SIMD_AVX2 )
+    {
+      simdYuvOperationAVX2( pSrc0, iSrc0Stride, pSrc1, iSrc1Stride, pDst, iDstStride, uiPartWidth, uiPartHeight, SimdYuvSubtract() );
+      continue;
+    }
+#endif
+
     for (Int y = uiPartHeight-1; y >= 0; y-- )
     {
       for (Int x = uiPartWidth-1; x >= 0; x-- )
@@ -375,6 +521,12 @@ Void TComYuv::addAvg( const TComYuv* pcYuvSrc0, const TComYuv* pcYuvSrc1, const
       assert(0);
       exit(-1);
     }
+#if VECTOR_CODING__YUV_OPERATIONS && VECTOR_CODING__AVX2
+    else if( getSIMDExtension( SIMD_KERNELS_YUV_OPERATIONS ) >= SIMD_AVX2 )
+    {
+      simdYuvOperationAVX2( pSrc0, iSrc0Stride, pSrc1, iSrc1Stride, pDst, iDstStride, iWidth, iHeight, SimdYuvAverage( offset, shiftNum, clipbd ) );
+    }
+#endif
     else if (iWidth&2)
     {
       for ( Int y = 0; y < iHeight; y++ )
@@ -426,6 +578,20 @@ Void TComYuv::removeHighFreq( const TComYuv* pcYuvSrc,
     const Int iDstStride = getStride(compID);
     const Int iWidth  = uiWidth >>getComponentScaleX(compID);
     const Int iHeight = uiHeight>>getComponentScaleY(compID);
+#if VECTOR_CODING__YUV_OPERATIONS && VECTOR_CODING__AVX2
+    if( getSIMDExtension( SIMD_KERNELS_YUV_OPERATIONS ) >= SIMD_AVX2 )
+    {
+      if (bClipToBitDepths)
+      {
+        simdYuvOperationAVX2( pDst, iDstStride, pSrc, iSrcStride, pDst, iDstStride, iWidth, iHeight, SimdYuvRemoveHighFreq<true>( bitDepths[toChannelType(compID)] ) );
+      }
+      else
+      {
+        simdYuvOperationAVX2( pDst, iDstStride, pSrc, iSrcStride, pDst, iDstStride, iWidth, iHeight, SimdYuvRemoveHighFreq<false>( 0 ) );
+      }
+      continue;
+    }
+#endif
     if (bClipToBitDepths)
     {
       const Int clipBd=bitDepths[toChannelType(compID)];
@@ -130,9 +130,27 @@
 #if defined __SSE2__ || defined __AVX2__ || defined __AVX__ || defined _M_AMD64 || defined _M_X64
 #define VECTOR_CODING__INTERPOLATION_FILTER               1 ///< enable vector coding for the interpolation filter. 1 (default if SSE possible) disable SSE vector coding. Should not affect RD costs/decisions. Code back-ported from JEM2.0.
 #define VECTOR_CODING__DISTORTION_CALCULATIONS            1 ///< enable vector coding for distortion calculations   1 (default if SSE possible) disable SSE vector coding. Should not affect RD costs/decisions. Code back-ported from JEM2.0.
+#define VECTOR_CODING__TRANSFORM                          1 ///< enable vector coding for the core forward and inverse transforms. 1 (default if SSE possible). Output is identical to the C code.
+#define VECTOR_CODING__INTRA_PREDICTION                   1 ///< enable vector coding for the angular, planar and DC intra prediction. 1 (default if SSE possible). Output is identical to the C code.
+#define VECTOR_CODING__DEBLOCKING_FILTER                  1 ///< enable vector coding for the luma and chroma deblocking filters. 1 (default if SSE possible). Output is identical to the C code.
+#define VECTOR_CODING__SAO                                1 ///< enable vector coding for the SAO edge and band offsets and the encoder SAO edge statistics. 1 (default if SSE possible). Output is identical to the C code.
+#define VECTOR_CODING__YUV_OPERATIONS                     1 ///< enable vector coding for the residual, reconstruction and averaging functions of TComYuv and for weighted prediction. 1 (default if SSE possible). Output is identical to the C code.
+#define VECTOR_CODING__BITSTREAM                          1 ///< enable vector coding for the start code and emulation prevention scanning of byte streams and NAL units. 1 (default if SSE possible). Output is identical to the C code.
+#if (defined __GNUC__ && __GNUC__ >= 5) || defined __clang__ || (defined _MSC_VER && _MSC_VER >= 1800)
+#define VECTOR_CODING__AVX2                               1 ///< also compile AVX2 versions of the vector coded functions, which are selected at run time when the processor supports them (see TComCpuFeatures.h). Should not affect RD costs/decisions.
+#else
+#define VECTOR_CODING__AVX2                               0 ///< the compiler cannot generate AVX2 code for individual functions
+#endif
 #else
 #define VECTOR_CODING__INTERPOLATION_FILTER               0 ///< enable vector coding for the interpolation filter. 0 (default if SSE not possible) disable SSE vector coding. Should not affect RD costs/decisions. Code back-ported from JEM2.0.
 #define VECTOR_CODING__DISTORTION_CALCULATIONS            0 ///< enable vector coding for distortion calculations   0 (default if SSE not possible) disable SSE vector coding. Should not affect RD costs/decisions. Code back-ported from JEM2.0.
+#define VECTOR_CODING__TRANSFORM                          0 ///< enable vector coding for the core forward and inverse transforms. 0 (default if SSE not possible)
+#define VECTOR_CODING__INTRA_PREDICTION                   0 ///< enable vector coding for the angular, planar and DC intra prediction. 0 (default if SSE not possible)
+#define VECTOR_CODING__DEBLOCKING_FILTER                  0 ///< enable vector coding for the luma and chroma deblocking filters. 0 (default if SSE not possible)
+#define VECTOR_CODING__SAO                                0 ///< enable vector coding for the SAO edge and band offsets and the encoder SAO edge statistics. 0 (default if SSE not possible)
+#define VECTOR_CODING__YUV_OPERATIONS                     0 ///< enable vector coding for the residual, reconstruction and averaging functions of TComYuv and for weighted prediction. 0 (default if SSE not possible)
+#define VECTOR_CODING__BITSTREAM                          0 ///< enable vector coding for the start code and emulation prevention scanning of byte streams and NAL units. 0 (default if SSE not possible)
+#define VECTOR_CODING__AVX2                               0 ///< also compile AVX2 versions of the vector coded functions. 0 (default if SSE not possible)
 #endif
 
 // ====================================================================================================================
@@ -801,7 +819,7 @@ struct TUEntropyCodingParameters
         COEFF_SCAN_TYPE  scanType;
         UInt             widthInGroups;
         UInt             heightInGroups;
-        UInt             firstSignificanceMapContext;
+  const UChar           *sigCtxIncInGroup; ///< significant_coeff_flag context increments of the TU, see g_sigCtxIncInGroup
 };
 
 
@@ -38,13 +38,25 @@
 
 
 #include <stdint.h>
+#include <stdio.h>
 #include <cassert>
 #include <vector>
 #include "AnnexBread.h"
+#include "TLibCommon/TComBitStream.h"
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
 #include "TLibCommon/TComCodingStatistics.h"
 #endif
 
+#if defined(__unix__) || defined(__APPLE__)
+#define ANNEXB_MEMORY_MAPPING 1
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#else
+#define ANNEXB_MEMORY_MAPPING 0
+#endif
+
 using namespace std;
 
 //! \ingroup TLibDecoder
@@ -196,4 +208,164 @@ byteStreamNALUnit(
   stats.m_numBytesInNALUnit = UInt(nalUnit.size());
   return eof;
 }
+
+// ====================================================================================================================
+// AnnexBFileReader
+// ====================================================================================================================
+
+AnnexBFileReader::AnnexBFileReader()
+: m_data(NULL)
+, m_size(0)
+, m_position(0)
+, m_mapped(false)
+{
+}
+
+AnnexBFileReader::~AnnexBFileReader()
+{
+  close();
+}
+
+Bool AnnexBFileReader::open(const string& fileName)
+{
+  close();
+
+#if ANNEXB_MEMORY_MAPPING
+  const Int fd = ::open(fileName.c_str(), O_RDONLY);
+  if (fd < 0)
+  {
+    return false;
+  }
+  struct stat status;
+  if (fstat(fd, &status) == 0 && status.st_size > 0)
+  {
+    void* mapping = mmap(NULL, size_t(status.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapping != MAP_FAILED)
+    {
+      madvise(mapping, size_t(status.st_size), MADV_SEQUENTIAL);
+      m_data   = (const uint8_t*)mapping;
+      m_size   = UInt64(status.st_size);
+      m_mapped = true;
+    }
+  }
+  ::close(fd);
+  if (m_mapped)
+  {
+    return true;
+  }
+#endif
+
+  // files that cannot be mapped are read in one block
+  FILE* file = fopen(fileName.c_str(), "rb");
+  if (file == NULL)
+  {
+    return false;
+  }
+  const size_t blockSize = 1 << 20;
+  size_t numBytesRead = 0;
+  do
+  {
+    m_buffer.resize(m_buffer.size() + blockSize);
+    numBytesRead = fread(&m_buffer[m_buffer.size() - blockSize], 1, blockSize, file);
+    m_buffer.resize(m_buffer.size() - blockSize + numBytesRead);
+  } while (numBytesRead == blockSize);
+  const Bool ok = !ferror(file);
+  fclose(file);
+
+  m_data = m_buffer.empty() ? NULL : &m_buffer[0];
+  m_size = UInt64(m_buffer.size());
+  return ok;
+}
+
+Void AnnexBFileReader::close()
+{
+#if ANNEXB_MEMORY_MAPPING
+  if (m_mapped)
+  {
+    munmap((void*)m_data, size_t(m_size));
+  }
+#endif
+  m_buffer.clear();
+  m_data     = NULL;
+  m_size     = 0;
+  m_position = 0;
+  m_mapped   = false;
+}
+
+/**
+ * returns the position of the first start_code_prefix_one_3bytes
+ * (0x000001) in [begin, end), or end if there is none
+ */
+static const uint8_t* xFindStartCodePrefix(const uint8_t* begin, const uint8_t* end)
+{
+  const uint8_t* p = findZeroZeroSequence(begin, end, 1);
+  while (p != end && p[2] != 1)
+  {
+    p = findZeroZeroSequence(p + 1, end, 1);
+  }
+  return p;
+}
+
+/**
+ * Performs the same steps as _byteStreamNALUnit(), on whole runs of
+ * bytes instead of one byte at a time.
+ */
+Bool AnnexBFileReader::readNALUnit(AnnexBNALUnitView& nalUnit, AnnexBStats& stats)
+{
+  const uint8_t* const end = m_data + m_size;
+  const uint8_t* p = m_data + m_position;
+#if RExt__DECODER_DEBUG_BIT_STATISTICS
+  TComCodingStatistics::SStat &statBits=TComCodingStatistics::GetStatisticEP(STATS__NAL_UNIT_PACKING);
+  TComCodingStatistics::SStat &bodyStats=TComCodingStatistics::GetStatisticEP(STATS__NAL_UNIT_TOTAL_BODY);
+#endif
+
+  nalUnit.m_data     = end;
+  nalUnit.m_numBytes = 0;
+
+  /* leading_zero_8bits and zero_byte, up to the start code prefix */
+  const uint8_t* startCodePrefix = xFindStartCodePrefix(p, end);
+  if (startCodePrefix == end)
+  {
+    stats.m_numLeadingZero8BitsBytes += UInt(end - p);
+#if RExt__DECODER_DEBUG_BIT_STATISTICS
+    statBits.bits += 8*Int64(end - p); statBits.count += Int64(end - p);
+#endif
+    m_position = m_size;
+    stats.m_numBytesInNALUnit = 0;
+    return true;
+  }
+  const UInt numZeroBytes = (startCodePrefix > p) ? 1 : 0;
+  assert(numZeroBytes == 0 || startCodePrefix[-1] == 0);
+  stats.m_numLeadingZero8BitsBytes += UInt(startCodePrefix - p) - numZeroBytes;
+  stats.m_numZeroByteBytes         += numZeroBytes;
+  stats.m_numStartCodePrefixBytes  += 3;
+#if RExt__DECODER_DEBUG_BIT_STATISTICS
+  statBits.bits += 8*Int64(startCodePrefix - p + 3); statBits.count += Int64(startCodePrefix - p + 3);
+#endif
+
+  /* the NAL unit ends before a subsequent 0x000000, 0x000001 (or the
+   * forbidden 0x000002), or at the end of the byte stream */
+  const uint8_t* nalUnitBegin = startCodePrefix + 3;
+  const uint8_t* nalUnitEnd   = findZeroZeroSequence(nalUnitBegin, end, 2);
+  nalUnit.m_data     = nalUnitBegin;
+  nalUnit.m_numBytes = UInt(nalUnitEnd - nalUnitBegin);
+  stats.m_numBytesInNALUnit = nalUnit.m_numBytes;
+#if RExt__DECODER_DEBUG_BIT_STATISTICS
+  bodyStats.bits += 8*Int64(nalUnit.m_numBytes); bodyStats.count += Int64(nalUnit.m_numBytes);
+#endif
+
+  /* trailing_zero_8bits, up to the zero_byte of the next start code or
+   * the end of the byte stream */
+  const uint8_t* next = xFindStartCodePrefix(nalUnitEnd, end);
+  if (next != end && next > nalUnitEnd)
+  {
+    next--;
+  }
+  stats.m_numTrailingZero8BitsBytes += UInt(next - nalUnitEnd);
+#if RExt__DECODER_DEBUG_BIT_STATISTICS
+  statBits.bits += 8*Int64(next - nalUnitEnd); statBits.count += Int64(next - nalUnitEnd);
+#endif
+  m_position = UInt64(next - m_data);
+  return isEndOfStream();
+}
 //! \}
@@ -43,6 +43,7 @@
 
 #include <stdint.h>
 #include <istream>
+#include <string>
 #include <vector>
 
 #include "TLibCommon/CommonDef.h"
@@ -194,6 +195,53 @@ struct AnnexBStats
 
 Bool byteStreamNALUnit(InputByteStream& bs, std::vector<uint8_t>& nalUnit, AnnexBStats& stats);
 
+/**
+ * A NAL unit of a byte stream, pointing into the buffer of the
+ * AnnexBFileReader that extracted it. It remains valid until the
+ * reader is closed.
+ */
+struct AnnexBNALUnitView
+{
+  const uint8_t* m_data;
+  UInt           m_numBytes;
+};
+
+/**
+ * Reader of an Annex B byte stream file, which is memory mapped when
+ * the platform allows it and otherwise read in one block. The start
+ * codes are found with findZeroZeroSequence(), and the NAL units are
+ * returned as views into the buffer, without copying them.
+ */
+class AnnexBFileReader
+{
+public:
+  AnnexBFileReader();
+  ~AnnexBFileReader();
+
+  /// returns false if the file cannot be opened or read
+  Bool open(const std::string& fileName);
+  Void close();
+
+  UInt64 getSize() const { return m_size; }
+
+  /// true when all the NAL units have been extracted
+  Bool isEndOfStream() const { return m_position >= m_size; }
+
+  /**
+   * Extracts the next NAL unit, accumulating the byte stream statistics
+   * into stats. Returns true if the end of the byte stream was reached
+   * (the NAL unit may still be valid), otherwise false.
+   */
+  Bool readNALUnit(AnnexBNALUnitView& nalUnit, AnnexBStats& stats);
+
+private:
+  const uint8_t*       m_data;     ///< contents of the file
+  UInt64               m_size;     ///< size of the file in bytes
+  UInt64               m_position; ///< position of the next byte to extract
+  Bool                 m_mapped;   ///< true when m_data is a memory mapping of the file
+  std::vector<uint8_t> m_buffer;   ///< contents of the file when it is not memory mapped
+};
+
 //! \}
 
 #endif
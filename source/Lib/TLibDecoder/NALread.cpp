@@ -40,6 +40,7 @@
 #include <vector>
 #include <algorithm>
 #include <ostream>
+#include <string.h>
 
 #include "NALread.h"
 #include "TLibCommon/NAL.h"
@@ -55,42 +56,63 @@ using namespace std;
 
 //! \ingroup TLibDecoder
 //! \{
+/**
+ * Removes the emulation_prevention_three_bytes of the NAL unit in place,
+ * recording their positions in bitstream. The 0x000003 sequences are found
+ * with findZeroZeroSequence(), and the bytes between them are moved in
+ * blocks.
+ */
 static Void convertPayloadToRBSP(vector<uint8_t>& nalUnitBuf, TComInputBitstream *bitstream, Bool isVclNalUnit)
 {
-  UInt zeroCount = 0;
-  vector<uint8_t>::iterator it_read, it_write;
-
-  UInt pos = 0;
   bitstream->clearEmulationPreventionByteLocation();
-  for (it_read = it_write = nalUnitBuf.begin(); it_read != nalUnitBuf.end(); it_read++, it_write++, pos++)
+  if (nalUnitBuf.empty())
+  {
+    return;
+  }
+
+  uint8_t* const begin = &nalUnitBuf[0];
+  const uint8_t* const end = begin + nalUnitBuf.size();
+  const uint8_t* it_read = begin;
+  uint8_t* it_write = begin;
+
+  for (const uint8_t* seq = findZeroZeroSequence(it_read, end, 0x03); seq != end; seq = findZeroZeroSequence(seq + 1, end, 0x03))
   {
-    assert(zeroCount < 2 || *it_read >= 0x03);
-    if (zeroCount == 2 && *it_read == 0x03)
+    // 0x000000, 0x000001 and 0x000002 shall not occur within a NAL unit
+    assert(seq[2] == 0x03);
+    if (seq[2] != 0x03)
     {
-      bitstream->pushEmulationPreventionByteLocation( pos );
-      pos++;
-      it_read++;
-      zeroCount = 0;
+      continue;
+    }
+    const UInt numBytes = UInt(seq + 2 - it_read);
+    if (it_write != it_read)
+    {
+      memmove(it_write, it_read, numBytes);
+    }
+    it_write += numBytes;
+    it_read   = seq + 3;
+    bitstream->pushEmulationPreventionByteLocation( UInt(seq + 2 - begin) );
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
-      TComCodingStatistics::IncrementStatisticEP(STATS__EMULATION_PREVENTION_3_BYTES, 8, 0);
+    TComCodingStatistics::IncrementStatisticEP(STATS__EMULATION_PREVENTION_3_BYTES, 8, 0);
 #endif
-      if (it_read == nalUnitBuf.end())
-      {
-        break;
-      }
-      assert(*it_read <= 0x03);
-    }
-    zeroCount = (*it_read == 0x00) ? zeroCount+1 : 0;
-    *it_write = *it_read;
+    assert(it_read == end || *it_read <= 0x03);
+
+    // the zero bytes before an emulation prevention byte do not start a new sequence
+    seq += 2;
+  }
+  const UInt numBytes = UInt(end - it_read);
+  if (it_write != it_read && numBytes > 0)
+  {
+    memmove(it_write, it_read, numBytes);
   }
-  assert(zeroCount == 0);
+  it_write += numBytes;
+  assert(it_read == end || end[-1] != 0x00);
 
   if (isVclNalUnit)
   {
     // Remove cabac_zero_word from payload if present
     Int n = 0;
 
-    while (it_write[-1] == 0x00)
+    while (it_write > begin && it_write[-1] == 0x00)
     {
       it_write--;
       n++;
@@ -102,7 +124,7 @@ static Void convertPayloadToRBSP(vector<uint8_t>& nalUnitBuf, TComInputBitstream
     }
   }
 
-  nalUnitBuf.resize(it_write - nalUnitBuf.begin());
+  nalUnitBuf.resize(it_write - begin);
 }
 
 #if ENC_DEC_TRACE && DEC_NUH_TRACE
@@ -166,7 +166,9 @@ Void SEIReader::xReadSEImessage(SEIMessages& seis, const NalUnitType nalUnitType
    * bitstream.
    */
   TComInputBitstream *bs = getBitstream();
-  setBitstream(bs->extractSubstream(payloadSize * 8));
+  TComInputBitstream payload;
+  bs->extractSubstream(payloadSize * 8, payload);
+  setBitstream(&payload);
 
   SEI *sei = NULL;
 
@@ -374,7 +376,6 @@ Void SEIReader::xReadSEImessage(SEIMessages& seis, const NalUnitType nalUnitType
   }
 
   /* restore primary bitstream for sei_message */
-  delete getBitstream();
   setBitstream(bs);
 }
 
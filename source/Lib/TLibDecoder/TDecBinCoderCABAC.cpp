@@ -41,9 +41,31 @@
 #include "TLibCommon/TComCodingStatistics.h"
 #endif
 
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
 //! \ingroup TLibDecoder
 //! \{
 
+/** The offset of the arithmetic decoder is kept in bits 62..54 of m_uiValue, so that it is compared with the range
+ *  shifted by OFFSET_SHIFT. The bits below it have been read ahead from the bitstream, which is only accessed once
+ *  they run out, several bytes at a time. Bit 63 is free so that a bypass bin can be shifted in before the comparison.
+ */
+static const Int    OFFSET_SHIFT = 54;
+static const UInt64 OFFSET_MASK  = ( UInt64( 1 ) << ( OFFSET_SHIFT + 8 ) ) - 1; ///< bits of m_uiValue below the MSB of an offset that is less than 256
+
+static inline Int xCountLeadingZeros( UInt value )
+{
+#if defined(_MSC_VER)
+  unsigned long index;
+  _BitScanReverse( &index, value );
+  return 31 - Int( index );
+#else
+  return __builtin_clz( value );
+#endif
+}
+
 TDecBinCABAC::TDecBinCABAC()
 : m_pcTComBitstream( 0 )
 {
@@ -72,10 +94,10 @@ TDecBinCABAC::start()
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
   TComCodingStatistics::UpdateCABACStat(STATS__CABAC_INITIALISATION, 512, 510, 0);
 #endif
-  m_uiRange    = 510;
-  m_bitsNeeded = -8;
-  m_uiValue    = (m_pcTComBitstream->readByte() << 8);
-  m_uiValue   |= m_pcTComBitstream->readByte();
+  m_uiRange          = 510;
+  m_uiValue          = 0;
+  m_numLookaheadBits = -9;
+  xRefill();
 }
 
 Void
@@ -85,7 +107,7 @@ TDecBinCABAC::finish()
 
   m_pcTComBitstream->peekPreviousByte( lastByte );
   // Check for proper stop/alignment pattern
-  assert( ((lastByte << (8 + m_bitsNeeded)) & 0xff) == 0x80 );
+  assert( ((lastByte << (7 - m_numLookaheadBits)) & 0xff) == 0x80 );
 }
 
 /**
@@ -97,11 +119,42 @@ Void
 TDecBinCABAC::copyState( const TDecBinIf* pcTDecBinIf )
 {
   const TDecBinCABAC* pcTDecBinCABAC = pcTDecBinIf->getTDecBinCABAC();
-  m_uiRange   = pcTDecBinCABAC->m_uiRange;
-  m_uiValue   = pcTDecBinCABAC->m_uiValue;
-  m_bitsNeeded= pcTDecBinCABAC->m_bitsNeeded;
+  m_uiRange          = pcTDecBinCABAC->m_uiRange;
+  m_uiValue          = pcTDecBinCABAC->m_uiValue;
+  m_numLookaheadBits = pcTDecBinCABAC->m_numLookaheadBits;
 }
 
+/** Read as many whole bytes as fit below the lookahead bits of m_uiValue.
+ */
+Void
+TDecBinCABAC::xRefill()
+{
+  const UInt numBytes = std::min<UInt>( ( OFFSET_SHIFT - m_numLookaheadBits ) >> 3, 8 );
+  UInt64     bytes;
+  const UInt numBytesRead = m_pcTComBitstream->readBytes( numBytes, bytes );
+
+  if( numBytesRead > 0 )
+  {
+    m_uiValue          |= bytes << ( OFFSET_SHIFT - m_numLookaheadBits - 8 * Int( numBytesRead ) );
+    m_numLookaheadBits += 8 * numBytesRead;
+  }
+}
+
+/** Return the whole bytes that were read ahead to the bitstream, leaving its position where a decoder that reads
+ *  a byte whenever it has consumed 8 bits would be. Used when the arithmetic decoding ends, before the bitstream is
+ *  read directly.
+ */
+Void
+TDecBinCABAC::xUnreadLookaheadBytes()
+{
+  const Int numBytes = m_numLookaheadBits >> 3;
+  if( numBytes > 0 )
+  {
+    m_pcTComBitstream->unreadBytes( numBytes );
+    m_numLookaheadBits -= 8 * numBytes;
+    m_uiValue          &= ~( ( UInt64( 1 ) << ( OFFSET_SHIFT - m_numLookaheadBits ) ) - 1 );
+  }
+}
 
 
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
@@ -116,7 +169,7 @@ Void TDecBinCABAC::decodeBin( UInt& ruiBin, ContextModel &rcCtxModel )
 
   UInt uiLPS = TComCABACTables::sm_aucLPSTable[ rcCtxModel.getState() ][ ( m_uiRange >> 6 ) - 4 ];
   m_uiRange -= uiLPS;
-  UInt scaledRange = m_uiRange << 7;
+  const UInt64 scaledRange = UInt64( m_uiRange ) << OFFSET_SHIFT;
 
   if( m_uiValue < scaledRange )
   {
@@ -126,18 +179,6 @@ Void TDecBinCABAC::decodeBin( UInt& ruiBin, ContextModel &rcCtxModel )
     TComCodingStatistics::UpdateCABACStat(whichStat, m_uiRange+uiLPS, m_uiRange, Int(ruiBin));
 #endif
     rcCtxModel.updateMPS();
-
-    if ( scaledRange < ( 256 << 7 ) )
-    {
-      m_uiRange = scaledRange >> 6;
-      m_uiValue += m_uiValue;
-
-      if ( ++m_bitsNeeded == 0 )
-      {
-        m_bitsNeeded = -8;
-        m_uiValue += m_pcTComBitstream->readByte();
-      }
-    }
   }
   else
   {
@@ -146,18 +187,20 @@ Void TDecBinCABAC::decodeBin( UInt& ruiBin, ContextModel &rcCtxModel )
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
     TComCodingStatistics::UpdateCABACStat(whichStat, m_uiRange+uiLPS, uiLPS, Int(ruiBin));
 #endif
-    Int numBits = TComCABACTables::sm_aucRenormTable[ uiLPS >> 3 ];
-    m_uiValue   = ( m_uiValue - scaledRange ) << numBits;
-    m_uiRange   = uiLPS << numBits;
+    m_uiValue  -= scaledRange;
+    m_uiRange   = uiLPS;
     rcCtxModel.updateLPS();
+  }
 
-    m_bitsNeeded += numBits;
+  // renormalize until the range has 9 bits again: at most 1 bit after an MPS, 6 after an LPS
+  const Int numBits = xCountLeadingZeros( m_uiRange ) - 23;
+  m_uiRange          <<= numBits;
+  m_uiValue          <<= numBits;
+  m_numLookaheadBits  -= numBits;
 
-    if ( m_bitsNeeded >= 0 )
-    {
-      m_uiValue += m_pcTComBitstream->readByte() << m_bitsNeeded;
-      m_bitsNeeded -= 8;
-    }
+  if ( m_numLookaheadBits < 0 )
+  {
+    xRefill();
   }
 
 #if DEBUG_CABAC_BINS
@@ -186,26 +229,15 @@ Void TDecBinCABAC::decodeBinEP( UInt& ruiBin, const TComCodingStatisticsClassTyp
 Void TDecBinCABAC::decodeBinEP( UInt& ruiBin )
 #endif
 {
-  if (m_uiRange == 256)
-  {
-#if RExt__DECODER_DEBUG_BIT_STATISTICS
-    decodeAlignedBinsEP(ruiBin, 1, whichStat);
-#else
-    decodeAlignedBinsEP(ruiBin, 1);
-#endif
-    return;
-  }
-
   m_uiValue += m_uiValue;
 
-  if ( ++m_bitsNeeded >= 0 )
+  if ( --m_numLookaheadBits < 0 )
   {
-    m_bitsNeeded = -8;
-    m_uiValue += m_pcTComBitstream->readByte();
+    xRefill();
   }
 
   ruiBin = 0;
-  UInt scaledRange = m_uiRange << 7;
+  const UInt64 scaledRange = UInt64( m_uiRange ) << OFFSET_SHIFT;
   if ( m_uiValue >= scaledRange )
   {
     ruiBin = 1;
@@ -222,6 +254,8 @@ Void TDecBinCABAC::decodeBinsEP( UInt& ruiBin, Int numBins, const TComCodingStat
 Void TDecBinCABAC::decodeBinsEP( UInt& ruiBin, Int numBins )
 #endif
 {
+  assert( numBins <= 32 );
+
   if (m_uiRange == 256)
   {
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
@@ -232,52 +266,98 @@ Void TDecBinCABAC::decodeBinsEP( UInt& ruiBin, Int numBins )
     return;
   }
 
-  UInt bins = 0;
-#if RExt__DECODER_DEBUG_BIT_STATISTICS
-  Int origNumBins=numBins;
-#endif
-  while ( numBins > 8 )
-  {
-    m_uiValue = ( m_uiValue << 8 ) + ( m_pcTComBitstream->readByte() << ( 8 + m_bitsNeeded ) );
-
-    UInt scaledRange = m_uiRange << 15;
-    for ( Int i = 0; i < 8; i++ )
-    {
-      bins += bins;
-      scaledRange >>= 1;
-      if ( m_uiValue >= scaledRange )
-      {
-        bins++;
-        m_uiValue -= scaledRange;
-      }
-    }
-    numBins -= 8;
-  }
-
-  m_bitsNeeded += numBins;
-  m_uiValue <<= numBins;
-
-  if ( m_bitsNeeded >= 0 )
+  if ( m_numLookaheadBits < numBins )
   {
-    m_uiValue += m_pcTComBitstream->readByte() << m_bitsNeeded;
-    m_bitsNeeded -= 8;
+    xRefill();
   }
 
-  UInt scaledRange = m_uiRange << ( numBins + 7 );
+  // all the bins are decoded from the lookahead bits, without touching the bitstream
+  UInt bins = 0;
+  const UInt64 scaledRange = UInt64( m_uiRange ) << OFFSET_SHIFT;
   for ( Int i = 0; i < numBins; i++ )
   {
+    m_uiValue += m_uiValue;
     bins += bins;
-    scaledRange >>= 1;
     if ( m_uiValue >= scaledRange )
     {
       bins++;
       m_uiValue -= scaledRange;
     }
   }
+  m_numLookaheadBits -= numBins;
 
   ruiBin = bins;
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
-  TComCodingStatistics::IncrementStatisticEP(whichStat, origNumBins, Int(ruiBin));
+  TComCodingStatistics::IncrementStatisticEP(whichStat, numBins, Int(ruiBin));
+#endif
+}
+
+/** Decode bypass bins up to and including the first 0, or until maxNumBins bins have been decoded, which is the
+ *  prefix of coeff_abs_level_remaining.
+ *  \param ruiNumOnes  the number of bins equal to 1 before the first 0
+ *  \param maxNumBins  maximum number of bins to decode
+ */
+#if RExt__DECODER_DEBUG_BIT_STATISTICS
+Void TDecBinCABAC::decodeUnaryBinsEP( UInt& ruiNumOnes, UInt maxNumBins, const TComCodingStatisticsClassType &whichStat )
+#else
+Void TDecBinCABAC::decodeUnaryBinsEP( UInt& ruiNumOnes, UInt maxNumBins )
+#endif
+{
+  UInt numOnes = 0;
+  Bool foundZero = false;
+
+  while ( !foundZero && numOnes < maxNumBins )
+  {
+    const Int numBins = Int( std::min<UInt>( maxNumBins - numOnes, 32 ) );
+    if ( m_numLookaheadBits < numBins )
+    {
+      xRefill();
+    }
+
+    Int numBinsDecoded;
+    if ( m_uiRange == 256 )
+    {
+      // the bins are the bits following the MSB of the offset (see decodeAlignedBinsEP), so count the leading ones
+      const UInt bins       = UInt( ( ( m_uiValue << 2 ) >> 1 ) >> ( 63 - numBins ) ) << ( 32 - numBins );
+      const Int  numLeading = ( bins == MAX_UINT ) ? 32 : xCountLeadingZeros( ~bins );
+
+      foundZero      = numLeading < numBins;
+      numBinsDecoded = foundZero ? numLeading + 1 : numBins;
+      numOnes       += UInt( std::min( numLeading, numBins ) );
+      m_uiValue      = ( m_uiValue << numBinsDecoded ) & OFFSET_MASK;
+    }
+    else
+    {
+      const UInt64 scaledRange = UInt64( m_uiRange ) << OFFSET_SHIFT;
+      numBinsDecoded = 0;
+      while ( !foundZero && numBinsDecoded < numBins )
+      {
+        m_uiValue += m_uiValue;
+        numBinsDecoded++;
+        if ( m_uiValue >= scaledRange )
+        {
+          numOnes++;
+          m_uiValue -= scaledRange;
+        }
+        else
+        {
+          foundZero = true;
+        }
+      }
+    }
+    m_numLookaheadBits -= numBinsDecoded;
+  }
+
+  ruiNumOnes = numOnes;
+#if RExt__DECODER_DEBUG_BIT_STATISTICS
+  for ( UInt i = 0; i < numOnes; i++ )
+  {
+    TComCodingStatistics::IncrementStatisticEP(whichStat, 1, 1);
+  }
+  if ( foundZero )
+  {
+    TComCodingStatistics::IncrementStatisticEP(whichStat, 1, 0);
+  }
 #endif
 }
 
@@ -295,40 +375,27 @@ Void TDecBinCABAC::decodeAlignedBinsEP( UInt& ruiBins, Int numBins, const class
 Void TDecBinCABAC::decodeAlignedBinsEP( UInt& ruiBins, Int numBins )
 #endif
 {
-  Int binsRemaining = numBins;
-  ruiBins = 0;
-
   assert(m_uiRange == 256); //aligned decode only works when range = 256
+  assert(numBins <= 32);
 
-  while (binsRemaining > 0)
+  if ( m_numLookaheadBits < numBins )
   {
-    const UInt binsToRead = std::min<UInt>(binsRemaining, 8); //read bytes if able to take advantage of the system's byte-read function
-    const UInt binMask    = (1 << binsToRead) - 1;
-
-    //The MSB of m_uiValue is known to be 0 because range is 256. Therefore:
-    // > The comparison against the symbol range of 128 is simply a test on the next-most-significant bit
-    // > "Subtracting" the symbol range if the decoded bin is 1 simply involves clearing that bit.
-    //
-    //As a result, the required bins are simply the <binsToRead> next-most-significant bits of m_uiValue
-    //(m_uiValue is stored MSB-aligned in a 16-bit buffer - hence the shift of 15)
-    //
-    //   m_uiValue = |0|V|V|V|V|V|V|V|V|B|B|B|B|B|B|B|        (V = usable bit, B = potential buffered bit (buffer refills when m_bitsNeeded >= 0))
-    //
-    const UInt newBins = (m_uiValue >> (15 - binsToRead)) & binMask;
-
-    ruiBins   = (ruiBins   << binsToRead) | newBins;
-    m_uiValue = (m_uiValue << binsToRead) & 0x7FFF;
-
-    binsRemaining -= binsToRead;
-    m_bitsNeeded  += binsToRead;
-
-    if (m_bitsNeeded >= 0)
-    {
-      m_uiValue    |= m_pcTComBitstream->readByte() << m_bitsNeeded;
-      m_bitsNeeded -= 8;
-    }
+    xRefill();
   }
 
+  //The MSB of the offset is known to be 0 because range is 256. Therefore:
+  // > The comparison against the symbol range of 128 is simply a test on the next-most-significant bit
+  // > "Subtracting" the symbol range if the decoded bin is 1 simply involves clearing that bit.
+  //
+  //As a result, the required bins are simply the <numBins> bits of m_uiValue following the MSB of the offset
+  //(the offset is stored in bits 62..54 - see OFFSET_SHIFT)
+  //
+  //   m_uiValue = |-|0|V|V|V|V|V|V|V|V|B|B|B|...|        (V = usable bit, B = lookahead bit)
+  //
+  ruiBins             = UInt( ( ( m_uiValue << 2 ) >> 1 ) >> ( 63 - numBins ) );
+  m_uiValue           = ( m_uiValue << numBins ) & OFFSET_MASK;
+  m_numLookaheadBits -= numBins;
+
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
   TComCodingStatistics::IncrementStatisticEP(whichStat, numBins, Int(ruiBins));
 #endif
@@ -338,13 +405,15 @@ Void
 TDecBinCABAC::decodeBinTrm( UInt& ruiBin )
 {
   m_uiRange -= 2;
-  UInt scaledRange = m_uiRange << 7;
+  const UInt64 scaledRange = UInt64( m_uiRange ) << OFFSET_SHIFT;
   if( m_uiValue >= scaledRange )
   {
     ruiBin = 1;
+    // the arithmetic decoding ends here, and the bitstream may be read directly next
+    xUnreadLookaheadBytes();
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
     TComCodingStatistics::UpdateCABACStat(STATS__CABAC_TRM_BITS, m_uiRange+2, 2, ruiBin);
-    TComCodingStatistics::IncrementStatisticEP(STATS__BYTE_ALIGNMENT_BITS, -m_bitsNeeded, 0);
+    TComCodingStatistics::IncrementStatisticEP(STATS__BYTE_ALIGNMENT_BITS, m_numLookaheadBits + 1, 0);
 #endif
   }
   else
@@ -353,15 +422,14 @@ TDecBinCABAC::decodeBinTrm( UInt& ruiBin )
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
     TComCodingStatistics::UpdateCABACStat(STATS__CABAC_TRM_BITS, m_uiRange+2, m_uiRange, ruiBin);
 #endif
-    if ( scaledRange < ( 256 << 7 ) )
+    if ( m_uiRange < 256 )
     {
-      m_uiRange = scaledRange >> 6;
+      m_uiRange += m_uiRange;
       m_uiValue += m_uiValue;
 
-      if ( ++m_bitsNeeded == 0 )
+      if ( --m_numLookaheadBits < 0 )
       {
-        m_bitsNeeded = -8;
-        m_uiValue += m_pcTComBitstream->readByte();
+        xRefill();
       }
     }
   }
@@ -61,11 +61,13 @@ public:
   Void  decodeBinEP        ( UInt& ruiBin                          , const class TComCodingStatisticsClassType &whichStat );
   Void  decodeBinsEP       ( UInt& ruiBin, Int numBins             , const class TComCodingStatisticsClassType &whichStat );
   Void  decodeAlignedBinsEP( UInt& ruiBins, Int numBins            , const class TComCodingStatisticsClassType &whichStat );
+  Void  decodeUnaryBinsEP  ( UInt& ruiNumOnes, UInt maxNumBins     , const class TComCodingStatisticsClassType &whichStat );
 #else
   Void  decodeBin         ( UInt& ruiBin, ContextModel& rcCtxModel );
   Void  decodeBinEP       ( UInt& ruiBin                           );
   Void  decodeBinsEP      ( UInt& ruiBin, Int numBins              );
   Void  decodeAlignedBinsEP( UInt& ruiBins, Int numBins             );
+  Void  decodeUnaryBinsEP ( UInt& ruiNumOnes, UInt maxNumBins      );
 #endif
 
   Void  align             ();
@@ -79,10 +81,13 @@ public:
   const TDecBinCABAC* getTDecBinCABAC() const { return this; }
 
 private:
+  Void  xRefill               ();
+  Void  xUnreadLookaheadBytes ();
+
   TComInputBitstream* m_pcTComBitstream;
   UInt                m_uiRange;
-  UInt                m_uiValue;
-  Int                 m_bitsNeeded;
+  UInt64              m_uiValue;           ///< 9-bit offset in bits 62..54, followed by m_numLookaheadBits bits read ahead from the bitstream
+  Int                 m_numLookaheadBits;  ///< number of valid bits below the offset in m_uiValue; negative when the offset itself is incomplete
 };
 
 //! \}
@@ -39,6 +39,7 @@
 #include "SEIread.h"
 #include "TDecSlice.h"
 #include "TLibCommon/TComChromaFormat.h"
+#include "TLibCommon/TComProfiler.h"
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
 #include "TLibCommon/TComCodingStatistics.h"
 #endif
@@ -956,6 +957,7 @@ Void TDecCavlc::parseVPS(TComVPS* pcVPS)
 
 Void TDecCavlc::parseSliceHeader (TComSlice* pcSlice, ParameterSetManager *parameterSetManager, const Int prevTid0POC)
 {
+  TComProfilingScope profilingScope( PROFILE_DEC_SLICE_HEADER );
   UInt  uiCode;
   Int   iCode;
 
@@ -0,0 +1,102 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TDecCtuWorker.cpp
+    \brief    per-thread CTU decoding context
+*/
+
+#include "TDecCtuWorker.h"
+
+//! \ingroup TLibDecoder
+//! \{
+
+// ====================================================================================================================
+// Constructor / destructor / create / destroy
+// ====================================================================================================================
+
+TDecCtuWorker::TDecCtuWorker()
+: m_bCuDecoderCreated( false )
+, m_maxTotalCUDepth( 0 )
+, m_maxCUWidth( 0 )
+, m_maxCUHeight( 0 )
+, m_chromaFormat( CHROMA_400 )
+, m_maxTrSize( 0 )
+{
+  m_cSbacDecoder.init( &m_cBinCABAC );
+  m_cEntropyDecoder.init( &m_cPrediction );
+  m_cEntropyDecoder.setEntropyDecoder( &m_cSbacDecoder );
+  m_cCuDecoder.init( &m_cEntropyDecoder, &m_cTrQuant, &m_cPrediction );
+}
+
+TDecCtuWorker::~TDecCtuWorker()
+{
+  destroy();
+}
+
+/** \param    sps       SPS of the pictures to be decoded
+ */
+Void TDecCtuWorker::create( const TComSPS& sps )
+{
+  destroy();
+
+  m_cPrediction.initTempBuff( sps.getChromaFormatIdc() );
+  m_cCuDecoder.create( sps.getMaxTotalCUDepth(), sps.getMaxCUWidth(), sps.getMaxCUHeight(), sps.getChromaFormatIdc() );
+  m_cTrQuant.init( sps.getMaxTrSize() );
+  m_bCuDecoderCreated = true;
+  m_maxTotalCUDepth   = sps.getMaxTotalCUDepth();
+  m_maxCUWidth        = sps.getMaxCUWidth();
+  m_maxCUHeight       = sps.getMaxCUHeight();
+  m_chromaFormat      = sps.getChromaFormatIdc();
+  m_maxTrSize         = sps.getMaxTrSize();
+}
+
+Bool TDecCtuWorker::isCreatedFor( const TComSPS& sps ) const
+{
+  return m_bCuDecoderCreated
+      && m_maxTotalCUDepth == sps.getMaxTotalCUDepth()
+      && m_maxCUWidth      == sps.getMaxCUWidth()
+      && m_maxCUHeight     == sps.getMaxCUHeight()
+      && m_chromaFormat    == sps.getChromaFormatIdc()
+      && m_maxTrSize       == sps.getMaxTrSize();
+}
+
+Void TDecCtuWorker::destroy()
+{
+  if ( m_bCuDecoderCreated )
+  {
+    m_cCuDecoder.destroy();
+    m_bCuDecoderCreated = false;
+  }
+}
+
+//! \}
@@ -0,0 +1,92 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TDecCtuWorker.h
+    \brief    per-thread CTU decoding context (header)
+*/
+
+#ifndef __TDECCTUWORKER__
+#define __TDECCTUWORKER__
+
+#include "TLibCommon/CommonDef.h"
+#include "TLibCommon/TComPrediction.h"
+#include "TLibCommon/TComTrQuant.h"
+#include "TDecCu.h"
+#include "TDecEntropy.h"
+#include "TDecSbac.h"
+#include "TDecBinCoderCABAC.h"
+
+//! \ingroup TLibDecoder
+//! \{
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// private copy of the CTU decoding tools, so that several CTUs can be parsed and reconstructed concurrently
+class TDecCtuWorker
+{
+private:
+  TComPrediction          m_cPrediction;
+  TComTrQuant             m_cTrQuant;
+  TDecCu                  m_cCuDecoder;
+  TDecEntropy             m_cEntropyDecoder;
+  TDecSbac                m_cSbacDecoder;
+  TDecBinCABAC            m_cBinCABAC;
+  Bool                    m_bCuDecoderCreated;
+  UInt                    m_maxTotalCUDepth;            ///< SPS parameters the tools have been created for
+  UInt                    m_maxCUWidth;
+  UInt                    m_maxCUHeight;
+  ChromaFormat            m_chromaFormat;
+  UInt                    m_maxTrSize;
+
+public:
+  TDecCtuWorker();
+  virtual ~TDecCtuWorker();
+
+  /// (re)allocate the internal buffers for the given SPS
+  Void  create          ( const TComSPS& sps );
+  Void  destroy         ();
+  /// the tools have been created with the CTU and transform parameters of the given SPS
+  Bool  isCreatedFor    ( const TComSPS& sps ) const;
+
+  TComTrQuant*            getTrQuant            () { return &m_cTrQuant;        }
+  TDecCu*                 getCuDecoder          () { return &m_cCuDecoder;      }
+  TDecEntropy*            getEntropyDecoder     () { return &m_cEntropyDecoder; }
+  TDecSbac*               getSbacDecoder        () { return &m_cSbacDecoder;    }
+  TDecBinCABAC*           getBinCABAC           () { return &m_cBinCABAC;       }
+};
+
+//! \}
+
+#endif // __TDECCTUWORKER__
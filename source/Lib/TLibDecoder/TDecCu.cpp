@@ -38,6 +38,7 @@
 #include "TDecCu.h"
 #include "TLibCommon/TComTU.h"
 #include "TLibCommon/TComPrediction.h"
+#include "TLibCommon/TComProfiler.h"
 
 //! \ingroup TLibDecoder
 //! \{
@@ -134,6 +135,8 @@ Void TDecCu::destroy()
  */
 Void TDecCu::decodeCtu( TComDataCU* pCtu, Bool& isLastCtuOfSliceSegment )
 {
+  TComProfilingScope profilingScope( PROFILE_DEC_ENTROPY_DECODING );
+
   if ( pCtu->getSlice()->getPPS()->getUseDQP() )
   {
     setdQPFlag(true);
@@ -418,7 +421,10 @@ Void TDecCu::xReconInter( TComDataCU* pcCU, UInt uiDepth )
 {
 
   // inter prediction
-  m_pcPrediction->motionCompensation( pcCU, m_ppcYuvReco[uiDepth] );
+  {
+    TComProfilingScope profilingScope( PROFILE_DEC_PREDICTION );
+    m_pcPrediction->motionCompensation( pcCU, m_ppcYuvReco[uiDepth] );
+  }
 
 #if DEBUG_STRING
   const Int debugPredModeMask=DebugStringGetPredModeMask(MODE_INTER);
@@ -514,12 +520,15 @@ TDecCu::xIntraRecBlk(       TComYuv*    pcRecoYuv,
 #endif
 
   DEBUG_STRING_NEW(sTemp)
-  m_pcPrediction->initIntraPatternChType( rTu, compID, bUseFilteredPredictions  DEBUG_STRING_PASS_INTO(sTemp) );
+  {
+    TComProfilingScope profilingScope( PROFILE_DEC_PREDICTION );
+    m_pcPrediction->initIntraPatternChType( rTu, compID, bUseFilteredPredictions  DEBUG_STRING_PASS_INTO(sTemp) );
 
 
-  //===== get prediction signal =====
+    //===== get prediction signal =====
 
-  m_pcPrediction->predIntraAng( compID,   uiChFinalMode, 0 /* Decoder does not have an original image */, 0, piPred, uiStride, rTu, bUseFilteredPredictions );
+    m_pcPrediction->predIntraAng( compID,   uiChFinalMode, 0 /* Decoder does not have an original image */, 0, piPred, uiStride, rTu, bUseFilteredPredictions );
+  }
 
 #if DEBUG_STRING
   ss << sTemp;
@@ -540,6 +549,7 @@ TDecCu::xIntraRecBlk(       TComYuv*    pcRecoYuv,
 
   if (pcCU->getCbf(uiAbsPartIdx, compID, rTu.GetTransformDepthRel()) != 0)
   {
+    TComProfilingScope profilingScope( PROFILE_DEC_INVERSE_TRANSFORM );
     m_pcTrQuant->invTransformNxN( rTu, compID, piResi, uiStride, pcCoeff, cQP DEBUG_STRING_PASS_INTO(psDebug) );
   }
   else
@@ -737,6 +747,7 @@ Void TDecCu::xCopyToPic( TComDataCU* pcCU, TComPic* pcPic, UInt uiZorderIdx, UIn
 
 Void TDecCu::xDecodeInterTexture ( TComDataCU* pcCU, UInt uiDepth )
 {
+  TComProfilingScope profilingScope( PROFILE_DEC_INVERSE_TRANSFORM );
 
   TComTURecurse tuRecur(pcCU, 0, uiDepth);
 
@@ -53,7 +53,9 @@ static Void calcAndPrintHashStatus(TComPicYuv& pic, const SEIDecodedPictureHash*
 // ====================================================================================================================
 
 TDecGop::TDecGop()
- : m_numberOfChecksumErrorsDetected(0)
+ : m_pcLoopFilterPipeline(NULL)
+ , m_numberOfChecksumErrorsDetected(0)
+ , m_pcProfilingLog(NULL)
 {
   m_dDecTime = 0;
 }
@@ -79,7 +81,8 @@ Void TDecGop::init( TDecEntropy*            pcEntropyDecoder,
                    TDecCavlc*              pcCavlcDecoder,
                    TDecSlice*              pcSliceDecoder,
                    TComLoopFilter*         pcLoopFilter,
-                   TComSampleAdaptiveOffset* pcSAO
+                   TComSampleAdaptiveOffset* pcSAO,
+                   TDecLoopFilterPipeline* pcLoopFilterPipeline
                    )
 {
   m_pcEntropyDecoder      = pcEntropyDecoder;
@@ -89,6 +92,7 @@ Void TDecGop::init( TDecEntropy*            pcEntropyDecoder,
   m_pcSliceDecoder        = pcSliceDecoder;
   m_pcLoopFilter          = pcLoopFilter;
   m_pcSAO                 = pcSAO;
+  m_pcLoopFilterPipeline  = pcLoopFilterPipeline;
   m_numberOfChecksumErrorsDetected = 0;
 }
 
@@ -103,9 +107,6 @@ Void TDecGop::init( TDecEntropy*            pcEntropyDecoder,
 Void TDecGop::decompressSlice(TComInputBitstream* pcBitstream, TComPic* pcPic)
 {
   TComSlice*  pcSlice = pcPic->getSlice(pcPic->getCurrSliceIdx());
-  // Table of extracted substreams.
-  // These must be deallocated AND their internal fifos, too.
-  TComInputBitstream **ppcSubstreams = NULL;
 
   //-- For time output for each slice
   clock_t iBeforeTime = clock();
@@ -114,31 +115,52 @@ Void TDecGop::decompressSlice(TComInputBitstream* pcBitstream, TComPic* pcPic)
 
   const UInt uiNumSubstreams = pcSlice->getNumberOfSubstreamSizes()+1;
 
-  // init each couple {EntropyDecoder, Substream}
-  ppcSubstreams    = new TComInputBitstream*[uiNumSubstreams];
+  // init each couple {EntropyDecoder, Substream}; the substreams and their pointers are kept from slice to slice
+  if (m_substreams.size() < uiNumSubstreams)
+  {
+    m_substreams.resize(uiNumSubstreams);
+  }
+  m_substreamPointers.resize(uiNumSubstreams);
   for ( UInt ui = 0 ; ui < uiNumSubstreams ; ui++ )
   {
-    ppcSubstreams[ui] = pcBitstream->extractSubstream(ui+1 < uiNumSubstreams ? (pcSlice->getSubstreamSize(ui)<<3) : pcBitstream->getNumBitsLeft());
+    pcBitstream->extractSubstream(ui+1 < uiNumSubstreams ? (pcSlice->getSubstreamSize(ui)<<3) : pcBitstream->getNumBitsLeft(), m_substreams[ui]);
+    m_substreamPointers[ui] = &m_substreams[ui];
   }
 
-  m_pcSliceDecoder->decompressSlice( ppcSubstreams, pcPic, m_pcSbacDecoder);
-  // deallocate all created substreams, including internal buffers.
-  for (UInt ui = 0; ui < uiNumSubstreams; ui++)
+  if (m_pcLoopFilterPipeline && pcPic->getCurrSliceIdx() == 0)
   {
-    delete ppcSubstreams[ui];
+    m_pcLoopFilterPipeline->startPicture( pcPic );
   }
-  delete[] ppcSubstreams;
+
+  m_pcSliceDecoder->decompressSlice( &m_substreamPointers[0], pcPic, m_pcSbacDecoder);
 
   m_dDecTime += (Double)(clock()-iBeforeTime) / CLOCKS_PER_SEC;
 }
 
 Void TDecGop::filterPicture(TComPic* pcPic)
+{
+  loopFilterPicture(pcPic);
+  finishPicture(pcPic, pcPic->getSlice(pcPic->getCurrSliceIdx())->isReferenced());
+
+  pcPic->setOutputMark(pcPic->getSlice(0)->getPicOutputFlag() ? true : false);
+  pcPic->setReconMark(true);
+}
+
+Void TDecGop::loopFilterPicture(TComPic* pcPic)
 {
   TComSlice*  pcSlice = pcPic->getSlice(pcPic->getCurrSliceIdx());
 
   //-- For time output for each slice
   clock_t iBeforeTime = clock();
 
+  if (m_pcLoopFilterPipeline)
+  {
+    // CTU rows have been filtered as they were decoded
+    m_pcLoopFilterPipeline->finishPicture();
+    m_dDecTime += (Double)(clock()-iBeforeTime) / CLOCKS_PER_SEC;
+    return;
+  }
+
   // deblocking filter
   Bool bLFCrossTileBoundary = pcSlice->getPPS()->getLoopFilterAcrossTilesEnabledFlag();
   m_pcLoopFilter->setCfg(bLFCrossTileBoundary);
@@ -152,8 +174,18 @@ Void TDecGop::filterPicture(TComPic* pcPic)
   }
 
   pcPic->compressMotion();
+
+  m_dDecTime += (Double)(clock()-iBeforeTime) / CLOCKS_PER_SEC;
+}
+
+/** \param isReferenced marking of the picture when its decoding was completed; later pictures may have changed it since
+ */
+Void TDecGop::finishPicture(TComPic* pcPic, Bool isReferenced)
+{
+  TComSlice*  pcSlice = pcPic->getSlice(pcPic->getCurrSliceIdx());
+
   TChar c = (pcSlice->isIntra() ? 'I' : pcSlice->isInterP() ? 'P' : 'B');
-  if (!pcSlice->isReferenced())
+  if (!isReferenced)
   {
     c += 32;
   }
@@ -164,7 +196,6 @@ Void TDecGop::filterPicture(TComPic* pcPic)
                                                   c,
                                                   pcSlice->getSliceQp() );
 
-  m_dDecTime += (Double)(clock()-iBeforeTime) / CLOCKS_PER_SEC;
   printf ("[DT %6.3f] ", m_dDecTime );
   m_dDecTime  = 0;
 
@@ -187,11 +218,12 @@ Void TDecGop::filterPicture(TComPic* pcPic)
     }
     calcAndPrintHashStatus(*(pcPic->getPicYuvRec()), hash, pcSlice->getSPS()->getBitDepths(), m_numberOfChecksumErrorsDetected);
   }
+  if (m_pcProfilingLog)
+  {
+    TComProfiler::printSelfTimes(m_pcProfilingLog->addPicture(pcSlice->getPOC()));
+  }
 
   printf("\n");
-
-  pcPic->setOutputMark(pcPic->getSlice(0)->getPicOutputFlag() ? true : false);
-  pcPic->setReconMark(true);
 }
 
 /**
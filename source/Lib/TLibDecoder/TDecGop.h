@@ -49,9 +49,11 @@
 #include "TLibCommon/TComPic.h"
 #include "TLibCommon/TComLoopFilter.h"
 #include "TLibCommon/TComSampleAdaptiveOffset.h"
+#include "TLibCommon/TComProfiler.h"
 
 #include "TDecEntropy.h"
 #include "TDecSlice.h"
+#include "TDecLoopFilterPipeline.h"
 #include "TDecBinCoder.h"
 #include "TDecBinCoderCABAC.h"
 
@@ -77,9 +79,13 @@ private:
   TComLoopFilter*       m_pcLoopFilter;
 
   TComSampleAdaptiveOffset*     m_pcSAO;
+  TDecLoopFilterPipeline*       m_pcLoopFilterPipeline;   ///< filters the pictures while they are decoded (NULL: once they have been decoded)
   Double                m_dDecTime;
   Int                   m_decodedPictureHashSEIEnabled;  ///< Checksum(3)/CRC(2)/MD5(1)/disable(0) acting on decoded picture hash SEI message
   UInt                  m_numberOfChecksumErrorsDetected;
+  TComProfilingLog*     m_pcProfilingLog;                ///< records the run time of the decoding stages of each picture (NULL: no profiling)
+  std::vector<TComInputBitstream>  m_substreams;         ///< substreams of the current slice, which refer to the bytes of its bitstream
+  std::vector<TComInputBitstream*> m_substreamPointers;  ///< pointers to m_substreams, as passed to TDecSlice
 
 public:
   TDecGop();
@@ -91,15 +97,20 @@ public:
                  TDecCavlc*              pcCavlcDecoder,
                  TDecSlice*              pcSliceDecoder,
                  TComLoopFilter*         pcLoopFilter,
-                 TComSampleAdaptiveOffset* pcSAO
+                 TComSampleAdaptiveOffset* pcSAO,
+                 TDecLoopFilterPipeline* pcLoopFilterPipeline = NULL
                  );
   Void  create  ();
   Void  destroy ();
   Void  decompressSlice(TComInputBitstream* pcBitstream, TComPic* pcPic );
   Void  filterPicture  (TComPic* pcPic );
+  Void  loopFilterPicture (TComPic* pcPic );   ///< in-loop filtering and motion compression only
+  Bool  extendsPicBorder  () const { return m_pcLoopFilterPipeline != NULL; }   ///< loopFilterPicture() also extends the picture borders
+  Void  finishPicture     (TComPic* pcPic, Bool isReferenced );   ///< status line and decoded picture hash check of a filtered picture
 
   Void setDecodedPictureHashSEIEnabled(Int enabled) { m_decodedPictureHashSEIEnabled = enabled; }
   UInt getNumberOfChecksumErrorsDetected() const { return m_numberOfChecksumErrorsDetected; }
+  Void setProfilingLog(TComProfilingLog* pcProfilingLog) { m_pcProfilingLog = pcProfilingLog; }
 
 };
 
@@ -0,0 +1,261 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TDecLoopFilterPipeline.cpp
+    \brief    CTU-row pipelined in-loop filtering of a picture being decoded
+*/
+
+#include "TDecLoopFilterPipeline.h"
+
+//! \ingroup TLibDecoder
+//! \{
+
+// ====================================================================================================================
+// Constructor / destructor / initialization
+// ====================================================================================================================
+
+TDecLoopFilterPipeline::TDecLoopFilterPipeline()
+: m_pcLoopFilter( NULL )
+, m_pcSAO( NULL )
+, m_pcThreadPool( NULL )
+, m_pcPic( NULL )
+, m_bUseSAO( false )
+, m_numCtuRows( 0 )
+, m_numAllocatedCtuRows( 0 )
+, m_pNumDecodedCtusInRow( NULL )
+, m_pcStageTasks( NULL )
+, m_pcStageDependencies( NULL )
+, m_pNumPendingDependencies( NULL )
+, m_nextStage( 0 )
+{
+}
+
+TDecLoopFilterPipeline::~TDecLoopFilterPipeline()
+{
+  xDestroy();
+}
+
+Void TDecLoopFilterPipeline::xDestroy()
+{
+  delete [] m_pNumDecodedCtusInRow;
+  delete [] m_pcStageTasks;
+  delete [] m_pcStageDependencies;
+  delete [] m_pNumPendingDependencies;
+  m_pNumDecodedCtusInRow    = NULL;
+  m_pcStageTasks            = NULL;
+  m_pcStageDependencies     = NULL;
+  m_pNumPendingDependencies = NULL;
+  m_numAllocatedCtuRows     = 0;
+}
+
+Void TDecLoopFilterPipeline::init( TComLoopFilter* pcLoopFilter, TComSampleAdaptiveOffset* pcSAO, TComThreadPool* pcThreadPool )
+{
+  m_pcLoopFilter = pcLoopFilter;
+  m_pcSAO        = pcSAO;
+  m_pcThreadPool = pcThreadPool;
+}
+
+// ====================================================================================================================
+// Public member functions
+// ====================================================================================================================
+
+Void TDecLoopFilterPipeline::startPicture( TComPic* pcPic )
+{
+  assert( m_pcPic == NULL );
+
+  m_pcPic      = pcPic;
+  m_numCtuRows = pcPic->getFrameHeightInCtus();
+
+  const TComSlice* pcSlice = pcPic->getSlice(0);
+  m_bUseSAO = pcSlice->getSPS()->getUseSAO();
+  m_pcLoopFilter->setCfg( pcSlice->getPPS()->getLoopFilterAcrossTilesEnabledFlag() );
+
+  if( m_numCtuRows > m_numAllocatedCtuRows )
+  {
+    xDestroy();
+    m_pNumDecodedCtusInRow    = new std::atomic<Int>[m_numCtuRows];
+    m_pcStageTasks            = new StageTask[m_numCtuRows + 1];
+    m_pcStageDependencies     = new TComTaskDependency[m_numCtuRows + 1];
+    m_pNumPendingDependencies = new Int[m_numCtuRows + 1];
+    m_numAllocatedCtuRows     = m_numCtuRows;
+  }
+
+  for( Int ctuRow = 0; ctuRow < m_numCtuRows; ctuRow++ )
+  {
+    m_pNumDecodedCtusInRow[ctuRow] = 0;
+  }
+
+  // stage s waits for CTU rows s and s+1 to be decoded; the last stage only completes the last row.
+  // The stages run by the thread pool also wait for the previous stage, the other ones are run in order
+  for( Int stage = 0; stage <= m_numCtuRows; stage++ )
+  {
+    const Int numRowDependencies = stage < m_numCtuRows ? min( 2, m_numCtuRows - stage ) : 0;
+
+    m_pcStageTasks[stage].pcPipeline = this;
+    m_pcStageTasks[stage].stage      = stage;
+    if( m_pcThreadPool )
+    {
+      m_pcThreadPool->addDependentTask( xFilterStageTask, &m_pcStageTasks[stage], m_cTaskGroup, m_pcStageDependencies[stage],
+                                        numRowDependencies + ( stage > 0 ? 1 : 0 ) );
+    }
+    else
+    {
+      m_pNumPendingDependencies[stage] = numRowDependencies;
+    }
+  }
+  m_nextStage = 0;
+}
+
+Void TDecLoopFilterPipeline::ctuDecoded( UInt ctuRsAddr )
+{
+  const Int frameWidthInCtus = m_pcPic->getFrameWidthInCtus();
+  const Int ctuRow           = ctuRsAddr / frameWidthInCtus;
+
+  if( ++m_pNumDecodedCtusInRow[ctuRow] == frameWidthInCtus )
+  {
+    xRowDecoded( ctuRow );
+    xRunReadyStages();
+  }
+}
+
+Void TDecLoopFilterPipeline::finishPicture()
+{
+  assert( m_pcPic != NULL );
+
+  const Int frameWidthInCtus = m_pcPic->getFrameWidthInCtus();
+  for( Int ctuRow = 0; ctuRow < m_numCtuRows; ctuRow++ )
+  {
+    if( m_pNumDecodedCtusInRow[ctuRow].exchange( frameWidthInCtus ) < frameWidthInCtus )
+    {
+      xRowDecoded( ctuRow );
+    }
+  }
+
+  if( m_pcThreadPool )
+  {
+    m_pcThreadPool->waitForTasks( m_cTaskGroup );
+  }
+  else
+  {
+    xRunReadyStages();
+  }
+  assert( m_pcThreadPool || m_nextStage > m_numCtuRows );
+
+  // all lines have been extended by the stages. The flag is already set when the picture is referenced while it is decoded
+  TComPicYuv* pcPicYuvRec = m_pcPic->getPicYuvRec();
+  if( !pcPicYuvRec->getBorderExtension() )
+  {
+    pcPicYuvRec->setBorderExtension( true );
+  }
+  m_pcPic = NULL;
+}
+
+// ====================================================================================================================
+// Private member functions
+// ====================================================================================================================
+
+Void TDecLoopFilterPipeline::xRowDecoded( Int ctuRow )
+{
+  xResolveDependency( ctuRow );
+  if( ctuRow > 0 )
+  {
+    xResolveDependency( ctuRow - 1 );
+  }
+}
+
+Void TDecLoopFilterPipeline::xResolveDependency( Int stage )
+{
+  if( m_pcThreadPool )
+  {
+    m_pcThreadPool->resolveDependency( m_pcStageDependencies[stage] );
+  }
+  else
+  {
+    assert( m_pNumPendingDependencies[stage] > 0 );
+    m_pNumPendingDependencies[stage]--;
+  }
+}
+
+/** Run the stages whose CTU rows have been decoded on the decoding thread, in order.
+ */
+Void TDecLoopFilterPipeline::xRunReadyStages()
+{
+  if( m_pcThreadPool )
+  {
+    return;
+  }
+  while( m_nextStage <= m_numCtuRows && m_pNumPendingDependencies[m_nextStage] == 0 )
+  {
+    xFilterStage( m_nextStage++ );
+  }
+}
+
+Void TDecLoopFilterPipeline::xFilterStageTask( Void* param, Int threadIdx )
+{
+  StageTask* pTask = (StageTask*)param;
+  TDecLoopFilterPipeline* pcPipeline = pTask->pcPipeline;
+
+  pcPipeline->xFilterStage( pTask->stage );
+  if( pTask->stage < pcPipeline->m_numCtuRows )
+  {
+    pcPipeline->m_pcThreadPool->resolveDependency( pcPipeline->m_pcStageDependencies[pTask->stage + 1] );
+  }
+}
+
+/** Deblock CTU row stage, then complete CTU row stage-1: its bottom lines and the first line of the row below it have
+ * been deblocked, and the motion of the row is no longer needed at full resolution for the deblocking of the row below.
+ */
+Void TDecLoopFilterPipeline::xFilterStage( Int stage )
+{
+  if( stage < m_numCtuRows )
+  {
+    m_pcLoopFilter->loopFilterCtuRow( m_pcPic, stage );
+  }
+
+  if( stage > 0 )
+  {
+    const Int ctuRow      = stage - 1;
+    const Int maxCUHeight = m_pcPic->getPicSym()->getSPS().getMaxCUHeight();
+
+    if( m_bUseSAO )
+    {
+      m_pcSAO->SAOProcessCtuRow( m_pcPic, ctuRow );
+      m_pcSAO->PCMLFDisableProcessCtuRow( m_pcPic, ctuRow );
+    }
+    m_pcPic->compressMotionCtuRow( ctuRow );
+    m_pcPic->getPicYuvRec()->extendPicBorderLines( ctuRow * maxCUHeight, ( ctuRow + 1 ) * maxCUHeight );
+    m_pcPic->setReconRowProgress( ctuRow + 1 );
+  }
+}
+
+//! \}
@@ -0,0 +1,111 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TDecLoopFilterPipeline.h
+    \brief    CTU-row pipelined in-loop filtering of a picture being decoded (header)
+*/
+
+#ifndef __TDECLOOPFILTERPIPELINE__
+#define __TDECLOOPFILTERPIPELINE__
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+#include "TLibCommon/CommonDef.h"
+#include "TLibCommon/TComPic.h"
+#include "TLibCommon/TComLoopFilter.h"
+#include "TLibCommon/TComSampleAdaptiveOffset.h"
+#include "TLibCommon/TComThreadPool.h"
+
+//! \ingroup TLibDecoder
+//! \{
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// in-loop filtering of a picture CTU row by CTU row, while the picture is being decoded.
+/// Stage s deblocks CTU row s once rows s and s+1 have been decoded, then applies SAO to row s-1, compresses its motion,
+/// extends its borders and reports it as reconstructed to the pictures that reference it. The stages run one after the
+/// other, either as thread pool tasks or on the decoding thread as soon as they are ready.
+class TDecLoopFilterPipeline
+{
+private:
+  TComLoopFilter*           m_pcLoopFilter;
+  TComSampleAdaptiveOffset* m_pcSAO;
+  TComThreadPool*           m_pcThreadPool;               ///< thread pool running the stages (NULL: decoding thread)
+
+  struct StageTask
+  {
+    TDecLoopFilterPipeline* pcPipeline;
+    Int                     stage;
+  };
+
+  TComPic*                  m_pcPic;                      ///< picture being filtered, NULL if none
+  Bool                      m_bUseSAO;
+  Int                       m_numCtuRows;
+  Int                       m_numAllocatedCtuRows;
+  std::atomic<Int>*         m_pNumDecodedCtusInRow;       ///< [m_numCtuRows]
+  StageTask*                m_pcStageTasks;               ///< [m_numCtuRows+1]
+  TComTaskDependency*       m_pcStageDependencies;        ///< [m_numCtuRows+1] dependencies of the stages run by the thread pool
+  Int*                      m_pNumPendingDependencies;    ///< [m_numCtuRows+1] dependencies of the stages run on the decoding thread
+  Int                       m_nextStage;                  ///< next stage to run on the decoding thread
+  TComTaskGroup             m_cTaskGroup;
+
+  Void  xDestroy          ();
+  Void  xRowDecoded       ( Int ctuRow );
+  Void  xResolveDependency( Int stage );
+  Void  xRunReadyStages   ();
+  Void  xFilterStage      ( Int stage );
+  static Void xFilterStageTask( Void* param, Int threadIdx );
+
+public:
+  TDecLoopFilterPipeline();
+  virtual ~TDecLoopFilterPipeline();
+
+  Void  init              ( TComLoopFilter* pcLoopFilter, TComSampleAdaptiveOffset* pcSAO, TComThreadPool* pcThreadPool = NULL );
+
+  /// start filtering a picture, before its first CTU is decoded
+  Void  startPicture      ( TComPic* pcPic );
+  /// report that a CTU of the picture has been reconstructed. May be called concurrently for different CTUs
+  Void  ctuDecoded        ( UInt ctuRsAddr );
+  /// complete the filtering once all slices of the picture have been decoded; CTUs that have not been decoded are filtered as they are
+  Void  finishPicture     ();
+
+  Bool  isFiltering       () const { return m_pcPic != NULL; }
+};
+
+//! \}
+
+#endif // __TDECLOOPFILTERPIPELINE__
@@ -306,28 +306,10 @@ Void TDecSbac::xReadCoefRemainExGolomb ( UInt &rSymbol, UInt &rParam, const Bool
   UInt prefix   = 0;
   UInt codeWord = 0;
 
-  if (useLimitedPrefixLength)
-  {
-    const UInt longestPossiblePrefix = (32 - (COEF_REMAIN_BIN_REDUCTION + maxLog2TrDynamicRange)) + COEF_REMAIN_BIN_REDUCTION;
-
-    do
-    {
-      prefix++;
-      m_pcTDecBinIf->decodeBinEP( codeWord RExt__DECODER_DEBUG_BIT_STATISTICS_PASS_OPT_ARG(whichStat) );
-    } while((codeWord != 0) && (prefix < longestPossiblePrefix));
-  }
-  else
-  {
-    do
-    {
-      prefix++;
-      m_pcTDecBinIf->decodeBinEP( codeWord RExt__DECODER_DEBUG_BIT_STATISTICS_PASS_OPT_ARG(whichStat) );
-    } while( codeWord);
-  }
-
-  codeWord  = 1 - codeWord;
-  prefix -= codeWord;
-  codeWord=0;
+  // the unary prefix is decoded in one call, up to the first 0 bin
+  const UInt longestPossiblePrefix = useLimitedPrefixLength ? (32 - (COEF_REMAIN_BIN_REDUCTION + maxLog2TrDynamicRange)) + COEF_REMAIN_BIN_REDUCTION
+                                                            : MAX_UINT;
+  m_pcTDecBinIf->decodeUnaryBinsEP( prefix, longestPossiblePrefix RExt__DECODER_DEBUG_BIT_STATISTICS_PASS_OPT_ARG(whichStat) );
 
   if (prefix < COEF_REMAIN_BIN_REDUCTION )
   {
@@ -1276,7 +1258,6 @@ Void TDecSbac::parseCoeffNxN(  TComTU &rTu, ComponentID compID )
 
   const ChannelType  chType            = toChannelType(compID);
   const UInt         uiLog2BlockWidth  = g_aucConvertToBit[ uiWidth  ] + 2;
-  const UInt         uiLog2BlockHeight = g_aucConvertToBit[ uiHeight ] + 2;
   const UInt         uiMaxNumCoeff     = uiWidth * uiHeight;
   const UInt         uiMaxNumCoeffM1   = uiMaxNumCoeff - 1;
 
@@ -1410,6 +1391,9 @@ Void TDecSbac::parseCoeffNxN(  TComTU &rTu, ComponentID compID )
     Int iCGPosY   = iCGBlkPos / codingParameters.widthInGroups;
     Int iCGPosX   = iCGBlkPos - (iCGPosY * codingParameters.widthInGroups);
 
+    // the significance of the right and lower groups selects the contexts of both significance flags
+    const Int patternSigCtx = TComTrQuant::calcPatternSigCtx(uiSigCoeffGroupFlag, iCGPosX, iCGPosY, codingParameters.widthInGroups, codingParameters.heightInGroups);
+
     if( iSubSet == iLastScanSet || iSubSet == 0)
     {
       uiSigCoeffGroupFlag[ iCGBlkPos ] = 1;
@@ -1417,42 +1401,45 @@ Void TDecSbac::parseCoeffNxN(  TComTU &rTu, ComponentID compID )
     else
     {
       UInt uiSigCoeffGroup;
-      UInt uiCtxSig  = TComTrQuant::getSigCoeffGroupCtxInc( uiSigCoeffGroupFlag, iCGPosX, iCGPosY, codingParameters.widthInGroups, codingParameters.heightInGroups );
+      UInt uiCtxSig  = TComTrQuant::getSigCoeffGroupCtxInc( patternSigCtx );
       m_pcTDecBinIf->decodeBin( uiSigCoeffGroup, baseCoeffGroupCtx[ uiCtxSig ] RExt__DECODER_DEBUG_BIT_STATISTICS_PASS_OPT_ARG(ctype_group) );
       uiSigCoeffGroupFlag[ iCGBlkPos ] = uiSigCoeffGroup;
     }
 
     // decode significant_coeff_flag
-    const Int patternSigCtx = TComTrQuant::calcPatternSigCtx(uiSigCoeffGroupFlag, iCGPosX, iCGPosY, codingParameters.widthInGroups, codingParameters.heightInGroups);
-
-    UInt uiBlkPos, uiSig, uiCtxSig;
-    for( ; iScanPosSig >= iSubPos; iScanPosSig-- )
+    if( uiSigCoeffGroupFlag[ iCGBlkPos ] )
     {
-      uiBlkPos  = codingParameters.scan[ iScanPosSig ];
-      uiSig     = 0;
+      const UChar *sigCtxIncInGroup = TComTrQuant::getSigCtxIncInGroup( codingParameters, patternSigCtx, iSubSet );
 
-      if( uiSigCoeffGroupFlag[ iCGBlkPos ] )
+      UInt uiBlkPos, uiSig;
+      for( ; iScanPosSig >= iSubPos; iScanPosSig-- )
       {
+        uiBlkPos  = codingParameters.scan[ iScanPosSig ];
+        uiSig     = 1; // inferred at the first position of a group that has no other significant coefficient
+
         if( iScanPosSig > iSubPos || iSubSet == 0  || numNonZero )
         {
-          uiCtxSig  = TComTrQuant::getSigCtxInc( patternSigCtx, codingParameters, iScanPosSig, uiLog2BlockWidth, uiLog2BlockHeight, chType );
-          m_pcTDecBinIf->decodeBin( uiSig, baseCtx[ uiCtxSig ] RExt__DECODER_DEBUG_BIT_STATISTICS_PASS_OPT_ARG(ctype_map) );
+          m_pcTDecBinIf->decodeBin( uiSig, baseCtx[ sigCtxIncInGroup[ iScanPosSig - iSubPos ] ] RExt__DECODER_DEBUG_BIT_STATISTICS_PASS_OPT_ARG(ctype_map) );
         }
-        else
+
+        pcCoef[ uiBlkPos ] = uiSig;
+        if( uiSig )
         {
-          uiSig = 1;
+          pos[ numNonZero ] = uiBlkPos;
+          numNonZero ++;
+          if( lastNZPosInCG == -1 )
+          {
+            lastNZPosInCG = iScanPosSig;
+          }
+          firstNZPosInCG = iScanPosSig;
         }
       }
-      pcCoef[ uiBlkPos ] = uiSig;
-      if( uiSig )
+    }
+    else
+    {
+      for( ; iScanPosSig >= iSubPos; iScanPosSig-- )
       {
-        pos[ numNonZero ] = uiBlkPos;
-        numNonZero ++;
-        if( lastNZPosInCG == -1 )
-        {
-          lastNZPosInCG = iScanPosSig;
-        }
-        firstNZPosInCG = iScanPosSig;
+        pcCoef[ codingParameters.scan[ iScanPosSig ] ] = 0;
       }
     }
 
@@ -46,11 +46,18 @@
 //////////////////////////////////////////////////////////////////////
 
 TDecSlice::TDecSlice()
+ : m_pcThreadPool(NULL)
+ , m_pcCtuWorkers(NULL)
+ , m_numCtuRanges(0)
+ , m_pcCtuRangeProgress(NULL)
+ , m_pcCtuRangeSyncContextState(NULL)
+ , m_pcLoopFilterPipeline(NULL)
 {
 }
 
 TDecSlice::~TDecSlice()
 {
+  destroy();
 }
 
 Void TDecSlice::create()
@@ -59,13 +66,21 @@ Void TDecSlice::create()
 
 Void TDecSlice::destroy()
 {
+  delete [] m_pcCtuRangeProgress;
+  delete [] m_pcCtuRangeSyncContextState;
+  m_pcCtuRangeProgress         = NULL;
+  m_pcCtuRangeSyncContextState = NULL;
+  m_numCtuRanges               = 0;
 }
 
-Void TDecSlice::init(TDecEntropy* pcEntropyDecoder, TDecCu* pcCuDecoder, TDecConformanceCheck *pDecConformanceCheck)
+Void TDecSlice::init(TDecEntropy* pcEntropyDecoder, TDecCu* pcCuDecoder, TDecConformanceCheck *pDecConformanceCheck, TComThreadPool* pcThreadPool, TDecCtuWorker* pcCtuWorkers, TDecLoopFilterPipeline* pcLoopFilterPipeline)
 {
   m_pcEntropyDecoder     = pcEntropyDecoder;
   m_pcCuDecoder          = pcCuDecoder;
   m_pDecConformanceCheck = pDecConformanceCheck;
+  m_pcThreadPool         = pcThreadPool;
+  m_pcCtuWorkers         = pcCtuWorkers;
+  m_pcLoopFilterPipeline = pcLoopFilterPipeline;
 }
 
 Void TDecSlice::decompressSlice(TComInputBitstream** ppcSubstreams, TComPic* pcPic, TDecSbac* pcSbacDecoder)
@@ -80,14 +95,20 @@ Void TDecSlice::decompressSlice(TComInputBitstream** ppcSubstreams, TComPic* pcP
   const Bool depSliceSegmentsEnabled = pcSlice->getPPS()->getDependentSliceSegmentsEnabledFlag();
   const Bool wavefrontsEnabled       = pcSlice->getPPS()->getEntropyCodingSyncEnabledFlag();
 
-  m_pcEntropyDecoder->setEntropyDecoder ( pcSbacDecoder  );
-  m_pcEntropyDecoder->setBitstream      ( ppcSubstreams[0] );
-  m_pcEntropyDecoder->resetEntropy      (pcSlice);
-
   // decoder doesn't need prediction & residual frame buffer
   pcPic->setPicYuvPred( 0 );
   pcPic->setPicYuvResi( 0 );
 
+  // each substream (tile or CTU row of a tile) is decoded by the entropy decoder of a worker thread.
+  if ( xUseParallelCtuRanges( pcSlice ) && xDecompressCtuRangesInParallel( ppcSubstreams, pcPic ) )
+  {
+    return;
+  }
+
+  m_pcEntropyDecoder->setEntropyDecoder ( pcSbacDecoder  );
+  m_pcEntropyDecoder->setBitstream      ( ppcSubstreams[0] );
+  m_pcEntropyDecoder->resetEntropy      (pcSlice);
+
 #if ENC_DEC_TRACE
   g_bJustDoIt = g_bEncDecTraceEnable;
 #endif
@@ -104,7 +125,6 @@ Void TDecSlice::decompressSlice(TComInputBitstream** ppcSubstreams, TComPic* pcP
   // This calculates the common offset for all substreams in this slice.
   const UInt subStreamOffset=pcPic->getSubstreamForCtuAddr(startCtuRsAddr, true, pcSlice);
 
-
   if (depSliceSegmentsEnabled)
   {
     // modify initial contexts with previous slice segment if this is a dependent slice.
@@ -174,42 +194,7 @@ Void TDecSlice::decompressSlice(TComInputBitstream** ppcSubstreams, TComPic* pcP
     const UInt numRemainingBitsPriorToCtu=ppcSubstreams[uiSubStrm]->getNumBitsLeft();
 #endif
 
-    if ( pcSlice->getSPS()->getUseSAO() )
-    {
-      SAOBlkParam& saoblkParam = (pcPic->getPicSym()->getSAOBlkParam())[ctuRsAddr];
-      Bool bIsSAOSliceEnabled = false;
-      Bool sliceEnabled[MAX_NUM_COMPONENT];
-      for(Int comp=0; comp < MAX_NUM_COMPONENT; comp++)
-      {
-        ComponentID compId=ComponentID(comp);
-        sliceEnabled[compId] = pcSlice->getSaoEnabledFlag(toChannelType(compId)) && (comp < pcPic->getNumberValidComponents());
-        if (sliceEnabled[compId])
-        {
-          bIsSAOSliceEnabled=true;
-        }
-        saoblkParam[compId].modeIdc = SAO_MODE_OFF;
-      }
-      if (bIsSAOSliceEnabled)
-      {
-        Bool leftMergeAvail = false;
-        Bool aboveMergeAvail= false;
-
-        //merge left condition
-        Int rx = (ctuRsAddr % frameWidthInCtus);
-        if(rx > 0)
-        {
-          leftMergeAvail = pcPic->getSAOMergeAvailability(ctuRsAddr, ctuRsAddr-1);
-        }
-        //merge up condition
-        Int ry = (ctuRsAddr / frameWidthInCtus);
-        if(ry > 0)
-        {
-          aboveMergeAvail = pcPic->getSAOMergeAvailability(ctuRsAddr, ctuRsAddr-frameWidthInCtus);
-        }
-
-        pcSbacDecoder->parseSAOBlkParam( saoblkParam, sliceEnabled, leftMergeAvail, aboveMergeAvail, pcSlice->getSPS()->getBitDepths());
-      }
-    }
+    xDecodeSAOBlkParam( pcSbacDecoder, pcPic, pcSlice, ctuRsAddr );
 
     m_pcCuDecoder->decodeCtu     ( pCtu, isLastCtuOfSliceSegment );
 
@@ -258,6 +243,10 @@ Void TDecSlice::decompressSlice(TComInputBitstream** ppcSubstreams, TComPic* pcP
 #endif
     }
 
+    if (m_pcLoopFilterPipeline)
+    {
+      m_pcLoopFilterPipeline->ctuDecoded( ctuRsAddr );
+    }
   }
 
   assert(isLastCtuOfSliceSegment == true);
@@ -270,4 +259,340 @@ Void TDecSlice::decompressSlice(TComInputBitstream** ppcSubstreams, TComPic* pcP
 
 }
 
+/** Parse the SAO parameters of a CTU.
+ */
+Void TDecSlice::xDecodeSAOBlkParam( TDecSbac* pcSbacDecoder, TComPic* pcPic, const TComSlice* pcSlice, const UInt ctuRsAddr )
+{
+  const UInt frameWidthInCtus = pcPic->getPicSym()->getFrameWidthInCtus();
+
+  if ( pcSlice->getSPS()->getUseSAO() )
+  {
+    SAOBlkParam& saoblkParam = (pcPic->getPicSym()->getSAOBlkParam())[ctuRsAddr];
+    Bool bIsSAOSliceEnabled = false;
+    Bool sliceEnabled[MAX_NUM_COMPONENT];
+    for(Int comp=0; comp < MAX_NUM_COMPONENT; comp++)
+    {
+      ComponentID compId=ComponentID(comp);
+      sliceEnabled[compId] = pcSlice->getSaoEnabledFlag(toChannelType(compId)) && (comp < pcPic->getNumberValidComponents());
+      if (sliceEnabled[compId])
+      {
+        bIsSAOSliceEnabled=true;
+      }
+      saoblkParam[compId].modeIdc = SAO_MODE_OFF;
+    }
+    if (bIsSAOSliceEnabled)
+    {
+      Bool leftMergeAvail = false;
+      Bool aboveMergeAvail= false;
+
+      //merge left condition
+      Int rx = (ctuRsAddr % frameWidthInCtus);
+      if(rx > 0)
+      {
+        leftMergeAvail = pcPic->getSAOMergeAvailability(ctuRsAddr, ctuRsAddr-1);
+      }
+      //merge up condition
+      Int ry = (ctuRsAddr / frameWidthInCtus);
+      if(ry > 0)
+      {
+        aboveMergeAvail = pcPic->getSAOMergeAvailability(ctuRsAddr, ctuRsAddr-frameWidthInCtus);
+      }
+
+      pcSbacDecoder->parseSAOBlkParam( saoblkParam, sliceEnabled, leftMergeAvail, aboveMergeAvail, pcSlice->getSPS()->getBitDepths());
+    }
+  }
+}
+
+/** Check whether the slice segment can be split into CTU ranges that are decoded by several threads.
+ * This is possible with tiles, which are coded in their own substreams and do not depend on each other, and with WPP,
+ * where each CTU row of a tile is coded in its own substream and only depends on the CTUs above and to the above-right.
+ */
+Bool TDecSlice::xUseParallelCtuRanges( const TComSlice* pcSlice )
+{
+#if ENC_DEC_TRACE || RExt__DECODER_DEBUG_BIT_STATISTICS
+  // the trace and the bit statistics are written in decoding order.
+  return false;
+#else
+#if DECODER_PARTIAL_CONFORMANCE_CHECK != 0
+  if ( TDecConformanceCheck::doChecking() && m_pDecConformanceCheck )
+  {
+    return false;
+  }
+#endif
+  const Bool bWavefronts    = pcSlice->getPPS()->getEntropyCodingSyncEnabledFlag();
+  const Bool bMultipleTiles = pcSlice->getPPS()->getNumTileColumnsMinus1() != 0 || pcSlice->getPPS()->getNumTileRowsMinus1() != 0;
+  return m_pcThreadPool != NULL && ( bWavefronts || bMultipleTiles );
+#endif
+}
+
+/** Decode the CTUs of a slice segment, one thread pool task per substream (tile, or CTU row of a tile with WPP).
+ * With WPP, a CTU is only decoded once the CTU row above has progressed two CTUs further, and the CABAC state after the
+ * second CTU of a row is handed to the row below as in the serial loop. Deblocking and SAO are applied to the whole
+ * picture afterwards, so they also cover the tile boundaries.
+ * \param ppcSubstreams      substreams of the slice segment
+ * \param pcPic              picture class
+ * \returns false if there is a single substream or the substreams do not match the tiles and CTU rows of the picture;
+ *          nothing has been decoded then.
+ */
+Bool TDecSlice::xDecompressCtuRangesInParallel( TComInputBitstream** ppcSubstreams, TComPic* pcPic )
+{
+  TComSlice* const pcSlice           = pcPic->getSlice(pcPic->getCurrSliceIdx());
+  const TComPicSym &picSym           = *(pcPic->getPicSym());
+  const UInt       frameWidthInCtus  = picSym.getFrameWidthInCtus();
+  const UInt       numCtusInFrame    = pcPic->getNumberOfCtusInFrame();
+  const Bool       wavefrontsEnabled = pcSlice->getPPS()->getEntropyCodingSyncEnabledFlag();
+  const UInt       startCtuTsAddr    = pcSlice->getSliceSegmentCurStartCtuTsAddr();
+  const UInt       numSubstreams     = pcSlice->getNumberOfSubstreamSizes()+1;
+  const UInt       subStreamOffset   = pcPic->getSubstreamForCtuAddr(picSym.getCtuTsToRsAddrMap(startCtuTsAddr), true, pcSlice);
+
+  if ( numSubstreams == 1 )
+  {
+    return false;
+  }
+
+  // the substreams cover consecutive CTU ranges in tile scan. All ranges but the last one end with their tile (or CTU row
+  // of the tile with WPP); the last one is bounded likewise but may end earlier, with the slice segment.
+  std::vector<CtuRangeTask> tasks( numSubstreams );
+  UInt numRanges = 0;
+  for ( UInt ctuTsAddr = startCtuTsAddr; ctuTsAddr < numCtusInFrame; ctuTsAddr++ )
+  {
+    const UInt subStrm = pcPic->getSubstreamForCtuAddr(picSym.getCtuTsToRsAddrMap(ctuTsAddr), true, pcSlice) - subStreamOffset;
+    if ( subStrm == numRanges )
+    {
+      if ( numRanges == numSubstreams )
+      {
+        break;
+      }
+      tasks[numRanges++].startCtuTsAddr = ctuTsAddr;
+    }
+    else if ( subStrm + 1 != numRanges )
+    {
+      return false;
+    }
+    tasks[numRanges - 1].boundingCtuTsAddr = ctuTsAddr + 1;
+  }
+  if ( numRanges != numSubstreams )
+  {
+    return false;
+  }
+
+  if ( m_numCtuRanges < Int(numSubstreams) )
+  {
+    destroy();
+    m_numCtuRanges               = numSubstreams;
+    m_pcCtuRangeProgress         = new TComProgressCounter[m_numCtuRanges];
+    m_pcCtuRangeSyncContextState = new TDecSbac[m_numCtuRanges];
+  }
+
+  for ( UInt i = 0; i < numSubstreams; i++ )
+  {
+    CtuRangeTask &task          = tasks[i];
+    const UInt   startCtuRsAddr = picSym.getCtuTsToRsAddrMap(task.startCtuTsAddr);
+    const UInt   tileIdx        = picSym.getTileIdxMap(startCtuRsAddr);
+    const UInt   tileXPosInCtus = picSym.getTComTile(tileIdx)->getFirstCtuRsAddr() % frameWidthInCtus;
+    task.pcSliceDecoder         = this;
+    task.pcPic                  = pcPic;
+    task.pcSubstream            = ppcSubstreams[i];
+    task.isFirst                = i == 0;
+    task.isLast                 = i + 1 == numSubstreams;
+    task.rangeIdx               = i;
+    task.aboveRangeIdx          = -1;
+    task.pcSyncContextState     = &m_entropyCodingSyncContextState;
+    task.pcWorker               = NULL;
+
+    // with WPP, the previous range of the same tile is the CTU row above. It stores its state after its second CTU if that
+    // CTU is part of this slice segment, otherwise the state stored by the previous slice segment is used.
+    if ( wavefrontsEnabled && i > 0 && picSym.getTileIdxMap(picSym.getCtuTsToRsAddrMap(tasks[i - 1].startCtuTsAddr)) == tileIdx )
+    {
+      const UInt aboveStartXPosInCtus = picSym.getCtuTsToRsAddrMap(tasks[i - 1].startCtuTsAddr) % frameWidthInCtus;
+      task.aboveRangeIdx = i - 1;
+      if ( picSym.getTComTile(tileIdx)->getTileWidthInCtus() > 1 && aboveStartXPosInCtus <= tileXPosInCtus + 1 )
+      {
+        task.pcSyncContextState = &m_pcCtuRangeSyncContextState[i - 1];
+      }
+    }
+    m_pcCtuRangeProgress[i].reset( startCtuRsAddr % frameWidthInCtus );
+  }
+
+  // initialize all CTUs first: the availability checks read the slice of neighbouring CTUs in other ranges.
+  // CTUs following the end of the slice segment are initialized again by the next slice segment.
+  for( UInt ctuTsAddr = startCtuTsAddr; ctuTsAddr < tasks.back().boundingCtuTsAddr; ++ctuTsAddr )
+  {
+    const UInt ctuRsAddr = picSym.getCtuTsToRsAddrMap(ctuTsAddr);
+    pcPic->getCtu( ctuRsAddr )->initCtu( pcPic, ctuRsAddr );
+  }
+
+  TComTaskGroup taskGroup;
+  for ( UInt i = 0; i < numSubstreams; i++ )
+  {
+    m_pcThreadPool->addTask( xDecompressCtuRangeTask, &tasks[i], taskGroup );
+  }
+  m_pcThreadPool->waitForTasks( taskGroup );
+
+  if ( wavefrontsEnabled )
+  {
+    // keep the state after the second CTU of the last CTU row that contains it for the next slice segment (the last range
+    // ends with the slice segment, possibly before the second CTU of its row).
+    Int lastSyncRangeIdx = -1;
+    for ( UInt i = 0; i < numSubstreams; i++ )
+    {
+      const UInt     startCtuRsAddr  = picSym.getCtuTsToRsAddrMap(tasks[i].startCtuTsAddr);
+      const TComTile &tile           = *(picSym.getTComTile(picSym.getTileIdxMap(startCtuRsAddr)));
+      const UInt     tileXPosInCtus  = tile.getFirstCtuRsAddr() % frameWidthInCtus;
+      const UInt     ctuXPosInCtus   = startCtuRsAddr % frameWidthInCtus;
+      if ( tile.getTileWidthInCtus() > 1 && ctuXPosInCtus <= tileXPosInCtus + 1 &&
+           tasks[i].boundingCtuTsAddr > tasks[i].startCtuTsAddr + ( tileXPosInCtus + 1 - ctuXPosInCtus ) )
+      {
+        lastSyncRangeIdx = i;
+      }
+    }
+    if ( lastSyncRangeIdx >= 0 )
+    {
+      m_entropyCodingSyncContextState.loadContexts( &m_pcCtuRangeSyncContextState[lastSyncRangeIdx] );
+    }
+  }
+
+  if( pcSlice->getPPS()->getDependentSliceSegmentsEnabledFlag() )
+  {
+    m_lastSliceSegmentEndContextState.loadContexts( tasks.back().pcWorker->getSbacDecoder() );//ctx end of dep.slice
+  }
+  return true;
+}
+
+Void TDecSlice::xDecompressCtuRangeTask( Void* param, Int threadIdx )
+{
+  CtuRangeTask* pTask = (CtuRangeTask*)param;
+  pTask->pcSliceDecoder->xDecompressCtuRange( *pTask, pTask->pcSliceDecoder->m_pcCtuWorkers[threadIdx] );
+}
+
+/** Decode the CTUs of one CTU range of a slice segment using the tools of the given worker.
+ * This follows the serial loop of decompressSlice().
+ */
+Void TDecSlice::xDecompressCtuRange( CtuRangeTask& task, TDecCtuWorker& worker )
+{
+  TComPic* const      pcPic             = task.pcPic;
+  TComSlice* const    pcSlice           = pcPic->getSlice(pcPic->getCurrSliceIdx());
+  const UInt          frameWidthInCtus  = pcPic->getPicSym()->getFrameWidthInCtus();
+  const Bool          wavefrontsEnabled = pcSlice->getPPS()->getEntropyCodingSyncEnabledFlag();
+
+  TDecEntropy* const  pcEntropyDecoder  = worker.getEntropyDecoder();
+  TDecSbac* const     pcSbacDecoder     = worker.getSbacDecoder();
+  TDecCu* const       pcCuDecoder       = worker.getCuDecoder();
+
+  pcEntropyDecoder->setEntropyDecoder ( pcSbacDecoder );
+  pcEntropyDecoder->setBitstream      ( task.pcSubstream );
+  pcEntropyDecoder->resetEntropy      ( pcSlice );
+
+  if ( task.isFirst && pcSlice->getPPS()->getDependentSliceSegmentsEnabledFlag() )
+  {
+    // modify initial contexts with previous slice segment if this is a dependent slice.
+    const UInt startCtuRsAddr = pcPic->getPicSym()->getCtuTsToRsAddrMap(task.startCtuTsAddr);
+    const TComTile *pCurrentTile=pcPic->getPicSym()->getTComTile(pcPic->getPicSym()->getTileIdxMap(startCtuRsAddr));
+
+    if( pcSlice->getDependentSliceSegmentFlag() && startCtuRsAddr != pCurrentTile->getFirstCtuRsAddr() )
+    {
+      if ( pCurrentTile->getTileWidthInCtus() >= 2 || !wavefrontsEnabled)
+      {
+        pcSbacDecoder->loadContexts(&m_lastSliceSegmentEndContextState);
+      }
+    }
+  }
+
+  Bool isLastCtuOfSliceSegment = false;
+  for( UInt ctuTsAddr = task.startCtuTsAddr; !isLastCtuOfSliceSegment && ctuTsAddr < task.boundingCtuTsAddr; ctuTsAddr++ )
+  {
+    const UInt ctuRsAddr = pcPic->getPicSym()->getCtuTsToRsAddrMap(ctuTsAddr);
+    const TComTile &currentTile = *(pcPic->getPicSym()->getTComTile(pcPic->getPicSym()->getTileIdxMap(ctuRsAddr)));
+    const UInt firstCtuRsAddrOfTile = currentTile.getFirstCtuRsAddr();
+    const UInt tileXPosInCtus = firstCtuRsAddrOfTile % frameWidthInCtus;
+    const UInt tileYPosInCtus = firstCtuRsAddrOfTile / frameWidthInCtus;
+    const UInt ctuXPosInCtus  = ctuRsAddr % frameWidthInCtus;
+    const UInt ctuYPosInCtus  = ctuRsAddr / frameWidthInCtus;
+
+    // wait for the CTU above-right to be decoded.
+    if ( task.aboveRangeIdx >= 0 )
+    {
+      m_pcCtuRangeProgress[task.aboveRangeIdx].waitFor( min( ctuXPosInCtus + 2, tileXPosInCtus + currentTile.getTileWidthInCtus() ) );
+    }
+
+    TComDataCU* pCtu = pcPic->getCtu( ctuRsAddr );
+
+    // set up CABAC contexts' state for this CTU
+    if (ctuRsAddr == firstCtuRsAddrOfTile)
+    {
+      if (ctuTsAddr != task.startCtuTsAddr) // if it is the first CTU, then the entropy coder has already been reset
+      {
+        pcEntropyDecoder->resetEntropy(pcSlice);
+      }
+    }
+    else if (ctuXPosInCtus == tileXPosInCtus && wavefrontsEnabled)
+    {
+      // Synchronize cabac probabilities with upper-right CTU if it's available and at the start of a line.
+      if (ctuTsAddr != task.startCtuTsAddr) // if it is the first CTU, then the entropy coder has already been reset
+      {
+        pcEntropyDecoder->resetEntropy(pcSlice);
+      }
+      TComDataCU *pCtuUp = pCtu->getCtuAbove();
+      if ( pCtuUp && ((ctuRsAddr%frameWidthInCtus+1) < frameWidthInCtus)  )
+      {
+        TComDataCU *pCtuTR = pcPic->getCtu( ctuRsAddr - frameWidthInCtus + 1 );
+        if ( pCtu->CUIsFromSameSliceAndTile(pCtuTR) )
+        {
+          // Top-right is available, so use it.
+          pcSbacDecoder->loadContexts( task.pcSyncContextState );
+        }
+      }
+    }
+
+    xDecodeSAOBlkParam( pcSbacDecoder, pcPic, pcSlice, ctuRsAddr );
+
+    pcCuDecoder->decodeCtu     ( pCtu, isLastCtuOfSliceSegment );
+    pcCuDecoder->decompressCtu ( pCtu );
+
+    if ( wavefrontsEnabled )
+    {
+      //Store probabilities of second CTU in line into buffer
+      if ( ctuXPosInCtus == tileXPosInCtus+1 )
+      {
+        m_pcCtuRangeSyncContextState[task.rangeIdx].loadContexts( pcSbacDecoder );
+      }
+      m_pcCtuRangeProgress[task.rangeIdx].set( ctuXPosInCtus + 1 );
+    }
+
+    if (isLastCtuOfSliceSegment)
+    {
+#if DECODER_CHECK_SUBSTREAM_AND_SLICE_TRAILING_BYTES
+      pcSbacDecoder->parseRemainingBytes(false);
+#endif
+      if(!pcSlice->getDependentSliceSegmentFlag())
+      {
+        pcSlice->setSliceCurEndCtuTsAddr( ctuTsAddr+1 );
+      }
+      pcSlice->setSliceSegmentCurEndCtuTsAddr( ctuTsAddr+1 );
+      task.boundingCtuTsAddr = ctuTsAddr+1;
+    }
+    else if (  ctuXPosInCtus + 1 == tileXPosInCtus + currentTile.getTileWidthInCtus() &&
+             ( ctuYPosInCtus + 1 == tileYPosInCtus + currentTile.getTileHeightInCtus() || wavefrontsEnabled)
+            )
+    {
+      // The sub-stream should be terminated after this CTU.
+      // (end of tile, end of wavefront-CTU-row)
+      UInt binVal;
+      pcSbacDecoder->parseTerminatingBit( binVal );
+      assert( binVal );
+#if DECODER_CHECK_SUBSTREAM_AND_SLICE_TRAILING_BYTES
+      pcSbacDecoder->parseRemainingBytes(true);
+#endif
+    }
+
+    if (m_pcLoopFilterPipeline)
+    {
+      m_pcLoopFilterPipeline->ctuDecoded( ctuRsAddr );
+    }
+  }
+
+  assert( isLastCtuOfSliceSegment == task.isLast );
+  task.pcWorker = &worker;
+}
+
 //! \}
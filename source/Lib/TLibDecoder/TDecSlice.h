@@ -49,6 +49,9 @@
 #include "TDecCu.h"
 #include "TDecSbac.h"
 #include "TDecBinCoderCABAC.h"
+#include "TDecCtuWorker.h"
+#include "TDecLoopFilterPipeline.h"
+#include "TLibCommon/TComThreadPool.h"
 
 //! \ingroup TLibDecoder
 //! \{
@@ -70,15 +73,48 @@ private:
 
   TDecSbac        m_lastSliceSegmentEndContextState;    ///< context storage for state at the end of the previous slice-segment (used for dependent slices only).
   TDecSbac        m_entropyCodingSyncContextState;      ///< context storate for state of contexts at the wavefront/WPP/entropy-coding-sync second CTU of tile-row
+
+  // multi-threading
+  TComThreadPool*       m_pcThreadPool;                 ///< thread pool (NULL if single-threaded)
+  TDecCtuWorker*        m_pcCtuWorkers;                 ///< CTU decoding tools, one set per thread of the pool
+  Int                   m_numCtuRanges;                 ///< number of CTU ranges the per-range arrays are allocated for
+  TComProgressCounter*  m_pcCtuRangeProgress;           ///< horizontal position (in CTUs) up to which each CTU range has been decoded
+  TDecSbac*             m_pcCtuRangeSyncContextState;   ///< context state after the second CTU of the tile-row of each CTU range (WPP)
+  TDecLoopFilterPipeline* m_pcLoopFilterPipeline;       ///< in-loop filtering notified of each reconstructed CTU (NULL if the picture is filtered at once)
+
+  /// CTU range (tile or CTU row of a tile with WPP) of a slice segment, coded in its own substream and decoded by a thread pool task
+  struct CtuRangeTask
+  {
+    TDecSlice*          pcSliceDecoder;
+    TComPic*            pcPic;
+    TComInputBitstream* pcSubstream;
+    UInt                startCtuTsAddr;
+    UInt                boundingCtuTsAddr;                ///< bound of the range; the last range may end earlier, with the slice segment
+    Bool                isFirst;                          ///< the range starts the slice segment
+    Bool                isLast;                           ///< the range ends the slice segment
+    Int                 rangeIdx;                         ///< index of the range (substream) in the slice segment
+    Int                 aboveRangeIdx;                    ///< range of the tile-row above in the same tile and slice segment with WPP, otherwise -1
+    const TDecSbac*     pcSyncContextState;               ///< context state after the second CTU of the tile-row above (WPP)
+    TDecCtuWorker*      pcWorker;                         ///< worker that has decoded the range
+  };
+
 public:
   TDecSlice();
   virtual ~TDecSlice();
 
-  Void  init              ( TDecEntropy* pcEntropyDecoder, TDecCu* pcMbDecoder, TDecConformanceCheck *pDecConformanceCheck );
+  Void  init              ( TDecEntropy* pcEntropyDecoder, TDecCu* pcMbDecoder, TDecConformanceCheck *pDecConformanceCheck,
+                            TComThreadPool* pcThreadPool = NULL, TDecCtuWorker* pcCtuWorkers = NULL, TDecLoopFilterPipeline* pcLoopFilterPipeline = NULL );
   Void  create            ();
   Void  destroy           ();
 
   Void  decompressSlice   ( TComInputBitstream** ppcSubstreams,   TComPic* pcPic, TDecSbac* pcSbacDecoder );
+
+private:
+  Bool  xUseParallelCtuRanges          ( const TComSlice* pcSlice );
+  Bool  xDecompressCtuRangesInParallel ( TComInputBitstream** ppcSubstreams, TComPic* pcPic );
+  Void  xDecompressCtuRange            ( CtuRangeTask& task, TDecCtuWorker& worker );
+  static Void xDecompressCtuRangeTask  ( Void* param, Int threadIdx );
+  Void  xDecodeSAOBlkParam             ( TDecSbac* pcSbacDecoder, TComPic* pcPic, const TComSlice* pcSlice, const UInt ctuRsAddr );
 };
 
 //! \}
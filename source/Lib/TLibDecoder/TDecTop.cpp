@@ -63,6 +63,14 @@ TDecTop::TDecTop()
   , m_seiReader()
   , m_cLoopFilter()
   , m_cSAO()
+  , m_numWorkerThreads(1)
+  , m_pcCtuWorkers(NULL)
+  , m_numParallelFrames(1)
+  , m_pipelinedLoopFilter(false)
+  , m_pcFrameTasks(NULL)
+  , m_oldestFrameTask(0)
+  , m_numRunningFrameTasks(0)
+  , m_pcCurrFrameTask(NULL)
   , m_pcPic(NULL)
   , m_prevPOC(MAX_INT)
   , m_prevTid0POC(0)
@@ -111,29 +119,106 @@ Void TDecTop::create()
   m_cGopDecoder.create();
   m_apcSlicePilot = new TComSlice;
   m_uiSliceIdx = 0;
+
+  if ( m_numWorkerThreads > 1 )
+  {
+    m_cThreadPool.create( m_numWorkerThreads );
+    m_pcCtuWorkers = new TDecCtuWorker[m_numWorkerThreads];
+#if !(ENC_DEC_TRACE || RExt__DECODER_DEBUG_BIT_STATISTICS)
+    // the trace and the bit statistics are written in decoding order, and the conformance checks use the state of the previous slices.
+    if ( m_numParallelFrames > 1 && !TDecConformanceCheck::doChecking() )
+    {
+      m_pcFrameTasks = new FrameTask[m_numParallelFrames];
+      for ( Int i = 0; i < m_numParallelFrames; i++ )
+      {
+        m_pcFrameTasks[i].pcDecTop     = this;
+        m_pcFrameTasks[i].pcCtuWorkers = new TDecCtuWorker[m_numWorkerThreads];
+      }
+    }
+#endif
+  }
 }
 
 Void TDecTop::destroy()
 {
+  finishPictureDecoding();
+  delete [] m_pcFrameTasks;
+  m_pcFrameTasks = NULL;
+
   m_cGopDecoder.destroy();
 
   delete m_apcSlicePilot;
   m_apcSlicePilot = NULL;
 
   m_cSliceDecoder.destroy();
+  m_cThreadPool.destroy();
+  delete [] m_pcCtuWorkers;
+  m_pcCtuWorkers = NULL;
 }
 
 Void TDecTop::init()
 {
   // initialize ROM
   initROM();
-  m_cGopDecoder.init( &m_cEntropyDecoder, &m_cSbacDecoder, &m_cBinCABAC, &m_cCavlcDecoder, &m_cSliceDecoder, &m_cLoopFilter, &m_cSAO);
-  m_cSliceDecoder.init( &m_cEntropyDecoder, &m_cCuDecoder, &m_conformanceCheck );
+  m_cLoopFilterPipeline.init( &m_cLoopFilter, &m_cSAO, getThreadPool() );
+  TDecLoopFilterPipeline* pcLoopFilterPipeline = m_pipelinedLoopFilter ? &m_cLoopFilterPipeline : NULL;
+  m_cGopDecoder.init( &m_cEntropyDecoder, &m_cSbacDecoder, &m_cBinCABAC, &m_cCavlcDecoder, &m_cSliceDecoder, &m_cLoopFilter, &m_cSAO, pcLoopFilterPipeline );
+  m_cSliceDecoder.init( &m_cEntropyDecoder, &m_cCuDecoder, &m_conformanceCheck, getThreadPool(), m_pcCtuWorkers, pcLoopFilterPipeline );
   m_cEntropyDecoder.init(&m_cPrediction);
+
+  for ( Int i = 0; m_pcFrameTasks && i < m_numParallelFrames; i++ )
+  {
+    FrameTask& task = m_pcFrameTasks[i];
+    task.cLoopFilterPipeline.init( &task.cLoopFilter, &task.cSAO, getThreadPool() );
+    TDecLoopFilterPipeline* pcTaskLoopFilterPipeline = m_pipelinedLoopFilter ? &task.cLoopFilterPipeline : NULL;
+    task.cSliceDecoder.init( task.cTools.getEntropyDecoder(), task.cTools.getCuDecoder(), &m_conformanceCheck, getThreadPool(), task.pcCtuWorkers, pcTaskLoopFilterPipeline );
+    task.cGopDecoder.init( task.cTools.getEntropyDecoder(), task.cTools.getSbacDecoder(), task.cTools.getBinCABAC(), &m_cCavlcDecoder, &task.cSliceDecoder, &task.cLoopFilter, &task.cSAO, pcTaskLoopFilterPipeline );
+  }
+}
+
+Void TDecTop::setDecodedPictureHashSEIEnabled(Int enabled)
+{
+  m_cGopDecoder.setDecodedPictureHashSEIEnabled(enabled);
+  for ( Int i = 0; m_pcFrameTasks && i < m_numParallelFrames; i++ )
+  {
+    m_pcFrameTasks[i].cGopDecoder.setDecodedPictureHashSEIEnabled(enabled);
+  }
+}
+
+Void TDecTop::setProfilingLog(TComProfilingLog* pcProfilingLog)
+{
+  m_cGopDecoder.setProfilingLog(pcProfilingLog);
+  for ( Int i = 0; m_pcFrameTasks && i < m_numParallelFrames; i++ )
+  {
+    m_pcFrameTasks[i].cGopDecoder.setProfilingLog(pcProfilingLog);
+  }
+}
+
+UInt TDecTop::getNumberOfChecksumErrorsDetected() const
+{
+  UInt numErrors = m_cGopDecoder.getNumberOfChecksumErrorsDetected();
+  for ( Int i = 0; m_pcFrameTasks && i < m_numParallelFrames; i++ )
+  {
+    numErrors += m_pcFrameTasks[i].cGopDecoder.getNumberOfChecksumErrorsDetected();
+  }
+  return numErrors;
 }
 
 Void TDecTop::deletePicBuffer ( )
 {
+  finishPictureDecoding();
+  if ( m_pcCurrFrameTask )
+  {
+    // slices of a picture that has not been completed
+    for ( UInt i = 0; i < m_pcCurrFrameTask->slices.size(); i++ )
+    {
+      delete m_pcCurrFrameTask->slices[i];
+    }
+    m_pcCurrFrameTask->slices.clear();
+    m_pcCurrFrameTask->pcPic = NULL;
+    m_pcCurrFrameTask        = NULL;
+  }
+
   TComList<TComPic*>::iterator  iterPic   = m_cListPic.begin();
   Int iSize = Int( m_cListPic.size() );
 
@@ -149,6 +234,11 @@ Void TDecTop::deletePicBuffer ( )
   m_cSAO.destroy();
 
   m_cLoopFilter.        destroy();
+  for ( Int i = 0; m_pcFrameTasks && i < m_numParallelFrames; i++ )
+  {
+    m_pcFrameTasks[i].cSAO.destroy();
+    m_pcFrameTasks[i].cLoopFilter.destroy();
+  }
 
   // destroy ROM
   destroyROM();
@@ -201,6 +291,23 @@ Void TDecTop::xGetNewPicBuffer ( const TComSPS &sps, const TComPPS &pps, TComPic
     rpcPic = new TComPic();
     m_cListPic.pushBack( rpcPic );
   }
+  else
+  {
+    // the picture buffer may still be decoded, or be referenced by pictures that are decoded, by frame tasks
+    Int numTasksToFinish = 0;
+    for ( Int i = 0; i < m_numRunningFrameTasks; i++ )
+    {
+      const TComPic* pcTaskPic = m_pcFrameTasks[(m_oldestFrameTask + i) % m_numParallelFrames].pcPic;
+      if ( pcTaskPic == rpcPic || xIsReferencedByPicture( pcTaskPic, rpcPic ) )
+      {
+        numTasksToFinish = i + 1;
+      }
+    }
+    while ( numTasksToFinish-- > 0 )
+    {
+      xFinishOldestFrameTask();
+    }
+  }
   rpcPic->destroy();
 #if REDUCED_ENCODER_MEMORY
   rpcPic->create ( sps, pps, false, true);
@@ -219,14 +326,32 @@ Void TDecTop::executeLoopFilters(Int& poc, TComList<TComPic*>*& rpcListPic)
 
   TComPic*   pcPic         = m_pcPic;
 
-  // Execute Deblock + Cleanup
-
-  m_cGopDecoder.filterPicture(pcPic);
+  if ( m_pcFrameTasks )
+  {
+    if ( m_pcCurrFrameTask )
+    {
+      // the slices, the loop filters and the border extension are processed by a frame task.
+      // Pictures decoded later wait for the rows of the picture they reference.
+      pcPic->setOutputMark(pcPic->getSlice(0)->getPicOutputFlag() ? true : false);
+      pcPic->setReconMark(true);
+      pcPic->getPicYuvRec()->setBorderExtension(true);
+      m_pcCurrFrameTask->bReferenced = pcPic->getSlice(m_uiSliceIdx-1)->isReferenced();
+      m_cThreadPool.addTask( xDecodeFrameTask, m_pcCurrFrameTask, m_pcCurrFrameTask->cTaskGroup );
+      m_numRunningFrameTasks++;
+      m_pcCurrFrameTask = NULL;
+    }
+  }
+  else
+  {
+    // Execute Deblock + Cleanup
+    m_cGopDecoder.filterPicture(pcPic);
+    pcPic->setReconRowProgress( pcPic->getFrameHeightInCtus() );
+    m_cCuDecoder.destroy();
+  }
 
   TComSlice::sortPicList( m_cListPic ); // sorting for application output
   poc                 = pcPic->getSlice(m_uiSliceIdx-1)->getPOC();
   rpcListPic          = &m_cListPic;
-  m_cCuDecoder.destroy();
   m_bFirstSliceInPicture  = true;
 
   return;
@@ -254,6 +379,7 @@ Void TDecTop::checkNoOutputPriorPics (TComList<TComPic*>* pcListPic)
 Void TDecTop::xCreateLostPicture(Int iLostPoc)
 {
   printf("\ninserting lost poc : %d\n",iLostPoc);
+  finishPictureDecoding();
   TComPic *cFillPic;
   xGetNewPicBuffer(*(m_parameterSetManager.getFirstSPS()), *(m_parameterSetManager.getFirstPPS()), cFillPic, 0);
   cFillPic->getSlice(0)->initSlice();
@@ -289,6 +415,7 @@ Void TDecTop::xCreateLostPicture(Int iLostPoc)
   xUpdatePreviousTid0POC(cFillPic->getSlice(0));
   cFillPic->setReconMark(true);
   cFillPic->setOutputMark(true);
+  cFillPic->setReconRowProgress( cFillPic->getFrameHeightInCtus() );
   if(m_pocRandomAccess == MAX_INT)
   {
     m_pocRandomAccess = iLostPoc;
@@ -345,10 +472,45 @@ Void TDecTop::xActivateParameterSets()
     pps=pSlice->getPPS();
     sps=pSlice->getSPS();
 
+    m_pcPic->resetReconRowProgress();
+
     // Initialise the various objects for the new set of settings
-    m_cSAO.create( sps->getPicWidthInLumaSamples(), sps->getPicHeightInLumaSamples(), sps->getChromaFormatIdc(), sps->getMaxCUWidth(), sps->getMaxCUHeight(), sps->getMaxTotalCUDepth(), pps->getPpsRangeExtension().getLog2SaoOffsetScale(CHANNEL_TYPE_LUMA), pps->getPpsRangeExtension().getLog2SaoOffsetScale(CHANNEL_TYPE_CHROMA) );
-    m_cLoopFilter.create( sps->getMaxTotalCUDepth() );
-    m_cPrediction.initTempBuff(sps->getChromaFormatIdc());
+    if ( m_pcFrameTasks )
+    {
+      // the picture is decoded by the next free frame task; wait for the oldest picture if all tasks are running
+      if ( m_numRunningFrameTasks == m_numParallelFrames )
+      {
+        xFinishOldestFrameTask();
+      }
+      m_pcCurrFrameTask = &m_pcFrameTasks[(m_oldestFrameTask + m_numRunningFrameTasks) % m_numParallelFrames];
+      m_pcCurrFrameTask->pcPic = m_pcPic;
+
+      FrameTask& task = *m_pcCurrFrameTask;
+      task.cSAO.create( sps->getPicWidthInLumaSamples(), sps->getPicHeightInLumaSamples(), sps->getChromaFormatIdc(), sps->getMaxCUWidth(), sps->getMaxCUHeight(), sps->getMaxTotalCUDepth(), pps->getPpsRangeExtension().getLog2SaoOffsetScale(CHANNEL_TYPE_LUMA), pps->getPpsRangeExtension().getLog2SaoOffsetScale(CHANNEL_TYPE_CHROMA) );
+      task.cLoopFilter.create( sps->getMaxTotalCUDepth() );
+      task.cSliceDecoder.create();
+
+      // the CU decoders set up the global partition tables when they are created, so the CTU tools of all tasks are
+      // only (re)created for a new CTU structure, once the pictures being decoded have been completed
+      if ( !task.cTools.isCreatedFor( *sps ) )
+      {
+        finishPictureDecoding();
+        for ( Int taskIdx = 0; taskIdx < m_numParallelFrames; taskIdx++ )
+        {
+          m_pcFrameTasks[taskIdx].cTools.create( *sps );
+          for ( Int i = 0; i < m_numWorkerThreads; i++ )
+          {
+            m_pcFrameTasks[taskIdx].pcCtuWorkers[i].create( *sps );
+          }
+        }
+      }
+    }
+    else
+    {
+      m_cSAO.create( sps->getPicWidthInLumaSamples(), sps->getPicHeightInLumaSamples(), sps->getChromaFormatIdc(), sps->getMaxCUWidth(), sps->getMaxCUHeight(), sps->getMaxTotalCUDepth(), pps->getPpsRangeExtension().getLog2SaoOffsetScale(CHANNEL_TYPE_LUMA), pps->getPpsRangeExtension().getLog2SaoOffsetScale(CHANNEL_TYPE_CHROMA) );
+      m_cLoopFilter.create( sps->getMaxTotalCUDepth() );
+      m_cPrediction.initTempBuff(sps->getChromaFormatIdc());
+    }
 
 
     Bool isField = false;
@@ -375,11 +537,18 @@ Void TDecTop::xActivateParameterSets()
     m_SEIs.clear();
 
     // Recursive structure
-    m_cCuDecoder.create ( sps->getMaxTotalCUDepth(), sps->getMaxCUWidth(), sps->getMaxCUHeight(), sps->getChromaFormatIdc() );
-    m_cCuDecoder.init   ( &m_cEntropyDecoder, &m_cTrQuant, &m_cPrediction );
-    m_cTrQuant.init     ( sps->getMaxTrSize() );
+    if ( !m_pcFrameTasks )
+    {
+      m_cCuDecoder.create ( sps->getMaxTotalCUDepth(), sps->getMaxCUWidth(), sps->getMaxCUHeight(), sps->getChromaFormatIdc() );
+      m_cCuDecoder.init   ( &m_cEntropyDecoder, &m_cTrQuant, &m_cPrediction );
+      m_cTrQuant.init     ( sps->getMaxTrSize() );
+      for ( Int i = 0; m_pcCtuWorkers && i < m_numWorkerThreads; i++ )
+      {
+        m_pcCtuWorkers[i].create( *sps );
+      }
 
-    m_cSliceDecoder.create();
+      m_cSliceDecoder.create();
+    }
   }
   else
   {
@@ -672,7 +841,34 @@ Bool TDecTop::xDecodeSlice(InputNALUnit &nalu, Int &iSkipFrame, Int iPOCLastDisp
     pcSlice->setRefPOCList();
   }
 
-  m_pcPic->setCurrSliceIdx(m_uiSliceIdx);
+  if ( m_pcCurrFrameTask )
+  {
+    // the slice data is decoded by the frame task, once all slices of the picture have been received
+    m_pcCurrFrameTask->slices.push_back( new TComInputBitstream( nalu.getBitstream() ) );
+  }
+  else
+  {
+    m_pcPic->setCurrSliceIdx(m_uiSliceIdx);
+    xSetScalingList( m_cTrQuant, pcSlice );
+    for ( Int i = 0; m_pcCtuWorkers && i < m_numWorkerThreads; i++ )
+    {
+      xSetScalingList( *m_pcCtuWorkers[i].getTrQuant(), pcSlice );
+    }
+
+    //  Decode a picture
+    m_cGopDecoder.decompressSlice(&(nalu.getBitstream()), m_pcPic);
+  }
+
+  m_bFirstSliceInPicture = false;
+  m_uiSliceIdx++;
+
+  return false;
+}
+
+/** Set up the scaling lists of a transform & quantization class for the given slice.
+ */
+Void TDecTop::xSetScalingList( TComTrQuant& trQuant, const TComSlice* pcSlice )
+{
   if(pcSlice->getSPS()->getScalingListFlag())
   {
     TComScalingList scalingList;
@@ -688,8 +884,8 @@ Bool TDecTop::xDecodeSlice(InputNALUnit &nalu, Int &iSkipFrame, Int iPOCLastDisp
     {
       scalingList.setDefaultScalingList();
     }
-    m_cTrQuant.setScalingListDec(scalingList);
-    m_cTrQuant.setUseScalingList(true);
+    trQuant.setScalingListDec(scalingList);
+    trQuant.setUseScalingList(true);
   }
   else
   {
@@ -698,17 +894,93 @@ Bool TDecTop::xDecodeSlice(InputNALUnit &nalu, Int &iSkipFrame, Int iPOCLastDisp
         pcSlice->getSPS()->getMaxLog2TrDynamicRange(CHANNEL_TYPE_LUMA),
         pcSlice->getSPS()->getMaxLog2TrDynamicRange(CHANNEL_TYPE_CHROMA)
     };
-    m_cTrQuant.setFlatScalingList(maxLog2TrDynamicRange, pcSlice->getSPS()->getBitDepths());
-    m_cTrQuant.setUseScalingList(false);
+    trQuant.setFlatScalingList(maxLog2TrDynamicRange, pcSlice->getSPS()->getBitDepths());
+    trQuant.setUseScalingList(false);
+  }
+}
+
+/** Check whether a slice of a picture uses another picture for inter prediction.
+ */
+Bool TDecTop::xIsReferencedByPicture( const TComPic* pcPic, const TComPic* pcRefPic )
+{
+  for ( UInt sliceIdx = 0; sliceIdx < pcPic->getNumAllocatedSlice(); sliceIdx++ )
+  {
+    const TComSlice* pcSlice = pcPic->getSlice( sliceIdx );
+    for ( Int iRefList = 0; iRefList < NUM_REF_PIC_LIST_01; iRefList++ )
+    {
+      for ( Int iRefIdx = 0; iRefIdx < pcSlice->getNumRefIdx( RefPicList(iRefList) ); iRefIdx++ )
+      {
+        if ( pcSlice->getRefPic( RefPicList(iRefList), iRefIdx ) == pcRefPic )
+        {
+          return true;
+        }
+      }
+    }
   }
+  return false;
+}
 
-  //  Decode a picture
-  m_cGopDecoder.decompressSlice(&(nalu.getBitstream()), m_pcPic);
+/** Wait for the frame task that was started first, and print its status line.
+ */
+Void TDecTop::xFinishOldestFrameTask()
+{
+  FrameTask& task = m_pcFrameTasks[m_oldestFrameTask];
 
-  m_bFirstSliceInPicture = false;
-  m_uiSliceIdx++;
+  m_cThreadPool.waitForTasks( task.cTaskGroup );
+  task.cGopDecoder.finishPicture( task.pcPic, task.bReferenced );
+  task.pcPic = NULL;
 
-  return false;
+  m_oldestFrameTask = ( m_oldestFrameTask + 1 ) % m_numParallelFrames;
+  m_numRunningFrameTasks--;
+}
+
+Void TDecTop::finishPictureDecoding( const TComPic* pcPic )
+{
+  // pictures are finished in decoding order, so that the status lines keep their order
+  Int numTasksToFinish = pcPic ? 0 : m_numRunningFrameTasks;
+  for ( Int i = 0; pcPic && i < m_numRunningFrameTasks; i++ )
+  {
+    if ( m_pcFrameTasks[(m_oldestFrameTask + i) % m_numParallelFrames].pcPic == pcPic )
+    {
+      numTasksToFinish = i + 1;
+    }
+  }
+  while ( numTasksToFinish-- > 0 )
+  {
+    xFinishOldestFrameTask();
+  }
+}
+
+/** Decode the slices of a picture, then apply the loop filters and extend its borders.
+ * Rows of reference pictures are waited for during inter prediction.
+ */
+Void TDecTop::xDecodeFrameTask( Void* param, Int threadIdx )
+{
+  FrameTask&     task     = *static_cast<FrameTask*>( param );
+  const TDecTop* pcDecTop = task.pcDecTop;
+  TComPic*       pcPic    = task.pcPic;
+
+  for ( UInt sliceIdx = 0; sliceIdx < task.slices.size(); sliceIdx++ )
+  {
+    pcPic->setCurrSliceIdx( sliceIdx );
+    const TComSlice* pcSlice = pcPic->getSlice( sliceIdx );
+    xSetScalingList( *task.cTools.getTrQuant(), pcSlice );
+    for ( Int i = 0; i < pcDecTop->m_numWorkerThreads; i++ )
+    {
+      xSetScalingList( *task.pcCtuWorkers[i].getTrQuant(), pcSlice );
+    }
+
+    task.cGopDecoder.decompressSlice( task.slices[sliceIdx], pcPic );
+    delete task.slices[sliceIdx];
+  }
+  task.slices.clear();
+
+  task.cGopDecoder.loopFilterPicture( pcPic );
+  if ( !task.cGopDecoder.extendsPicBorder() )
+  {
+    pcPic->getPicYuvRec()->extendPicBorderLines( 0, pcPic->getPicYuvRec()->getHeight( COMPONENT_Y ) );
+  }
+  pcPic->setReconRowProgress( pcPic->getFrameHeightInCtus() );
 }
 
 Void TDecTop::xDecodeVPS(const std::vector<UChar> &naluData)
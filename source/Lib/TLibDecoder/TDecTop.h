@@ -45,6 +45,7 @@
 #include "TLibCommon/TComTrQuant.h"
 #include "TLibCommon/TComPrediction.h"
 #include "TLibCommon/SEI.h"
+#include "TLibCommon/TComThreadPool.h"
 
 #include "TDecGop.h"
 #include "TDecEntropy.h"
@@ -52,6 +53,7 @@
 #include "TDecCAVLC.h"
 #include "SEIread.h"
 #include "TDecConformance.h"
+#include "TDecCtuWorker.h"
 
 class InputNALUnit;
 
@@ -91,8 +93,40 @@ private:
   SEIReader               m_seiReader;
   TComLoopFilter          m_cLoopFilter;
   TComSampleAdaptiveOffset m_cSAO;
+  TDecLoopFilterPipeline  m_cLoopFilterPipeline;
   TDecConformanceCheck    m_conformanceCheck;
 
+  // multi-threading
+  Int                     m_numWorkerThreads;           ///< number of threads used for decoding (1: single-threaded)
+  TComThreadPool          m_cThreadPool;                ///< worker threads (only created when more than one thread is used)
+  TDecCtuWorker*          m_pcCtuWorkers;               ///< CTU decoding tools, one set per thread of the pool
+  Int                     m_numParallelFrames;          ///< maximum number of pictures decoded concurrently (1: one picture at a time)
+  Bool                    m_pipelinedLoopFilter;        ///< filter the CTU rows of a picture while it is decoded
+
+  /// decoding of one picture as a thread pool task, with its own set of slice, CTU and loop filter tools
+  struct FrameTask
+  {
+    TDecTop*                  pcDecTop;
+    TDecCtuWorker             cTools;                   ///< tools of the thread running the task
+    TDecCtuWorker*            pcCtuWorkers;             ///< CTU decoding tools for the substreams, one set per thread of the pool
+    TDecSlice                 cSliceDecoder;
+    TDecGop                   cGopDecoder;
+    TComLoopFilter            cLoopFilter;
+    TComSampleAdaptiveOffset  cSAO;
+    TDecLoopFilterPipeline    cLoopFilterPipeline;
+    TComPic*                  pcPic;                    ///< picture being decoded, NULL if the task is not in use
+    Bool                      bReferenced;              ///< reference marking of the picture when all its slices had been received
+    std::vector<TComInputBitstream*> slices;            ///< slice segment NAL units of the picture, in decoding order
+    TComTaskGroup             cTaskGroup;
+
+    FrameTask() : pcDecTop(NULL), pcCtuWorkers(NULL), pcPic(NULL), bReferenced(false) {}
+    ~FrameTask()                                        { delete [] pcCtuWorkers; }
+  };
+  FrameTask*              m_pcFrameTasks;               ///< m_numParallelFrames tasks, NULL if pictures are decoded on the calling thread
+  Int                     m_oldestFrameTask;            ///< index of the running task that was started first
+  Int                     m_numRunningFrameTasks;
+  FrameTask*              m_pcCurrFrameTask;            ///< task collecting the slices of the current picture
+
   Bool isSkipPictureForBLA(Int& iPOCLastDisplay);
   Bool isRandomAccessSkipPicture(Int& iSkipFrame,  Int& iPOCLastDisplay);
   TComPic*                m_pcPic;
@@ -122,7 +156,8 @@ public:
   Void  create  ();
   Void  destroy ();
 
-  Void setDecodedPictureHashSEIEnabled(Int enabled) { m_cGopDecoder.setDecodedPictureHashSEIEnabled(enabled); }
+  Void setDecodedPictureHashSEIEnabled(Int enabled);
+  Void setProfilingLog(TComProfilingLog* pcProfilingLog);   ///< the run time of the decoding stages of each picture is printed and recorded in the log
 
   Void  init();
   Bool  decode(InputNALUnit& nalu, Int& iSkipFrame, Int& iPOCLastDisplay);
@@ -141,7 +176,17 @@ public:
   Void  setForceDecodeBitDepth(UInt bitDepth) { m_forceDecodeBitDepth = bitDepth; }
 #endif
   Void  setDecodedSEIMessageOutputStream(std::ostream *pOpStream) { m_pDecodedSEIOutputStream = pOpStream; }
-  UInt  getNumberOfChecksumErrorsDetected() const { return m_cGopDecoder.getNumberOfChecksumErrorsDetected(); }
+  Void  setNumWorkerThreads(Int i)         { m_numWorkerThreads = i; }   ///< must be called before create()
+  Int   getNumWorkerThreads() const        { return m_numWorkerThreads; }
+  TComThreadPool* getThreadPool()          { return m_numWorkerThreads > 1 ? &m_cThreadPool : NULL; }
+  Void  setNumParallelFrames(Int i)        { m_numParallelFrames = i; }  ///< must be called before create()
+  Int   getNumParallelFrames() const       { return m_numParallelFrames; }
+  Void  setPipelinedLoopFilter(Bool b)     { m_pipelinedLoopFilter = b; }  ///< must be called before init()
+  Bool  getPipelinedLoopFilter() const     { return m_pipelinedLoopFilter; }
+  UInt  getNumberOfChecksumErrorsDetected() const;
+
+  /// wait until the given picture (all pictures if NULL) has been decoded and filtered
+  Void  finishPictureDecoding(const TComPic* pcPic = NULL);
 
 protected:
   Void  xGetNewPicBuffer  (const TComSPS &sps, const TComPPS &pps, TComPic*& rpcPic, const UInt temporalLayer);
@@ -149,6 +194,7 @@ protected:
 
   Void      xActivateParameterSets();
   Bool      xDecodeSlice(InputNALUnit &nalu, Int &iSkipFrame, Int iPOCLastDisplay);
+  static Void xSetScalingList(TComTrQuant& trQuant, const TComSlice* pcSlice);
   Void      xDecodeVPS(const std::vector<UChar> &naluData);
   Void      xDecodeSPS(const std::vector<UChar> &naluData);
   Void      xDecodePPS(const std::vector<UChar> &naluData);
@@ -156,6 +202,10 @@ protected:
   Void      xParsePrefixSEImessages();
   Void      xParsePrefixSEIsForUnknownVCLNal();
 
+  static Bool xIsReferencedByPicture(const TComPic* pcPic, const TComPic* pcRefPic);
+  Void      xFinishOldestFrameTask();
+  static Void xDecodeFrameTask(Void* param, Int threadIdx);
+
 };// END CLASS DEFINITION TDecTop
 
 
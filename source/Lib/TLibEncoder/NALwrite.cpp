@@ -85,41 +85,34 @@ Void write(ostream& out, OutputNALUnit& nalu)
    *  - 0x00000303
    */
   vector<uint8_t>& rbsp   = nalu.m_Bitstream.getFIFO();
-
-  vector<uint8_t> outputBuffer;
-  outputBuffer.resize(rbsp.size()*2+1); //there can never be enough emulation_prevention_three_bytes to require this much space
-  std::size_t outputAmount = 0;
-  Int         zeroCount    = 0;
-  for (vector<uint8_t>::iterator it = rbsp.begin(); it != rbsp.end(); it++)
+  if (rbsp.empty())
   {
-    const uint8_t v=(*it);
-    if (zeroCount==2 && v<=3)
-    {
-      outputBuffer[outputAmount++]=emulation_prevention_three_byte[0];
-      zeroCount=0;
-    }
+    return;
+  }
 
-    if (v==0)
-    {
-      zeroCount++;
-    }
-    else
-    {
-      zeroCount=0;
-    }
-    outputBuffer[outputAmount++]=v;
+  /* the runs of bytes between the emulation_prevention_three_bytes, which
+   * are found with findZeroZeroSequence(), are written without copying them.
+   * The byte following an inserted emulation_prevention_three_byte can
+   * start the next 0x0000xx sequence. */
+  const uint8_t* run = &rbsp[0];
+  const uint8_t* end = run + rbsp.size();
+  for (const uint8_t* found = findZeroZeroSequence(run, end, 3); found != end; found = findZeroZeroSequence(found + 2, end, 3))
+  {
+    out.write(reinterpret_cast<const TChar*>(run), found + 2 - run);
+    out.write(reinterpret_cast<const TChar*>(emulation_prevention_three_byte), 1);
+    run = found + 2;
   }
+  out.write(reinterpret_cast<const TChar*>(run), end - run);
 
   /* 7.4.1.1
    * ... when the last byte of the RBSP data is equal to 0x00 (which can
    * only occur when the RBSP ends in a cabac_zero_word), a final byte equal
    * to 0x03 is appended to the end of the data.
    */
-  if (zeroCount>0)
+  if (end[-1] == 0x00)
   {
-    outputBuffer[outputAmount++]=emulation_prevention_three_byte[0];
+    out.write(reinterpret_cast<const TChar*>(emulation_prevention_three_byte), 1);
   }
-  out.write(reinterpret_cast<const TChar*>(&(*outputBuffer.begin())), outputAmount);
 }
 
 //! \}
@@ -280,6 +280,8 @@ protected:
   std::vector<Int> m_tileRowHeight;
 
   Bool      m_entropyCodingSyncEnabledFlag;
+  Int       m_numWorkerThreads;                               ///< number of threads used to compress CTUs (1: single-threaded)
+  Int       m_numParallelFrames;                              ///< maximum number of pictures compressed concurrently (1: one picture at a time)
 
   HashType  m_decodedPictureHashSEIType;
   Bool      m_bufferingPeriodSEIEnabled;
@@ -419,6 +421,8 @@ protected:
   std::string m_summaryOutFilename;                           ///< filename to use for producing summary output file.
   std::string m_summaryPicFilenameBase;                       ///< Base filename to use for producing summary picture output files. The actual filenames used will have I.txt, P.txt and B.txt appended.
   UInt        m_summaryVerboseness;                           ///< Specifies the level of the verboseness of the text output.
+  Bool        m_profiling;                                    ///< print the run time of the encoding stages for each picture and for the sequence
+  std::string m_profilingFileName;                            ///< JSON file for the run time of the encoding stages. If empty, no file is written.
 
 public:
   TEncCfg()
@@ -487,6 +491,9 @@ public:
   Void      setMaxCUWidth                   ( UInt  u )      { m_maxCUWidth  = u; }
   Void      setMaxCUHeight                  ( UInt  u )      { m_maxCUHeight = u; }
   Void      setMaxTotalCUDepth              ( UInt  u )      { m_maxTotalCUDepth = u; }
+  UInt      getMaxCUWidth                   ()         const { return m_maxCUWidth; }
+  UInt      getMaxCUHeight                  ()         const { return m_maxCUHeight; }
+  UInt      getMaxTotalCUDepth              ()         const { return m_maxTotalCUDepth; }
   Void      setLog2DiffMaxMinCodingBlockSize( UInt  u )      { m_log2DiffMaxMinCodingBlockSize = u; }
 
   //======== Transform =============
@@ -509,6 +516,7 @@ public:
   Void      setMotionEstimationSearchMethod ( MESearchMethod e ) { m_motionEstimationSearchMethod = e; }
   Void      setSearchRange                  ( Int   i )      { m_iSearchRange = i; }
   Void      setBipredSearchRange            ( Int   i )      { m_bipredSearchRange = i; }
+  Int       getBipredSearchRange            ()         const { return m_bipredSearchRange; }
   Void      setClipForBiPredMeEnabled       ( Bool  b )      { m_bClipForBiPredMeEnabled = b; }
   Void      setFastMEAssumingSmootherMVEnabled ( Bool b )    { m_bFastMEAssumingSmootherMVEnabled = b; }
   Void      setMinSearchWindow              ( Int   i )      { m_minSearchWindow = i; }
@@ -670,6 +678,7 @@ public:
   Bool      getUseReconBasedCrossCPredictionEstimate ()                const { return m_reconBasedCrossCPredictionEstimate;  }
   Void      setUseReconBasedCrossCPredictionEstimate (const Bool value)      { m_reconBasedCrossCPredictionEstimate = value; }
   Void      setLog2SaoOffsetScale(ChannelType type, UInt uiBitShift)         { m_log2SaoOffsetScale[type] = uiBitShift; }
+  UInt      getLog2SaoOffsetScale(ChannelType type)                    const { return m_log2SaoOffsetScale[type]; }
 
   Bool getUseTransformSkip                             ()      { return m_useTransformSkip;        }
   Void setUseTransformSkip                             ( Bool b ) { m_useTransformSkip  = b;       }
@@ -737,6 +746,10 @@ public:
   Void  xCheckGSParameters();
   Void  setEntropyCodingSyncEnabledFlag(Bool b)                      { m_entropyCodingSyncEnabledFlag = b; }
   Bool  getEntropyCodingSyncEnabledFlag() const                      { return m_entropyCodingSyncEnabledFlag; }
+  Void  setNumWorkerThreads(Int i)                                   { m_numWorkerThreads = i; }
+  Int   getNumWorkerThreads() const                                  { return m_numWorkerThreads; }
+  Void  setNumParallelFrames(Int i)                                  { m_numParallelFrames = i; }
+  Int   getNumParallelFrames() const                                 { return m_numParallelFrames; }
   Void  setDecodedPictureHashSEIType(HashType m)                     { m_decodedPictureHashSEIType = m; }
   HashType getDecodedPictureHashSEIType() const                      { return m_decodedPictureHashSEIType; }
   Void  setBufferingPeriodSEIEnabled(Bool b)                         { m_bufferingPeriodSEIEnabled = b; }
@@ -1040,6 +1053,10 @@ public:
 
   Void      setSummaryVerboseness(UInt v)                            { m_summaryVerboseness = v; }
   UInt      getSummaryVerboseness( ) const                           { return m_summaryVerboseness; }
+  Void      setProfiling(Bool b)                                     { m_profiling = b; }
+  Bool      getProfiling() const                                     { return m_profiling; }
+  Void      setProfilingFileName(const std::string &s)               { m_profilingFileName = s; }
+  const std::string& getProfilingFileName() const                    { return m_profilingFileName; }
 };
 
 //! \}
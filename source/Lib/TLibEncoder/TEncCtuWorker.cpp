@@ -0,0 +1,184 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TEncCtuWorker.cpp
+    \brief    per-thread CTU compression context
+*/
+
+#include "TEncCtuWorker.h"
+#include "TEncTop.h"
+
+//! \ingroup TLibEncoder
+//! \{
+
+// ====================================================================================================================
+// Constructor / destructor / create / destroy
+// ====================================================================================================================
+
+TEncCtuWorker::TEncCtuWorker()
+: m_maxTotalCUDepth   ( 0 )
+, m_pppcRDSbacCoder   ( NULL )
+, m_pppcBinCoderCABAC ( NULL )
+{
+  m_cSbacCoder.init( &m_cBinCoderCABAC );
+  m_cRDGoOnSbacCoder.init( &m_cRDGoOnBinCoderCABAC );
+}
+
+TEncCtuWorker::~TEncCtuWorker()
+{
+  destroy();
+}
+
+Void TEncCtuWorker::create( TEncTop* pcEncTop )
+{
+  m_maxTotalCUDepth = pcEncTop->getMaxTotalCUDepth();
+
+  m_cCuEncoder.create( m_maxTotalCUDepth, pcEncTop->getMaxCUWidth(), pcEncTop->getMaxCUHeight(), pcEncTop->getChromaFormatIdc() );
+
+  m_pppcRDSbacCoder = new TEncSbac** [m_maxTotalCUDepth+1];
+#if FAST_BIT_EST
+  m_pppcBinCoderCABAC = new TEncBinCABACCounter** [m_maxTotalCUDepth+1];
+#else
+  m_pppcBinCoderCABAC = new TEncBinCABAC** [m_maxTotalCUDepth+1];
+#endif
+
+  for ( Int iDepth = 0; iDepth < m_maxTotalCUDepth+1; iDepth++ )
+  {
+    m_pppcRDSbacCoder[iDepth] = new TEncSbac* [CI_NUM];
+#if FAST_BIT_EST
+    m_pppcBinCoderCABAC[iDepth] = new TEncBinCABACCounter* [CI_NUM];
+#else
+    m_pppcBinCoderCABAC[iDepth] = new TEncBinCABAC* [CI_NUM];
+#endif
+
+    for (Int iCIIdx = 0; iCIIdx < CI_NUM; iCIIdx ++ )
+    {
+      m_pppcRDSbacCoder[iDepth][iCIIdx] = new TEncSbac;
+#if FAST_BIT_EST
+      m_pppcBinCoderCABAC [iDepth][iCIIdx] = new TEncBinCABACCounter;
+#else
+      m_pppcBinCoderCABAC [iDepth][iCIIdx] = new TEncBinCABAC;
+#endif
+      m_pppcRDSbacCoder   [iDepth][iCIIdx]->init( m_pppcBinCoderCABAC [iDepth][iCIIdx] );
+    }
+  }
+}
+
+Void TEncCtuWorker::destroy()
+{
+  if ( m_pppcRDSbacCoder == NULL )
+  {
+    return;
+  }
+
+  m_cCuEncoder.destroy();
+  m_cSearch.   destroy();
+
+  for ( Int iDepth = 0; iDepth < m_maxTotalCUDepth+1; iDepth++ )
+  {
+    for (Int iCIIdx = 0; iCIIdx < CI_NUM; iCIIdx ++ )
+    {
+      delete m_pppcRDSbacCoder[iDepth][iCIIdx];
+      delete m_pppcBinCoderCABAC[iDepth][iCIIdx];
+    }
+    delete [] m_pppcRDSbacCoder[iDepth];
+    delete [] m_pppcBinCoderCABAC[iDepth];
+  }
+
+  delete [] m_pppcRDSbacCoder;
+  delete [] m_pppcBinCoderCABAC;
+  m_pppcRDSbacCoder   = NULL;
+  m_pppcBinCoderCABAC = NULL;
+}
+
+/** \param    pcEncTop  pointer of encoder class
+    \param    sps       SPS providing the scaling lists and bit depths
+ */
+Void TEncCtuWorker::init( TEncTop* pcEncTop, TComSPS& sps )
+{
+  m_cCuEncoder.init( pcEncTop, &m_cSearch, &m_cTrQuant, &m_cRdCost, &m_cEntropyCoder, m_pppcRDSbacCoder, &m_cRDGoOnSbacCoder );
+  m_cCuEncoder.setSliceEncoder( pcEncTop->getSliceEncoder() );
+
+  m_cRdCost.setCostMode( pcEncTop->getCostMode() );
+
+  m_cTrQuant.init( 1 << pcEncTop->getQuadtreeTULog2MaxSize(),
+                   pcEncTop->getUseRDOQ(),
+                   pcEncTop->getUseRDOQTS(),
+                   pcEncTop->getUseSelectiveRDOQ(),
+                   true
+                  ,pcEncTop->getUseTransformSkipFast()
+#if ADAPTIVE_QP_SELECTION
+                  ,pcEncTop->getUseAdaptQpSelect()
+#endif
+                  );
+
+  const Int maxLog2TrDynamicRange[MAX_NUM_CHANNEL_TYPE] =
+  {
+      sps.getMaxLog2TrDynamicRange(CHANNEL_TYPE_LUMA),
+      sps.getMaxLog2TrDynamicRange(CHANNEL_TYPE_CHROMA)
+  };
+  if ( pcEncTop->getUseScalingListId() == SCALING_LIST_OFF )
+  {
+    m_cTrQuant.setFlatScalingList( maxLog2TrDynamicRange, sps.getBitDepths() );
+    m_cTrQuant.setUseScalingList( false );
+  }
+  else
+  {
+    m_cTrQuant.setScalingList( &(sps.getScalingList()), maxLog2TrDynamicRange, sps.getBitDepths() );
+    m_cTrQuant.setUseScalingList( true );
+  }
+
+  m_cSearch.init( pcEncTop, &m_cTrQuant, pcEncTop->getSearchRange(), pcEncTop->getBipredSearchRange(), pcEncTop->getMotionEstimationSearchMethod(),
+                  pcEncTop->getMaxCUWidth(), pcEncTop->getMaxCUHeight(), m_maxTotalCUDepth, &m_cEntropyCoder, &m_cRdCost, m_pppcRDSbacCoder, &m_cRDGoOnSbacCoder );
+}
+
+// ====================================================================================================================
+// Public member functions
+// ====================================================================================================================
+
+/** \param    pcRdCost      RD cost class of the main encoder
+    \param    pcTrQuant     transform & quantization class of the main encoder
+    \param    bFastDeltaQP  fast delta QP setting of the current slice
+ */
+Void TEncCtuWorker::initSlice( const TComRdCost* pcRdCost, const TComTrQuant* pcTrQuant, const Bool bFastDeltaQP )
+{
+  m_cRdCost = *pcRdCost;
+#if RDOQ_CHROMA_LAMBDA
+  m_cTrQuant.setLambdas( pcTrQuant->getLambdas() );
+#else
+  m_cTrQuant.setLambda( pcTrQuant->getLambda() );
+#endif
+  m_cCuEncoder.setFastDeltaQp( bFastDeltaQP );
+}
+
+//! \}
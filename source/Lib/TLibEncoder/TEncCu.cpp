@@ -204,17 +204,32 @@ Void TEncCu::destroy()
 /** \param    pcEncTop      pointer of encoder class
  */
 Void TEncCu::init( TEncTop* pcEncTop )
+{
+  init( pcEncTop, pcEncTop->getPredSearch(), pcEncTop->getTrQuant(), pcEncTop->getRdCost(),
+        pcEncTop->getEntropyCoder(), pcEncTop->getRDSbacCoder(), pcEncTop->getRDGoOnSbacCoder() );
+}
+
+/** \param    pcEncTop           pointer of encoder class
+    \param    pcPredSearch       encoder search class to be used
+    \param    pcTrQuant          transform & quantization class to be used
+    \param    pcRdCost           RD cost computation class to be used
+    \param    pcEntropyCoder     entropy encoder to be used
+    \param    pppcRDSbacCoder    SBAC coders for RD computation
+    \param    pcRDGoOnSbacCoder  going on SBAC coder for RD computation
+ */
+Void TEncCu::init( TEncTop* pcEncTop, TEncSearch* pcPredSearch, TComTrQuant* pcTrQuant, TComRdCost* pcRdCost,
+                   TEncEntropy* pcEntropyCoder, TEncSbac*** pppcRDSbacCoder, TEncSbac* pcRDGoOnSbacCoder )
 {
   m_pcEncCfg           = pcEncTop;
-  m_pcPredSearch       = pcEncTop->getPredSearch();
-  m_pcTrQuant          = pcEncTop->getTrQuant();
-  m_pcRdCost           = pcEncTop->getRdCost();
+  m_pcPredSearch       = pcPredSearch;
+  m_pcTrQuant          = pcTrQuant;
+  m_pcRdCost           = pcRdCost;
 
-  m_pcEntropyCoder     = pcEncTop->getEntropyCoder();
+  m_pcEntropyCoder     = pcEntropyCoder;
   m_pcBinCABAC         = pcEncTop->getBinCABAC();
 
-  m_pppcRDSbacCoder    = pcEncTop->getRDSbacCoder();
-  m_pcRDGoOnSbacCoder  = pcEncTop->getRDGoOnSbacCoder();
+  m_pppcRDSbacCoder    = pppcRDSbacCoder;
+  m_pcRDGoOnSbacCoder  = pcRDGoOnSbacCoder;
 
   m_pcRateCtrl         = pcEncTop->getRateCtrl();
   m_lumaQPOffset       = 0;
@@ -99,6 +99,10 @@ TEncGOP::TEncGOP()
   m_associatedIRAPType = NAL_UNIT_CODED_SLICE_IDR_N_LP;
   m_associatedIRAPPOC  = 0;
   m_pcDeblockingTempPicYuv = NULL;
+  m_encCABACTableIdx    = I_SLICE;
+  m_pcPicEncodeTasks    = NULL;
+  m_numPicEncodeTasks   = 1;
+  m_pcLoopFilterPipelines = NULL;
 }
 
 TEncGOP::~TEncGOP()
@@ -121,6 +125,20 @@ Void  TEncGOP::destroy()
     delete m_pcDeblockingTempPicYuv;
     m_pcDeblockingTempPicYuv = NULL;
   }
+  if (m_pcPicEncodeTasks)
+  {
+    delete [] m_pcPicEncodeTasks;
+    m_pcPicEncodeTasks = NULL;
+  }
+  if (m_pcLoopFilterPipelines)
+  {
+    for ( Int i = 0; i < m_numPicEncodeTasks; i++ )
+    {
+      m_pcLoopFilterPipelines[i].destroy();
+    }
+    delete [] m_pcLoopFilterPipelines;
+    m_pcLoopFilterPipelines = NULL;
+  }
 }
 
 Void TEncGOP::init ( TEncTop* pcTEncTop )
@@ -139,9 +157,26 @@ Void TEncGOP::init ( TEncTop* pcTEncTop )
 
   m_pcSAO                = pcTEncTop->getSAO();
   m_pcRateCtrl           = pcTEncTop->getRateCtrl();
+  m_profilingLog.reset();
   m_lastBPSEI          = 0;
   m_totalCoded         = 0;
 
+  // with frame slice encoders, several pictures can be in flight; otherwise they are written one at a time
+  m_numPicEncodeTasks  = pcTEncTop->getFrameSliceEncoders() ? pcTEncTop->getNumParallelFrames() : 1;
+  m_pcPicEncodeTasks   = new PicEncodeTask[m_numPicEncodeTasks];
+
+#if REDUCED_ENCODER_MEMORY
+  // pictures in flight are loop filtered while they are compressed, so that the pictures referencing them only wait for
+  // the CTU rows they read; the tools that analyse or re-filter the whole picture need it to be filtered afterwards
+  if ( pcTEncTop->getFrameSliceEncoders() && !m_pcCfg->getDeblockingFilterMetric() && !m_pcCfg->getTestSAODisableAtPictureLevel() && m_pcCfg->getDeltaQpRD() == 0 )
+  {
+    m_pcLoopFilterPipelines = new TEncLoopFilterPipeline[m_numPicEncodeTasks];
+    for ( Int i = 0; i < m_numPicEncodeTasks; i++ )
+    {
+      m_pcLoopFilterPipelines[i].create( m_pcCfg );
+    }
+  }
+#endif
 }
 
 Int TEncGOP::xWriteVPS (AccessUnit &accessUnit, const TComVPS *vps)
@@ -991,6 +1026,23 @@ Int EfficientFieldIRAPMapping::restoreGOPid(const Int GOPid)
   return GOPid;
 }
 
+/** Check whether a picture is used for reference by the current picture.
+    Long-term reference pictures may only be known by their POC LSBs: all pictures are then assumed to be referenced.
+ */
+static Bool isReferencedByCurrPic(TComSlice *pSlice, const TComPic *pcPic)
+{
+  const TComReferencePictureSet *pRPS = pSlice->getRPS();
+  const Int numShortTermPics = pRPS->getNumberOfNegativePictures() + pRPS->getNumberOfPositivePictures();
+  for (Int i = 0; i < numShortTermPics; i++)
+  {
+    if (pRPS->getUsed(i) && pSlice->getPOC() + pRPS->getDeltaPOC(i) == pcPic->getPOC())
+    {
+      return true;
+    }
+  }
+  return pRPS->getNumberOfLongtermPictures() > 0;
+}
+
 
 #if X0038_LAMBDA_FROM_QP_CAPABILITY
 static UInt calculateCollocatedFromL0Flag(const TComSlice *pSlice)
@@ -1096,18 +1148,17 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
   TComPic*        pcPic = NULL;
   TComPicYuv*     pcPicYuvRecOut;
   TComSlice*      pcSlice;
-  TComOutputBitstream  *pcBitstreamRedirect;
-  pcBitstreamRedirect = new TComOutputBitstream;
   AccessUnit::iterator  itLocationToPushSliceHeaderNALU; // used to store location where NALU containing slice header is to be inserted
 
   xInitGOP( iPOCLast, iNumPicRcvd, isField );
 
   m_iNumPicCoded = 0;
-  SEIMessages leadingSeiMessages;
-  SEIMessages nestedSeiMessages;
-  SEIMessages duInfoSeiMessages;
-  SEIMessages trailingSeiMessages;
-  std::deque<DUData> duData;
+  GOPWriteContext writeCtx;
+  writeCtx.pcListPic           = &rcListPic;
+  writeCtx.isField             = isField;
+  writeCtx.isTff               = isTff;
+  writeCtx.snrConversion       = snr_conversion;
+  writeCtx.printFrameMSE       = printFrameMSE;
   SEIDecodingUnitInfo decodingUnitInfoSEI;
 
   EfficientFieldIRAPMapping effFieldIRAPMap;
@@ -1115,6 +1166,22 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
   {
     effFieldIRAPMap.initialize(isField, m_iGopSize, iPOCLast, iNumPicRcvd, m_iLastIDR, this, m_pcCfg);
   }
+  writeCtx.IRAPGOPid = m_pcCfg->getEfficientFieldIRAPEnabled() ? effFieldIRAPMap.GetIRAPGOPid() : 0;
+
+  // the cabac_init table of the pictures of the GOP is chosen from the statistics of the last picture of the previous GOP,
+  // which has been written before any of them is compressed, whether or not pictures are compressed concurrently
+  const SliceType encCABACTableIdx = m_encCABACTableIdx;
+
+  // Pictures are prepared and written in coding order by this thread. Up to m_numPicEncodeTasks pictures are in flight
+  // in between, each compressed by its own slice encoder; their slice lists are only accessed with m_picListMutex locked.
+  TEncSlice*      pcFrameSliceEncoders = m_pcEncTop->getFrameSliceEncoders();
+  TComTaskGroup   picTaskGroup;
+  Int             numPicsStarted = 0;
+  Int             numPicsWritten = 0;
+  std::unique_lock<std::mutex> lock( m_picListMutex );
+
+  // the SAO encoder state is passed on from picture to picture in coding order
+  m_cSAOPicStateProgress.reset( 0 );
 
   // reset flag indicating whether pictures have been encoded
   for ( Int iGOPid=0; iGOPid < m_iGopSize; iGOPid++ )
@@ -1124,6 +1191,12 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
 
   for ( Int iGOPid=0; iGOPid < m_iGopSize; iGOPid++ )
   {
+    // the task entry and slice encoder of the oldest picture in flight are needed for the next picture
+    while ( numPicsStarted - numPicsWritten >= m_numPicEncodeTasks )
+    {
+      xFilterAndWritePicture( m_pcPicEncodeTasks[numPicsWritten++ % m_numPicEncodeTasks], writeCtx, lock );
+    }
+
     if (m_pcCfg->getEfficientFieldIRAPEnabled())
     {
       iGOPid=effFieldIRAPMap.adjustGOPid(iGOPid);
@@ -1173,18 +1246,27 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
     accessUnitsInGOP.push_back(AccessUnit());
     AccessUnit& accessUnit = accessUnitsInGOP.back();
     xGetBuffer( rcListPic, rcListPicYuvRecOut, iNumPicRcvd, iTimeOffset, pcPic, pcPicYuvRecOut, pocCurr, isField );
+    pcPic->resetReconRowProgress();
+
+    PicEncodeTask& task           = m_pcPicEncodeTasks[numPicsStarted % m_numPicEncodeTasks];
+    TEncSlice*     pcSliceEncoder = pcFrameSliceEncoders ? &pcFrameSliceEncoders[numPicsStarted % m_numPicEncodeTasks] : m_pcSliceEncoder;
 
 #if REDUCED_ENCODER_MEMORY
     pcPic->prepareForReconstruction();
+    if ( m_pcLoopFilterPipelines )
+    {
+      // the borders are extended CTU row by CTU row by the loop filter pipeline
+      pcPic->getPicYuvRec()->setBorderExtension( true );
+    }
 
 #endif
     //  Slice data initialization
     pcPic->clearSliceBuffer();
     pcPic->allocateNewSlice();
-    m_pcSliceEncoder->setSliceIdx(0);
+    pcSliceEncoder->setSliceIdx(0);
     pcPic->setCurrSliceIdx(0);
 
-    m_pcSliceEncoder->initEncSlice ( pcPic, iPOCLast, pocCurr, iGOPid, pcSlice, isField );
+    pcSliceEncoder->initEncSlice ( pcPic, iPOCLast, pocCurr, iGOPid, pcSlice, isField );
 
     pcSlice->setLastIDR(m_iLastIDR);
     pcSlice->setSliceIdx(0);
@@ -1333,6 +1415,21 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
     pcSlice->setNumRefIdx(REF_PIC_LIST_0,min(m_pcCfg->getGOPEntry(iGOPid).m_numRefPicsActive,pcSlice->getRPS()->getNumberOfPictures()));
     pcSlice->setNumRefIdx(REF_PIC_LIST_1,min(m_pcCfg->getGOPEntry(iGOPid).m_numRefPicsActive,pcSlice->getRPS()->getNumberOfPictures()));
 
+    // setting the reference lists extends the borders of the reference pictures: referenced pictures in flight are written first,
+    // unless they are loop filtered while they are compressed
+    Int numPicsToWrite = numPicsWritten;
+    for ( Int i = numPicsWritten; i < numPicsStarted && !m_pcLoopFilterPipelines; i++ )
+    {
+      if ( isReferencedByCurrPic( pcSlice, m_pcPicEncodeTasks[i % m_numPicEncodeTasks].pcPic ) )
+      {
+        numPicsToWrite = i + 1;
+      }
+    }
+    while ( numPicsWritten < numPicsToWrite )
+    {
+      xFilterAndWritePicture( m_pcPicEncodeTasks[numPicsWritten++ % m_numPicEncodeTasks], writeCtx, lock );
+    }
+
     //  Set reference list
     pcSlice->setRefPicList ( rcListPic );
 
@@ -1341,7 +1438,7 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
     {
       pcSlice->setSliceType ( P_SLICE );
     }
-    pcSlice->setEncCABACTableIdx(m_pcSliceEncoder->getEncCABACTableIdx());
+    pcSlice->setEncCABACTableIdx(encCABACTableIdx);
 
     if (pcSlice->getSliceType() == B_SLICE)
     {
@@ -1410,7 +1507,7 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
     // set adaptive search range for non-intra-slices
     if (m_pcCfg->getUseASR() && pcSlice->getSliceType()!=I_SLICE)
     {
-      m_pcSliceEncoder->setSearchRange(pcSlice);
+      pcSliceEncoder->setSearchRange(pcSlice);
     }
 
     Bool bGPBcheck=false;
@@ -1441,10 +1538,7 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
 
 
     Double lambda            = 0.0;
-    Int actualHeadBits       = 0;
-    Int actualTotalBits      = 0;
     Int estimatedBits        = 0;
-    Int tmpBitsBeforeWriting = 0;
     if ( m_pcCfg->getUseRateCtrl() ) // TODO: does this work with multiple slices and slice-segments?
     {
       Int frameLevel = m_pcRateCtrl->getRCSeq()->getGOPID2Level( iGOPid );
@@ -1488,7 +1582,7 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
       }
       else if ( frameLevel == 0 )   // intra case, but use the model
       {
-        m_pcSliceEncoder->calCostSliceI(pcPic); // TODO: This only analyses the first slice segment - what about the others?
+        pcSliceEncoder->calCostSliceI(pcPic); // TODO: This only analyses the first slice segment - what about the others?
 
         if ( m_pcCfg->getIntraPeriod() != 1 )   // do not refine allocated bits for all intra case
         {
@@ -1535,362 +1629,485 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
       sliceQP = Clip3( -pcSlice->getSPS()->getQpBDOffset(CHANNEL_TYPE_LUMA), MAX_QP, sliceQP );
       m_pcRateCtrl->getRCPic()->setPicEstQP( sliceQP );
 
-      m_pcSliceEncoder->resetQP( pcPic, sliceQP, lambda );
+      pcSliceEncoder->resetQP( pcPic, sliceQP, lambda );
     }
 
-    UInt uiNumSliceSegments = 1;
+    // hand the picture over for compression
+    task.pcGOPEncoder         = this;
+    task.pcSliceEncoder       = pcSliceEncoder;
+    task.pcLoopFilterPipeline = m_pcLoopFilterPipelines ? &m_pcLoopFilterPipelines[numPicsStarted % m_numPicEncodeTasks] : NULL;
+    task.pcPic                = pcPic;
+    task.pcPicYuvRecOut       = pcPicYuvRecOut;
+    task.pcAccessUnit         = &accessUnit;
+    task.iGOPid               = iGOPid;
+    task.iBeforeTime          = iBeforeTime;
+    task.lambda               = lambda;
+    task.estimatedBits        = estimatedBits;
+    task.numSliceSegments     = 1;
+    task.compressed.reset( 0 );
+    if ( task.pcLoopFilterPipeline )
+    {
+      const Bool bSAOPicState = m_pcCfg->getSaoEncodingRate() > 0.0;
+      task.pcLoopFilterPipeline->startPicture( pcPic, bSAOPicState ? m_pcSAO : NULL, bSAOPicState ? &m_cSAOPicStateProgress : NULL, numPicsStarted );
+    }
+    pcSliceEncoder->setLoopFilterPipeline( task.pcLoopFilterPipeline );
+    numPicsStarted++;
 
-    // Allocate some coders, now the number of tiles are known.
-    const Int numSubstreamsColumns = (pcSlice->getPPS()->getNumTileColumnsMinus1() + 1);
-    const Int numSubstreamRows     = pcSlice->getPPS()->getEntropyCodingSyncEnabledFlag() ? pcPic->getFrameHeightInCtus() : (pcSlice->getPPS()->getNumTileRowsMinus1() + 1);
-    const Int numSubstreams        = numSubstreamRows * numSubstreamsColumns;
-    std::vector<TComOutputBitstream> substreamsOut(numSubstreams);
+    if ( pcFrameSliceEncoders )
+    {
+      m_pcEncTop->getThreadPool()->addTask( xCompressPictureTask, &task, picTaskGroup );
+    }
+    else
+    {
+      lock.unlock();
+      xCompressPicture( task );
+      lock.lock();
+    }
 
-    // now compress (trial encode) the various slice segments (slices, and dependent slices)
+    if (m_pcCfg->getEfficientFieldIRAPEnabled())
     {
-      const UInt numberOfCtusInFrame=pcPic->getPicSym()->getNumberOfCtusInFrame();
-      pcSlice->setSliceCurStartCtuTsAddr( 0 );
-      pcSlice->setSliceSegmentCurStartCtuTsAddr( 0 );
+      iGOPid=effFieldIRAPMap.restoreGOPid(iGOPid);
+    }
+  } // iGOPid-loop
 
-      for(UInt nextCtuTsAddr = 0; nextCtuTsAddr < numberOfCtusInFrame; )
-      {
-        m_pcSliceEncoder->precompressSlice( pcPic );
-        m_pcSliceEncoder->compressSlice   ( pcPic, false, false );
+  while ( numPicsWritten < numPicsStarted )
+  {
+    xFilterAndWritePicture( m_pcPicEncodeTasks[numPicsWritten++ % m_numPicEncodeTasks], writeCtx, lock );
+  }
+  lock.unlock();
+  if ( pcFrameSliceEncoders )
+  {
+    m_pcEncTop->getThreadPool()->waitForTasks( picTaskGroup );
+  }
+
+  assert ( (m_iNumPicCoded == iNumPicRcvd) );
+}
+
+/** The picture is compressed by the slice encoder of the task. Its reference pictures may still be in flight: the CTU
+ * rows they are read from are waited for, unless weighted prediction analyses them as a whole.
+ */
+Void TEncGOP::xCompressPicture( PicEncodeTask& task )
+{
+  TComPic*   pcPic          = task.pcPic;
+  TEncSlice* pcSliceEncoder = task.pcSliceEncoder;
+  TComSlice* pcSlice        = pcPic->getSlice(0);
 
-        const UInt curSliceSegmentEnd = pcSlice->getSliceSegmentCurEndCtuTsAddr();
-        if (curSliceSegmentEnd < numberOfCtusInFrame)
+  const Bool bWaitForRefPics = !task.pcLoopFilterPipeline || pcSlice->getPPS()->getUseWP() || pcSlice->getPPS()->getWPBiPred();
+  for ( Int iRefList = 0; iRefList < NUM_REF_PIC_LIST_01 && bWaitForRefPics; iRefList++ )
+  {
+    for ( Int iRefIdx = 0; iRefIdx < pcSlice->getNumRefIdx( RefPicList( iRefList ) ); iRefIdx++ )
+    {
+      TComPic* pcRefPic = pcSlice->getRefPic( RefPicList( iRefList ), iRefIdx );
+      pcRefPic->waitForReconRows( pcRefPic->getFrameHeightInCtus() );
+    }
+  }
+
+  // now compress (trial encode) the various slice segments (slices, and dependent slices)
+  {
+    const UInt numberOfCtusInFrame=pcPic->getPicSym()->getNumberOfCtusInFrame();
+    pcSlice->setSliceCurStartCtuTsAddr( 0 );
+    pcSlice->setSliceSegmentCurStartCtuTsAddr( 0 );
+
+    for(UInt nextCtuTsAddr = 0; nextCtuTsAddr < numberOfCtusInFrame; )
+    {
+      pcSliceEncoder->precompressSlice( pcPic );
+      pcSliceEncoder->compressSlice   ( pcPic, false, false );
+
+      const UInt curSliceSegmentEnd = pcSlice->getSliceSegmentCurEndCtuTsAddr();
+      if (curSliceSegmentEnd < numberOfCtusInFrame)
+      {
+        const Bool bNextSegmentIsDependentSlice=curSliceSegmentEnd<pcSlice->getSliceCurEndCtuTsAddr();
+        const UInt sliceBits=pcSlice->getSliceBits();
         {
-          const Bool bNextSegmentIsDependentSlice=curSliceSegmentEnd<pcSlice->getSliceCurEndCtuTsAddr();
-          const UInt sliceBits=pcSlice->getSliceBits();
+          std::lock_guard<std::mutex> listLock( m_picListMutex );
           pcPic->allocateNewSlice();
           // prepare for next slice
-          pcPic->setCurrSliceIdx                    ( uiNumSliceSegments );
-          m_pcSliceEncoder->setSliceIdx             ( uiNumSliceSegments   );
-          pcSlice = pcPic->getSlice                 ( uiNumSliceSegments   );
-          assert(pcSlice->getPPS()!=0);
-          pcSlice->copySliceInfo                    ( pcPic->getSlice(uiNumSliceSegments-1)  );
-          pcSlice->setSliceIdx                      ( uiNumSliceSegments   );
-          if (bNextSegmentIsDependentSlice)
-          {
-            pcSlice->setSliceBits(sliceBits);
-          }
-          else
-          {
-            pcSlice->setSliceCurStartCtuTsAddr      ( curSliceSegmentEnd );
-            pcSlice->setSliceBits(0);
-          }
-          pcSlice->setDependentSliceSegmentFlag(bNextSegmentIsDependentSlice);
-          pcSlice->setSliceSegmentCurStartCtuTsAddr ( curSliceSegmentEnd );
-          // TODO: optimise cabac_init during compress slice to improve multi-slice operation
-          // pcSlice->setEncCABACTableIdx(m_pcSliceEncoder->getEncCABACTableIdx());
-          uiNumSliceSegments ++;
+          pcPic->setCurrSliceIdx                  ( task.numSliceSegments );
         }
-        nextCtuTsAddr = curSliceSegmentEnd;
+        pcSliceEncoder->setSliceIdx               ( task.numSliceSegments   );
+        pcSlice = pcPic->getSlice                 ( task.numSliceSegments   );
+        assert(pcSlice->getPPS()!=0);
+        pcSlice->copySliceInfo                    ( pcPic->getSlice(task.numSliceSegments-1)  );
+        pcSlice->setSliceIdx                      ( task.numSliceSegments   );
+        if (bNextSegmentIsDependentSlice)
+        {
+          pcSlice->setSliceBits(sliceBits);
+        }
+        else
+        {
+          pcSlice->setSliceCurStartCtuTsAddr      ( curSliceSegmentEnd );
+          pcSlice->setSliceBits(0);
+        }
+        pcSlice->setDependentSliceSegmentFlag(bNextSegmentIsDependentSlice);
+        pcSlice->setSliceSegmentCurStartCtuTsAddr ( curSliceSegmentEnd );
+        // TODO: optimise cabac_init during compress slice to improve multi-slice operation
+        // pcSlice->setEncCABACTableIdx(pcSliceEncoder->getEncCABACTableIdx());
+        task.numSliceSegments++;
       }
+      nextCtuTsAddr = curSliceSegmentEnd;
     }
+  }
+
+  if ( task.pcLoopFilterPipeline )
+  {
+    task.pcLoopFilterPipeline->finishPicture( task.numSliceSegments );
+  }
+  task.compressed.set( 1 );
+}
+
+Void TEncGOP::xCompressPictureTask( Void* param, Int threadIdx )
+{
+  PicEncodeTask* pTask = static_cast<PicEncodeTask*>( param );
+  pTask->pcGOPEncoder->xCompressPicture( *pTask );
+}
+
+/** The picture is deblocked and SAO is applied to it, once it has been compressed.
+ */
+Void TEncGOP::xFilterPicture( PicEncodeTask& task )
+{
+  TComPic*   pcPic            = task.pcPic;
+  const Int  iGOPid           = task.iGOPid;
+  const UInt numSliceSegments = task.numSliceSegments;
+  TComSlice* pcSlice          = pcPic->getSlice(0);
 
-    duData.clear();
-    pcSlice = pcPic->getSlice(0);
+  // SAO parameter estimation using non-deblocked pixels for CTU bottom and right boundary areas
+  if( pcSlice->getSPS()->getUseSAO() && m_pcCfg->getSaoCtuBoundary() )
+  {
+    m_pcSAO->getPreDBFStatistics(pcPic);
+  }
 
-    // SAO parameter estimation using non-deblocked pixels for CTU bottom and right boundary areas
-    if( pcSlice->getSPS()->getUseSAO() && m_pcCfg->getSaoCtuBoundary() )
+  //-- Loop filter
+  Bool bLFCrossTileBoundary = pcSlice->getPPS()->getLoopFilterAcrossTilesEnabledFlag();
+  m_pcLoopFilter->setCfg(bLFCrossTileBoundary);
+  if ( m_pcCfg->getDeblockingFilterMetric() )
+  {
+    if ( m_pcCfg->getDeblockingFilterMetric()==2 )
     {
-      m_pcSAO->getPreDBFStatistics(pcPic);
+      applyDeblockingFilterParameterSelection(pcPic, numSliceSegments, iGOPid);
     }
-
-    //-- Loop filter
-    Bool bLFCrossTileBoundary = pcSlice->getPPS()->getLoopFilterAcrossTilesEnabledFlag();
-    m_pcLoopFilter->setCfg(bLFCrossTileBoundary);
-    if ( m_pcCfg->getDeblockingFilterMetric() )
+    else
     {
-      if ( m_pcCfg->getDeblockingFilterMetric()==2 )
-      {
-        applyDeblockingFilterParameterSelection(pcPic, uiNumSliceSegments, iGOPid);
-      }
-      else
-      {
-        applyDeblockingFilterMetric(pcPic, uiNumSliceSegments);
-      }
+      applyDeblockingFilterMetric(pcPic, numSliceSegments);
     }
-    m_pcLoopFilter->loopFilterPic( pcPic );
+  }
+  m_pcLoopFilter->loopFilterPic( pcPic );
 
-    /////////////////////////////////////////////////////////////////////////////////////////////////// File writing
-    // Set entropy coder
-    m_pcEntropyCoder->setEntropyCoder   ( m_pcCavlcCoder );
+  if (pcSlice->getSPS()->getUseSAO())
+  {
+    Bool sliceEnabled[MAX_NUM_COMPONENT];
+    TComBitCounter tempBitCounter;
+    tempBitCounter.resetBits();
+    m_pcEncTop->getRDGoOnSbacCoder()->setBitstream(&tempBitCounter);
+    m_pcSAO->initRDOCabacCoder(m_pcEncTop->getRDGoOnSbacCoder(), pcSlice);
+    m_pcSAO->SAOProcess(pcPic, sliceEnabled, pcPic->getSlice(0)->getLambdas(),
+                        m_pcCfg->getTestSAODisableAtPictureLevel(),
+                        m_pcCfg->getSaoEncodingRate(),
+                        m_pcCfg->getSaoEncodingRateChroma(),
+                        m_pcCfg->getSaoCtuBoundary(),
+                        m_pcCfg->getSaoResetEncoderStateAfterIRAP());
+    m_pcSAO->PCMLFDisableProcess(pcPic);
+    m_pcEncTop->getRDGoOnSbacCoder()->setBitstream(NULL);
 
-    // write various parameter sets
-#if JCTVC_Y0038_PARAMS
-    //bool writePS = m_bSeqFirst || (m_pcCfg->getReWriteParamSetsFlag() && (pcPic->getSlice(0)->getSliceType() == I_SLICE));
-    bool writePS = m_bSeqFirst || (m_pcCfg->getReWriteParamSetsFlag() && (pcSlice->isIRAP()));
-    if (writePS)
+    //assign SAO slice header
+    for(Int s=0; s< numSliceSegments; s++)
     {
-      m_pcEncTop->setParamSetChanged(pcSlice->getSPS()->getSPSId(), pcSlice->getPPS()->getPPSId());
+      pcPic->getSlice(s)->setSaoEnabledFlag(CHANNEL_TYPE_LUMA, sliceEnabled[COMPONENT_Y]);
+      assert(sliceEnabled[COMPONENT_Cb] == sliceEnabled[COMPONENT_Cr]);
+      pcPic->getSlice(s)->setSaoEnabledFlag(CHANNEL_TYPE_CHROMA, sliceEnabled[COMPONENT_Cb]);
     }
-    actualTotalBits += xWriteParameterSets(accessUnit, pcSlice, writePS);
-
-    if (writePS)
-#else
-    actualTotalBits += xWriteParameterSets(accessUnit, pcSlice, m_bSeqFirst);
+  }
+}
 
-    if ( m_bSeqFirst )
-#endif
-    {
-      // create prefix SEI messages at the beginning of the sequence
-      assert(leadingSeiMessages.empty());
-      xCreateIRAPLeadingSEIMessages(leadingSeiMessages, pcSlice->getSPS(), pcSlice->getPPS());
+/** The picture is loop filtered and its access unit is written once it has been compressed.
+    Pictures are written in coding order; the picture list is unlocked while waiting for the compression.
+ */
+Void TEncGOP::xFilterAndWritePicture( PicEncodeTask& task, GOPWriteContext& ctx, std::unique_lock<std::mutex>& lock )
+{
+  lock.unlock();
+  task.compressed.waitFor( 1 );
+  lock.lock();
 
-      m_bSeqFirst = false;
-    }
-    if (m_pcCfg->getAccessUnitDelimiter())
-    {
-      xWriteAccessUnitDelimiter(accessUnit, pcSlice);
-    }
+  TComPic*             pcPic                = task.pcPic;
+  TEncSlice*           pcSliceEncoder       = task.pcSliceEncoder;
+  AccessUnit&          accessUnit           = *task.pcAccessUnit;
+  const Int            iGOPid               = task.iGOPid;
+  SEIMessages&         leadingSeiMessages   = ctx.leadingSeiMessages;
+  SEIMessages&         nestedSeiMessages    = ctx.nestedSeiMessages;
+  SEIMessages&         duInfoSeiMessages    = ctx.duInfoSeiMessages;
+  SEIMessages&         trailingSeiMessages  = ctx.trailingSeiMessages;
+  std::deque<DUData>&  duData               = ctx.duData;
+  TComSlice*           pcSlice              = pcPic->getSlice(0);
 
-    // reset presence of BP SEI indication
-    m_bufferingPeriodSEIPresentInAU = false;
-    // create prefix SEI associated with a picture
-    xCreatePerPictureSEIMessages(iGOPid, leadingSeiMessages, nestedSeiMessages, pcSlice);
+  Int actualHeadBits       = 0;
+  Int actualTotalBits      = 0;
+  Int tmpBitsBeforeWriting = 0;
 
-    /* use the main bitstream buffer for storing the marshalled picture */
-    m_pcEntropyCoder->setBitstream(NULL);
+  // Allocate some coders, now the number of tiles are known.
+  const Int numSubstreamsColumns = (pcSlice->getPPS()->getNumTileColumnsMinus1() + 1);
+  const Int numSubstreamRows     = pcSlice->getPPS()->getEntropyCodingSyncEnabledFlag() ? pcPic->getFrameHeightInCtus() : (pcSlice->getPPS()->getNumTileRowsMinus1() + 1);
+  const Int numSubstreams        = numSubstreamRows * numSubstreamsColumns;
+  std::vector<TComOutputBitstream> substreamsOut(numSubstreams);
 
-    pcSlice = pcPic->getSlice(0);
+  duData.clear();
+  pcSlice = pcPic->getSlice(0);
 
-    if (pcSlice->getSPS()->getUseSAO())
-    {
-      Bool sliceEnabled[MAX_NUM_COMPONENT];
-      TComBitCounter tempBitCounter;
-      tempBitCounter.resetBits();
-      m_pcEncTop->getRDGoOnSbacCoder()->setBitstream(&tempBitCounter);
-      m_pcSAO->initRDOCabacCoder(m_pcEncTop->getRDGoOnSbacCoder(), pcSlice);
-      m_pcSAO->SAOProcess(pcPic, sliceEnabled, pcPic->getSlice(0)->getLambdas(),
-                          m_pcCfg->getTestSAODisableAtPictureLevel(),
-                          m_pcCfg->getSaoEncodingRate(),
-                          m_pcCfg->getSaoEncodingRateChroma(),
-                          m_pcCfg->getSaoCtuBoundary(),
-                          m_pcCfg->getSaoResetEncoderStateAfterIRAP());
-      m_pcSAO->PCMLFDisableProcess(pcPic);
-      m_pcEncTop->getRDGoOnSbacCoder()->setBitstream(NULL);
+  // the first slice is written with the cabac_init table it has been compressed with
+  pcSliceEncoder->setEncCABACTableIdx( pcSlice->getEncCABACTableIdx() );
 
-      //assign SAO slice header
-      for(Int s=0; s< uiNumSliceSegments; s++)
-      {
-        pcPic->getSlice(s)->setSaoEnabledFlag(CHANNEL_TYPE_LUMA, sliceEnabled[COMPONENT_Y]);
-        assert(sliceEnabled[COMPONENT_Cb] == sliceEnabled[COMPONENT_Cr]);
-        pcPic->getSlice(s)->setSaoEnabledFlag(CHANNEL_TYPE_CHROMA, sliceEnabled[COMPONENT_Cb]);
-      }
-    }
+  if ( !task.pcLoopFilterPipeline )
+  {
+    xFilterPicture( task );
+  }
 
-    // pcSlice is currently slice 0.
-    std::size_t binCountsInNalUnits   = 0; // For implementation of cabac_zero_word stuffing (section 7.4.3.10)
-    std::size_t numBytesInVclNalUnits = 0; // For implementation of cabac_zero_word stuffing (section 7.4.3.10)
+  /////////////////////////////////////////////////////////////////////////////////////////////////// File writing
+  // Set entropy coder
+  m_pcEntropyCoder->setEntropyCoder   ( m_pcCavlcCoder );
 
-    for( UInt sliceSegmentStartCtuTsAddr = 0, sliceIdxCount=0; sliceSegmentStartCtuTsAddr < pcPic->getPicSym()->getNumberOfCtusInFrame(); sliceIdxCount++, sliceSegmentStartCtuTsAddr=pcSlice->getSliceSegmentCurEndCtuTsAddr() )
-    {
-      pcSlice = pcPic->getSlice(sliceIdxCount);
-      if(sliceIdxCount > 0 && pcSlice->getSliceType()!= I_SLICE)
-      {
-        pcSlice->checkColRefIdx(sliceIdxCount, pcPic);
-      }
-      pcPic->setCurrSliceIdx(sliceIdxCount);
-      m_pcSliceEncoder->setSliceIdx(sliceIdxCount);
+  // write various parameter sets
+#if JCTVC_Y0038_PARAMS
+  //bool writePS = m_bSeqFirst || (m_pcCfg->getReWriteParamSetsFlag() && (pcPic->getSlice(0)->getSliceType() == I_SLICE));
+  bool writePS = m_bSeqFirst || (m_pcCfg->getReWriteParamSetsFlag() && (pcSlice->isIRAP()));
+  if (writePS)
+  {
+    m_pcEncTop->setParamSetChanged(pcSlice->getSPS()->getSPSId(), pcSlice->getPPS()->getPPSId());
+  }
+  actualTotalBits += xWriteParameterSets(accessUnit, pcSlice, writePS);
 
-      pcSlice->setRPS(pcPic->getSlice(0)->getRPS());
-      pcSlice->setRPSidx(pcPic->getSlice(0)->getRPSidx());
+  if (writePS)
+#else
+  actualTotalBits += xWriteParameterSets(accessUnit, pcSlice, m_bSeqFirst);
 
-      for ( UInt ui = 0 ; ui < numSubstreams; ui++ )
-      {
-        substreamsOut[ui].clear();
-      }
+  if ( m_bSeqFirst )
+#endif
+  {
+    // create prefix SEI messages at the beginning of the sequence
+    assert(leadingSeiMessages.empty());
+    xCreateIRAPLeadingSEIMessages(leadingSeiMessages, pcSlice->getSPS(), pcSlice->getPPS());
 
-      m_pcEntropyCoder->setEntropyCoder   ( m_pcCavlcCoder );
-      m_pcEntropyCoder->resetEntropy      ( pcSlice );
-      /* start slice NALunit */
-      OutputNALUnit nalu( pcSlice->getNalUnitType(), pcSlice->getTLayer() );
-      m_pcEntropyCoder->setBitstream(&nalu.m_Bitstream);
+    m_bSeqFirst = false;
+  }
+  if (m_pcCfg->getAccessUnitDelimiter())
+  {
+    xWriteAccessUnitDelimiter(accessUnit, pcSlice);
+  }
 
-      pcSlice->setNoRaslOutputFlag(false);
-      if (pcSlice->isIRAP())
-      {
-        if (pcSlice->getNalUnitType() >= NAL_UNIT_CODED_SLICE_BLA_W_LP && pcSlice->getNalUnitType() <= NAL_UNIT_CODED_SLICE_IDR_N_LP)
-        {
-          pcSlice->setNoRaslOutputFlag(true);
-        }
-        //the inference for NoOutputPriorPicsFlag
-        // KJS: This cannot happen at the encoder
-        if (!m_bFirst && pcSlice->isIRAP() && pcSlice->getNoRaslOutputFlag())
-        {
-          if (pcSlice->getNalUnitType() == NAL_UNIT_CODED_SLICE_CRA)
-          {
-            pcSlice->setNoOutputPriorPicsFlag(true);
-          }
-        }
-      }
+  // reset presence of BP SEI indication
+  m_bufferingPeriodSEIPresentInAU = false;
+  // create prefix SEI associated with a picture
+  xCreatePerPictureSEIMessages(iGOPid, leadingSeiMessages, nestedSeiMessages, pcSlice);
 
-      pcSlice->setEncCABACTableIdx(m_pcSliceEncoder->getEncCABACTableIdx());
+  /* use the main bitstream buffer for storing the marshalled picture */
+  m_pcEntropyCoder->setBitstream(NULL);
 
-      tmpBitsBeforeWriting = m_pcEntropyCoder->getNumberOfWrittenBits();
-      m_pcEntropyCoder->encodeSliceHeader(pcSlice);
-      actualHeadBits += ( m_pcEntropyCoder->getNumberOfWrittenBits() - tmpBitsBeforeWriting );
+  pcSlice = pcPic->getSlice(0);
 
-      pcSlice->setFinalized(true);
+  // pcSlice is currently slice 0.
+  std::size_t binCountsInNalUnits   = 0; // For implementation of cabac_zero_word stuffing (section 7.4.3.10)
+  std::size_t numBytesInVclNalUnits = 0; // For implementation of cabac_zero_word stuffing (section 7.4.3.10)
 
-      pcSlice->clearSubstreamSizes(  );
-      {
-        UInt numBinsCoded = 0;
-        m_pcSliceEncoder->encodeSlice(pcPic, &(substreamsOut[0]), numBinsCoded);
-        binCountsInNalUnits+=numBinsCoded;
-      }
+  for( UInt sliceSegmentStartCtuTsAddr = 0, sliceIdxCount=0; sliceSegmentStartCtuTsAddr < pcPic->getPicSym()->getNumberOfCtusInFrame(); sliceIdxCount++, sliceSegmentStartCtuTsAddr=pcSlice->getSliceSegmentCurEndCtuTsAddr() )
+  {
+    pcSlice = pcPic->getSlice(sliceIdxCount);
+    if(sliceIdxCount > 0 && pcSlice->getSliceType()!= I_SLICE)
+    {
+      pcSlice->checkColRefIdx(sliceIdxCount, pcPic);
+    }
+    pcPic->setCurrSliceIdx(sliceIdxCount);
+    pcSliceEncoder->setSliceIdx(sliceIdxCount);
 
-      {
-        // Construct the final bitstream by concatenating substreams.
-        // The final bitstream is either nalu.m_Bitstream or pcBitstreamRedirect;
-        // Complete the slice header info.
-        m_pcEntropyCoder->setEntropyCoder   ( m_pcCavlcCoder );
-        m_pcEntropyCoder->setBitstream(&nalu.m_Bitstream);
-        m_pcEntropyCoder->encodeTilesWPPEntryPoint( pcSlice );
+    pcSlice->setRPS(pcPic->getSlice(0)->getRPS());
+    pcSlice->setRPSidx(pcPic->getSlice(0)->getRPSidx());
 
-        // Append substreams...
-        TComOutputBitstream *pcOut = pcBitstreamRedirect;
-        const Int numZeroSubstreamsAtStartOfSlice  = pcPic->getSubstreamForCtuAddr(pcSlice->getSliceSegmentCurStartCtuTsAddr(), false, pcSlice);
-        const Int numSubstreamsToCode  = pcSlice->getNumberOfSubstreamSizes()+1;
-        for ( UInt ui = 0 ; ui < numSubstreamsToCode; ui++ )
-        {
-          pcOut->addSubstream(&(substreamsOut[ui+numZeroSubstreamsAtStartOfSlice]));
-        }
-      }
+    for ( UInt ui = 0 ; ui < numSubstreams; ui++ )
+    {
+      substreamsOut[ui].clear();
+    }
 
-      // If current NALU is the first NALU of slice (containing slice header) and more NALUs exist (due to multiple dependent slices) then buffer it.
-      // If current NALU is the last NALU of slice and a NALU was buffered, then (a) Write current NALU (b) Update an write buffered NALU at approproate location in NALU list.
-      Bool bNALUAlignedWrittenToList    = false; // used to ensure current NALU is not written more than once to the NALU list.
-      xAttachSliceDataToNalUnit(nalu, pcBitstreamRedirect);
-      accessUnit.push_back(new NALUnitEBSP(nalu));
-      actualTotalBits += UInt(accessUnit.back()->m_nalUnitData.str().size()) * 8;
-      numBytesInVclNalUnits += (std::size_t)(accessUnit.back()->m_nalUnitData.str().size());
-      bNALUAlignedWrittenToList = true;
+    m_pcEntropyCoder->setEntropyCoder   ( m_pcCavlcCoder );
+    m_pcEntropyCoder->resetEntropy      ( pcSlice );
+    /* start slice NALunit */
+    OutputNALUnit nalu( pcSlice->getNalUnitType(), pcSlice->getTLayer() );
+    m_pcEntropyCoder->setBitstream(&nalu.m_Bitstream);
 
-      if (!bNALUAlignedWrittenToList)
+    pcSlice->setNoRaslOutputFlag(false);
+    if (pcSlice->isIRAP())
+    {
+      if (pcSlice->getNalUnitType() >= NAL_UNIT_CODED_SLICE_BLA_W_LP && pcSlice->getNalUnitType() <= NAL_UNIT_CODED_SLICE_IDR_N_LP)
       {
-        nalu.m_Bitstream.writeAlignZero();
-        accessUnit.push_back(new NALUnitEBSP(nalu));
+        pcSlice->setNoRaslOutputFlag(true);
       }
-
-      if( ( m_pcCfg->getPictureTimingSEIEnabled() || m_pcCfg->getDecodingUnitInfoSEIEnabled() ) &&
-          ( pcSlice->getSPS()->getVuiParametersPresentFlag() ) &&
-          ( ( pcSlice->getSPS()->getVuiParameters()->getHrdParameters()->getNalHrdParametersPresentFlag() )
-         || ( pcSlice->getSPS()->getVuiParameters()->getHrdParameters()->getVclHrdParametersPresentFlag() ) ) &&
-          ( pcSlice->getSPS()->getVuiParameters()->getHrdParameters()->getSubPicCpbParamsPresentFlag() ) )
+      //the inference for NoOutputPriorPicsFlag
+      // KJS: This cannot happen at the encoder
+      if (!m_bFirst && pcSlice->isIRAP() && pcSlice->getNoRaslOutputFlag())
       {
-          UInt numNalus = 0;
-        UInt numRBSPBytes = 0;
-        for (AccessUnit::const_iterator it = accessUnit.begin(); it != accessUnit.end(); it++)
+        if (pcSlice->getNalUnitType() == NAL_UNIT_CODED_SLICE_CRA)
         {
-          numRBSPBytes += UInt((*it)->m_nalUnitData.str().size());
-          numNalus ++;
+          pcSlice->setNoOutputPriorPicsFlag(true);
         }
-        duData.push_back(DUData());
-        duData.back().accumBitsDU = ( numRBSPBytes << 3 );
-        duData.back().accumNalsDU = numNalus;
       }
-    } // end iteration over slices
+    }
 
-    // cabac_zero_words processing
-    cabac_zero_word_padding(pcSlice, pcPic, binCountsInNalUnits, numBytesInVclNalUnits, accessUnit.back()->m_nalUnitData, m_pcCfg->getCabacZeroWordPaddingEnabled());
+    pcSlice->setEncCABACTableIdx(pcSliceEncoder->getEncCABACTableIdx());
 
-    pcPic->compressMotion();
+    tmpBitsBeforeWriting = m_pcEntropyCoder->getNumberOfWrittenBits();
+    m_pcEntropyCoder->encodeSliceHeader(pcSlice);
+    actualHeadBits += ( m_pcEntropyCoder->getNumberOfWrittenBits() - tmpBitsBeforeWriting );
 
-    //-- For time output for each slice
-    Double dEncTime = (Double)(clock()-iBeforeTime) / CLOCKS_PER_SEC;
+    pcSlice->setFinalized(true);
 
-    std::string digestStr;
-    if (m_pcCfg->getDecodedPictureHashSEIType()!=HASHTYPE_NONE)
+    pcSlice->clearSubstreamSizes(  );
     {
-      SEIDecodedPictureHash *decodedPictureHashSei = new SEIDecodedPictureHash();
-      m_seiEncoder.initDecodedPictureHashSEI(decodedPictureHashSei, pcPic, digestStr, pcSlice->getSPS()->getBitDepths());
-      trailingSeiMessages.push_back(decodedPictureHashSei);
+      UInt numBinsCoded = 0;
+      pcSliceEncoder->encodeSlice(pcPic, &(substreamsOut[0]), numBinsCoded);
+      binCountsInNalUnits+=numBinsCoded;
     }
 
-    m_pcCfg->setEncodedFlag(iGOPid, true);
-
-    Double PSNR_Y;
-    xCalculateAddPSNRs( isField, isTff, iGOPid, pcPic, accessUnit, rcListPic, dEncTime, snr_conversion, printFrameMSE, &PSNR_Y );
-    
-    // Only produce the Green Metadata SEI message with the last picture.
-    if( m_pcCfg->getSEIGreenMetadataInfoSEIEnable() && pcSlice->getPOC() == ( m_pcCfg->getFramesToBeEncoded() - 1 )  )
     {
-      SEIGreenMetadataInfo *seiGreenMetadataInfo = new SEIGreenMetadataInfo;
-      m_seiEncoder.initSEIGreenMetadataInfo(seiGreenMetadataInfo, (UInt)(PSNR_Y * 100 + 0.5));
-      trailingSeiMessages.push_back(seiGreenMetadataInfo);
+      // Complete the slice header info.
+      m_pcEntropyCoder->setEntropyCoder   ( m_pcCavlcCoder );
+      m_pcEntropyCoder->setBitstream(&nalu.m_Bitstream);
+      m_pcEntropyCoder->encodeTilesWPPEntryPoint( pcSlice );
     }
-    
-    xWriteTrailingSEIMessages(trailingSeiMessages, accessUnit, pcSlice->getTLayer(), pcSlice->getSPS());
-    
-    printHash(m_pcCfg->getDecodedPictureHashSEIType(), digestStr);
 
-    if ( m_pcCfg->getUseRateCtrl() )
+    // If current NALU is the first NALU of slice (containing slice header) and more NALUs exist (due to multiple dependent slices) then buffer it.
+    // If current NALU is the last NALU of slice and a NALU was buffered, then (a) Write current NALU (b) Update an write buffered NALU at approproate location in NALU list.
+    Bool bNALUAlignedWrittenToList    = false; // used to ensure current NALU is not written more than once to the NALU list.
     {
-      Double avgQP     = m_pcRateCtrl->getRCPic()->calAverageQP();
-      Double avgLambda = m_pcRateCtrl->getRCPic()->calAverageLambda();
-      if ( avgLambda < 0.0 )
-      {
-        avgLambda = lambda;
-      }
+      // Construct the final bitstream by appending the substreams to the slice header.
+      const Int numZeroSubstreamsAtStartOfSlice  = pcPic->getSubstreamForCtuAddr(pcSlice->getSliceSegmentCurStartCtuTsAddr(), false, pcSlice);
+      const Int numSubstreamsToCode  = pcSlice->getNumberOfSubstreamSizes()+1;
+      xAttachSliceDataToNalUnit(nalu, &(substreamsOut[numZeroSubstreamsAtStartOfSlice]), numSubstreamsToCode);
+    }
+    accessUnit.push_back(new NALUnitEBSP(nalu));
+    actualTotalBits += UInt(accessUnit.back()->m_nalUnitData.str().size()) * 8;
+    numBytesInVclNalUnits += (std::size_t)(accessUnit.back()->m_nalUnitData.str().size());
+    bNALUAlignedWrittenToList = true;
 
-      m_pcRateCtrl->getRCPic()->updateAfterPicture( actualHeadBits, actualTotalBits, avgQP, avgLambda, pcSlice->getSliceType());
-      m_pcRateCtrl->getRCPic()->addToPictureLsit( m_pcRateCtrl->getPicList() );
+    if (!bNALUAlignedWrittenToList)
+    {
+      nalu.m_Bitstream.writeAlignZero();
+      accessUnit.push_back(new NALUnitEBSP(nalu));
+    }
 
-      m_pcRateCtrl->getRCSeq()->updateAfterPic( actualTotalBits );
-      if ( pcSlice->getSliceType() != I_SLICE )
-      {
-        m_pcRateCtrl->getRCGOP()->updateAfterPicture( actualTotalBits );
-      }
-      else    // for intra picture, the estimated bits are used to update the current status in the GOP
-      {
-        m_pcRateCtrl->getRCGOP()->updateAfterPicture( estimatedBits );
-      }
-      if (m_pcRateCtrl->getCpbSaturationEnabled())
+    if( ( m_pcCfg->getPictureTimingSEIEnabled() || m_pcCfg->getDecodingUnitInfoSEIEnabled() ) &&
+        ( pcSlice->getSPS()->getVuiParametersPresentFlag() ) &&
+        ( ( pcSlice->getSPS()->getVuiParameters()->getHrdParameters()->getNalHrdParametersPresentFlag() )
+       || ( pcSlice->getSPS()->getVuiParameters()->getHrdParameters()->getVclHrdParametersPresentFlag() ) ) &&
+        ( pcSlice->getSPS()->getVuiParameters()->getHrdParameters()->getSubPicCpbParamsPresentFlag() ) )
+    {
+        UInt numNalus = 0;
+      UInt numRBSPBytes = 0;
+      for (AccessUnit::const_iterator it = accessUnit.begin(); it != accessUnit.end(); it++)
       {
-        m_pcRateCtrl->updateCpbState(actualTotalBits);
-        printf(" [CPB %6d bits]", m_pcRateCtrl->getCpbState());
+        numRBSPBytes += UInt((*it)->m_nalUnitData.str().size());
+        numNalus ++;
       }
+      duData.push_back(DUData());
+      duData.back().accumBitsDU = ( numRBSPBytes << 3 );
+      duData.back().accumNalsDU = numNalus;
     }
+  } // end iteration over slices
+  m_encCABACTableIdx = pcSliceEncoder->getEncCABACTableIdx();
 
-    xCreatePictureTimingSEI(m_pcCfg->getEfficientFieldIRAPEnabled()?effFieldIRAPMap.GetIRAPGOPid():0, leadingSeiMessages, nestedSeiMessages, duInfoSeiMessages, pcSlice, isField, duData);
-    if (m_pcCfg->getScalableNestingSEIEnabled())
-    {
-      xCreateScalableNestingSEI (leadingSeiMessages, nestedSeiMessages);
-    }
-    xWriteLeadingSEIMessages(leadingSeiMessages, duInfoSeiMessages, accessUnit, pcSlice->getTLayer(), pcSlice->getSPS(), duData);
-    xWriteDuSEIMessages(duInfoSeiMessages, accessUnit, pcSlice->getTLayer(), pcSlice->getSPS(), duData);
+  // cabac_zero_words processing
+  cabac_zero_word_padding(pcSlice, pcPic, binCountsInNalUnits, numBytesInVclNalUnits, accessUnit.back()->m_nalUnitData, m_pcCfg->getCabacZeroWordPaddingEnabled());
 
-    pcPic->getPicYuvRec()->copyToPic(pcPicYuvRecOut);
+  if ( !task.pcLoopFilterPipeline )
+  {
+    pcPic->compressMotion();
 
-    pcPic->setReconMark   ( true );
-    m_bFirst = false;
-    m_iNumPicCoded++;
-    m_totalCoded ++;
-    /* logging: insert a newline at end of picture period */
-    printf("\n");
-    fflush(stdout);
+    // the picture is final: pictures referencing it can be compressed
+    pcPic->setReconRowProgress( pcPic->getFrameHeightInCtus() );
+  }
 
-    if (m_pcCfg->getEfficientFieldIRAPEnabled())
+  //-- For time output for each slice
+  Double dEncTime = (Double)(clock()-task.iBeforeTime) / CLOCKS_PER_SEC;
+
+  std::string digestStr;
+  if (m_pcCfg->getDecodedPictureHashSEIType()!=HASHTYPE_NONE)
+  {
+    SEIDecodedPictureHash *decodedPictureHashSei = new SEIDecodedPictureHash();
+    m_seiEncoder.initDecodedPictureHashSEI(decodedPictureHashSei, pcPic, digestStr, pcSlice->getSPS()->getBitDepths());
+    trailingSeiMessages.push_back(decodedPictureHashSei);
+  }
+
+  m_pcCfg->setEncodedFlag(iGOPid, true);
+
+  Double PSNR_Y;
+  xCalculateAddPSNRs( ctx.isField, ctx.isTff, iGOPid, pcPic, accessUnit, *ctx.pcListPic, dEncTime, ctx.snrConversion, ctx.printFrameMSE, &PSNR_Y );
+  
+  // Only produce the Green Metadata SEI message with the last picture.
+  if( m_pcCfg->getSEIGreenMetadataInfoSEIEnable() && pcSlice->getPOC() == ( m_pcCfg->getFramesToBeEncoded() - 1 )  )
+  {
+    SEIGreenMetadataInfo *seiGreenMetadataInfo = new SEIGreenMetadataInfo;
+    m_seiEncoder.initSEIGreenMetadataInfo(seiGreenMetadataInfo, (UInt)(PSNR_Y * 100 + 0.5));
+    trailingSeiMessages.push_back(seiGreenMetadataInfo);
+  }
+  
+  xWriteTrailingSEIMessages(trailingSeiMessages, accessUnit, pcSlice->getTLayer(), pcSlice->getSPS());
+  
+  printHash(m_pcCfg->getDecodedPictureHashSEIType(), digestStr);
+
+  if ( m_pcCfg->getUseRateCtrl() )
+  {
+    Double avgQP     = m_pcRateCtrl->getRCPic()->calAverageQP();
+    Double avgLambda = m_pcRateCtrl->getRCPic()->calAverageLambda();
+    if ( avgLambda < 0.0 )
     {
-      iGOPid=effFieldIRAPMap.restoreGOPid(iGOPid);
+      avgLambda = task.lambda;
     }
-#if REDUCED_ENCODER_MEMORY
 
-    pcPic->releaseReconstructionIntermediateData();
-    if (!isField) // don't release the source data for field-coding because the fields are dealt with in pairs. // TODO: release source data for interlace simulations.
+    m_pcRateCtrl->getRCPic()->updateAfterPicture( actualHeadBits, actualTotalBits, avgQP, avgLambda, pcSlice->getSliceType());
+    m_pcRateCtrl->getRCPic()->addToPictureLsit( m_pcRateCtrl->getPicList() );
+
+    m_pcRateCtrl->getRCSeq()->updateAfterPic( actualTotalBits );
+    if ( pcSlice->getSliceType() != I_SLICE )
+    {
+      m_pcRateCtrl->getRCGOP()->updateAfterPicture( actualTotalBits );
+    }
+    else    // for intra picture, the estimated bits are used to update the current status in the GOP
+    {
+      m_pcRateCtrl->getRCGOP()->updateAfterPicture( task.estimatedBits );
+    }
+    if (m_pcRateCtrl->getCpbSaturationEnabled())
     {
-      pcPic->releaseEncoderSourceImageData();
+      m_pcRateCtrl->updateCpbState(actualTotalBits);
+      printf(" [CPB %6d bits]", m_pcRateCtrl->getCpbState());
     }
+  }
 
-#endif
-  } // iGOPid-loop
+  xCreatePictureTimingSEI(ctx.IRAPGOPid, leadingSeiMessages, nestedSeiMessages, duInfoSeiMessages, pcSlice, ctx.isField, duData);
+  if (m_pcCfg->getScalableNestingSEIEnabled())
+  {
+    xCreateScalableNestingSEI (leadingSeiMessages, nestedSeiMessages);
+  }
+  xWriteLeadingSEIMessages(leadingSeiMessages, duInfoSeiMessages, accessUnit, pcSlice->getTLayer(), pcSlice->getSPS(), duData);
+  xWriteDuSEIMessages(duInfoSeiMessages, accessUnit, pcSlice->getTLayer(), pcSlice->getSPS(), duData);
 
-  delete pcBitstreamRedirect;
+  pcPic->getPicYuvRec()->copyToPic(task.pcPicYuvRecOut);
 
-  assert ( (m_iNumPicCoded == iNumPicRcvd) );
+  pcPic->setReconMark   ( true );
+  m_bFirst = false;
+  m_iNumPicCoded++;
+  m_totalCoded ++;
+  if ( m_pcCfg->getProfiling() )
+  {
+    printf(" ");
+    TComProfiler::printSelfTimes( m_profilingLog.addPicture( pcSlice->getPOC() ) );
+  }
+  /* logging: insert a newline at end of picture period */
+  printf("\n");
+  fflush(stdout);
+
+#if REDUCED_ENCODER_MEMORY
+
+  pcPic->releaseReconstructionIntermediateData();
+  if (!ctx.isField) // don't release the source data for field-coding because the fields are dealt with in pairs. // TODO: release source data for interlace simulations.
+  {
+    pcPic->releaseEncoderSourceImageData();
+  }
+
+#endif
 }
 
 Void TEncGOP::printOutSummary(UInt uiNumAllPicCoded, Bool isField, const Bool printMSEBasedSNR, const Bool printSequenceMSE, const BitDepths &bitDepths)
@@ -1948,6 +2165,18 @@ Void TEncGOP::printOutSummary(UInt uiNumAllPicCoded, Bool isField, const Bool pr
   }
 
   printf("\nRVM: %.3lf\n" , xCalculateRVM());
+
+  if (m_pcCfg->getProfiling())
+  {
+    TComProfilingCounters profilingCounters;
+    m_profilingLog.getTotal(profilingCounters);
+    TComProfiler::printSummary(profilingCounters, m_profilingLog.getNumPictures());
+
+    if (!m_pcCfg->getProfilingFileName().empty() && !m_profilingLog.writeJSON(m_pcCfg->getProfilingFileName()))
+    {
+      fprintf(stderr, "\nUnable to write the profiling file %s\n", m_pcCfg->getProfilingFileName().c_str());
+    }
+  }
 }
 
 Void TEncGOP::preLoopFilterPicAll( TComPic* pcPic, UInt64& ruiDist )
@@ -2015,9 +2244,9 @@ Void TEncGOP::xGetBuffer( TComList<TComPic*>&      rcListPic,
   while (iterPic != rcListPic.end())
   {
     rpcPic = *(iterPic);
-    rpcPic->setCurrSliceIdx(0);
     if (rpcPic->getPOC() == pocCurr)
     {
+      rpcPic->setCurrSliceIdx(0);
       break;
     }
     iterPic++;
@@ -2479,25 +2708,28 @@ Double TEncGOP::xCalculateRVM()
   return( dRVM );
 }
 
-/** Attaches the input bitstream to the stream in the output NAL unit
-    Updates rNalu to contain concatenated bitstream. rpcBitstreamRedirect is cleared at the end of this function call.
- *  \param codedSliceData contains the coded slice data (bitstream) to be concatenated to rNalu
+/** Attaches the coded slice data to the stream in the output NAL unit
+    Updates rNalu to contain concatenated bitstream. The substreams are cleared at the end of this function call.
  *  \param rNalu          target NAL unit
+ *  \param substreams     substreams of the coded slice data, which are appended to the byte-aligned slice header
+ *  \param numSubstreams  number of substreams
  */
-Void TEncGOP::xAttachSliceDataToNalUnit (OutputNALUnit& rNalu, TComOutputBitstream* codedSliceData)
+Void TEncGOP::xAttachSliceDataToNalUnit (OutputNALUnit& rNalu, TComOutputBitstream* substreams, UInt numSubstreams)
 {
   // Byte-align
   rNalu.m_Bitstream.writeByteAlignment();   // Slice header byte-alignment
 
   // Perform bitstream concatenation
-  if (codedSliceData->getNumberOfWrittenBits() > 0)
+  for (UInt ui = 0; ui < numSubstreams; ui++)
   {
-    rNalu.m_Bitstream.addSubstream(codedSliceData);
+    if (substreams[ui].getNumberOfWrittenBits() > 0)
+    {
+      rNalu.m_Bitstream.addSubstream(&substreams[ui]);
+    }
+    substreams[ui].clear();
   }
 
   m_pcEntropyCoder->setBitstream(&rNalu.m_Bitstream);
-
-  codedSliceData->clear();
 }
 
 // Function will arrange the long-term pictures in the decreasing order of poc_lsb_lt,
@@ -41,14 +41,18 @@
 #include <list>
 
 #include <stdlib.h>
+#include <time.h>
 
 #include "TLibCommon/TComList.h"
 #include "TLibCommon/TComPic.h"
+#include "TLibCommon/TComThreadPool.h"
 #include "TLibCommon/TComBitCounter.h"
 #include "TLibCommon/TComLoopFilter.h"
 #include "TLibCommon/AccessUnit.h"
+#include "TLibCommon/TComProfiler.h"
 #include "TEncSampleAdaptiveOffset.h"
 #include "TEncSlice.h"
+#include "TEncLoopFilterPipeline.h"
 #include "TEncEntropy.h"
 #include "TEncCavlc.h"
 #include "TEncSbac.h"
@@ -84,6 +88,39 @@ class TEncGOP
     Int accumNalsDU;
   };
 
+  /// picture of the GOP between its preparation and the writing of its access unit
+  struct PicEncodeTask
+  {
+    TEncGOP*                pcGOPEncoder;
+    TEncSlice*              pcSliceEncoder;               ///< slice encoder compressing the picture
+    TEncLoopFilterPipeline* pcLoopFilterPipeline;         ///< loop filter of the CTU rows as they are compressed (NULL if filtered when written)
+    TComPic*                pcPic;
+    TComPicYuv*             pcPicYuvRecOut;
+    AccessUnit*             pcAccessUnit;
+    Int                     iGOPid;
+    clock_t                 iBeforeTime;
+    Double                  lambda;                       ///< picture lambda selected by the rate control
+    Int                     estimatedBits;                ///< target bits of the rate control
+    UInt                    numSliceSegments;
+    TComProgressCounter     compressed;                   ///< set to 1 when all slice segments of the picture are compressed
+  };
+
+  /// state shared by the pictures of a GOP while their access units are written
+  struct GOPWriteContext
+  {
+    TComList<TComPic*>*        pcListPic;
+    Bool                       isField;
+    Bool                       isTff;
+    InputColourSpaceConversion snrConversion;
+    Bool                       printFrameMSE;
+    Int                        IRAPGOPid;
+    SEIMessages                leadingSeiMessages;
+    SEIMessages                nestedSeiMessages;
+    SEIMessages                duInfoSeiMessages;
+    SEIMessages                trailingSeiMessages;
+    std::deque<DUData>         duData;
+  };
+
 private:
 
   TEncAnalyze             m_gcAnalyzeAll;
@@ -93,6 +130,8 @@ private:
 
   TEncAnalyze             m_gcAnalyzeAll_in;
 
+  TComProfilingLog        m_profilingLog;                 ///< run time of the encoding stages of each picture, when profiling
+
 #if EXTENSION_360_VIDEO
   TExt360EncGop           m_ext360;
 public:
@@ -145,6 +184,14 @@ private:
   SEIEncoder              m_seiEncoder;
   TComPicYuv*             m_pcDeblockingTempPicYuv;
   Int                     m_DBParam[MAX_ENCODER_DEBLOCKING_QUALITY_LAYERS][4];   //[layer_id][0: available; 1: bDBDisabled; 2: Beta Offset Div2; 3: Tc Offset Div2;]
+  SliceType               m_encCABACTableIdx;             ///< cabac_init decision of the last picture written, used by the pictures of the next GOP
+
+  // frame-parallel encoding
+  PicEncodeTask*          m_pcPicEncodeTasks;             ///< pictures in flight, indexed by their position in coding order modulo m_numPicEncodeTasks
+  Int                     m_numPicEncodeTasks;            ///< maximum number of pictures in flight
+  TEncLoopFilterPipeline* m_pcLoopFilterPipelines;        ///< loop filter of each picture in flight, which publishes its CTU rows as they are final (NULL if unused)
+  TComProgressCounter     m_cSAOPicStateProgress;         ///< number of pictures of the GOP whose SAO encoder state has been passed on
+  std::mutex              m_picListMutex;                 ///< guards the slice lists of the pictures, which grow while a picture is compressed
 
 public:
   TEncGOP();
@@ -156,7 +203,7 @@ public:
   Void  init        ( TEncTop* pcTEncTop );
   Void  compressGOP ( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rcListPic, TComList<TComPicYuv*>& rcListPicYuvRec,
                       std::list<AccessUnit>& accessUnitsInGOP, Bool isField, Bool isTff, const InputColourSpaceConversion snr_conversion, const Bool printFrameMSE );
-  Void  xAttachSliceDataToNalUnit (OutputNALUnit& rNalu, TComOutputBitstream* pcBitstreamRedirect);
+  Void  xAttachSliceDataToNalUnit (OutputNALUnit& rNalu, TComOutputBitstream* substreams, UInt numSubstreams);
 
 
   Int   getGOPSize()          { return  m_iGopSize;  }
@@ -183,6 +230,11 @@ protected:
   Void  xInitGOP          ( Int iPOCLast, Int iNumPicRcvd, Bool isField );
   Void  xGetBuffer        ( TComList<TComPic*>& rcListPic, TComList<TComPicYuv*>& rcListPicYuvRecOut, Int iNumPicRcvd, Int iTimeOffset, TComPic*& rpcPic, TComPicYuv*& rpcPicYuvRecOut, Int pocCurr, Bool isField );
 
+  Void  xCompressPicture        ( PicEncodeTask& task );              ///< compress all slice segments of a prepared picture
+  static Void xCompressPictureTask( Void* param, Int threadIdx );
+  Void  xFilterPicture          ( PicEncodeTask& task );              ///< deblock and apply SAO to a compressed picture
+  Void  xFilterAndWritePicture  ( PicEncodeTask& task, GOPWriteContext& ctx, std::unique_lock<std::mutex>& lock ); ///< loop filter and write a compressed picture
+
   Void  xCalculateAddPSNRs         ( const Bool isField, const Bool isFieldTopFieldFirst, const Int iGOPid, TComPic* pcPic, const AccessUnit&accessUnit, TComList<TComPic*> &rcListPic, Double dEncTime, const InputColourSpaceConversion snr_conversion, const Bool printFrameMSE, Double* PSNR_Y );
   Void  xCalculateAddPSNR          ( TComPic* pcPic, TComPicYuv* pcPicD, const AccessUnit&, Double dEncTime, const InputColourSpaceConversion snr_conversion, const Bool printFrameMSE, Double* PSNR_Y );
   Void  xCalculateInterlacedAddPSNR( TComPic* pcPicOrgFirstField, TComPic* pcPicOrgSecondField,
@@ -0,0 +1,285 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TEncLoopFilterPipeline.cpp
+    \brief    CTU-row pipelined in-loop filtering of a picture being compressed
+*/
+
+#include "TEncLoopFilterPipeline.h"
+
+//! \ingroup TLibEncoder
+//! \{
+
+// ====================================================================================================================
+// Constructor / destructor / create / destroy
+// ====================================================================================================================
+
+TEncLoopFilterPipeline::TEncLoopFilterPipeline()
+: m_pcCfg( NULL )
+, m_pcPic( NULL )
+, m_bUseSAO( false )
+, m_bUsePreDBFSamples( false )
+, m_numCtuRows( 0 )
+, m_numCompressedCtuRows( 0 )
+, m_nextStage( 0 )
+, m_numStatsCtuRows( 0 )
+, m_numDecidedCtuRows( 0 )
+, m_numCompletedCtuRows( 0 )
+, m_bPicParamsDecided( false )
+, m_pcPicStateSAO( NULL )
+, m_pcPicStateProgress( NULL )
+, m_picStateIdx( 0 )
+{
+  m_cRDGoOnSbacCoder.init( &m_cRDGoOnBinCoderCABAC );
+}
+
+TEncLoopFilterPipeline::~TEncLoopFilterPipeline()
+{
+}
+
+Void TEncLoopFilterPipeline::create( TEncCfg* pcCfg )
+{
+  m_pcCfg = pcCfg;
+
+  if ( m_pcCfg->getUseSAO() )
+  {
+    m_cEncSAO.create( m_pcCfg->getSourceWidth(), m_pcCfg->getSourceHeight(), m_pcCfg->getChromaFormatIdc(), m_pcCfg->getMaxCUWidth(), m_pcCfg->getMaxCUHeight(), m_pcCfg->getMaxTotalCUDepth(),
+                      m_pcCfg->getLog2SaoOffsetScale( CHANNEL_TYPE_LUMA ), m_pcCfg->getLog2SaoOffsetScale( CHANNEL_TYPE_CHROMA ) );
+    m_cEncSAO.createEncData( m_pcCfg->getSaoCtuBoundary() );
+  }
+  m_cLoopFilter.create( m_pcCfg->getMaxTotalCUDepth() );
+}
+
+Void TEncLoopFilterPipeline::destroy()
+{
+  m_cEncSAO.destroyEncData();
+  m_cEncSAO.destroy();
+  m_cLoopFilter.destroy();
+}
+
+// ====================================================================================================================
+// Public member functions
+// ====================================================================================================================
+
+Void TEncLoopFilterPipeline::startPicture( TComPic* pcPic, TEncSampleAdaptiveOffset* pcPicStateSAO, TComProgressCounter* pcPicStateProgress, Int picStateIdx )
+{
+  assert( m_pcPic == NULL );
+
+  m_pcPic      = pcPic;
+  m_numCtuRows = pcPic->getFrameHeightInCtus();
+
+  TComSlice* pcSlice = pcPic->getSlice(0);
+  m_bUseSAO           = pcSlice->getSPS()->getUseSAO();
+  m_bUsePreDBFSamples = m_bUseSAO && m_pcCfg->getSaoCtuBoundary();
+  m_cLoopFilter.setCfg( pcSlice->getPPS()->getLoopFilterAcrossTilesEnabledFlag() );
+
+  m_numCompressedCtusInRow.assign( m_numCtuRows, 0 );
+  m_numCompressedCtuRows = 0;
+  m_nextStage            = 0;
+  m_numStatsCtuRows      = 0;
+  m_numDecidedCtuRows    = 0;
+  m_numCompletedCtuRows  = 0;
+  m_bPicParamsDecided    = false;
+
+  m_pcPicStateSAO      = pcPicStateSAO;
+  m_pcPicStateProgress = pcPicStateProgress;
+  m_picStateIdx        = picStateIdx;
+
+  if ( m_bUseSAO )
+  {
+    m_cBitCounter.resetBits();
+    m_cRDGoOnSbacCoder.setBitstream( &m_cBitCounter );
+    m_cEncSAO.initRDOCabacCoder( &m_cRDGoOnSbacCoder, pcSlice );
+  }
+}
+
+Void TEncLoopFilterPipeline::ctuCompressed( UInt ctuRsAddr )
+{
+  const Int frameWidthInCtus = m_pcPic->getFrameWidthInCtus();
+
+  if ( ++m_numCompressedCtusInRow[ctuRsAddr / frameWidthInCtus] == frameWidthInCtus )
+  {
+    while ( m_numCompressedCtuRows < m_numCtuRows && m_numCompressedCtusInRow[m_numCompressedCtuRows] == frameWidthInCtus )
+    {
+      m_numCompressedCtuRows++;
+    }
+    xRunReadyStages();
+  }
+}
+
+Void TEncLoopFilterPipeline::finishPicture( UInt numSliceSegments )
+{
+  assert( m_pcPic != NULL );
+
+  m_numCompressedCtuRows = m_numCtuRows;
+  xRunReadyStages();
+  assert( m_nextStage > m_numCtuRows );
+
+  if ( m_bUseSAO )
+  {
+    if ( !m_bPicParamsDecided )
+    {
+      if ( m_pcPicStateProgress )
+      {
+        m_pcPicStateProgress->waitFor( m_picStateIdx );
+      }
+      xDecideAndOffsetRows();
+    }
+    assert( m_numCompletedCtuRows == m_numCtuRows );
+
+    m_cEncSAO.finishCtuRowPicParams( m_pcPic, m_pcCfg->getSaoEncodingRate(), m_pcCfg->getSaoEncodingRateChroma() );
+    if ( m_pcPicStateSAO )
+    {
+      m_pcPicStateSAO->copyPicState( m_cEncSAO );
+      m_pcPicStateProgress->set( m_picStateIdx + 1 );
+    }
+    m_cRDGoOnSbacCoder.setBitstream( NULL );
+
+    //assign SAO slice header
+    for ( UInt s = 0; s < numSliceSegments; s++ )
+    {
+      m_pcPic->getSlice(s)->setSaoEnabledFlag( CHANNEL_TYPE_LUMA, m_sliceEnabled[COMPONENT_Y] );
+      assert( m_sliceEnabled[COMPONENT_Cb] == m_sliceEnabled[COMPONENT_Cr] );
+      m_pcPic->getSlice(s)->setSaoEnabledFlag( CHANNEL_TYPE_CHROMA, m_sliceEnabled[COMPONENT_Cb] );
+    }
+  }
+  m_pcPic = NULL;
+}
+
+// ====================================================================================================================
+// Private member functions
+// ====================================================================================================================
+
+/** Number of CTU rows that must have been compressed before a stage can run: the row below the deblocked one, whose
+ * intra prediction reads it before deblocking, and with pre-deblocking SAO statistics, the row below that one.
+ */
+Int TEncLoopFilterPipeline::xGetNumCtuRowsNeeded( Int stage ) const
+{
+  return min( m_numCtuRows, stage + ( m_bUsePreDBFSamples ? 3 : 2 ) );
+}
+
+Void TEncLoopFilterPipeline::xRunReadyStages()
+{
+  while ( m_nextStage <= m_numCtuRows && m_numCompressedCtuRows >= xGetNumCtuRowsNeeded( m_nextStage ) )
+  {
+    xFilterStage( m_nextStage++ );
+  }
+}
+
+/** Deblock CTU row stage, after the statistics of the non-deblocked samples of the row below it have been gathered, then
+ * complete CTU row stage-1 (without SAO), or gather its SAO statistics and decide and offset the rows that are ready.
+ */
+Void TEncLoopFilterPipeline::xFilterStage( Int stage )
+{
+  if ( m_bUsePreDBFSamples )
+  {
+    if ( stage == 0 )
+    {
+      m_cEncSAO.getPreDBFCtuRowStatistics( m_pcPic, 0 );
+    }
+    if ( stage + 1 < m_numCtuRows )
+    {
+      m_cEncSAO.getPreDBFCtuRowStatistics( m_pcPic, stage + 1 );
+    }
+  }
+
+  if ( stage < m_numCtuRows )
+  {
+    m_cLoopFilter.loopFilterCtuRow( m_pcPic, stage );
+  }
+
+  if ( stage == 0 )
+  {
+    return;
+  }
+
+  if ( !m_bUseSAO )
+  {
+    xCompleteCtuRow( stage - 1 );
+    return;
+  }
+
+  m_cEncSAO.getCtuRowStatistics( m_pcPic, stage - 1, m_bUsePreDBFSamples );
+  m_numStatsCtuRows = stage;
+
+  if ( !m_bPicParamsDecided && m_pcPicStateProgress && m_pcPicStateProgress->get() < m_picStateIdx )
+  {
+    // the decision depends on the previous picture, which is still being filtered
+    return;
+  }
+  xDecideAndOffsetRows();
+}
+
+/** Decide the SAO parameters of the rows whose statistics have been gathered, and offset the rows whose bottom line has
+ * been read by the statistics of the row below it.
+ */
+Void TEncLoopFilterPipeline::xDecideAndOffsetRows()
+{
+  if ( !m_bPicParamsDecided )
+  {
+    if ( m_pcPicStateSAO )
+    {
+      m_cEncSAO.copyPicState( *m_pcPicStateSAO );
+    }
+    m_cEncSAO.decideCtuRowPicParams( m_pcPic, m_sliceEnabled, m_pcPic->getSlice(0)->getLambdas(),
+                                     m_pcCfg->getSaoEncodingRate(), m_pcCfg->getSaoEncodingRateChroma(),
+                                     m_pcCfg->getSaoResetEncoderStateAfterIRAP() );
+    m_bPicParamsDecided = true;
+  }
+
+  while ( m_numDecidedCtuRows < m_numStatsCtuRows )
+  {
+    m_cEncSAO.decideCtuRowParams( m_pcPic, m_numDecidedCtuRows++, m_sliceEnabled );
+  }
+
+  while ( m_numCompletedCtuRows < m_numDecidedCtuRows && ( m_numCompletedCtuRows + 1 < m_numStatsCtuRows || m_numStatsCtuRows == m_numCtuRows ) )
+  {
+    m_cEncSAO.offsetCtuRow( m_pcPic, m_numCompletedCtuRows );
+    m_cEncSAO.PCMLFDisableProcessCtuRow( m_pcPic, m_numCompletedCtuRows );
+    xCompleteCtuRow( m_numCompletedCtuRows );
+  }
+}
+
+/** The CTU row is final: compress its motion, extend its borders and report it to the pictures that reference it.
+ */
+Void TEncLoopFilterPipeline::xCompleteCtuRow( Int ctuRow )
+{
+  const Int maxCUHeight = m_pcPic->getPicSym()->getSPS().getMaxCUHeight();
+
+  m_pcPic->compressMotionCtuRow( ctuRow );
+  m_pcPic->getPicYuvRec()->extendPicBorderLines( ctuRow * maxCUHeight, ( ctuRow + 1 ) * maxCUHeight );
+  m_pcPic->setReconRowProgress( ctuRow + 1 );
+  m_numCompletedCtuRows = ctuRow + 1;
+}
+
+//! \}
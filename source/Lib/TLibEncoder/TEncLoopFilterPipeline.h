@@ -0,0 +1,127 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TEncLoopFilterPipeline.h
+    \brief    CTU-row pipelined in-loop filtering of a picture being compressed (header)
+*/
+
+#ifndef __TENCLOOPFILTERPIPELINE__
+#define __TENCLOOPFILTERPIPELINE__
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+#include <vector>
+
+#include "TLibCommon/CommonDef.h"
+#include "TLibCommon/TComPic.h"
+#include "TLibCommon/TComLoopFilter.h"
+#include "TLibCommon/TComBitCounter.h"
+#include "TLibCommon/TComThreadPool.h"
+#include "TEncCfg.h"
+#include "TEncSbac.h"
+#include "TEncSampleAdaptiveOffset.h"
+
+//! \ingroup TLibEncoder
+//! \{
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// in-loop filtering of a picture CTU row by CTU row, while the picture is being compressed.
+/// Stage s deblocks CTU row s once rows s and s+1 have been compressed (the intra prediction of row s+1 reads the samples
+/// of row s before deblocking). Without SAO, it then completes row s-1: its motion is compressed, its borders are
+/// extended and it is reported as reconstructed to the pictures that reference it. With SAO, the statistics of row s-1
+/// are gathered, and the rows are decided and offset from top to bottom, each one once the statistics of the row below
+/// it have been gathered, before they are completed in the same way.
+/// The stages run on the thread compressing the picture, as soon as they are ready.
+class TEncLoopFilterPipeline
+{
+private:
+  TEncCfg*                  m_pcCfg;
+  TComLoopFilter            m_cLoopFilter;
+  TEncSampleAdaptiveOffset  m_cEncSAO;
+  TEncSbac                  m_cRDGoOnSbacCoder;           ///< going on SBAC model of the SAO decisions
+#if FAST_BIT_EST
+  TEncBinCABACCounter       m_cRDGoOnBinCoderCABAC;
+#else
+  TEncBinCABAC              m_cRDGoOnBinCoderCABAC;
+#endif
+  TComBitCounter            m_cBitCounter;
+
+  TComPic*                  m_pcPic;                      ///< picture being filtered, NULL if none
+  Bool                      m_bUseSAO;
+  Bool                      m_bUsePreDBFSamples;          ///< SAO statistics of the non-deblocked samples at the CTU boundaries
+  Int                       m_numCtuRows;
+  std::vector<Int>          m_numCompressedCtusInRow;
+  Int                       m_numCompressedCtuRows;       ///< the CTU rows above this one have all been compressed
+  Int                       m_nextStage;
+  Int                       m_numStatsCtuRows;            ///< CTU rows whose SAO statistics have been gathered
+  Int                       m_numDecidedCtuRows;          ///< CTU rows whose SAO parameters have been decided
+  Int                       m_numCompletedCtuRows;        ///< CTU rows reported as reconstructed
+  Bool                      m_bPicParamsDecided;          ///< the SAO slice on/off decision has been made
+  Bool                      m_sliceEnabled[MAX_NUM_COMPONENT];
+
+  // SAO state carried from picture to picture (disabled rates), when pictures are filtered by different pipelines
+  TEncSampleAdaptiveOffset* m_pcPicStateSAO;              ///< state after the previous picture in coding order, NULL if not used
+  TComProgressCounter*      m_pcPicStateProgress;         ///< number of pictures whose state has been stored in m_pcPicStateSAO
+  Int                       m_picStateIdx;                ///< position of the picture in the chain
+
+  Int   xGetNumCtuRowsNeeded( Int stage ) const;
+  Void  xRunReadyStages     ();
+  Void  xFilterStage        ( Int stage );
+  Void  xDecideAndOffsetRows();
+  Void  xCompleteCtuRow     ( Int ctuRow );
+
+public:
+  TEncLoopFilterPipeline();
+  virtual ~TEncLoopFilterPipeline();
+
+  Void  create              ( TEncCfg* pcCfg );
+  Void  destroy             ();
+
+  /// start filtering a picture, before its first CTU is compressed. When pcPicStateSAO is given, the SAO decision of the
+  /// picture waits until pcPicStateProgress has reached picStateIdx, and the SAO state is then stored and the counter
+  /// incremented when the picture is finished
+  Void  startPicture        ( TComPic* pcPic, TEncSampleAdaptiveOffset* pcPicStateSAO, TComProgressCounter* pcPicStateProgress, Int picStateIdx );
+  /// report that a CTU of the picture has been compressed for the last time
+  Void  ctuCompressed       ( UInt ctuRsAddr );
+  /// complete the filtering once all slice segments of the picture have been compressed, and set their SAO flags
+  Void  finishPicture       ( UInt numSliceSegments );
+};
+
+//! \}
+
+#endif // __TENCLOOPFILTERPIPELINE__
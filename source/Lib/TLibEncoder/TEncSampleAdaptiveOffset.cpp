@@ -36,11 +36,17 @@
  \brief       estimation part of sample adaptive offset class
  */
 #include "TEncSampleAdaptiveOffset.h"
+#include "TLibCommon/TComProfiler.h"
 #include <string.h>
 #include <stdlib.h>
 #include <stdio.h>
 #include <math.h>
 
+#if VECTOR_CODING__SAO && VECTOR_CODING__AVX2 && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+#include <immintrin.h>
+#include "TLibCommon/TComCpuFeatures.h"
+#endif
+
 //! \ingroup TLibEncoder
 //! \{
 
@@ -57,6 +63,143 @@ inline Double xRoundIbdi(Int bitDepth, Double x)
 }
 
 
+#if VECTOR_CODING__SAO && VECTOR_CODING__AVX2 && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+// ====================================================================================================================
+// AVX2 SAO statistics
+// ====================================================================================================================
+
+/** adds the differences and counts of the edge classes (index 0..4 = edge type -2..2) of the samples [startX, endX) x
+ *  [startY, endY) of a block, the edge class of a sample being derived from its neighbours at -neighbourOffset and
+ *  +neighbourOffset
+ */
+SIMD_TARGET_AVX2
+static Void simdSaoEdgeStatsAVX2( const Pel* srcBlk, const Pel* orgBlk, Int srcStride, Int orgStride, Int startX, Int endX, Int startY, Int endY
+                                , Int neighbourOffset, Int64* diff, Int64* count )
+{
+  if( startX >= endX || startY >= endY )
+  {
+    return;
+  }
+
+  const __m256i ones = _mm256_set1_epi16( 1 );
+  __m256i sumDiff [NUM_SAO_EO_CLASSES];
+  __m256i sumCount[NUM_SAO_EO_CLASSES];
+  for( Int k = 0; k < NUM_SAO_EO_CLASSES; k++ )
+  {
+    sumDiff [k] = _mm256_setzero_si256();
+    sumCount[k] = _mm256_setzero_si256();
+  }
+
+  for( Int y = startY; y < endY; y++ )
+  {
+    const Pel *srcLine = srcBlk + y * srcStride;
+    const Pel *orgLine = orgBlk + y * orgStride;
+    Int x = startX;
+    for( ; x + 16 <= endX; x += 16 )
+    {
+      const __m256i cur = _mm256_loadu_si256( ( const __m256i* )( srcLine + x ) );
+      const __m256i n0  = _mm256_loadu_si256( ( const __m256i* )( srcLine + x - neighbourOffset ) );
+      const __m256i n1  = _mm256_loadu_si256( ( const __m256i* )( srcLine + x + neighbourOffset ) );
+      // sgn(cur - n) = (n > cur) - (cur > n), as 0 / -1 masks
+      __m256i edgeClass = _mm256_sub_epi16( _mm256_cmpgt_epi16( n0, cur ), _mm256_cmpgt_epi16( cur, n0 ) );
+      edgeClass = _mm256_add_epi16( edgeClass, _mm256_sub_epi16( _mm256_cmpgt_epi16( n1, cur ), _mm256_cmpgt_epi16( cur, n1 ) ) );
+      edgeClass = _mm256_add_epi16( edgeClass, _mm256_set1_epi16( 2 ) );
+
+      const __m256i orgDiff = _mm256_sub_epi16( _mm256_loadu_si256( ( const __m256i* )( orgLine + x ) ), cur );
+      for( Int k = 0; k < NUM_SAO_EO_CLASSES; k++ )
+      {
+        const __m256i inClass = _mm256_cmpeq_epi16( edgeClass, _mm256_set1_epi16( k ) );
+        sumDiff [k] = _mm256_add_epi32( sumDiff [k], _mm256_madd_epi16( _mm256_and_si256( orgDiff, inClass ), ones ) );
+        sumCount[k] = _mm256_add_epi32( sumCount[k], _mm256_madd_epi16( inClass, inClass ) );
+      }
+    }
+    for( ; x < endX; x++ )
+    {
+      const Int edgeType = sgn( srcLine[x] - srcLine[x - neighbourOffset] ) + sgn( srcLine[x] - srcLine[x + neighbourOffset] ) + 2;
+      diff [edgeType] += ( orgLine[x] - srcLine[x] );
+      count[edgeType] ++;
+    }
+  }
+
+  for( Int k = 0; k < NUM_SAO_EO_CLASSES; k++ )
+  {
+    __m128i d = _mm_add_epi32( _mm256_castsi256_si128( sumDiff [k] ), _mm256_extracti128_si256( sumDiff [k], 1 ) );
+    __m128i c = _mm_add_epi32( _mm256_castsi256_si128( sumCount[k] ), _mm256_extracti128_si256( sumCount[k], 1 ) );
+    d = _mm_add_epi32( d, _mm_shuffle_epi32( d, 0x4e ) );
+    c = _mm_add_epi32( c, _mm_shuffle_epi32( c, 0x4e ) );
+    d = _mm_add_epi32( d, _mm_shuffle_epi32( d, 0xb1 ) );
+    c = _mm_add_epi32( c, _mm_shuffle_epi32( c, 0xb1 ) );
+    diff [k] += _mm_cvtsi128_si32( d );
+    count[k] += _mm_cvtsi128_si32( c );
+  }
+}
+
+/// edge offset statistics of one SAO type, over the same samples as the C code of TEncSampleAdaptiveOffset::getBlkStats()
+static Void simdSaoGetBlkEdgeStatsAVX2( Int typeIdx, SAOStatData& statsData, const Pel* srcBlk, const Pel* orgBlk, Int srcStride, Int orgStride, Int width, Int height
+                                      , Bool isLeftAvail, Bool isRightAvail, Bool isAboveAvail, Bool isBelowAvail, Bool isAboveLeftAvail, Bool isAboveRightAvail
+                                      , Bool isCalculatePreDeblockSamples, Int skipLinesR, Int skipLinesB )
+{
+  Int64 *diff  = statsData.diff;
+  Int64 *count = statsData.count;
+  Int startX, endX, endY, neighbourOffset;
+
+  if( typeIdx == SAO_TYPE_EO_90 )
+  {
+    startX = (!isCalculatePreDeblockSamples) ? 0 : (isRightAvail ? (width - skipLinesR) : width);
+    endX   = (!isCalculatePreDeblockSamples) ? (isRightAvail ? (width - skipLinesR) : width) : width;
+    endY   = isBelowAvail ? (height - skipLinesB) : (height - 1);
+    simdSaoEdgeStatsAVX2( srcBlk, orgBlk, srcStride, orgStride, startX, endX, isAboveAvail ? 0 : 1, endY, srcStride, diff, count );
+
+    if( isCalculatePreDeblockSamples && isBelowAvail )
+    {
+      simdSaoEdgeStatsAVX2( srcBlk, orgBlk, srcStride, orgStride, 0, width, endY, endY + skipLinesB, srcStride, diff, count );
+    }
+    return;
+  }
+
+  startX = (!isCalculatePreDeblockSamples) ? (isLeftAvail  ? 0 : 1) : (isRightAvail ? (width - skipLinesR) : (width - 1));
+  endX   = (!isCalculatePreDeblockSamples) ? (isRightAvail ? (width - skipLinesR) : (width - 1)) : (isRightAvail ? width : (width - 1));
+
+  switch( typeIdx )
+  {
+  case SAO_TYPE_EO_0:
+    endY = isBelowAvail ? (height - skipLinesB) : height;
+    neighbourOffset = 1;
+    simdSaoEdgeStatsAVX2( srcBlk, orgBlk, srcStride, orgStride, startX, endX, 0, endY, neighbourOffset, diff, count );
+    break;
+  case SAO_TYPE_EO_135:
+    endY = isBelowAvail ? (height - skipLinesB) : (height - 1);
+    neighbourOffset = srcStride + 1;
+    simdSaoEdgeStatsAVX2( srcBlk, orgBlk, srcStride, orgStride
+                        , (!isCalculatePreDeblockSamples) ? (isAboveLeftAvail ? 0    : 1) : startX
+                        , (!isCalculatePreDeblockSamples) ? (isAboveAvail     ? endX : 1) : endX
+                        , 0, 1, neighbourOffset, diff, count );
+    simdSaoEdgeStatsAVX2( srcBlk, orgBlk, srcStride, orgStride, startX, endX, 1, endY, neighbourOffset, diff, count );
+    break;
+  case SAO_TYPE_EO_45:
+    endY = isBelowAvail ? (height - skipLinesB) : (height - 1);
+    neighbourOffset = srcStride - 1;
+    simdSaoEdgeStatsAVX2( srcBlk, orgBlk, srcStride, orgStride
+                        , (!isCalculatePreDeblockSamples) ? (isAboveAvail ? startX : endX) : startX
+                        , (!isCalculatePreDeblockSamples) ? ((!isRightAvail && isAboveRightAvail) ? width : endX) : endX
+                        , 0, 1, neighbourOffset, diff, count );
+    simdSaoEdgeStatsAVX2( srcBlk, orgBlk, srcStride, orgStride, startX, endX, 1, endY, neighbourOffset, diff, count );
+    break;
+  default:
+    {
+      printf("Not a supported SAO types\n");
+      assert(0);
+      exit(-1);
+    }
+  }
+
+  if( isCalculatePreDeblockSamples && isBelowAvail )
+  {
+    simdSaoEdgeStatsAVX2( srcBlk, orgBlk, srcStride, orgStride, isLeftAvail ? 0 : 1, isRightAvail ? width : (width - 1), endY, endY + skipLinesB, neighbourOffset, diff, count );
+  }
+}
+#endif
+
 TEncSampleAdaptiveOffset::TEncSampleAdaptiveOffset()
 {
   m_pppcRDSbacCoder = NULL;
@@ -64,6 +207,7 @@ TEncSampleAdaptiveOffset::TEncSampleAdaptiveOffset()
   m_pppcBinCoderCABAC = NULL;
   m_statData = NULL;
   m_preDBFstatData = NULL;
+  m_ctuRowReconParams = NULL;
 }
 
 TEncSampleAdaptiveOffset::~TEncSampleAdaptiveOffset()
@@ -118,6 +262,8 @@ Void TEncSampleAdaptiveOffset::createEncData(Bool isPreDBFSamplesUsed)
 
   }
 
+  m_ctuRowReconParams = new SAOBlkParam[m_numCTUsPic];
+
   ::memset(m_saoDisabledRate, 0, sizeof(m_saoDisabledRate));
   m_lastIRAPPoc = MAX_INT;
 
@@ -226,6 +372,10 @@ Void TEncSampleAdaptiveOffset::destroyEncData()
     }
     delete[] m_preDBFstatData; m_preDBFstatData = NULL;
   }
+  if(m_ctuRowReconParams != NULL)
+  {
+    delete[] m_ctuRowReconParams; m_ctuRowReconParams = NULL;
+  }
 }
 
 Void TEncSampleAdaptiveOffset::initRDOCabacCoder(TEncSbac* pcRDGoOnSbacCoder, TComSlice* pcSlice)
@@ -241,16 +391,13 @@ Void TEncSampleAdaptiveOffset::initRDOCabacCoder(TEncSbac* pcRDGoOnSbacCoder, TC
 
 Void TEncSampleAdaptiveOffset::SAOProcess(TComPic* pPic, Bool* sliceEnabled, const Double *lambdas, const Bool bTestSAODisableAtPictureLevel, const Double saoEncodingRate, const Double saoEncodingRateChroma, const Bool isPreDBFSamplesUsed, const Bool bResetStateAfterIRAP )
 {
+  TComProfilingScope profilingScope( PROFILE_ENC_SAO_DECISION );
   TComPicYuv* orgYuv= pPic->getPicYuvOrg();
   TComPicYuv* resYuv= pPic->getPicYuvRec();
   memcpy(m_lambda, lambdas, sizeof(m_lambda));
-  TComPicYuv* srcYuv = m_tempPicYuv;
-  resYuv->copyToPic(srcYuv);
-  srcYuv->setBorderExtension(false);
-  srcYuv->extendPicBorder();
 
-  //collect statistics
-  getStatistics(m_statData, orgYuv, srcYuv, pPic);
+  //collect statistics, on the deblocked picture before any offset is applied
+  getStatistics(m_statData, orgYuv, resYuv, pPic);
   if(isPreDBFSamplesUsed)
   {
     addPreDBFStatistics(m_statData);
@@ -261,18 +408,116 @@ Void TEncSampleAdaptiveOffset::SAOProcess(TComPic* pPic, Bool* sliceEnabled, con
 
   //block on/off
   SAOBlkParam* reconParams = new SAOBlkParam[m_numCTUsPic]; //temporary parameter buffer for storing reconstructed SAO parameters
-  decideBlkParams(pPic, sliceEnabled, m_statData, srcYuv, resYuv, reconParams, pPic->getPicSym()->getSAOBlkParam(), bTestSAODisableAtPictureLevel, saoEncodingRate, saoEncodingRateChroma);
+  decideBlkParams(pPic, sliceEnabled, m_statData, resYuv, reconParams, pPic->getPicSym()->getSAOBlkParam(), bTestSAODisableAtPictureLevel, saoEncodingRate, saoEncodingRateChroma);
   delete[] reconParams;
 }
 
+/** Statistics of one CTU row, once it and the first line of the row below it have been deblocked, and before the offsets
+ *  are applied to the rows above and below it.
+ */
+Void TEncSampleAdaptiveOffset::getCtuRowStatistics(TComPic* pPic, Int ctuRow, const Bool isPreDBFSamplesUsed)
+{
+  TComProfilingScope profilingScope( PROFILE_ENC_SAO_DECISION );
+  const Int startCtuRsAddr = ctuRow * m_numCTUInWidth;
+  const Int endCtuRsAddr   = startCtuRsAddr + m_numCTUInWidth;
+
+  getStatistics(m_statData, pPic->getPicYuvOrg(), pPic->getPicYuvRec(), pPic, startCtuRsAddr, endCtuRsAddr);
+  if(isPreDBFSamplesUsed)
+  {
+    addPreDBFStatistics(m_statData, startCtuRsAddr, endCtuRsAddr);
+  }
+}
+
+/** Statistics of the non-deblocked samples of one CTU row, before the row and the row above it are deblocked.
+ */
+Void TEncSampleAdaptiveOffset::getPreDBFCtuRowStatistics(TComPic* pPic, Int ctuRow)
+{
+  TComProfilingScope profilingScope( PROFILE_ENC_SAO_DECISION );
+  const Int startCtuRsAddr = ctuRow * m_numCTUInWidth;
+
+  getStatistics(m_preDBFstatData, pPic->getPicYuvOrg(), pPic->getPicYuvRec(), pPic, startCtuRsAddr, startCtuRsAddr + m_numCTUInWidth, true);
+}
+
+/** Picture-level decision of the CTU-row-wise processing, before the parameters of the first CTU row are decided.
+ */
+Void TEncSampleAdaptiveOffset::decideCtuRowPicParams(TComPic* pPic, Bool* sliceEnabled, const Double *lambdas, const Double saoEncodingRate, const Double saoEncodingRateChroma, const Bool bResetStateAfterIRAP)
+{
+  memcpy(m_lambda, lambdas, sizeof(m_lambda));
+  decidePicParams(sliceEnabled, pPic, saoEncodingRate, saoEncodingRateChroma, bResetStateAfterIRAP);
+
+  for(Int ctuRsAddr = 0; ctuRsAddr < m_numCTUsPic; ctuRsAddr++)
+  {
+    m_ctuRowReconParams[ctuRsAddr].reset();
+  }
+  m_pcRDGoOnSbacCoder->load(m_pppcRDSbacCoder[ SAO_CABACSTATE_PIC_INIT ]);
+}
+
+/** Decide the SAO parameters of the CTUs of one CTU row, the rows being decided from top to bottom.
+ */
+Void TEncSampleAdaptiveOffset::decideCtuRowParams(TComPic* pPic, Int ctuRow, Bool* sliceEnabled)
+{
+  TComProfilingScope profilingScope( PROFILE_ENC_SAO_DECISION );
+  const Int    startCtuRsAddr = ctuRow * m_numCTUInWidth;
+  SAOBlkParam* codedParams    = pPic->getPicSym()->getSAOBlkParam();
+
+  for(Int ctuRsAddr = startCtuRsAddr; ctuRsAddr < startCtuRsAddr + m_numCTUInWidth; ctuRsAddr++)
+  {
+    if(isAllBlksDisabled(sliceEnabled))
+    {
+      codedParams[ctuRsAddr].reset();
+    }
+    else
+    {
+      decideCtuParams(pPic, ctuRsAddr, sliceEnabled, m_statData, m_ctuRowReconParams, codedParams);
+    }
+  }
+}
+
+/** Apply the offsets to one CTU row, after the statistics of the row below it have been gathered.
+ */
+Void TEncSampleAdaptiveOffset::offsetCtuRow(TComPic* pPic, Int ctuRow)
+{
+  const Int startCtuRsAddr = ctuRow * m_numCTUInWidth;
+
+  for(Int ctuRsAddr = startCtuRsAddr; ctuRsAddr < startCtuRsAddr + m_numCTUInWidth; ctuRsAddr++)
+  {
+    offsetCTU(ctuRsAddr, pPic->getPicYuvRec(), m_ctuRowReconParams[ctuRsAddr], pPic);
+  }
+}
+
+/** Update the SAO disabled rates of the temporal layer of the picture, once all its CTU rows have been decided.
+ */
+Void TEncSampleAdaptiveOffset::finishCtuRowPicParams(TComPic* pPic, const Double saoEncodingRate, const Double saoEncodingRateChroma)
+{
+  if (saoEncodingRate > 0.0)
+  {
+    updateDisabledRate(pPic, m_ctuRowReconParams, saoEncodingRateChroma);
+  }
+}
+
+/** Copy the state carried from picture to picture (the SAO disabled rates of the temporal layers and the POC of the last
+ *  IRAP picture), when pictures are processed by different instances.
+ */
+Void TEncSampleAdaptiveOffset::copyPicState(const TEncSampleAdaptiveOffset& src)
+{
+  ::memcpy(m_saoDisabledRate, src.m_saoDisabledRate, sizeof(m_saoDisabledRate));
+  m_lastIRAPPoc = src.m_lastIRAPPoc;
+}
+
 Void TEncSampleAdaptiveOffset::getPreDBFStatistics(TComPic* pPic)
 {
+  TComProfilingScope profilingScope( PROFILE_ENC_SAO_DECISION );
   getStatistics(m_preDBFstatData, pPic->getPicYuvOrg(), pPic->getPicYuvRec(), pPic, true);
 }
 
 Void TEncSampleAdaptiveOffset::addPreDBFStatistics(SAOStatData*** blkStats)
 {
-  for(Int n=0; n< m_numCTUsPic; n++)
+  addPreDBFStatistics(blkStats, 0, m_numCTUsPic);
+}
+
+Void TEncSampleAdaptiveOffset::addPreDBFStatistics(SAOStatData*** blkStats, Int startCtuRsAddr, Int endCtuRsAddr)
+{
+  for(Int n=startCtuRsAddr; n< endCtuRsAddr; n++)
   {
     for(Int compIdx=0; compIdx < MAX_NUM_COMPONENT; compIdx++)
     {
@@ -285,12 +530,19 @@ Void TEncSampleAdaptiveOffset::addPreDBFStatistics(SAOStatData*** blkStats)
 }
 
 Void TEncSampleAdaptiveOffset::getStatistics(SAOStatData*** blkStats, TComPicYuv* orgYuv, TComPicYuv* srcYuv, TComPic* pPic, Bool isCalculatePreDeblockSamples)
+{
+  getStatistics(blkStats, orgYuv, srcYuv, pPic, 0, m_numCTUsPic, isCalculatePreDeblockSamples);
+}
+
+/** Statistics of the CTUs [startCtuRsAddr, endCtuRsAddr).
+ */
+Void TEncSampleAdaptiveOffset::getStatistics(SAOStatData*** blkStats, TComPicYuv* orgYuv, TComPicYuv* srcYuv, TComPic* pPic, Int startCtuRsAddr, Int endCtuRsAddr, Bool isCalculatePreDeblockSamples)
 {
   Bool isLeftAvail,isRightAvail,isAboveAvail,isBelowAvail,isAboveLeftAvail,isAboveRightAvail,isBelowLeftAvail,isBelowRightAvail;
 
   const Int numberOfComponents = getNumberValidComponents(m_chromaFormatIDC);
 
-  for(Int ctuRsAddr= 0; ctuRsAddr < m_numCTUsPic; ctuRsAddr++)
+  for(Int ctuRsAddr= startCtuRsAddr; ctuRsAddr < endCtuRsAddr; ctuRsAddr++)
   {
     Int yPos   = (ctuRsAddr / m_numCTUInWidth)*m_maxCUHeight;
     Int xPos   = (ctuRsAddr % m_numCTUInWidth)*m_maxCUWidth;
@@ -779,26 +1031,14 @@ Void TEncSampleAdaptiveOffset::deriveModeMergeRDO(const BitDepths &bitDepths, In
   m_pcRDGoOnSbacCoder->load(cabacCoderRDO[SAO_CABACSTATE_BLK_TEMP]);
 }
 
-Void TEncSampleAdaptiveOffset::decideBlkParams(TComPic* pic, Bool* sliceEnabled, SAOStatData*** blkStats, TComPicYuv* srcYuv, TComPicYuv* resYuv,
+Void TEncSampleAdaptiveOffset::decideBlkParams(TComPic* pic, Bool* sliceEnabled, SAOStatData*** blkStats, TComPicYuv* resYuv,
                                                SAOBlkParam* reconParams, SAOBlkParam* codedParams, const Bool bTestSAODisableAtPictureLevel,
                                                const Double saoEncodingRate, const Double saoEncodingRateChroma)
 {
-  Bool allBlksDisabled = true;
-  const Int numberOfComponents = getNumberValidComponents(m_chromaFormatIDC);
-  for(Int compId = COMPONENT_Y; compId < numberOfComponents; compId++)
-  {
-    if (sliceEnabled[compId])
-    {
-      allBlksDisabled = false;
-    }
-  }
+  const Bool allBlksDisabled = isAllBlksDisabled(sliceEnabled);
 
   m_pcRDGoOnSbacCoder->load(m_pppcRDSbacCoder[ SAO_CABACSTATE_PIC_INIT ]);
 
-  SAOBlkParam modeParam;
-  Double minCost, modeCost;
-
-
   Double totalCost = 0; // Used if bTestSAODisableAtPictureLevel==true
 
   for(Int ctuRsAddr=0; ctuRsAddr< m_numCTUsPic; ctuRsAddr++)
@@ -809,57 +1049,10 @@ Void TEncSampleAdaptiveOffset::decideBlkParams(TComPic* pic, Bool* sliceEnabled,
       continue;
     }
 
-    m_pcRDGoOnSbacCoder->store(m_pppcRDSbacCoder[ SAO_CABACSTATE_BLK_CUR ]);
-
-    //get merge list
-    SAOBlkParam* mergeList[NUM_SAO_MERGE_TYPES] = { NULL };
-    getMergeList(pic, ctuRsAddr, reconParams, mergeList);
-
-    minCost = MAX_DOUBLE;
-    for(Int mode=0; mode < NUM_SAO_MODES; mode++)
-    {
-      switch(mode)
-      {
-      case SAO_MODE_OFF:
-        {
-          continue; //not necessary, since all-off case will be tested in SAO_MODE_NEW case.
-        }
-        break;
-      case SAO_MODE_NEW:
-        {
-          deriveModeNewRDO(pic->getPicSym()->getSPS().getBitDepths(), ctuRsAddr, mergeList, sliceEnabled, blkStats, modeParam, modeCost, m_pppcRDSbacCoder, SAO_CABACSTATE_BLK_CUR);
-
-        }
-        break;
-      case SAO_MODE_MERGE:
-        {
-          deriveModeMergeRDO(pic->getPicSym()->getSPS().getBitDepths(), ctuRsAddr, mergeList, sliceEnabled, blkStats , modeParam, modeCost, m_pppcRDSbacCoder, SAO_CABACSTATE_BLK_CUR);
-        }
-        break;
-      default:
-        {
-          printf("Not a supported SAO mode\n");
-          assert(0);
-          exit(-1);
-        }
-      }
-
-      if(modeCost < minCost)
-      {
-        minCost = modeCost;
-        codedParams[ctuRsAddr] = modeParam;
-        m_pcRDGoOnSbacCoder->store(m_pppcRDSbacCoder[ SAO_CABACSTATE_BLK_NEXT ]);
-      }
-    } //mode
-
-    totalCost += minCost;
-
-    m_pcRDGoOnSbacCoder->load(m_pppcRDSbacCoder[ SAO_CABACSTATE_BLK_NEXT ]);
+    totalCost += decideCtuParams(pic, ctuRsAddr, sliceEnabled, blkStats, reconParams, codedParams);
 
     //apply reconstructed offsets
-    reconParams[ctuRsAddr] = codedParams[ctuRsAddr];
-    reconstructBlkSAOParam(reconParams[ctuRsAddr], mergeList);
-    offsetCTU(ctuRsAddr, srcYuv, resYuv, reconParams[ctuRsAddr], pic);
+    offsetCTU(ctuRsAddr, resYuv, reconParams[ctuRsAddr], pic);
   } //ctuRsAddr
 
   if (!allBlksDisabled && (totalCost >= 0) && bTestSAODisableAtPictureLevel) //SAO has not beneficial in this case - disable it
@@ -879,32 +1072,109 @@ Void TEncSampleAdaptiveOffset::decideBlkParams(TComPic* pic, Bool* sliceEnabled,
 
   if (saoEncodingRate > 0.0)
   {
-    Int picTempLayer = pic->getSlice(0)->getDepth();
-    Int numCtusForSAOOff[MAX_NUM_COMPONENT];
+    updateDisabledRate(pic, reconParams, saoEncodingRateChroma);
+  }
+}
 
-    for (Int compIdx = 0; compIdx < numberOfComponents; compIdx++)
+Bool TEncSampleAdaptiveOffset::isAllBlksDisabled(const Bool* sliceEnabled) const
+{
+  const Int numberOfComponents = getNumberValidComponents(m_chromaFormatIDC);
+  for(Int compId = COMPONENT_Y; compId < numberOfComponents; compId++)
+  {
+    if (sliceEnabled[compId])
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+/** Decide the SAO parameters of one CTU, after those of the previous CTUs in raster order, and return their cost.
+ */
+Double TEncSampleAdaptiveOffset::decideCtuParams(TComPic* pic, Int ctuRsAddr, Bool* sliceEnabled, SAOStatData*** blkStats, SAOBlkParam* reconParams, SAOBlkParam* codedParams)
+{
+  SAOBlkParam modeParam;
+  Double minCost, modeCost;
+
+  m_pcRDGoOnSbacCoder->store(m_pppcRDSbacCoder[ SAO_CABACSTATE_BLK_CUR ]);
+
+  //get merge list
+  SAOBlkParam* mergeList[NUM_SAO_MERGE_TYPES] = { NULL };
+  getMergeList(pic, ctuRsAddr, reconParams, mergeList);
+
+  minCost = MAX_DOUBLE;
+  for(Int mode=0; mode < NUM_SAO_MODES; mode++)
+  {
+    switch(mode)
     {
-      numCtusForSAOOff[compIdx] = 0;
-      for(Int ctuRsAddr=0; ctuRsAddr< m_numCTUsPic; ctuRsAddr++)
+    case SAO_MODE_OFF:
       {
-        if( reconParams[ctuRsAddr][compIdx].modeIdc == SAO_MODE_OFF)
-        {
-          numCtusForSAOOff[compIdx]++;
-        }
+        continue; //not necessary, since all-off case will be tested in SAO_MODE_NEW case.
+      }
+      break;
+    case SAO_MODE_NEW:
+      {
+        deriveModeNewRDO(pic->getPicSym()->getSPS().getBitDepths(), ctuRsAddr, mergeList, sliceEnabled, blkStats, modeParam, modeCost, m_pppcRDSbacCoder, SAO_CABACSTATE_BLK_CUR);
+
+      }
+      break;
+    case SAO_MODE_MERGE:
+      {
+        deriveModeMergeRDO(pic->getPicSym()->getSPS().getBitDepths(), ctuRsAddr, mergeList, sliceEnabled, blkStats , modeParam, modeCost, m_pppcRDSbacCoder, SAO_CABACSTATE_BLK_CUR);
+      }
+      break;
+    default:
+      {
+        printf("Not a supported SAO mode\n");
+        assert(0);
+        exit(-1);
       }
     }
-    if (saoEncodingRateChroma > 0.0)
+
+    if(modeCost < minCost)
     {
-      for (Int compIdx = 0; compIdx < numberOfComponents; compIdx++)
+      minCost = modeCost;
+      codedParams[ctuRsAddr] = modeParam;
+      m_pcRDGoOnSbacCoder->store(m_pppcRDSbacCoder[ SAO_CABACSTATE_BLK_NEXT ]);
+    }
+  } //mode
+
+  m_pcRDGoOnSbacCoder->load(m_pppcRDSbacCoder[ SAO_CABACSTATE_BLK_NEXT ]);
+
+  reconParams[ctuRsAddr] = codedParams[ctuRsAddr];
+  reconstructBlkSAOParam(reconParams[ctuRsAddr], mergeList);
+
+  return minCost;
+}
+
+Void TEncSampleAdaptiveOffset::updateDisabledRate(const TComPic* pic, SAOBlkParam* reconParams, const Double saoEncodingRateChroma)
+{
+  const Int numberOfComponents = getNumberValidComponents(m_chromaFormatIDC);
+  Int picTempLayer = pic->getSlice(0)->getDepth();
+  Int numCtusForSAOOff[MAX_NUM_COMPONENT];
+
+  for (Int compIdx = 0; compIdx < numberOfComponents; compIdx++)
+  {
+    numCtusForSAOOff[compIdx] = 0;
+    for(Int ctuRsAddr=0; ctuRsAddr< m_numCTUsPic; ctuRsAddr++)
+    {
+      if( reconParams[ctuRsAddr][compIdx].modeIdc == SAO_MODE_OFF)
       {
-        m_saoDisabledRate[compIdx][picTempLayer] = (Double)numCtusForSAOOff[compIdx]/(Double)m_numCTUsPic;
+        numCtusForSAOOff[compIdx]++;
       }
     }
-    else if (picTempLayer == 0)
+  }
+  if (saoEncodingRateChroma > 0.0)
+  {
+    for (Int compIdx = 0; compIdx < numberOfComponents; compIdx++)
     {
-      m_saoDisabledRate[COMPONENT_Y][0] = (Double)(numCtusForSAOOff[COMPONENT_Y]+numCtusForSAOOff[COMPONENT_Cb]+numCtusForSAOOff[COMPONENT_Cr])/(Double)(m_numCTUsPic*3);
+      m_saoDisabledRate[compIdx][picTempLayer] = (Double)numCtusForSAOOff[compIdx]/(Double)m_numCTUsPic;
     }
   }
+  else if (picTempLayer == 0)
+  {
+    m_saoDisabledRate[COMPONENT_Y][0] = (Double)(numCtusForSAOOff[COMPONENT_Y]+numCtusForSAOOff[COMPONENT_Cb]+numCtusForSAOOff[COMPONENT_Cr])/(Double)(m_numCTUsPic*3);
+  }
 }
 
 
@@ -945,6 +1215,16 @@ Void TEncSampleAdaptiveOffset::getBlkStats(const ComponentID compIdx, const Int
     SAOStatData& statsData= statsDataTypes[typeIdx];
     statsData.reset();
 
+#if VECTOR_CODING__SAO && VECTOR_CODING__AVX2 && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+    if( typeIdx != SAO_TYPE_BO && getSIMDExtension( SIMD_KERNELS_SAO ) >= SIMD_AVX2 )
+    {
+      simdSaoGetBlkEdgeStatsAVX2( typeIdx, statsData, srcBlk, orgBlk, srcStride, orgStride, width, height
+                                , isLeftAvail, isRightAvail, isAboveAvail, isBelowAvail, isAboveLeftAvail, isAboveRightAvail
+                                , isCalculatePreDeblockSamples, skipLinesR[typeIdx], skipLinesB[typeIdx] );
+      continue;
+    }
+#endif
+
     srcLine = srcBlk;
     orgLine = orgBlk;
     diff    = statsData.diff;
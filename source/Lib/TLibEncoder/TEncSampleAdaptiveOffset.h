@@ -105,10 +105,24 @@ public:
   Void SAOProcess(TComPic* pPic, Bool* sliceEnabled, const Double *lambdas, const Bool bTestSAODisableAtPictureLevel, const Double saoEncodingRate, const Double saoEncodingRateChroma, const Bool isPreDBFSamplesUsed, const Bool bResetStateAfterIRAP);
 public: //methods
   Void getPreDBFStatistics(TComPic* pPic);
+
+  //CTU-row-wise interface, while the picture is being compressed
+  Void getCtuRowStatistics(TComPic* pPic, Int ctuRow, const Bool isPreDBFSamplesUsed);
+  Void getPreDBFCtuRowStatistics(TComPic* pPic, Int ctuRow);
+  Void decideCtuRowPicParams(TComPic* pPic, Bool* sliceEnabled, const Double *lambdas, const Double saoEncodingRate, const Double saoEncodingRateChroma, const Bool bResetStateAfterIRAP);
+  Void decideCtuRowParams(TComPic* pPic, Int ctuRow, Bool* sliceEnabled);
+  Void offsetCtuRow(TComPic* pPic, Int ctuRow);
+  Void finishCtuRowPicParams(TComPic* pPic, const Double saoEncodingRate, const Double saoEncodingRateChroma);
+  Void copyPicState(const TEncSampleAdaptiveOffset& src);
 private: //methods
+  friend class TBenchSAOStatistics; ///< kernel benchmark of getBlkStats() (TAppBench)
   Void getStatistics(SAOStatData*** blkStats, TComPicYuv* orgYuv, TComPicYuv* srcYuv,TComPic* pPic, Bool isCalculatePreDeblockSamples = false);
+  Void getStatistics(SAOStatData*** blkStats, TComPicYuv* orgYuv, TComPicYuv* srcYuv,TComPic* pPic, Int startCtuRsAddr, Int endCtuRsAddr, Bool isCalculatePreDeblockSamples = false);
   Void decidePicParams(Bool* sliceEnabled, const TComPic* pic, const Double saoEncodingRate, const Double saoEncodingRateChroma, const Bool bResetStateAfterIRAP);
-  Void decideBlkParams(TComPic* pic, Bool* sliceEnabled, SAOStatData*** blkStats, TComPicYuv* srcYuv, TComPicYuv* resYuv, SAOBlkParam* reconParams, SAOBlkParam* codedParams, const Bool bTestSAODisableAtPictureLevel, const Double saoEncodingRate, const Double saoEncodingRateChroma);
+  Void decideBlkParams(TComPic* pic, Bool* sliceEnabled, SAOStatData*** blkStats, TComPicYuv* resYuv, SAOBlkParam* reconParams, SAOBlkParam* codedParams, const Bool bTestSAODisableAtPictureLevel, const Double saoEncodingRate, const Double saoEncodingRateChroma);
+  Bool isAllBlksDisabled(const Bool* sliceEnabled) const;
+  Double decideCtuParams(TComPic* pic, Int ctuRsAddr, Bool* sliceEnabled, SAOStatData*** blkStats, SAOBlkParam* reconParams, SAOBlkParam* codedParams);
+  Void updateDisabledRate(const TComPic* pic, SAOBlkParam* reconParams, const Double saoEncodingRateChroma);
   Void getBlkStats(const ComponentID compIdx, const Int channelBitDepth, SAOStatData* statsDataTypes, Pel* srcBlk, Pel* orgBlk, Int srcStride, Int orgStride, Int width, Int height, Bool isLeftAvail,  Bool isRightAvail, Bool isAboveAvail, Bool isBelowAvail, Bool isAboveLeftAvail, Bool isAboveRightAvail, Bool isCalculatePreDeblockSamples);
   Void deriveModeNewRDO(const BitDepths &bitDepths, Int ctuRsAddr, SAOBlkParam* mergeList[NUM_SAO_MERGE_TYPES], Bool* sliceEnabled, SAOStatData*** blkStats, SAOBlkParam& modeParam, Double& modeNormCost, TEncSbac** cabacCoderRDO, Int inCabacLabel);
   Void deriveModeMergeRDO(const BitDepths &bitDepths, Int ctuRsAddr, SAOBlkParam* mergeList[NUM_SAO_MERGE_TYPES], Bool* sliceEnabled, SAOStatData*** blkStats, SAOBlkParam& modeParam, Double& modeNormCost, TEncSbac** cabacCoderRDO, Int inCabacLabel);
@@ -117,6 +131,7 @@ private: //methods
   inline Int64 estSaoDist(Int64 count, Int64 offset, Int64 diffSum, Int shift);
   inline Int estIterOffset(Int typeIdx, Double lambda, Int offsetInput, Int64 count, Int64 diffSum, Int shift, Int bitIncrease, Int64& bestDist, Double& bestCost, Int offsetTh );
   Void addPreDBFStatistics(SAOStatData*** blkStats);
+  Void addPreDBFStatistics(SAOStatData*** blkStats, Int startCtuRsAddr, Int endCtuRsAddr);
 private: //members
   //for RDO
   TEncSbac**             m_pppcRDSbacCoder;
@@ -135,6 +150,7 @@ private: //members
   Int                    m_lastIRAPPoc;
   Int                    m_skipLinesR[MAX_NUM_COMPONENT][NUM_SAO_NEW_TYPES];
   Int                    m_skipLinesB[MAX_NUM_COMPONENT][NUM_SAO_NEW_TYPES];
+  SAOBlkParam*           m_ctuRowReconParams; //[ctu] reconstructed parameters of the CTU-row-wise processing
 };
 
 
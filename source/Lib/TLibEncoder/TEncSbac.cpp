@@ -38,6 +38,7 @@
 #include "TEncTop.h"
 #include "TEncSbac.h"
 #include "TLibCommon/TComTU.h"
+#include "TLibCommon/TComProfiler.h"
 
 #include <map>
 #include <algorithm>
@@ -1240,7 +1241,6 @@ Void TEncSbac::codeCoeffNxN( TComTU &rTu, TCoeff* pcCoef, const ComponentID comp
 
   const ChannelType  chType            = toChannelType(compID);
   const UInt         uiLog2BlockWidth  = g_aucConvertToBit[ uiWidth  ] + 2;
-  const UInt         uiLog2BlockHeight = g_aucConvertToBit[ uiHeight ] + 2;
 
   const ChannelType  channelType       = toChannelType(compID);
   const Bool         extendedPrecision = sps.getSpsRangeExtension().getExtendedPrecisionProcessingFlag();
@@ -1379,6 +1379,9 @@ Void TEncSbac::codeCoeffNxN( TComTU &rTu, TCoeff* pcCoef, const ComponentID comp
     Int iCGPosY   = iCGBlkPos / codingParameters.widthInGroups;
     Int iCGPosX   = iCGBlkPos - (iCGPosY * codingParameters.widthInGroups);
 
+    // the significance of the right and lower groups selects the contexts of both significance flags
+    const Int patternSigCtx = TComTrQuant::calcPatternSigCtx(uiSigCoeffGroupFlag, iCGPosX, iCGPosY, codingParameters.widthInGroups, codingParameters.heightInGroups);
+
     if( iSubSet == iLastScanSet || iSubSet == 0)
     {
       uiSigCoeffGroupFlag[ iCGBlkPos ] = 1;
@@ -1386,24 +1389,23 @@ Void TEncSbac::codeCoeffNxN( TComTU &rTu, TCoeff* pcCoef, const ComponentID comp
     else
     {
       UInt uiSigCoeffGroup   = (uiSigCoeffGroupFlag[ iCGBlkPos ] != 0);
-      UInt uiCtxSig  = TComTrQuant::getSigCoeffGroupCtxInc( uiSigCoeffGroupFlag, iCGPosX, iCGPosY, codingParameters.widthInGroups, codingParameters.heightInGroups );
+      UInt uiCtxSig  = TComTrQuant::getSigCoeffGroupCtxInc( patternSigCtx );
       m_pcBinIf->encodeBin( uiSigCoeffGroup, baseCoeffGroupCtx[ uiCtxSig ] );
     }
 
     // encode significant_coeff_flag
     if( uiSigCoeffGroupFlag[ iCGBlkPos ] )
     {
-      const Int patternSigCtx = TComTrQuant::calcPatternSigCtx(uiSigCoeffGroupFlag, iCGPosX, iCGPosY, codingParameters.widthInGroups, codingParameters.heightInGroups);
+      const UChar *sigCtxIncInGroup = TComTrQuant::getSigCtxIncInGroup( codingParameters, patternSigCtx, iSubSet );
 
-      UInt uiBlkPos, uiSig, uiCtxSig;
+      UInt uiBlkPos, uiSig;
       for( ; iScanPosSig >= iSubPos; iScanPosSig-- )
       {
         uiBlkPos  = codingParameters.scan[ iScanPosSig ];
         uiSig     = (pcCoef[ uiBlkPos ] != 0);
         if( iScanPosSig > iSubPos || iSubSet == 0 || numNonZero )
         {
-          uiCtxSig  = TComTrQuant::getSigCtxInc( patternSigCtx, codingParameters, iScanPosSig, uiLog2BlockWidth, uiLog2BlockHeight, chType );
-          m_pcBinIf->encodeBin( uiSig, baseCtx[ uiCtxSig ] );
+          m_pcBinIf->encodeBin( uiSig, baseCtx[ sigCtxIncInGroup[ iScanPosSig - iSubPos ] ] );
         }
         if( uiSig )
         {
@@ -1725,6 +1727,7 @@ Void TEncSbac::codeSAOBlkParam(SAOBlkParam& saoBlkParam, const BitDepths &bitDep
  */
 Void TEncSbac::estBit( estBitsSbacStruct* pcEstBitsSbac, Int width, Int height, ChannelType chType, COEFF_SCAN_TYPE scanType )
 {
+  TComProfilingScope profilingScope( PROFILE_ENC_RATE_ESTIMATION );
   estCBFBit( pcEstBitsSbac );
 
   estSignificantCoeffGroupMapBit( pcEstBitsSbac, chType );
@@ -41,6 +41,7 @@
 #include "TEncSearch.h"
 #include "TLibCommon/TComTU.h"
 #include "TLibCommon/Debug.h"
+#include "TLibCommon/TComProfiler.h"
 #include <math.h>
 #include <limits>
 
@@ -1070,6 +1071,7 @@ TEncSearch::xGetIntraBitsQT(TComTU &rTu,
                             Bool         bChroma,
                             Bool         bRealCoeff /* just for test */ )
 {
+  TComProfilingScope profilingScope( PROFILE_ENC_RATE_ESTIMATION );
   TComDataCU* pcCU=rTu.getCU();
   const UInt uiAbsPartIdx = rTu.GetAbsPartIdxTU();
   const UInt uiTrDepth=rTu.GetTransformDepthRel();
@@ -1414,6 +1416,7 @@ TEncSearch::xRecurIntraCodingLumaQT(TComYuv*    pcOrgYuv,
                                     TComTU&     rTu
                                     DEBUG_STRING_FN_DECLARE(sDebug))
 {
+  TComProfilingScope profilingScope( PROFILE_ENC_RQT );
   TComDataCU   *pcCU          = rTu.getCU();
   const UInt    uiAbsPartIdx  = rTu.GetAbsPartIdxTU();
   const UInt    uiFullDepth   = rTu.GetTransformDepthTotal();
@@ -1921,6 +1924,7 @@ TEncSearch::xRecurIntraChromaCodingQT(TComYuv*    pcOrgYuv,
                                       TComTU&     rTu
                                       DEBUG_STRING_FN_DECLARE(sDebug))
 {
+  TComProfilingScope profilingScope( PROFILE_ENC_RQT );
   TComDataCU         *pcCU                  = rTu.getCU();
   const UInt          uiTrDepth             = rTu.GetTransformDepthRel();
   const UInt          uiAbsPartIdx          = rTu.GetAbsPartIdxTU();
@@ -2183,6 +2187,7 @@ TEncSearch::estIntraPredLumaQT(TComDataCU* pcCU,
                                Pel         resiLuma[NUMBER_OF_STORED_RESIDUAL_TYPES][MAX_CU_SIZE * MAX_CU_SIZE]
                                DEBUG_STRING_FN_DECLARE(sDebug))
 {
+  TComProfilingScope profilingScope( PROFILE_ENC_INTRA_SEARCH );
   const UInt         uiDepth               = pcCU->getDepth(0);
   const UInt         uiInitTrDepth         = pcCU->getPartitionSize(0) == SIZE_2Nx2N ? 0 : 1;
   const UInt         uiNumPU               = 1<<(2*uiInitTrDepth);
@@ -2568,6 +2573,7 @@ TEncSearch::estIntraPredChromaQT(TComDataCU* pcCU,
                                  Pel         resiLuma[NUMBER_OF_STORED_RESIDUAL_TYPES][MAX_CU_SIZE * MAX_CU_SIZE]
                                  DEBUG_STRING_FN_DECLARE(sDebug))
 {
+  TComProfilingScope profilingScope( PROFILE_ENC_INTRA_SEARCH );
   const UInt    uiInitTrDepth  = pcCU->getPartitionSize(0) != SIZE_2Nx2N && enable4ChromaPUsInIntraNxNCU(pcOrgYuv->getChromaFormat()) ? 1 : 0;
 
   TComTURecurse tuRecurseCU(pcCU, 0);
@@ -3633,6 +3639,7 @@ Distortion TEncSearch::xGetTemplateCost( TComDataCU* pcCU,
   TComPicYuv* pcPicYuvRef = pcCU->getSlice()->getRefPic( eRefPicList, iRefIdx )->getPicYuvRec();
 
   pcCU->clipMv( cMvCand );
+  xWaitForRefRows( pcCU, pcCU->getSlice()->getRefPic( eRefPicList, iRefIdx ), uiPartAddr, cMvCand, iSizeY );
 
   // prediction pattern
   if ( pcCU->getSlice()->testWeightPred() && pcCU->getSlice()->getSliceType()==P_SLICE )
@@ -3657,6 +3664,18 @@ Distortion TEncSearch::xGetTemplateCost( TComDataCU* pcCU,
 }
 
 
+Void TEncSearch::resetIntegerMv2Nx2N()
+{
+  for (UInt refList = 0; refList < NUM_REF_PIC_LIST_01; refList++)
+  {
+    for (UInt refIdx = 0; refIdx < MAX_NUM_REF; refIdx++)
+    {
+      m_integerMv2Nx2N[refList][refIdx].setZero();
+    }
+  }
+}
+
+
 Void TEncSearch::xMotionEstimation( TComDataCU* pcCU, TComYuv* pcYuvOrg, Int iPartIdx, RefPicList eRefPicList, TComMv* pcMvPred, Int iRefIdxPred, TComMv& rcMv, UInt& ruiBits, Distortion& ruiCost, Bool bBi  )
 {
   UInt          uiPartAddr;
@@ -3721,8 +3740,11 @@ Void TEncSearch::xMotionEstimation( TComDataCU* pcCU, TComYuv* pcYuvOrg, Int iPa
 
   setWpScalingDistParam( pcCU, iRefIdxPred, eRefPicList );
   //  Do integer search
+  // the reference picture may still be reconstructed by another picture: wait for the rows the search can reach
+  const TComPic* pcRefPic = pcCU->getSlice()->getRefPic( eRefPicList, iRefIdxPred );
   if ( (m_motionEstimationSearchMethod==MESEARCH_FULL) || bBi )
   {
+    xWaitForRefRows( pcCU, pcRefPic, uiPartAddr, TComMv( 0, cMvSrchRngRB.getVer() << 2 ), iRoiHeight );
     xPatternSearch      ( pcPatternKey, piRefY, iRefStride, &cMvSrchRngLT, &cMvSrchRngRB, rcMv, ruiCost );
   }
   else
@@ -3733,6 +3755,7 @@ Void TEncSearch::xMotionEstimation( TComDataCU* pcCU, TComYuv* pcYuvOrg, Int iPa
     {
       pIntegerMv2Nx2NPred = &(m_integerMv2Nx2N[eRefPicList][iRefIdxPred]);
     }
+    xWaitForRefRows( pcCU, pcRefPic, uiPartAddr, TComMv( 0, xGetFastSearchBottom( pcCU, rcMv, cMvSrchRngRB, pIntegerMv2Nx2NPred ) << 2 ), iRoiHeight );
     xPatternSearchFast  ( pcCU, pcPatternKey, piRefY, iRefStride, &cMvSrchRngLT, &cMvSrchRngRB, rcMv, ruiCost, pIntegerMv2Nx2NPred );
     if (pcCU->getPartitionSize(0) == SIZE_2Nx2N)
     {
@@ -3791,6 +3814,7 @@ Void TEncSearch::xPatternSearch( const TComPattern* const pcPatternKey,
                                  TComMv&      rcMv,
                                  Distortion&  ruiSAD )
 {
+  TComProfilingScope profilingScope( PROFILE_ENC_INTEGER_ME );
   Int   iSrchRngHorLeft   = pcMvSrchRngLT->getHor();
   Int   iSrchRngHorRight  = pcMvSrchRngRB->getHor();
   Int   iSrchRngVerTop    = pcMvSrchRngLT->getVer();
@@ -3847,6 +3871,35 @@ Void TEncSearch::xPatternSearch( const TComPattern* const pcPatternKey,
 }
 
 
+/** Bottom of the integer positions the fast searches can test, in integer samples: the search window, the start
+ * candidates (start MV, neighbouring predictors, zero and 2Nx2N MV) and the window re-centred on the best of them.
+ */
+Int TEncSearch::xGetFastSearchBottom( const TComDataCU* const pcCU,
+                                      const TComMv&           cMvStart,
+                                      const TComMv&           cMvSrchRngRB,
+                                      const TComMv* const     pIntegerMv2Nx2NPred )
+{
+  TComMv acMvCand[NUM_MV_PREDICTORS + 2];
+  pcCU->getMvPredLeft       ( acMvCand[MD_LEFT] );
+  pcCU->getMvPredAbove      ( acMvCand[MD_ABOVE] );
+  pcCU->getMvPredAboveRight ( acMvCand[MD_ABOVE_RIGHT] );
+  acMvCand[NUM_MV_PREDICTORS] = cMvStart;
+  if ( pIntegerMv2Nx2NPred != 0 )
+  {
+    acMvCand[NUM_MV_PREDICTORS + 1] = *pIntegerMv2Nx2NPred;
+    acMvCand[NUM_MV_PREDICTORS + 1] <<= 2;
+  }
+
+  Int iCandBottom = 0;
+  for ( UInt i = 0; i < NUM_MV_PREDICTORS + 2; i++ )
+  {
+    pcCU->clipMv( acMvCand[i] );
+    iCandBottom = max( iCandBottom, ( acMvCand[i].getVer() + 3 ) >> 2 );
+  }
+
+  return max( cMvSrchRngRB.getVer(), iCandBottom + ( pIntegerMv2Nx2NPred != 0 ? m_iSearchRange : 0 ) );
+}
+
 Void TEncSearch::xPatternSearchFast( const TComDataCU* const  pcCU,
                                      const TComPattern* const pcPatternKey,
                                      const Pel* const         piRefY,
@@ -3857,6 +3910,7 @@ Void TEncSearch::xPatternSearchFast( const TComDataCU* const  pcCU,
                                      Distortion&              ruiSAD,
                                      const TComMv* const      pIntegerMv2Nx2NPred )
 {
+  TComProfilingScope profilingScope( PROFILE_ENC_INTEGER_ME );
   assert (MD_LEFT < NUM_MV_PREDICTORS);
   pcCU->getMvPredLeft       ( m_acMvPredictors[MD_LEFT] );
   assert (MD_ABOVE < NUM_MV_PREDICTORS);
@@ -4378,6 +4432,7 @@ Void TEncSearch::xPatternSearchFracDIF(
                                        Distortion&  ruiCost
                                       )
 {
+  TComProfilingScope profilingScope( PROFILE_ENC_FRACTIONAL_ME );
   //  Reference pattern initialization (integer scale)
   TComPattern cPatternRoi;
   Int         iOffset    = pcMvInt->getHor() + pcMvInt->getVer() * iRefStride;
@@ -4561,6 +4616,7 @@ Void TEncSearch::xEstimateInterResidualQT( TComYuv    *pcResi,
                                            TComTU     &rTu
                                            DEBUG_STRING_FN_DECLARE(sDebug) )
 {
+  TComProfilingScope profilingScope( PROFILE_ENC_RQT );
   TComDataCU *pcCU        = rTu.getCU();
   const UInt uiAbsPartIdx = rTu.GetAbsPartIdxTU();
   const UInt uiDepth      = rTu.GetTransformDepthTotal();
@@ -5352,6 +5408,7 @@ Void TEncSearch::xSetInterResidualQTData( TComYuv* pcResi, Bool bSpatial, TComTU
 
 UInt TEncSearch::xModeBitsIntra( TComDataCU* pcCU, UInt uiMode, UInt uiPartOffset, UInt uiDepth, const ChannelType chType )
 {
+  TComProfilingScope profilingScope( PROFILE_ENC_RATE_ESTIMATION );
   // Reload only contexts required for coding intra mode information
   m_pcRDGoOnSbacCoder->loadIntraDirMode( m_pppcRDSbacCoder[uiDepth][CI_CURR_BEST], chType );
 
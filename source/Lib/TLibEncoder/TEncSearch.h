@@ -208,6 +208,9 @@ public:
   /// set ME search range
   Void setAdaptiveSearchRange   ( Int iDir, Int iRefIdx, Int iSearchRange) { assert(iDir < MAX_NUM_REF_LIST_ADAPT_SR && iRefIdx<Int(MAX_IDX_ADAPT_SR)); m_aaiAdaptSR[iDir][iRefIdx] = iSearchRange; }
 
+  /// forget the integer 2Nx2N motion vectors of the previous CTUs (used as fast-search predictors)
+  Void resetIntegerMv2Nx2N      ();
+
   Void xEncPCM    (TComDataCU* pcCU, UInt uiAbsPartIdx, Pel* piOrg, Pel* piPCM, Pel* piPred, Pel* piResi, Pel* piReco, UInt uiStride, UInt uiWidth, UInt uiHeight, const ComponentID compID );
   Void IPCMSearch (TComDataCU* pcCU, TComYuv* pcOrgYuv, TComYuv* rpcPredYuv, TComYuv* rpcResiYuv, TComYuv* rpcRecoYuv );
 protected:
@@ -398,6 +401,11 @@ protected:
                                     TComMv&      rcMvSrchRngLT,
                                     TComMv&      rcMvSrchRngRB );
 
+  Int  xGetFastSearchBottom       ( const TComDataCU* const pcCU,
+                                    const TComMv&      cMvStart,
+                                    const TComMv&      cMvSrchRngRB,
+                                    const TComMv* const pIntegerMv2Nx2NPred );
+
   Void xPatternSearchFast         ( const TComDataCU* const  pcCU,
                                     const TComPattern* const pcPatternKey,
                                     const Pel* const         piRefY,
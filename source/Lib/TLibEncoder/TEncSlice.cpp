@@ -37,6 +37,8 @@
 
 #include "TEncTop.h"
 #include "TEncSlice.h"
+#include "TEncLoopFilterPipeline.h"
+#include "TLibCommon/TComProfiler.h"
 #include <math.h>
 
 //! \ingroup TLibEncoder
@@ -48,6 +50,12 @@
 
 TEncSlice::TEncSlice()
  : m_encCABACTableIdx(I_SLICE)
+ , m_pcThreadPool(NULL)
+ , m_pcCtuWorkers(NULL)
+ , m_numCtuRows(0)
+ , m_pcCtuRowProgress(NULL)
+ , m_pcCtuRowSyncContextState(NULL)
+ , m_pcLoopFilterPipeline(NULL)
 {
 }
 
@@ -63,6 +71,11 @@ Void TEncSlice::create( Int iWidth, Int iHeight, ChromaFormat chromaFormat, UInt
 
   // create residual picture
   m_picYuvResi.create( iWidth, iHeight, chromaFormat, iMaxCUWidth, iMaxCUHeight, uhTotalDepth, true );
+
+  // create CTU row synchronisation data (used when CTU rows are compressed in parallel)
+  m_numCtuRows               = ( iHeight + iMaxCUHeight - 1 ) / iMaxCUHeight;
+  m_pcCtuRowProgress         = new TComProgressCounter[m_numCtuRows];
+  m_pcCtuRowSyncContextState = new TEncSbac[m_numCtuRows];
 }
 
 Void TEncSlice::destroy()
@@ -70,6 +83,12 @@ Void TEncSlice::destroy()
   m_picYuvPred.destroy();
   m_picYuvResi.destroy();
 
+  delete [] m_pcCtuRowProgress;
+  m_pcCtuRowProgress = NULL;
+  delete [] m_pcCtuRowSyncContextState;
+  m_pcCtuRowSyncContextState = NULL;
+  m_numCtuRows = 0;
+
   // free lambda and QP arrays
   m_vdRdPicLambda.clear();
   m_vdRdPicQp.clear();
@@ -94,6 +113,9 @@ Void TEncSlice::init( TEncTop* pcEncTop )
   m_pppcRDSbacCoder   = pcEncTop->getRDSbacCoder();
   m_pcRDGoOnSbacCoder = pcEncTop->getRDGoOnSbacCoder();
 
+  m_pcThreadPool      = pcEncTop->getThreadPool();
+  m_pcCtuWorkers      = pcEncTop->getCtuWorkers();
+
   // create lambda and QP arrays
   m_vdRdPicLambda.resize(m_pcCfg->getDeltaQpRD() * 2 + 1 );
   m_vdRdPicQp.resize(    m_pcCfg->getDeltaQpRD() * 2 + 1 );
@@ -101,6 +123,31 @@ Void TEncSlice::init( TEncTop* pcEncTop )
   m_pcRateCtrl        = pcEncTop->getRateCtrl();
 }
 
+/** The slice encoder compresses and encodes its pictures with the tools of the worker. The CTU ranges that can be
+    processed in parallel are submitted to the thread pool of the encoder, and use the tools of the other workers.
+    \param    pcEncTop     pointer of encoder class
+    \param    pcCtuWorker  CTU compression tools to be used
+    \param    pcCtuWorkers CTU compression tools of the tasks, one set per thread of the pool
+ */
+Void TEncSlice::init( TEncTop* pcEncTop, TEncCtuWorker* pcCtuWorker, TEncCtuWorker* pcCtuWorkers )
+{
+  init( pcEncTop );
+
+  m_pcCuEncoder       = pcCtuWorker->getCuEncoder();
+  m_pcPredSearch      = pcCtuWorker->getPredSearch();
+
+  m_pcEntropyCoder    = pcCtuWorker->getEntropyCoder();
+  m_pcSbacCoder       = pcCtuWorker->getSbacCoder();
+  m_pcBinCABAC        = pcCtuWorker->getBinCABAC();
+  m_pcTrQuant         = pcCtuWorker->getTrQuant();
+
+  m_pcRdCost          = pcCtuWorker->getRdCost();
+  m_pppcRDSbacCoder   = pcCtuWorker->getRDSbacCoder();
+  m_pcRDGoOnSbacCoder = pcCtuWorker->getRDGoOnSbacCoder();
+
+  m_pcCtuWorkers      = pcCtuWorkers;
+}
+
 Void TEncSlice::updateLambda(TComSlice* pSlice, Double dQP)
 {
   Int iQP = (Int)dQP;
@@ -560,6 +607,13 @@ Void TEncSlice::setSearchRange( TComSlice* pcSlice )
       iRefPOC = pcSlice->getRefPic(e, iRefIdx)->getPOC();
       Int newSearchRange = Clip3(m_pcCfg->getMinSearchWindow(), iMaxSR, (iMaxSR*ADAPT_SR_SCALE*abs(iCurrPOC - iRefPOC)+iOffset)/iGOPSize);
       m_pcPredSearch->setAdaptiveSearchRange(iDir, iRefIdx, newSearchRange);
+      if ( m_pcThreadPool )
+      {
+        for ( Int i = 0; i < m_pcThreadPool->getNumThreads(); i++ )
+        {
+          m_pcCtuWorkers[i].getPredSearch()->setAdaptiveSearchRange(iDir, iRefIdx, newSearchRange);
+        }
+      }
     }
   }
 }
@@ -787,7 +841,14 @@ Void TEncSlice::compressSlice( TComPic* pcPic, const Bool bCompressEntireSlice,
     }
   }
 
+  if ( xUseParallelCompression( pcSlice ) )
+  {
+    xCompressCtuRangesInParallel( pcPic, startCtuTsAddr, boundingCtuTsAddr, bFastDeltaQP );
+    return;
+  }
+
   // for every CTU in the slice segment (may terminate sooner if there is a byte limit on the slice-segment)
+  const Bool bIndependentCtuRanges = m_pcCfg->getEntropyCodingSyncEnabledFlag() || pcSlice->getPPS()->getNumTileColumnsMinus1() != 0 || pcSlice->getPPS()->getNumTileRowsMinus1() != 0;
 
   for( UInt ctuTsAddr = startCtuTsAddr; ctuTsAddr < boundingCtuTsAddr; ++ctuTsAddr )
   {
@@ -822,6 +883,12 @@ Void TEncSlice::compressSlice( TComPic* pcPic, const Bool bCompressEntireSlice,
       }
     }
 
+    // with WPP or tiles, the motion search must not depend on the previous CTU rows or tiles (so that these can also be compressed in parallel)
+    if ( bIndependentCtuRanges && ( ctuTsAddr == startCtuTsAddr || ctuRsAddr == firstCtuRsAddrOfTile || ( ctuXPosInCtus == tileXPosInCtus && m_pcCfg->getEntropyCodingSyncEnabledFlag() ) ) )
+    {
+      m_pcPredSearch->resetIntegerMv2Nx2N();
+    }
+
     // set go-on entropy coder (used for all trial encodings - the cu encoder and encoder search also have a copy of the same pointer)
     m_pcEntropyCoder->setEntropyCoder ( m_pcRDGoOnSbacCoder );
     m_pcEntropyCoder->setBitstream( &tempBitCounter );
@@ -959,6 +1026,11 @@ Void TEncSlice::compressSlice( TComPic* pcPic, const Bool bCompressEntireSlice,
     m_uiPicTotalBits += pCtu->getTotalBits();
     m_dPicRdCost     += pCtu->getTotalCost();
     m_uiPicDist      += pCtu->getTotalDistortion();
+
+    if ( m_pcLoopFilterPipeline )
+    {
+      m_pcLoopFilterPipeline->ctuCompressed( ctuRsAddr );
+    }
   }
 
   // store context state at the end of this slice-segment, in case the next slice is a dependent slice and continues using the CABAC contexts.
@@ -982,8 +1054,279 @@ Void TEncSlice::compressSlice( TComPic* pcPic, const Bool bCompressEntireSlice,
   //}
 }
 
+/** Check whether the CTUs of the current slice segment can be compressed by several threads.
+ * This is possible with WPP, where a CTU row only depends on the CTUs above and to the above-right, or with several
+ * tiles, which do not depend on each other (but not with both). Rate control, luma-level dependent QP, adaptive QP
+ * selection and slices limited by a number of bytes make the compression of a CTU depend on all previously
+ * compressed CTUs, so the CTUs are then compressed serially.
+ */
+Bool TEncSlice::xUseParallelCompression( const TComSlice* pcSlice )
+{
+  if ( !xUseParallelCtuRanges( pcSlice ) )
+  {
+    return false;
+  }
+  if ( m_pcCfg->getUseRateCtrl() || m_pcCfg->getLumaLevelToDeltaQPMapping().isEnabled() )
+  {
+    return false;
+  }
+#if ADAPTIVE_QP_SELECTION
+  if ( m_pcCfg->getUseAdaptQpSelect() )
+  {
+    return false;
+  }
+#endif
+  return pcSlice->getSliceMode() != FIXED_NUMBER_OF_BYTES && pcSlice->getSliceSegmentMode() != FIXED_NUMBER_OF_BYTES;
+}
+
+/** Check whether the slice segment can be split into CTU ranges (the CTU rows with WPP, or the tiles) that can be
+ * processed by several threads.
+ */
+Bool TEncSlice::xUseParallelCtuRanges( const TComSlice* pcSlice )
+{
+#if ENC_DEC_TRACE
+  // the trace is written in coding order.
+  return false;
+#else
+  const Bool bWavefronts    = pcSlice->getPPS()->getEntropyCodingSyncEnabledFlag();
+  const Bool bMultipleTiles = pcSlice->getPPS()->getNumTileColumnsMinus1() != 0 || pcSlice->getPPS()->getNumTileRowsMinus1() != 0;
+  return m_pcThreadPool != NULL && bWavefronts != bMultipleTiles;
+#endif
+}
+
+/** Split a slice segment into the CTU ranges that are processed by separate tasks: the CTU rows with WPP, the
+ * tiles otherwise.
+ * \param pcPic              picture class
+ * \param startCtuTsAddr     first CTU of the slice segment
+ * \param boundingCtuTsAddr  CTU following the last CTU of the slice segment
+ * \param tasks              resulting tasks, in CTU coding order
+ */
+Void TEncSlice::xInitCtuRangeTasks( TComPic* pcPic, const UInt startCtuTsAddr, const UInt boundingCtuTsAddr, std::vector<CtuRangeTask>& tasks )
+{
+  const TComPicSym &picSym           = *(pcPic->getPicSym());
+  const UInt       frameWidthInCtus  = picSym.getFrameWidthInCtus();
+  const Bool       bWavefronts       = pcPic->getSlice(getSliceIdx())->getPPS()->getEntropyCodingSyncEnabledFlag();
+
+  tasks.clear();
+  for( UInt ctuTsAddr = startCtuTsAddr; ctuTsAddr < boundingCtuTsAddr; ++ctuTsAddr )
+  {
+    const UInt ctuRsAddr            = picSym.getCtuTsToRsAddrMap(ctuTsAddr);
+    const UInt firstCtuRsAddrOfTile = picSym.getTComTile(picSym.getTileIdxMap(ctuRsAddr))->getFirstCtuRsAddr();
+    if ( ctuTsAddr == startCtuTsAddr || ctuRsAddr == firstCtuRsAddrOfTile || ( bWavefronts && ctuRsAddr % frameWidthInCtus == firstCtuRsAddrOfTile % frameWidthInCtus ) )
+    {
+      CtuRangeTask task;
+      task.pcSliceEncoder     = this;
+      task.pcPic              = pcPic;
+      task.startCtuTsAddr     = ctuTsAddr;
+      task.boundingCtuTsAddr  = ctuTsAddr + 1;
+      task.isFirst            = ctuTsAddr == startCtuTsAddr;
+      task.isLast             = false;
+      task.ctuRow             = bWavefronts ? Int(ctuRsAddr / frameWidthInCtus) : -1;
+      task.pcSyncContextState = NULL;
+      task.pcSubstream        = NULL;
+      task.pcWorker           = NULL;
+      task.numWrittenBits     = 0;
+      task.numBinsCoded       = 0;
+      tasks.push_back( task );
+    }
+    else
+    {
+      tasks.back().boundingCtuTsAddr = ctuTsAddr + 1;
+    }
+  }
+  tasks.back().isLast = true;
+}
+
+/** Compress the CTUs of a slice segment, one thread pool task per CTU range (CTU row or tile).
+ * With WPP, a CTU is only compressed once the CTU row above has progressed two CTUs further.
+ * The resulting decisions and bitstream are the same as those of the serial compression.
+ * \param pcPic              picture class
+ * \param startCtuTsAddr     first CTU of the slice segment
+ * \param boundingCtuTsAddr  CTU following the last CTU of the slice segment
+ * \param bFastDeltaQP       fast delta QP setting
+ */
+Void TEncSlice::xCompressCtuRangesInParallel( TComPic* pcPic, const UInt startCtuTsAddr, const UInt boundingCtuTsAddr, const Bool bFastDeltaQP )
+{
+  TComSlice* const pcSlice          = pcPic->getSlice(getSliceIdx());
+  const UInt       frameWidthInCtus = pcPic->getPicSym()->getFrameWidthInCtus();
+
+  for ( Int i = 0; i < m_pcThreadPool->getNumThreads(); i++ )
+  {
+    m_pcCtuWorkers[i].initSlice( m_pcRdCost, m_pcTrQuant, bFastDeltaQP );
+  }
+
+  std::vector<CtuRangeTask> tasks;
+  xInitCtuRangeTasks( pcPic, startCtuTsAddr, boundingCtuTsAddr, tasks );
+
+  // WPP (with a single tile): the row above stores its state after its second CTU if that CTU is part of this
+  // slice segment, otherwise the state stored by the previous slice segment is used.
+  Int lastSyncCtuRow = -1; // last CTU row whose state after its second CTU is stored in m_pcCtuRowSyncContextState
+  for ( Int i = 0; i < Int(tasks.size()); i++ )
+  {
+    CtuRangeTask &task = tasks[i];
+    if ( task.ctuRow >= 0 )
+    {
+      const UInt secondCtuOfRow = task.ctuRow * frameWidthInCtus + 1;
+      task.pcSyncContextState   = ( lastSyncCtuRow == task.ctuRow - 1 ) ? &m_pcCtuRowSyncContextState[task.ctuRow - 1] : &m_entropyCodingSyncContextState;
+      if ( frameWidthInCtus > 1 && task.startCtuTsAddr <= secondCtuOfRow && task.boundingCtuTsAddr > secondCtuOfRow )
+      {
+        lastSyncCtuRow = task.ctuRow;
+      }
+      m_pcCtuRowProgress[task.ctuRow].reset( task.startCtuTsAddr % frameWidthInCtus );
+    }
+  }
+
+  // initialize all CTU encoders first: the availability checks read the slice of neighbouring CTUs in other ranges.
+  for( UInt ctuTsAddr = startCtuTsAddr; ctuTsAddr < boundingCtuTsAddr; ++ctuTsAddr )
+  {
+    const UInt ctuRsAddr = pcPic->getPicSym()->getCtuTsToRsAddrMap(ctuTsAddr);
+    pcPic->getCtu( ctuRsAddr )->initCtu( pcPic, ctuRsAddr );
+  }
+
+  TComTaskGroup taskGroup;
+  for ( Int i = 0; i < Int(tasks.size()); i++ )
+  {
+    m_pcThreadPool->addTask( xCompressCtuRangeTask, &tasks[i], taskGroup );
+  }
+  m_pcThreadPool->waitForTasks( taskGroup );
+
+  if ( lastSyncCtuRow >= 0 )
+  {
+    m_entropyCodingSyncContextState.loadContexts( &m_pcCtuRowSyncContextState[lastSyncCtuRow] );
+  }
+  // continue with the state at the end of the slice segment, and store it in case the next slice is a dependent slice.
+  m_pppcRDSbacCoder[0][CI_CURR_BEST]->load( tasks.back().pcWorker->getRDSbacCoder()[0][CI_CURR_BEST] );
+  if( pcSlice->getPPS()->getDependentSliceSegmentsEnabledFlag() )
+  {
+    m_lastSliceSegmentEndContextState.loadContexts( m_pppcRDSbacCoder[0][CI_CURR_BEST] );
+  }
+
+  for ( Int i = 0; i < Int(tasks.size()); i++ )
+  {
+    pcSlice->setSliceBits( (UInt)(pcSlice->getSliceBits() + tasks[i].numWrittenBits) );
+    pcSlice->setSliceSegmentBits( pcSlice->getSliceSegmentBits() + tasks[i].numWrittenBits );
+  }
+
+  for( UInt ctuTsAddr = startCtuTsAddr; ctuTsAddr < boundingCtuTsAddr; ++ctuTsAddr )
+  {
+    TComDataCU* pCtu = pcPic->getCtu( pcPic->getPicSym()->getCtuTsToRsAddrMap(ctuTsAddr) );
+    m_uiPicTotalBits += pCtu->getTotalBits();
+    m_dPicRdCost     += pCtu->getTotalCost();
+    m_uiPicDist      += pCtu->getTotalDistortion();
+  }
+}
+
+Void TEncSlice::xCompressCtuRangeTask( Void* param, Int threadIdx )
+{
+  CtuRangeTask* pTask = (CtuRangeTask*)param;
+  pTask->pcSliceEncoder->xCompressCtuRange( *pTask, pTask->pcSliceEncoder->m_pcCtuWorkers[threadIdx] );
+}
+
+/** Compress the CTUs of one CTU range of a slice segment using the tools of the given worker.
+ * This follows the serial loop of compressSlice().
+ */
+Void TEncSlice::xCompressCtuRange( CtuRangeTask& task, TEncCtuWorker& worker )
+{
+  TComPic* const    pcPic            = task.pcPic;
+  TComSlice* const  pcSlice          = pcPic->getSlice(getSliceIdx());
+  const UInt        frameWidthInCtus = pcPic->getPicSym()->getFrameWidthInCtus();
+  const Bool        bWavefronts      = task.ctuRow >= 0;
+
+  TEncCu* const     pcCuEncoder      = worker.getCuEncoder();
+  TEncEntropy*const pcEntropyCoder   = worker.getEntropyCoder();
+  TEncSbac* const   pcRDCurrBest     = worker.getRDSbacCoder()[0][CI_CURR_BEST];
+  TEncSbac* const   pcRDGoOnSbac     = worker.getRDGoOnSbacCoder();
+  TComBitCounter&   tempBitCounter   = *worker.getBitCounter();
+
+  if ( task.isFirst )
+  {
+    // continue from the state at the start of the slice segment.
+    pcRDCurrBest->load( m_pppcRDSbacCoder[0][CI_CURR_BEST] );
+  }
+  TEncBinCABAC* pRDSbacCoder = (TEncBinCABAC *) pcRDCurrBest->getEncBinIf();
+  pRDSbacCoder->setBinCountingEnableFlag( false );
+  pRDSbacCoder->setBinsCoded( 0 );
+
+  worker.getPredSearch()->resetIntegerMv2Nx2N();
+
+  for( UInt ctuTsAddr = task.startCtuTsAddr; ctuTsAddr < task.boundingCtuTsAddr; ++ctuTsAddr )
+  {
+    const UInt ctuRsAddr            = pcPic->getPicSym()->getCtuTsToRsAddrMap(ctuTsAddr);
+    const UInt firstCtuRsAddrOfTile = pcPic->getPicSym()->getTComTile(pcPic->getPicSym()->getTileIdxMap(ctuRsAddr))->getFirstCtuRsAddr();
+    const UInt tileXPosInCtus       = firstCtuRsAddrOfTile % frameWidthInCtus;
+    const UInt ctuXPosInCtus        = ctuRsAddr % frameWidthInCtus;
+
+    // wait for the CTU above-right to be compressed.
+    if ( bWavefronts && !task.isFirst )
+    {
+      m_pcCtuRowProgress[task.ctuRow - 1].waitFor( min( ctuXPosInCtus + 2, frameWidthInCtus ) );
+    }
+
+    TComDataCU* pCtu = pcPic->getCtu( ctuRsAddr );
+
+    // update CABAC state
+    if ( ctuRsAddr == firstCtuRsAddrOfTile )
+    {
+      pcRDCurrBest->resetEntropy(pcSlice);
+    }
+    else if ( ctuXPosInCtus == tileXPosInCtus && bWavefronts )
+    {
+      // reset and then update contexts to the state at the end of the top-right CTU (if within current slice and tile).
+      pcRDCurrBest->resetEntropy(pcSlice);
+      TComDataCU *pCtuUp = pCtu->getCtuAbove();
+      if ( pCtuUp && ((ctuRsAddr%frameWidthInCtus+1) < frameWidthInCtus)  )
+      {
+        TComDataCU *pCtuTR = pcPic->getCtu( ctuRsAddr - frameWidthInCtus + 1 );
+        if ( pCtu->CUIsFromSameSliceAndTile(pCtuTR) )
+        {
+          pcRDCurrBest->loadContexts( task.pcSyncContextState );
+        }
+      }
+    }
+
+    // set go-on entropy coder
+    pcEntropyCoder->setEntropyCoder ( pcRDGoOnSbac );
+    pcEntropyCoder->setBitstream( &tempBitCounter );
+    tempBitCounter.resetBits();
+    pcRDGoOnSbac->load( pcRDCurrBest );
+
+    ((TEncBinCABAC*)pcRDGoOnSbac->getEncBinIf())->setBinCountingEnableFlag(true);
+
+    // run CTU trial encoder
+    pcCuEncoder->compressCtu( pCtu );
+
+    // encode CTU and calculate the true bit counters.
+    pcEntropyCoder->setEntropyCoder ( pcRDCurrBest );
+    pcEntropyCoder->setBitstream( &tempBitCounter );
+    pRDSbacCoder->setBinCountingEnableFlag( true );
+    pcRDCurrBest->resetBits();
+    pRDSbacCoder->setBinsCoded( 0 );
+
+    pcCuEncoder->encodeCtu( pCtu );
+
+    pRDSbacCoder->setBinCountingEnableFlag( false );
+
+    task.numWrittenBits += pcEntropyCoder->getNumberOfWrittenBits();
+
+    if ( bWavefronts )
+    {
+      // Store probabilities of second CTU in line into buffer.
+      if ( ctuXPosInCtus == tileXPosInCtus+1 )
+      {
+        m_pcCtuRowSyncContextState[task.ctuRow].loadContexts( pcRDCurrBest );
+      }
+      m_pcCtuRowProgress[task.ctuRow].set( ctuXPosInCtus + 1 );
+    }
+  }
+
+  pcRDCurrBest->setBitstream(NULL);
+  pcRDGoOnSbac->setBitstream(NULL);
+  task.pcWorker = &worker;
+}
+
 Void TEncSlice::encodeSlice   ( TComPic* pcPic, TComOutputBitstream* pcSubstreams, UInt &numBinsCoded )
 {
+  TComProfilingScope profilingScope( PROFILE_ENC_ENTROPY_CODING );
   TComSlice *const pcSlice           = pcPic->getSlice(getSliceIdx());
 
   const UInt startCtuTsAddr          = pcSlice->getSliceSegmentCurStartCtuTsAddr();
@@ -1031,6 +1374,13 @@ Void TEncSlice::encodeSlice   ( TComPic* pcPic, TComOutputBitstream* pcSubstream
     }
   }
 
+  if ( xUseParallelCtuRanges( pcSlice ) )
+  {
+    xEncodeCtuRangesInParallel( pcPic, pcSubstreams );
+    xFinishEncodeSlice( pcSlice, numBinsCoded );
+    return;
+  }
+
   // for every CTU in the slice segment...
 
   for( UInt ctuTsAddr = startCtuTsAddr; ctuTsAddr < boundingCtuTsAddr; ++ctuTsAddr )
@@ -1075,42 +1425,7 @@ Void TEncSlice::encodeSlice   ( TComPic* pcPic, TComOutputBitstream* pcSubstream
     }
 
 
-    if ( pcSlice->getSPS()->getUseSAO() )
-    {
-      Bool bIsSAOSliceEnabled = false;
-      Bool sliceEnabled[MAX_NUM_COMPONENT];
-      for(Int comp=0; comp < MAX_NUM_COMPONENT; comp++)
-      {
-        ComponentID compId=ComponentID(comp);
-        sliceEnabled[compId] = pcSlice->getSaoEnabledFlag(toChannelType(compId)) && (comp < pcPic->getNumberValidComponents());
-        if (sliceEnabled[compId])
-        {
-          bIsSAOSliceEnabled=true;
-        }
-      }
-      if (bIsSAOSliceEnabled)
-      {
-        SAOBlkParam& saoblkParam = (pcPic->getPicSym()->getSAOBlkParam())[ctuRsAddr];
-
-        Bool leftMergeAvail = false;
-        Bool aboveMergeAvail= false;
-        //merge left condition
-        Int rx = (ctuRsAddr % frameWidthInCtus);
-        if(rx > 0)
-        {
-          leftMergeAvail = pcPic->getSAOMergeAvailability(ctuRsAddr, ctuRsAddr-1);
-        }
-
-        //merge up condition
-        Int ry = (ctuRsAddr / frameWidthInCtus);
-        if(ry > 0)
-        {
-          aboveMergeAvail = pcPic->getSAOMergeAvailability(ctuRsAddr, ctuRsAddr-frameWidthInCtus);
-        }
-
-        m_pcEntropyCoder->encodeSAOBlkParam(saoblkParam, pcPic->getPicSym()->getSPS().getBitDepths(), sliceEnabled, leftMergeAvail, aboveMergeAvail);
-      }
-    }
+    xEncodeSAOBlkParam( m_pcEntropyCoder, pcPic, pcSlice, ctuRsAddr );
 
 #if ENC_DEC_TRACE
     g_bJustDoIt = g_bEncDecTraceEnable;
@@ -1146,7 +1461,14 @@ Void TEncSlice::encodeSlice   ( TComPic* pcPic, TComOutputBitstream* pcSubstream
     }
   } // CTU-loop
 
-  if( depSliceSegmentsEnabled )
+  xFinishEncodeSlice( pcSlice, numBinsCoded );
+}
+
+/** Store the state at the end of an encoded slice segment, and decide the cabac_init_flag of the next picture.
+ */
+Void TEncSlice::xFinishEncodeSlice( TComSlice* pcSlice, UInt &numBinsCoded )
+{
+  if( pcSlice->getPPS()->getDependentSliceSegmentsEnabledFlag() )
   {
     m_lastSliceSegmentEndContextState.loadContexts( m_pcSbacCoder );//ctx end of dep.slice
   }
@@ -1170,6 +1492,200 @@ Void TEncSlice::encodeSlice   ( TComPic* pcPic, TComOutputBitstream* pcSubstream
   numBinsCoded = m_pcBinCABAC->getBinsCoded();
 }
 
+/** Encode the CTUs of a slice segment into their substreams, one thread pool task per CTU range (CTU row or tile).
+ * With WPP, a CTU row is only encoded once the row above has encoded its second CTU.
+ * \param pcPic         picture class
+ * \param pcSubstreams  substreams of the slice segment
+ */
+Void TEncSlice::xEncodeCtuRangesInParallel( TComPic* pcPic, TComOutputBitstream* pcSubstreams )
+{
+  TComSlice *const pcSlice           = pcPic->getSlice(getSliceIdx());
+  const UInt       frameWidthInCtus  = pcPic->getPicSym()->getFrameWidthInCtus();
+
+  std::vector<CtuRangeTask> tasks;
+  xInitCtuRangeTasks( pcPic, pcSlice->getSliceSegmentCurStartCtuTsAddr(), pcSlice->getSliceSegmentCurEndCtuTsAddr(), tasks );
+
+  Int lastSyncCtuRow = -1; // last CTU row whose state after its second CTU is stored in m_pcCtuRowSyncContextState
+  for ( Int i = 0; i < Int(tasks.size()); i++ )
+  {
+    CtuRangeTask &task = tasks[i];
+    task.pcSubstream   = &pcSubstreams[pcPic->getSubstreamForCtuAddr(task.startCtuTsAddr, false, pcSlice)];
+    if ( task.ctuRow >= 0 )
+    {
+      const UInt secondCtuOfRow = task.ctuRow * frameWidthInCtus + 1;
+      task.pcSyncContextState   = ( lastSyncCtuRow == task.ctuRow - 1 ) ? &m_pcCtuRowSyncContextState[task.ctuRow - 1] : &m_entropyCodingSyncContextState;
+      if ( frameWidthInCtus > 1 && task.startCtuTsAddr <= secondCtuOfRow && task.boundingCtuTsAddr > secondCtuOfRow )
+      {
+        lastSyncCtuRow = task.ctuRow;
+      }
+      m_pcCtuRowProgress[task.ctuRow].reset( task.startCtuTsAddr % frameWidthInCtus );
+    }
+  }
+
+  TComTaskGroup taskGroup;
+  for ( Int i = 0; i < Int(tasks.size()); i++ )
+  {
+    m_pcThreadPool->addTask( xEncodeCtuRangeTask, &tasks[i], taskGroup );
+  }
+  m_pcThreadPool->waitForTasks( taskGroup );
+
+  if ( lastSyncCtuRow >= 0 )
+  {
+    m_entropyCodingSyncContextState.loadContexts( &m_pcCtuRowSyncContextState[lastSyncCtuRow] );
+  }
+
+  // every range ends its substream; the sizes of all but the last substream are signalled in the slice header.
+  UInt numBinsCoded = 0;
+  for ( Int i = 0; i < Int(tasks.size()); i++ )
+  {
+    if ( !tasks[i].isLast )
+    {
+      pcSlice->addSubstreamSize( (tasks[i].pcSubstream->getNumberOfWrittenBits() >> 3) + tasks[i].pcSubstream->countStartCodeEmulations() );
+    }
+    numBinsCoded += tasks[i].numBinsCoded;
+  }
+  m_pcBinCABAC->setBinsCoded( numBinsCoded );
+
+  // continue with the final contexts, e.g. for the next dependent slice segment.
+  m_pcSbacCoder->loadContexts( tasks.back().pcWorker->getSbacCoder() );
+}
+
+Void TEncSlice::xEncodeCtuRangeTask( Void* param, Int threadIdx )
+{
+  CtuRangeTask* pTask = (CtuRangeTask*)param;
+  pTask->pcSliceEncoder->xEncodeCtuRange( *pTask, pTask->pcSliceEncoder->m_pcCtuWorkers[threadIdx] );
+}
+
+/** Encode the CTUs of one CTU range of a slice segment into its substream using the tools of the given worker.
+ * This follows the serial loop of encodeSlice().
+ */
+Void TEncSlice::xEncodeCtuRange( CtuRangeTask& task, TEncCtuWorker& worker )
+{
+  TComPic* const    pcPic            = task.pcPic;
+  TComSlice* const  pcSlice          = pcPic->getSlice(getSliceIdx());
+  const UInt        frameWidthInCtus = pcPic->getPicSym()->getFrameWidthInCtus();
+  const Bool        bWavefronts      = task.ctuRow >= 0;
+
+  TEncEntropy*const pcEntropyCoder   = worker.getEntropyCoder();
+  TEncSbac* const   pcSbacCoder      = worker.getSbacCoder();
+  TEncBinCABAC*const pcBinCABAC      = worker.getBinCABAC();
+
+  pcEntropyCoder->setEntropyCoder ( pcSbacCoder );
+  pcEntropyCoder->setBitstream    ( task.pcSubstream );
+  if ( task.isFirst )
+  {
+    // continue from the state at the start of the slice segment.
+    pcSbacCoder->load( m_pcSbacCoder );
+  }
+  pcBinCABAC->setBinCountingEnableFlag( true );
+  pcBinCABAC->setBinsCoded(0);
+
+  for( UInt ctuTsAddr = task.startCtuTsAddr; ctuTsAddr < task.boundingCtuTsAddr; ++ctuTsAddr )
+  {
+    const UInt ctuRsAddr            = pcPic->getPicSym()->getCtuTsToRsAddrMap(ctuTsAddr);
+    const UInt firstCtuRsAddrOfTile = pcPic->getPicSym()->getTComTile(pcPic->getPicSym()->getTileIdxMap(ctuRsAddr))->getFirstCtuRsAddr();
+    const UInt tileXPosInCtus       = firstCtuRsAddrOfTile % frameWidthInCtus;
+    const UInt ctuXPosInCtus        = ctuRsAddr % frameWidthInCtus;
+    TComDataCU* pCtu = pcPic->getCtu( ctuRsAddr );
+
+    // set up CABAC contexts' state for this CTU (the state at the start of the slice segment has already been set up)
+    const Bool bStartOfSliceSegment = task.isFirst && ctuTsAddr == task.startCtuTsAddr;
+    if ( ctuRsAddr == firstCtuRsAddrOfTile )
+    {
+      if ( !bStartOfSliceSegment )
+      {
+        pcEntropyCoder->resetEntropy(pcSlice);
+      }
+    }
+    else if ( ctuXPosInCtus == tileXPosInCtus && bWavefronts )
+    {
+      if ( !bStartOfSliceSegment )
+      {
+        pcEntropyCoder->resetEntropy(pcSlice);
+      }
+      TComDataCU *pCtuUp = pCtu->getCtuAbove();
+      if ( pCtuUp && ((ctuRsAddr%frameWidthInCtus+1) < frameWidthInCtus)  )
+      {
+        TComDataCU *pCtuTR = pcPic->getCtu( ctuRsAddr - frameWidthInCtus + 1 );
+        if ( pCtu->CUIsFromSameSliceAndTile(pCtuTR) )
+        {
+          // wait for the row above to have encoded the top-right CTU.
+          if ( !task.isFirst )
+          {
+            m_pcCtuRowProgress[task.ctuRow - 1].waitFor( ctuXPosInCtus + 2 );
+          }
+          pcSbacCoder->loadContexts( task.pcSyncContextState );
+        }
+      }
+    }
+
+    xEncodeSAOBlkParam( pcEntropyCoder, pcPic, pcSlice, ctuRsAddr );
+
+    worker.getCuEncoder()->encodeCtu( pCtu );
+
+    if ( bWavefronts )
+    {
+      //Store probabilities of second CTU in line into buffer
+      if ( ctuXPosInCtus == tileXPosInCtus+1 )
+      {
+        m_pcCtuRowSyncContextState[task.ctuRow].loadContexts( pcSbacCoder );
+      }
+      m_pcCtuRowProgress[task.ctuRow].set( ctuXPosInCtus + 1 );
+    }
+  }
+
+  // terminate the sub-stream: a range ends at the end of a slice-segment, of a tile or of a wavefront-CTU-row.
+  pcEntropyCoder->encodeTerminatingBit(1);
+  pcEntropyCoder->encodeSliceFinish();
+  task.pcSubstream->writeByteAlignment();
+
+  task.numBinsCoded = pcBinCABAC->getBinsCoded();
+  task.pcWorker     = &worker;
+}
+
+/** Encode the SAO parameters of a CTU, if SAO is enabled in the slice.
+ */
+Void TEncSlice::xEncodeSAOBlkParam( TEncEntropy* pcEntropyCoder, TComPic* pcPic, const TComSlice* pcSlice, const UInt ctuRsAddr )
+{
+  if ( pcSlice->getSPS()->getUseSAO() )
+  {
+    const UInt frameWidthInCtus = pcPic->getPicSym()->getFrameWidthInCtus();
+    Bool bIsSAOSliceEnabled = false;
+    Bool sliceEnabled[MAX_NUM_COMPONENT];
+    for(Int comp=0; comp < MAX_NUM_COMPONENT; comp++)
+    {
+      ComponentID compId=ComponentID(comp);
+      sliceEnabled[compId] = pcSlice->getSaoEnabledFlag(toChannelType(compId)) && (comp < pcPic->getNumberValidComponents());
+      if (sliceEnabled[compId])
+      {
+        bIsSAOSliceEnabled=true;
+      }
+    }
+    if (bIsSAOSliceEnabled)
+    {
+      SAOBlkParam& saoblkParam = (pcPic->getPicSym()->getSAOBlkParam())[ctuRsAddr];
+
+      Bool leftMergeAvail = false;
+      Bool aboveMergeAvail= false;
+      //merge left condition
+      Int rx = (ctuRsAddr % frameWidthInCtus);
+      if(rx > 0)
+      {
+        leftMergeAvail = pcPic->getSAOMergeAvailability(ctuRsAddr, ctuRsAddr-1);
+      }
+
+      //merge up condition
+      Int ry = (ctuRsAddr / frameWidthInCtus);
+      if(ry > 0)
+      {
+        aboveMergeAvail = pcPic->getSAOMergeAvailability(ctuRsAddr, ctuRsAddr-frameWidthInCtus);
+      }
+
+      pcEntropyCoder->encodeSAOBlkParam(saoblkParam, pcPic->getPicSym()->getSPS().getBitDepths(), sliceEnabled, leftMergeAvail, aboveMergeAvail);
+    }
+  }
+}
+
 Void TEncSlice::calculateBoundingCtuTsAddrForSlice(UInt &startCtuTSAddrSlice, UInt &boundingCtuTSAddrSlice, Bool &haveReachedTileBoundary,
                                                    TComPic* pcPic, const Int sliceMode, const Int sliceArgument)
 {
@@ -43,7 +43,9 @@
 #include "TLibCommon/TComList.h"
 #include "TLibCommon/TComPic.h"
 #include "TLibCommon/TComPicYuv.h"
+#include "TLibCommon/TComThreadPool.h"
 #include "TEncCu.h"
+#include "TEncCtuWorker.h"
 #include "WeightPredAnalysis.h"
 #include "TEncRateCtrl.h"
 
@@ -52,6 +54,7 @@
 
 class TEncTop;
 class TEncGOP;
+class TEncLoopFilterPipeline;
 
 // ====================================================================================================================
 // Class definition
@@ -100,6 +103,31 @@ private:
   SliceType               m_encCABACTableIdx;
   Int                     m_gopID;
 
+  // multi-threading
+  TComThreadPool*         m_pcThreadPool;                       ///< thread pool (NULL if single-threaded)
+  TEncCtuWorker*          m_pcCtuWorkers;                       ///< CTU compression tools, one set per thread of the pool
+  Int                     m_numCtuRows;                         ///< number of CTU rows in the picture
+  TComProgressCounter*    m_pcCtuRowProgress;                   ///< number of compressed CTUs of each CTU row (parallel WPP)
+  TEncSbac*               m_pcCtuRowSyncContextState;           ///< context state after the second CTU of each CTU row (parallel WPP)
+  TEncLoopFilterPipeline* m_pcLoopFilterPipeline;               ///< loop filter of the CTU rows of the picture as they are compressed (NULL if filtered afterwards)
+
+  /// CTU range (CTU row with WPP, tile otherwise) of a slice segment, compressed or encoded by a thread pool task
+  struct CtuRangeTask
+  {
+    TEncSlice*           pcSliceEncoder;
+    TComPic*             pcPic;
+    UInt                 startCtuTsAddr;
+    UInt                 boundingCtuTsAddr;
+    Bool                 isFirst;                               ///< the range starts the slice segment
+    Bool                 isLast;                                ///< the range ends the slice segment
+    Int                  ctuRow;                                ///< CTU row of the range with WPP, -1 otherwise
+    const TEncSbac*      pcSyncContextState;                    ///< context state after the second CTU of the row above (WPP)
+    TComOutputBitstream* pcSubstream;                           ///< substream of the range (encoding only)
+    TEncCtuWorker*       pcWorker;                              ///< worker that has processed the range
+    UInt                 numWrittenBits;
+    UInt                 numBinsCoded;
+  };
+
   Double   calculateLambda( const TComSlice* pSlice, const Int GOPid, const Int depth, const Double refQP, const Double dQP, Int &iQP );
   Void     setUpLambda(TComSlice* slice, const Double dLambda, Int iQP);
   Void     calculateBoundingCtuTsAddrForSlice(UInt &startCtuTSAddrSlice, UInt &boundingCtuTSAddrSlice, Bool &haveReachedTileBoundary, TComPic* pcPic, const Int sliceMode, const Int sliceArgument);
@@ -111,6 +139,7 @@ public:
   Void    create              ( Int iWidth, Int iHeight, ChromaFormat chromaFormat, UInt iMaxCUWidth, UInt iMaxCUHeight, UChar uhTotalDepth );
   Void    destroy             ();
   Void    init                ( TEncTop* pcEncTop );
+  Void    init                ( TEncTop* pcEncTop, TEncCtuWorker* pcCtuWorker, TEncCtuWorker* pcCtuWorkers );   ///< use the CTU tools of the workers, with the thread pool of the encoder
 
   /// preparation of slice encoding (reference marking, QP and lambda)
   Void    initEncSlice        ( TComPic*  pcPic, const Int pocLast, const Int pocCurr,
@@ -135,9 +164,24 @@ public:
   Void    setSliceIdx(UInt i)   { m_uiSliceIdx = i;                       }
 
   SliceType getEncCABACTableIdx() const           { return m_encCABACTableIdx;        }
+  Void      setEncCABACTableIdx(SliceType b)      { m_encCABACTableIdx = b;           }
+
+  Void      setLoopFilterPipeline(TEncLoopFilterPipeline* p) { m_pcLoopFilterPipeline = p; }
 
 private:
   Double  xGetQPValueAccordingToLambda ( Double lambda );
+
+  Bool    xUseParallelCompression      ( const TComSlice* pcSlice );
+  Bool    xUseParallelCtuRanges        ( const TComSlice* pcSlice );
+  Void    xInitCtuRangeTasks           ( TComPic* pcPic, const UInt startCtuTsAddr, const UInt boundingCtuTsAddr, std::vector<CtuRangeTask>& tasks );
+  Void    xCompressCtuRangesInParallel ( TComPic* pcPic, const UInt startCtuTsAddr, const UInt boundingCtuTsAddr, const Bool bFastDeltaQP );
+  Void    xCompressCtuRange            ( CtuRangeTask& task, TEncCtuWorker& worker );
+  static Void xCompressCtuRangeTask    ( Void* param, Int threadIdx );
+  Void    xEncodeCtuRangesInParallel   ( TComPic* pcPic, TComOutputBitstream* pcSubstreams );
+  Void    xEncodeCtuRange              ( CtuRangeTask& task, TEncCtuWorker& worker );
+  static Void xEncodeCtuRangeTask      ( Void* param, Int threadIdx );
+  Void    xFinishEncodeSlice           ( TComSlice* pcSlice, UInt &numBinsCoded );
+  Void    xEncodeSAOBlkParam           ( TEncEntropy* pcEntropyCoder, TComPic* pcPic, const TComSlice* pcSlice, const UInt ctuRsAddr );
 };
 
 //! \}
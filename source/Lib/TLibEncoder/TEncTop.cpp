@@ -59,6 +59,9 @@ TEncTop::TEncTop() :
   m_uiNumAllPicCoded  =  0;
   m_pppcRDSbacCoder   =  NULL;
   m_pppcBinCoderCABAC =  NULL;
+  m_pcCtuWorkers      =  NULL;
+  m_pcFrameSliceEncoders = NULL;
+  m_pcFrameCtuWorkers =  NULL;
   m_cRDGoOnSbacCoder.init( &m_cRDGoOnBinCoderCABAC );
 #if ENC_DEC_TRACE
   if (g_hTrace == NULL)
@@ -142,6 +145,32 @@ Void TEncTop::create ()
       m_pppcRDSbacCoder   [iDepth][iCIIdx]->init( m_pppcBinCoderCABAC [iDepth][iCIIdx] );
     }
   }
+
+  if ( m_numWorkerThreads > 1 )
+  {
+    m_cThreadPool.create( m_numWorkerThreads );
+    m_pcCtuWorkers = new TEncCtuWorker[m_numWorkerThreads];
+    for ( Int i = 0; i < m_numWorkerThreads; i++ )
+    {
+      m_pcCtuWorkers[i].create( this );
+    }
+  }
+
+  // pictures compressed concurrently each get a slice encoder with its own CTU compression tools, and one set of
+  // tools per thread of the pool for the CTU ranges (WPP rows or tiles) it compresses in parallel
+  if ( xUseFrameParallelism() )
+  {
+    m_pcFrameSliceEncoders = new TEncSlice[m_numParallelFrames];
+    m_pcFrameCtuWorkers    = new TEncCtuWorker[m_numParallelFrames * ( m_numWorkerThreads + 1 )];
+    for ( Int i = 0; i < m_numParallelFrames; i++ )
+    {
+      m_pcFrameSliceEncoders[i].create( getSourceWidth(), getSourceHeight(), m_chromaFormatIDC, m_maxCUWidth, m_maxCUHeight, m_maxTotalCUDepth );
+    }
+    for ( Int i = 0; i < m_numParallelFrames * ( m_numWorkerThreads + 1 ); i++ )
+    {
+      m_pcFrameCtuWorkers[i].create( this );
+    }
+  }
 }
 
 Void TEncTop::destroy ()
@@ -155,6 +184,23 @@ Void TEncTop::destroy ()
   m_cLoopFilter.        destroy();
   m_cRateCtrl.          destroy();
   m_cSearch.            destroy();
+  m_cThreadPool.        destroy();
+  if ( m_pcCtuWorkers )
+  {
+    delete [] m_pcCtuWorkers;
+    m_pcCtuWorkers = NULL;
+  }
+  if ( m_pcFrameSliceEncoders )
+  {
+    for ( Int i = 0; i < m_numParallelFrames; i++ )
+    {
+      m_pcFrameSliceEncoders[i].destroy();
+    }
+    delete [] m_pcFrameSliceEncoders;
+    delete [] m_pcFrameCtuWorkers;
+    m_pcFrameSliceEncoders = NULL;
+    m_pcFrameCtuWorkers    = NULL;
+  }
   Int iDepth;
   for ( iDepth = 0; iDepth < m_maxTotalCUDepth+1; iDepth++ )
   {
@@ -180,6 +226,28 @@ Void TEncTop::destroy ()
   return;
 }
 
+/** Pictures are only compressed concurrently when they do not share encoder state across pictures:
+    rate control and adaptive QP selection update their models picture by picture.
+ */
+Bool TEncTop::xUseFrameParallelism() const
+{
+#if ENC_DEC_TRACE
+  return false;
+#else
+  if ( m_numParallelFrames <= 1 || m_numWorkerThreads <= 1 || m_RCEnableRateControl )
+  {
+    return false;
+  }
+#if ADAPTIVE_QP_SELECTION
+  if ( m_bUseAdaptQpSelect )
+  {
+    return false;
+  }
+#endif
+  return true;
+#endif
+}
+
 Void TEncTop::init(Bool isFieldCoding)
 {
   TComSPS &sps0=*(m_spsMap.allocatePS(0)); // NOTE: implementations that use more than 1 SPS need to be aware of activation issues.
@@ -195,6 +263,8 @@ Void TEncTop::init(Bool isFieldCoding)
 
   m_cRdCost.setCostMode(m_costMode);
 
+  TComProfilingScope::setEnabled(m_profiling);
+
   // initialize PPS
   xInitPPS(pps0, sps0);
   xInitRPS(sps0, isFieldCoding);
@@ -230,6 +300,30 @@ Void TEncTop::init(Bool isFieldCoding)
   // initialize encoder search class
   m_cSearch.init( this, &m_cTrQuant, m_iSearchRange, m_bipredSearchRange, m_motionEstimationSearchMethod, m_maxCUWidth, m_maxCUHeight, m_maxTotalCUDepth, &m_cEntropyCoder, &m_cRdCost, getRDSbacCoder(), getRDGoOnSbacCoder() );
 
+  // initialize the CTU compression tools of the worker threads
+  if ( m_pcCtuWorkers )
+  {
+    for ( Int i = 0; i < m_numWorkerThreads; i++ )
+    {
+      m_pcCtuWorkers[i].init( this, sps0 );
+    }
+  }
+
+  // initialize the slice encoders of the pictures that are compressed concurrently
+  if ( m_pcFrameSliceEncoders )
+  {
+    for ( Int i = 0; i < m_numParallelFrames; i++ )
+    {
+      TEncCtuWorker* pcCtuWorkers = &m_pcFrameCtuWorkers[i * ( m_numWorkerThreads + 1 )];
+      for ( Int j = 0; j <= m_numWorkerThreads; j++ )
+      {
+        pcCtuWorkers[j].init( this, sps0 );
+        pcCtuWorkers[j].getCuEncoder()->setSliceEncoder( &m_pcFrameSliceEncoders[i] );
+      }
+      m_pcFrameSliceEncoders[i].init( this, &pcCtuWorkers[0], &pcCtuWorkers[1] );
+    }
+  }
+
   m_iMaxRefPicNum = 0;
 }
 
@@ -44,6 +44,7 @@
 #include "TLibCommon/TComTrQuant.h"
 #include "TLibCommon/TComLoopFilter.h"
 #include "TLibCommon/AccessUnit.h"
+#include "TLibCommon/TComThreadPool.h"
 
 #include "TLibVideoIO/TVideoIOYuv.h"
 
@@ -57,6 +58,7 @@
 #include "TEncSampleAdaptiveOffset.h"
 #include "TEncPreanalyzer.h"
 #include "TEncRateCtrl.h"
+#include "TEncCtuWorker.h"
 //! \ingroup TLibEncoder
 //! \{
 
@@ -111,6 +113,12 @@ private:
 
   TEncRateCtrl            m_cRateCtrl;                    ///< Rate control class
 
+  // multi-threading
+  TComThreadPool          m_cThreadPool;                  ///< worker threads (only created when more than one thread is used)
+  TEncCtuWorker*          m_pcCtuWorkers;                 ///< CTU compression tools, one set per thread of the pool
+  TEncSlice*              m_pcFrameSliceEncoders;         ///< slice encoders of the pictures compressed concurrently (NULL if one picture at a time)
+  TEncCtuWorker*          m_pcFrameCtuWorkers;            ///< CTU compression tools of the frame slice encoders, followed by one set per thread of the pool
+
 protected:
   Void  xGetNewPicBuffer  ( TComPic*& rpcPic, Int ppsId ); ///< get picture buffer which will be processed. If ppsId<0, then the ppsMap will be queried for the first match.
   Void  xInitVPS          (TComVPS &vps, const TComSPS &sps); ///< initialize VPS from encoder options
@@ -122,6 +130,8 @@ protected:
   Void  xInitPPSforTiles  (TComPPS &pps);
   Void  xInitRPS          (TComSPS &sps, Bool isFieldCoding);           ///< initialize PPS from encoder options
 
+  Bool  xUseFrameParallelism() const;                     ///< check whether several pictures can be compressed concurrently
+
 public:
   TEncTop();
   virtual ~TEncTop();
@@ -153,6 +163,9 @@ public:
   TEncSbac***             getRDSbacCoder        () { return  m_pppcRDSbacCoder;       }
   TEncSbac*               getRDGoOnSbacCoder    () { return  &m_cRDGoOnSbacCoder;     }
   TEncRateCtrl*           getRateCtrl           () { return &m_cRateCtrl;             }
+  TComThreadPool*         getThreadPool         () { return  m_pcCtuWorkers ? &m_cThreadPool : NULL; }
+  TEncCtuWorker*          getCtuWorkers         () { return  m_pcCtuWorkers;          }
+  TEncSlice*              getFrameSliceEncoders () { return  m_pcFrameSliceEncoders;  }
   Void selectReferencePictureSet(TComSlice* slice, Int POCCurr, Int GOPid );
   Int getReferencePictureSetIdxForSOP(Int POCCurr, Int GOPid );
 